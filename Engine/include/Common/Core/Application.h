@@ -24,8 +24,7 @@ public:
     // ----------------------------------------
     Application(const std::string &name = "Basic Renderer", const int width = 800,
                 const int height = 600);
-    /// @brief Delete the application.
-    virtual ~Application() = default;
+    virtual ~Application();
     
     // Run
     // ----------------------------------------
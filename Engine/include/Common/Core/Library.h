@@ -67,6 +67,15 @@ public:
         else
             CORE_WARN("{0} not found!", GetName());
     }
+    /// @brief Removes the object with the specific name.
+    /// @param name The name associated with the object.
+    /// @note If the object with the specified name does not exist in the library, a warning is
+    /// logged.
+    void Remove(const std::string& name)
+    {
+        if (m_Objects.erase(name) == 0)
+            CORE_WARN("{0} not found!", GetName());
+    }
     /// @brief Checks if an object with a given name exists in the library.
     /// @param name The name of the object to check for existence.
     /// @return True if an object with the specified name exists in the library, otherwise false.
@@ -74,6 +83,8 @@ public:
     {
         return m_Objects.find(name) != m_Objects.end();
     }
+    /// @brief Removes all the objects of the library.
+    void Clear() { m_Objects.clear(); }
     
     // Iteration support
     // ----------------------------------------
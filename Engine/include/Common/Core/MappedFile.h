@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <sstream>
+#include <thread>
+
+/**
+ * Maps the content of a file into memory (read-only).
+ *
+ * The `MappedFile` class lets the operating system page the file in on demand, so large files
+ * (e.g. texture containers) are read directly from the page cache without being copied into
+ * a buffer first. The memory remains valid while the object exists.
+ *
+ * Copying or moving `MappedFile` objects is disabled to ensure single ownership of the mapping.
+ */
+class MappedFile
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    MappedFile(const std::filesystem::path& filePath);
+    ~MappedFile();
+    
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Check if the file has been mapped.
+    /// @return `true` if the content of the file can be read.
+    bool IsOpen() const { return m_Data != nullptr; }
+    /// @brief Get the content of the file.
+    /// @return The mapped memory.
+    const uint8_t* GetData() const { return m_Data; }
+    /// @brief Get the size of the file.
+    /// @return The size (in bytes).
+    size_t GetSize() const { return m_Size; }
+    
+    // Mapped file variables
+    // ----------------------------------------
+private:
+    ///< Mapped memory of the file.
+    const uint8_t* m_Data = nullptr;
+    ///< Size of the file (in bytes).
+    size_t m_Size = 0;
+    
+#ifdef _WIN32
+    ///< Handles of the file and its mapping.
+    void* m_File = nullptr;
+    void* m_Mapping = nullptr;
+#endif
+    
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+};
+
+/**
+ * Utility functions related to files.
+ */
+namespace utils {
+/// @brief Namespace containing utility functions for file operations.
+namespace Files {
+
+/**
+ * Get the path of a temporary file next to a file written, unique to the writer (process, thread
+ * and call), so concurrent writers never share a temporary file before renaming it.
+ *
+ * @param filePath The file written.
+ *
+ * @return The path of the temporary file.
+ */
+inline std::filesystem::path TemporaryPath(const std::filesystem::path& filePath)
+{
+    static const unsigned int process = std::random_device()();
+    static std::atomic<unsigned int> counter = 0;
+    
+    std::ostringstream suffix;
+    suffix << "." << std::hex << process << "-" << std::this_thread::get_id() << "-" << counter++ << ".tmp";
+    std::filesystem::path temporary = filePath;
+    temporary += suffix.str();
+    return temporary;
+}
+
+} // namespace Files
+} // namespace utils
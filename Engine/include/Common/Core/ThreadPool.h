@@ -0,0 +1,101 @@
+#pragma once
+
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <type_traits>
+
+/**
+ * Runs tasks concurrently on a fixed set of worker threads.
+ *
+ * The `ThreadPool` class keeps its worker threads alive while the pool exists, so tasks (e.g.
+ * decoding image files) can be submitted without the cost of creating a thread each time. The
+ * tasks are run in submission order, and their results are returned through futures.
+ *
+ * The pending tasks are still run when the pool is destroyed, before joining the workers.
+ *
+ * Copying or moving `ThreadPool` objects is disabled to ensure single ownership of the workers.
+ */
+class ThreadPool
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    ThreadPool(const unsigned int threads = 0);
+    ~ThreadPool();
+    
+    // Tasks
+    // ----------------------------------------
+    /// @brief Submit a task to be run by a worker thread.
+    /// @param task The task (callable without arguments).
+    /// @return The future result of the task.
+    template<typename Task>
+    auto Submit(Task&& task) -> std::future<std::invoke_result_t<Task>>
+    {
+        using Result = std::invoke_result_t<Task>;
+        auto job = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+        std::future<Result> result = job->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Tasks.push([job]() { (*job)(); });
+        }
+        m_Condition.notify_one();
+        return result;
+    }
+    /// @brief Run a function over ranges of items split among the calling thread and the workers,
+    /// waiting for all of them (it must not be called from a task of the same pool).
+    /// @param count The number of items.
+    /// @param parts The number of ranges (the first one is run by the calling thread).
+    /// @param function The function processing a range of items (begin and end).
+    template<typename Function>
+    void ParallelFor(const int count, const int parts, const Function& function)
+    {
+        int chunk = (count + parts - 1) / parts;
+        std::vector<std::future<void>> ranges;
+        for (int t = 1; t < parts; t++)
+        {
+            int begin = std::min(t * chunk, count), end = std::min((t + 1) * chunk, count);
+            ranges.push_back(Submit([&function, begin, end]() { function(begin, end); }));
+        }
+        function(0, std::min(chunk, count));
+        
+        for (auto& range : ranges)
+            range.get();
+    }
+    
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the number of worker threads.
+    /// @return The thread count.
+    unsigned int GetThreadCount() const { return (unsigned int)m_Workers.size(); }
+    
+private:
+    // Workers
+    // ----------------------------------------
+    void Run();
+    
+    // Thread pool variables
+    // ----------------------------------------
+private:
+    ///< Worker threads.
+    std::vector<std::thread> m_Workers;
+    ///< Tasks waiting for a worker.
+    std::queue<std::function<void()>> m_Tasks;
+    
+    ///< Mutex guarding the tasks.
+    std::mutex m_Mutex;
+    ///< Condition notified when a task is submitted (or the pool is stopped).
+    std::condition_variable m_Condition;
+    ///< Whether the workers should finish.
+    bool m_Stop = false;
+    
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+};
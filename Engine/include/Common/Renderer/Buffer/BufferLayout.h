@@ -7,12 +7,20 @@
  *
  * The `DataType` enumeration represents different data types that can be used for vertex attributes.
  * It includes boolean, integer, floating-point, vectors (2D, 3D, 4D), and matrices (2x2, 3x3, 4x4) types.
+ * It also includes compact (quantized) types: 8/16-bit integer vectors, which are usually combined
+ * with the `Normalized` flag of a `BufferElement` (snorm/unorm), half-float vectors, and the packed
+ * signed 10:10:10:2 format.
  */
 enum class DataType
 {
     Bool, Int, Float,
     Vec2, Vec3, Vec4,
-    Mat2, Mat3, Mat4
+    Mat2, Mat3, Mat4,
+    Byte4, UByte4,
+    Short2, Short4,
+    UShort2, UShort4,
+    Half2, Half4,
+    Int2101010
 };
 
 namespace utils { namespace OpenGL
@@ -37,6 +45,15 @@ inline unsigned int GetCompCountOfType(DataType type)
         case DataType::Mat2: return 2;
         case DataType::Mat3: return 3;
         case DataType::Mat4: return 4;
+        case DataType::Byte4: return 4;
+        case DataType::UByte4: return 4;
+        case DataType::Short2: return 2;
+        case DataType::Short4: return 4;
+        case DataType::UShort2: return 2;
+        case DataType::UShort4: return 4;
+        case DataType::Half2: return 2;
+        case DataType::Half4: return 4;
+        case DataType::Int2101010: return 4;
     }
     
     CORE_ASSERT(false, "Unknown vertex data type!");
@@ -63,6 +80,15 @@ inline unsigned int GetSizeOfType(DataType type)
         case DataType::Mat2: return 4 * 2 * 2;
         case DataType::Mat3: return 4 * 3 * 3;
         case DataType::Mat4: return 4 * 4 * 4;
+        case DataType::Byte4: return 1 * 4;
+        case DataType::UByte4: return 1 * 4;
+        case DataType::Short2: return 2 * 2;
+        case DataType::Short4: return 2 * 4;
+        case DataType::UShort2: return 2 * 2;
+        case DataType::UShort4: return 2 * 4;
+        case DataType::Half2: return 2 * 2;
+        case DataType::Half4: return 2 * 4;
+        case DataType::Int2101010: return 4;
     }
     
     CORE_ASSERT(false, "Unknown vertex data type!");
@@ -91,6 +117,15 @@ inline GLenum DataTypeToOpenGLType(DataType type)
         case DataType::Mat2: return GL_FLOAT;
         case DataType::Mat3: return GL_FLOAT;
         case DataType::Mat4: return GL_FLOAT;
+        case DataType::Byte4: return GL_BYTE;
+        case DataType::UByte4: return GL_UNSIGNED_BYTE;
+        case DataType::Short2: return GL_SHORT;
+        case DataType::Short4: return GL_SHORT;
+        case DataType::UShort2: return GL_UNSIGNED_SHORT;
+        case DataType::UShort4: return GL_UNSIGNED_SHORT;
+        case DataType::Half2: return GL_HALF_FLOAT;
+        case DataType::Half4: return GL_HALF_FLOAT;
+        case DataType::Int2101010: return GL_INT_2_10_10_10_REV;
     }
     
     CORE_ASSERT(false, "Unknown vertex data type!");
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstdint>
+
+/**
+ * Represents a range of memory allocated from a buffer pool.
+ *
+ * The allocation is a handle: its buffer and offset are resolved through the pool, since they
+ * can change when the pool is defragmented.
+ */
+struct BufferAllocation
+{
+    unsigned int handle = std::numeric_limits<unsigned int>::max(); ///< Block allocated in the pool.
+
+    /// @brief Check if the allocation succeeded.
+    /// @return `true` if the allocation refers to a block of the pool.
+    bool IsValid() const { return handle != std::numeric_limits<unsigned int>::max(); }
+};
+
+/**
+ * Suballocates the memory of a few large buffers in the GPU.
+ *
+ * The `BufferPool` class hands out ranges of large buffers (pages) instead of creating one buffer
+ * for each resource, avoiding thousands of small allocations in the driver. The free ranges are
+ * managed with a two-level segregated fit allocator (TLSF): the free blocks are classified by
+ * size into segregated lists indexed with bitmaps, so allocations and releases run in constant
+ * time, and the released blocks are merged with their free neighbours.
+ *
+ * At load boundaries (e.g. after unloading a scene), the pool can be defragmented, moving the
+ * allocated blocks of each page to its beginning, and the empty pages can be released. Since the
+ * ranges move, their location must be read through the pool whenever they are used, and the
+ * objects caching it must check the generation of the pool (see `GetGeneration()`).
+ *
+ * Copying or moving `BufferPool` objects is disabled to ensure single ownership and prevent
+ * unintended buffer duplication.
+ */
+class BufferPool
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    BufferPool(const unsigned int pageSize, const unsigned int alignment = 16);
+    ~BufferPool();
+
+    // Allocation
+    // ----------------------------------------
+    BufferAllocation Allocate(const unsigned int size);
+    void Free(BufferAllocation& allocation);
+
+    void SetData(const BufferAllocation& allocation, const void *data, const unsigned int size,
+                 const unsigned int offset = 0);
+
+    // Maintenance
+    // ----------------------------------------
+    void Defragment();
+    void Trim();
+
+    // Getter(s)
+    // ----------------------------------------
+    unsigned int GetBuffer(const BufferAllocation& allocation) const;
+    unsigned int GetOffset(const BufferAllocation& allocation) const;
+    unsigned int GetSize(const BufferAllocation& allocation) const;
+
+    /// @brief Get the generation of the pool, increased every time the allocations are moved.
+    /// @return The pool generation.
+    unsigned int GetGeneration() const { return m_Generation; }
+
+    // Statistics
+    // ----------------------------------------
+    /**
+     * Represents the information related to the statistics of the buffer pool.
+     */
+    struct PoolStatistics
+    {
+        ///< Number of buffers (pages) allocated.
+        unsigned int pages = 0;
+        ///< Number of ranges allocated.
+        unsigned int allocations = 0;
+        ///< Number of free blocks.
+        unsigned int freeBlocks = 0;
+        ///< Size of all the pages (in bytes).
+        size_t capacity = 0;
+        ///< Size of the ranges allocated (in bytes).
+        size_t used = 0;
+        ///< Size of the largest free block (in bytes).
+        size_t largestFree = 0;
+
+        /// @brief Get the fraction of the pool memory allocated.
+        /// @return The utilization (between 0 and 1).
+        float GetUtilization() const { return capacity > 0 ? (float)used / (float)capacity : 0.0f; }
+        /// @brief Get the fraction of the free memory not available for the largest allocation.
+        /// @return The fragmentation (between 0 and 1).
+        float GetFragmentation() const
+        {
+            size_t free = capacity - used;
+            return free > 0 ? 1.0f - (float)largestFree / (float)free : 0.0f;
+        }
+    };
+
+    PoolStatistics GetStats() const;
+
+private:
+    // Pages
+    // ----------------------------------------
+    void AddPage(const unsigned int size);
+
+    // Blocks
+    // ----------------------------------------
+    unsigned int CreateBlock();
+    void ReleaseBlock(const unsigned int block);
+
+    void InsertFreeBlock(const unsigned int block);
+    void RemoveFreeBlock(const unsigned int block);
+    unsigned int FindFreeBlock(const unsigned int units) const;
+
+    // Buffer pool structures
+    // ----------------------------------------
+private:
+    /**
+     * Represents a buffer of the pool.
+     */
+    struct Page
+    {
+        ///< ID of the buffer (zero if the page has been released).
+        unsigned int id = 0;
+        ///< Size of the buffer (in bytes).
+        unsigned int size = 0;
+        ///< First block of the page.
+        unsigned int first = 0;
+    };
+
+    /**
+     * Represents a contiguous range of a page, either allocated or free.
+     */
+    struct Block
+    {
+        ///< Page containing the block.
+        unsigned int page = 0;
+        ///< Offset of the block in its page (in bytes).
+        unsigned int offset = 0;
+        ///< Size of the block (in bytes).
+        unsigned int size = 0;
+        ///< Whether the block is free.
+        bool free = false;
+
+        ///< Previous and next blocks in the page.
+        unsigned int prevPhysical = 0, nextPhysical = 0;
+        ///< Previous and next blocks in the free list.
+        unsigned int prevFree = 0, nextFree = 0;
+    };
+
+    // Buffer pool variables
+    // ----------------------------------------
+private:
+    ///< Default size of the pages (in bytes).
+    unsigned int m_PageSize = 0;
+    ///< Alignment of the allocations (in bytes).
+    unsigned int m_Alignment = 1;
+    ///< Generation of the pool (increased when the allocations move).
+    unsigned int m_Generation = 0;
+
+    ///< Buffers of the pool.
+    std::vector<Page> m_Pages;
+    ///< Blocks of all the pages.
+    std::vector<Block> m_Blocks;
+    ///< Blocks not in use (reused when new blocks are required).
+    std::vector<unsigned int> m_UnusedBlocks;
+
+    ///< First free block of each list (first and second level).
+    std::vector<std::array<unsigned int, 16>> m_FreeLists;
+    ///< Non-empty first level lists.
+    uint32_t m_FirstLevelMap = 0;
+    ///< Non-empty second level lists of each first level.
+    std::vector<uint32_t> m_SecondLevelMap;
+
+    ///< Number of ranges allocated.
+    unsigned int m_Allocations = 0;
+    ///< Size of the ranges allocated (in bytes).
+    size_t m_Used = 0;
+
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    BufferPool(const BufferPool&) = delete;
+    BufferPool(BufferPool&&) = delete;
+
+    BufferPool& operator=(const BufferPool&) = delete;
+    BufferPool& operator=(BufferPool&&) = delete;
+};
@@ -1,5 +1,62 @@
 #pragma once
 
+#include "Common/Renderer/Buffer/BufferPool.h"
+
+#include <GL/glew.h>
+
+#include <cstdint>
+
+/**
+ * Enumeration of the data types that can be used to store the indices of an index buffer.
+ */
+enum class IndexType
+{
+    UInt16, UInt32
+};
+
+namespace utils { namespace OpenGL
+{
+/**
+ * Get the size (in bytes) of an index depending on its type.
+ *
+ * @param type Index type.
+ *
+ * @return The size of an index (in bytes).
+ */
+inline unsigned int GetSizeOfIndexType(IndexType type)
+{
+    switch (type)
+    {
+        case IndexType::UInt16: return 2;
+        case IndexType::UInt32: return 4;
+    }
+    
+    CORE_ASSERT(false, "Unknown index type!");
+    return 0;
+}
+
+/**
+ * Convert the index type to its corresponding OpenGL type.
+ *
+ * @param type Index type.
+ *
+ * @return OpenGL index type.
+ */
+inline GLenum IndexTypeToOpenGLType(IndexType type)
+{
+    switch (type)
+    {
+        case IndexType::UInt16: return GL_UNSIGNED_SHORT;
+        case IndexType::UInt32: return GL_UNSIGNED_INT;
+    }
+    
+    CORE_ASSERT(false, "Unknown index type!");
+    return 0;
+}
+
+} // namespace OpenGL
+} // namespace utils
+
 /**
  * Represents an index buffer for rendering.
  *
@@ -7,6 +64,12 @@
  * which vertices are rendered, allowing for efficient reuse of shared vertices. It provides functions
  * for creation, binding, and management of index buffers.
  *
+ * The indices are stored using 16-bit values whenever all of them fit, halving the memory and the
+ * index fetch bandwidth. The selected type is available through `GetType()` for the draw calls.
+ *
+ * The indices are stored in a range of the index pool of the renderer, shared with the other
+ * index buffers, so the draw calls must start at the offset of the range (`GetOffset()`).
+ *
  * Copying or moving `IndexBuffer` objects is disabled to ensure single ownership and prevent
  * unintended buffer duplication.
  */
@@ -16,6 +79,7 @@ public:
     // Constructor(s)/Destructor
     // ----------------------------------------
     IndexBuffer(const unsigned int *indices, const unsigned int count);
+    IndexBuffer(const uint16_t *indices, const unsigned int count);
     ~IndexBuffer();
     
     // Usage
@@ -28,14 +92,35 @@ public:
     /// Get the number of indices.
     /// @return The count of indices.
     unsigned int GetCount() const { return m_Count; }
+    /// Get the data type of the indices.
+    /// @return The index type.
+    IndexType GetType() const { return m_Type; }
+    /// Get the size of the index data stored in the buffer.
+    /// @return The size (in bytes).
+    unsigned int GetSize() const
+    {
+        return m_Count * utils::OpenGL::GetSizeOfIndexType(m_Type);
+    }
+    /// Get the offset of the indices in the buffer bound.
+    /// @return The offset (in bytes).
+    unsigned int GetOffset() const { return m_Pool->GetOffset(m_Allocation); }
+    
+private:
+    // Definition
+    // ----------------------------------------
+    void DefineBuffer(const void *indices, IndexType type);
     
     // Index buffer variables
     // ----------------------------------------
 private:
-    ///< ID of the index buffer.
-    unsigned int m_ID = 0;
+    ///< Pool containing the indices.
+    std::shared_ptr<BufferPool> m_Pool;
+    ///< Range of the pool allocated for the indices.
+    BufferAllocation m_Allocation;
     ///< Number of indices (element count).
     unsigned int m_Count = 0;
+    ///< Data type of the indices.
+    IndexType m_Type = IndexType::UInt32;
     
     // Disable the copying or moving of this resource
     // ----------------------------------------
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "Common/Renderer/Buffer/StorageBuffer.h"
+
+#include <cstdint>
+
+/**
+ * Represents a region of a ring buffer written during the current frame.
+ */
+struct RingAllocation
+{
+    void* data = nullptr;       ///< Memory to be written (valid until the end of the frame).
+    unsigned int offset = 0;    ///< Offset of the region in the buffer (in bytes).
+    unsigned int size = 0;      ///< Size of the region (in bytes).
+
+    /// @brief Check if the allocation succeeded.
+    /// @return `true` if the region can be written.
+    bool IsValid() const { return data != nullptr; }
+};
+
+/**
+ * Represents a buffer streaming dynamic data to the GPU every frame.
+ *
+ * The `RingBuffer` class splits a buffer into one region per frame in flight (three by default).
+ * Each frame, the dynamic data (per-draw transforms, instance data or streaming vertices) is
+ * appended into the region of the frame, and then bound as a range of the buffer. Once the frame
+ * is submitted, a fence is placed so the region is only overwritten after the GPU has consumed it.
+ * A frame writing more than a region holds continues into the next one (see `NextRegion()`),
+ * waiting for the GPU if needed, so the regions should be sized for the largest frames.
+ *
+ * When supported, the buffer uses immutable storage persistently and coherently mapped, so the
+ * allocations are written directly into the memory read by the GPU without any call to the driver.
+ * Otherwise, the data is written into a copy in the client memory, and everything written since
+ * the previous binding is uploaded in a single update (so data bound right after being written
+ * costs one update per binding).
+ *
+ * Copying or moving `RingBuffer` objects is disabled to ensure single ownership and prevent
+ * unintended buffer duplication.
+ */
+class RingBuffer
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    RingBuffer(const unsigned int size, const unsigned int frames = 3);
+    ~RingBuffer();
+
+    // Frame
+    // ----------------------------------------
+    void BeginFrame();
+    void EndFrame();
+    void NextRegion();
+
+    // Allocation
+    // ----------------------------------------
+    RingAllocation Allocate(const unsigned int size, const unsigned int alignment = 0);
+    RingAllocation Push(const void *data, const unsigned int size, const unsigned int alignment = 0);
+    /// @brief Append a value into the region of the current frame.
+    /// @param value The value to be copied.
+    /// @param alignment The alignment of the region (the binding alignment if zero).
+    /// @return The region written, invalid if the frame region is full.
+    template<typename T>
+    RingAllocation Push(const T& value, const unsigned int alignment = 0)
+    {
+        return Push(&value, (unsigned int)sizeof(T), alignment);
+    }
+
+    // Usage
+    // ----------------------------------------
+    void Bind(const StorageTarget& target = StorageTarget::Uniform);
+    void Unbind(const StorageTarget& target = StorageTarget::Uniform) const;
+    void BindRange(const StorageTarget& target, const unsigned int index,
+                   const RingAllocation& allocation);
+
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Check if the buffer is persistently mapped.
+    /// @return `true` if the allocations are written directly into the buffer.
+    bool IsPersistent() const { return m_Persistent; }
+    /// @brief Get the size of the region of each frame.
+    /// @return The frame size (in bytes).
+    unsigned int GetFrameSize() const { return m_FrameSize; }
+    /// @brief Get the number of frames in flight.
+    /// @return The frame count.
+    unsigned int GetFrameNumber() const { return m_Frames; }
+    /// @brief Get the size allocated in the current frame.
+    /// @return The used size (in bytes).
+    unsigned int GetUsedSize() const { return m_Head; }
+    /// @brief Get the default alignment of the allocations (required to bind them as ranges).
+    /// @return The alignment (in bytes).
+    unsigned int GetAlignment() const { return m_Alignment; }
+
+    static unsigned int QueryAlignment();
+
+    // Statistics
+    // ----------------------------------------
+    /**
+     * Represents the information related to the statistics of the ring buffer.
+     */
+    struct RingStatistics
+    {
+        ///< Number of regions allocated.
+        unsigned int allocations = 0;
+        ///< Number of bytes allocated (including the alignment).
+        unsigned int bytes = 0;
+        ///< Number of allocations failed because the frame region was full.
+        unsigned int overflows = 0;
+        ///< Number of regions the frame continued into after filling its first one.
+        unsigned int extraRegions = 0;
+        ///< Number of times the GPU had not yet consumed the region of the frame.
+        unsigned int fenceWaits = 0;
+        ///< Time spent waiting for the GPU (in milliseconds).
+        float waitTime = 0.0f;
+    };
+
+    /// @brief Get the statistics since the beginning of the frame.
+    /// @return The ring buffer statistics.
+    const RingStatistics& GetStats() const { return m_Stats; }
+
+private:
+    // Synchronization
+    // ----------------------------------------
+    void Advance();
+    void Flush();
+    /// @brief Get the offset of the current frame region in the buffer.
+    /// @return The offset (in bytes).
+    unsigned int GetFrameOffset() const { return m_Frame * m_FrameSize; }
+
+    // Ring buffer variables
+    // ----------------------------------------
+private:
+    ///< ID of the buffer.
+    unsigned int m_ID = 0;
+
+    ///< Size of the region of each frame (in bytes).
+    unsigned int m_FrameSize = 0;
+    ///< Number of frames in flight.
+    unsigned int m_Frames = 0;
+    ///< Index of the current frame region.
+    unsigned int m_Frame = 0;
+
+    ///< Size allocated in the current frame region (in bytes).
+    unsigned int m_Head = 0;
+    ///< Size of the current frame region already uploaded (non-persistent buffers).
+    unsigned int m_Flushed = 0;
+    ///< Default alignment of the allocations (in bytes).
+    unsigned int m_Alignment = 1;
+
+    ///< Whether the buffer is persistently mapped.
+    bool m_Persistent = false;
+    ///< Mapped memory of the buffer (persistent buffers).
+    uint8_t* m_Data = nullptr;
+    ///< Client copy of the buffer (non-persistent buffers).
+    std::vector<uint8_t> m_Staging;
+    ///< Fence signaled once the GPU has consumed each frame region.
+    std::vector<GLsync> m_Fences;
+
+    ///< Statistics of the ring buffer.
+    RingStatistics m_Stats;
+
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer(RingBuffer&&) = delete;
+
+    RingBuffer& operator=(const RingBuffer&) = delete;
+    RingBuffer& operator=(RingBuffer&&) = delete;
+};
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <GL/glew.h>
+
+/**
+ * Enumeration of the targets a storage buffer can be bound to.
+ */
+enum class StorageTarget
+{
+    ShaderStorage,  ///< Read/written by the shaders (`buffer` blocks).
+    DrawIndirect,   ///< Source of the indirect draw commands.
+    Parameter,      ///< Source of the draw count for the indirect draw calls.
+    Uniform,        ///< Read by the shaders (`uniform` blocks).
+    Vertex,         ///< Source of the vertex attributes.
+    PixelUnpack,    ///< Source of the texture data uploads.
+    PixelPack,      ///< Destination of the pixel data read back.
+};
+
+/**
+ * Enumeration of the accesses to the memory of a mapped storage buffer.
+ */
+enum class StorageAccess
+{
+    Read,       ///< The data is read (e.g. results of a compute shader).
+    Write,      ///< The data is overwritten (the previous content is discarded).
+    ReadWrite,  ///< The data is read and modified.
+};
+
+namespace utils { namespace OpenGL
+{
+/**
+ * Convert the storage target to its corresponding OpenGL target.
+ *
+ * @param target Storage target.
+ *
+ * @return OpenGL buffer target.
+ */
+inline GLenum StorageTargetToOpenGLTarget(StorageTarget target)
+{
+    switch (target)
+    {
+        case StorageTarget::ShaderStorage: return GL_SHADER_STORAGE_BUFFER;
+        case StorageTarget::DrawIndirect: return GL_DRAW_INDIRECT_BUFFER;
+        case StorageTarget::Parameter: return GL_PARAMETER_BUFFER_ARB;
+        case StorageTarget::Uniform: return GL_UNIFORM_BUFFER;
+        case StorageTarget::Vertex: return GL_ARRAY_BUFFER;
+        case StorageTarget::PixelUnpack: return GL_PIXEL_UNPACK_BUFFER;
+        case StorageTarget::PixelPack: return GL_PIXEL_PACK_BUFFER;
+    }
+
+    CORE_ASSERT(false, "Unknown storage target!");
+    return 0;
+}
+
+/**
+ * Convert the storage access to its corresponding OpenGL mapping flags.
+ *
+ * @param access Storage access.
+ *
+ * @return OpenGL buffer mapping flags.
+ */
+inline GLbitfield StorageAccessToOpenGLFlags(StorageAccess access)
+{
+    switch (access)
+    {
+        case StorageAccess::Read: return GL_MAP_READ_BIT;
+        case StorageAccess::Write: return GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+        case StorageAccess::ReadWrite: return GL_MAP_READ_BIT | GL_MAP_WRITE_BIT;
+    }
+
+    CORE_ASSERT(false, "Unknown storage access!");
+    return 0;
+}
+
+} // namespace OpenGL
+} // namespace utils
+
+/**
+ * Represents a general purpose buffer in the GPU.
+ *
+ * The `StorageBuffer` class manages buffers that are written and read by the shaders (shader
+ * storage buffers), or that source the arguments of indirect draw calls. It provides functions
+ * for creation, update, and binding of the buffer to its different targets.
+ *
+ * Copying or moving `StorageBuffer` objects is disabled to ensure single ownership and prevent
+ * unintended buffer duplication.
+ */
+class StorageBuffer
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    StorageBuffer(const unsigned int size, const void *data = nullptr);
+    ~StorageBuffer();
+
+    // Usage
+    // ----------------------------------------
+    void Bind(const StorageTarget& target = StorageTarget::ShaderStorage) const;
+    void Unbind(const StorageTarget& target = StorageTarget::ShaderStorage) const;
+    void BindBase(const unsigned int index) const;
+
+    // Setter(s)
+    // ----------------------------------------
+    void SetData(const void *data, const unsigned int size, const unsigned int offset = 0);
+    void Clear();
+
+    // Mapping
+    // ----------------------------------------
+    void* Map(const StorageAccess& access = StorageAccess::Read, const unsigned int offset = 0,
+              const unsigned int size = 0);
+    void Unmap();
+    /// @brief Map a region of the buffer into the client memory.
+    /// @param access The access to the mapped memory.
+    /// @param offset Offset of the region (in elements).
+    /// @param count Number of elements in the region (the rest of the buffer if zero).
+    /// @return The mapped memory, or null if the mapping failed.
+    template<typename T>
+    T* Map(const StorageAccess& access = StorageAccess::Read, const unsigned int offset = 0,
+           const unsigned int count = 0)
+    {
+        return static_cast<T*>(Map(access, offset * (unsigned int)sizeof(T),
+                                   count * (unsigned int)sizeof(T)));
+    }
+
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the size of the buffer.
+    /// @return The size (in bytes).
+    unsigned int GetSize() const { return m_Size; }
+
+    // Storage buffer variables
+    // ----------------------------------------
+private:
+    ///< ID of the storage buffer.
+    unsigned int m_ID = 0;
+    ///< Size of the buffer (in bytes).
+    unsigned int m_Size = 0;
+    ///< Whether the buffer is currently mapped.
+    bool m_Mapped = false;
+
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    StorageBuffer(const StorageBuffer&) = delete;
+    StorageBuffer(StorageBuffer&&) = delete;
+
+    StorageBuffer& operator=(const StorageBuffer&) = delete;
+    StorageBuffer& operator=(StorageBuffer&&) = delete;
+};
@@ -11,6 +11,9 @@
  * It allows for adding multiple vertex buffers and setting an index buffer. Use this class to define
  * the complete layout of vertex data for rendering a `Mesh`.
  *
+ * The attributes point to the ranges of the vertex pool, so they are defined again when the
+ * pool has been defragmented since they were set up.
+ *
  * Copying or moving `VertexArray` objects is disabled to ensure single ownership and prevent
  * unintended duplication.
  */
@@ -52,13 +55,18 @@ public:
         m_IndexBuffer = ibo;
     }
     
+private:
+    // Attributes
+    // ----------------------------------------
+    void DefineAttributes() const;
+    
     // Vertex array variables
     // ----------------------------------------
 private:
     ///< ID of the vertex array.
     unsigned int m_ID = 0;
-    ///< Vertex attribute index.
-    unsigned int m_Index = 0;
+    ///< Generation of the vertex pool when the attributes were defined.
+    mutable unsigned int m_Generation = 0;
     
     ///< Linked vertex buffers (possible to have more than one).
     std::vector<std::shared_ptr<VertexBuffer>> m_VertexBuffers;
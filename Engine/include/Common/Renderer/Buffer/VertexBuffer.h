@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common/Renderer/Buffer/BufferLayout.h"
+#include "Common/Renderer/Buffer/BufferPool.h"
 
 /**
  * Represents a vertex buffer for storing vertex data.
@@ -9,6 +10,9 @@
  * position, color, texture coordinates, etc.). This data is used by the graphics pipeline during rendering.
  * It provides functions for creation, binding, and management of vertex buffers.
  *
+ * The vertex data is stored in a range of the vertex pool of the renderer, shared with the other
+ * vertex buffers, so the attributes must be read from the offset of the range (`GetOffset()`).
+ *
  * Copying or moving `VertexBuffer` objects is disabled to ensure single ownership and prevent
  * unintended buffer duplication.
  */
@@ -31,6 +35,15 @@ public:
     /// Get the number of vertices.
     /// @return The amount of vertices defined.
     unsigned int GetCount() const { return m_Count; }
+    /// Get the size of the vertex data stored in the buffer.
+    /// @return The size (in bytes).
+    unsigned int GetSize() const { return m_Size; }
+    /// Get the buffer containing the vertex data.
+    /// @return The ID of the buffer.
+    unsigned int GetBuffer() const { return m_Pool->GetBuffer(m_Allocation); }
+    /// Get the offset of the vertex data in the buffer bound.
+    /// @return The offset (in bytes).
+    unsigned int GetOffset() const { return m_Pool->GetOffset(m_Allocation); }
     /// @brief Retrieve the current layout of the buffer, specifying the arrangement and format
     /// of vertex attributes within the buffer.
     /// @return The layout of the buffer.
@@ -46,10 +59,14 @@ public:
     // Vertex buffer variables
     // ----------------------------------------
 private:
-    ///< ID of the vertex buffer.
-    unsigned int m_ID = 0;
+    ///< Pool containing the vertex data.
+    std::shared_ptr<BufferPool> m_Pool;
+    ///< Range of the pool allocated for the vertex data.
+    BufferAllocation m_Allocation;
     ///< Number of vertices (element count).
     unsigned int m_Count = 0;
+    ///< Size of the vertex data (in bytes).
+    unsigned int m_Size = 0;
     ///< Layout for the vertex attributes.
     BufferLayout m_Layout;
     
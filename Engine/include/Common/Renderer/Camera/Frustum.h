@@ -0,0 +1,56 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+/**
+ * Represents the planes bounding the volume visible through a view-projection transformation.
+ *
+ * Each plane is stored as (normal, distance), with the normal pointing inside the volume, so a
+ * point `p` is inside the plane when `dot(normal, p) + distance >= 0`. The planes are defined in
+ * the space the transformation starts from (e.g. world space for `projection * view`, or the
+ * model space for `projection * view * model`).
+ */
+struct Frustum
+{
+    ///< Frustum planes (left, right, bottom, top, near, far).
+    std::array<glm::vec4, 6> planes;
+
+    /// @brief Define the frustum of a transformation to clip space.
+    /// @param transform The transformation to clip space (e.g. `projection * view * model`).
+    Frustum(const glm::mat4& transform = glm::mat4(1.0f))
+    {
+        // Rows of the transformation (glm matrices are column-major)
+        glm::vec4 rows[4];
+        for (int i = 0; i < 4; i++)
+            rows[i] = glm::vec4(transform[0][i], transform[1][i], transform[2][i], transform[3][i]);
+
+        planes[0] = rows[3] + rows[0];
+        planes[1] = rows[3] - rows[0];
+        planes[2] = rows[3] + rows[1];
+        planes[3] = rows[3] - rows[1];
+        planes[4] = rows[3] + rows[2];
+        planes[5] = rows[3] - rows[2];
+
+        // Normalize the planes, so they measure distances in the source space
+        for (auto& plane : planes)
+        {
+            float length = glm::length(glm::vec3(plane));
+            if (length > 0.0f)
+                plane /= length;
+        }
+    }
+
+    /// @brief Check if a sphere is (at least partially) inside the frustum.
+    /// @param center The center of the sphere.
+    /// @param radius The radius of the sphere.
+    /// @return `true` if the sphere intersects the frustum.
+    bool IntersectsSphere(const glm::vec3& center, const float radius) const
+    {
+        for (const auto& plane : planes)
+        {
+            if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+                return false;
+        }
+        return true;
+    }
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "Common/Renderer/Buffer/StorageBuffer.h"
+#include "Common/Renderer/Shader/ComputeShader.h"
+#include "Common/Renderer/Texture/Texture.h"
+
+#include "Common/Renderer/Mesh/Mesh.h"
+
+#include <glm/glm.hpp>
+
+/**
+ * Culls and draws the instances of a mesh entirely on the GPU.
+ *
+ * The `GPUCulling` class stores the transformations of a (large) set of instances in a shader
+ * storage buffer. For each draw, a compute pass tests the bounding sphere of every instance
+ * against the view frustum and, if a depth pyramid of the previous frame has been defined,
+ * against its depth (occlusion culling). The visible instances select their level of detail and
+ * append their draw command into an indirect buffer, which is consumed without any readback.
+ *
+ * The instances are drawn one command each, with the base instance identifying the
+ * transformation, so the material shader must read it from the instances buffer (see
+ * `Resources/shaders/common/matrix/InstanceMatrix.glsl`). This requires compute shaders and
+ * draw parameters; the number of commands is read from a buffer when supported
+ * (`glMultiDrawElementsIndirectCount`), otherwise the unused commands are reset to zero.
+ *
+ * Copying or moving `GPUCulling` objects is disabled to ensure single ownership and prevent
+ * unintended duplication of the buffer resources.
+ */
+class GPUCulling
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    GPUCulling(const unsigned int capacity);
+    /// @brief Delete the GPU culling resources.
+    ~GPUCulling() = default;
+
+    // Setter(s)
+    // ----------------------------------------
+    void SetInstances(const std::vector<glm::mat4>& transforms);
+    void SetDepthPyramid(const std::shared_ptr<Texture>& pyramid, const glm::mat4& viewProjection);
+
+    // Getter(s)
+    // ----------------------------------------
+    static bool IsSupported();
+
+    /// @brief Get the maximum number of instances.
+    /// @return The instance capacity.
+    unsigned int GetCapacity() const { return m_Capacity; }
+    /// @brief Get the number of instances defined.
+    /// @return The instance count.
+    unsigned int GetInstanceCount() const { return m_InstanceCount; }
+    unsigned int ReadVisibleCount();
+
+    // Render
+    // ----------------------------------------
+    template<typename VertexData>
+    void Draw(const Mesh<VertexData>& mesh, const std::shared_ptr<Material>& material,
+              const PrimitiveType &primitive = PrimitiveType::Triangles);
+
+private:
+    // Culling
+    // ----------------------------------------
+    void Cull(const BSphere& sphere, const std::vector<IndexRange>& lods);
+
+    // GPU culling variables
+    // ----------------------------------------
+private:
+    ///< Maximum number of instances.
+    unsigned int m_Capacity = 0;
+    ///< Number of instances defined.
+    unsigned int m_InstanceCount = 0;
+
+    ///< Compute shader culling the instances.
+    std::shared_ptr<ComputeShader> m_Shader;
+
+    ///< Transformation of each instance.
+    std::unique_ptr<StorageBuffer> m_Instances;
+    ///< Draw commands of the visible instances.
+    std::unique_ptr<StorageBuffer> m_Commands;
+    ///< Number of draw commands written.
+    std::unique_ptr<StorageBuffer> m_DrawCount;
+
+    ///< Farthest depth of each region of the previous frame (mipmapped).
+    std::shared_ptr<Texture> m_DepthPyramid;
+    ///< View-projection used to render the depth pyramid.
+    glm::mat4 m_PyramidViewProjection = glm::mat4(1.0f);
+
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    GPUCulling(const GPUCulling&) = delete;
+    GPUCulling(GPUCulling&&) = delete;
+
+    GPUCulling& operator=(const GPUCulling&) = delete;
+    GPUCulling& operator=(GPUCulling&&) = delete;
+};
+
+/**
+ * Cull the instances of a mesh and draw the visible ones.
+ *
+ * @param mesh The mesh drawn by every instance.
+ * @param material The material used for the shading (reading the instance transformations).
+ * @param primitive The type of primitive to be drawn (e.g., Points, Lines, Triangles).
+ */
+template<typename VertexData>
+void GPUCulling::Draw(const Mesh<VertexData>& mesh, const std::shared_ptr<Material>& material,
+                      const PrimitiveType &primitive)
+{
+    if (m_InstanceCount == 0 || !mesh.GetVertexArray())
+        return;
+
+    // The commands address the indices from the start of the (pooled) index buffer
+    const auto& ibo = mesh.GetVertexArray()->GetIndexBuffer();
+    unsigned int first = ibo->GetOffset() / utils::OpenGL::GetSizeOfIndexType(ibo->GetType());
+    
+    std::vector<IndexRange> lods(mesh.GetLODNumber());
+    for (unsigned int i = 0; i < lods.size(); i++)
+    {
+        lods[i] = mesh.GetLODRange(i);
+        lods[i].offset += first;
+    }
+    Cull(mesh.GetBSphere(), lods);
+
+    // The instance transformations are read through the base instance of each command
+    m_Instances->BindBase(0);
+    Renderer::DrawIndirect(mesh.GetVertexArray(), material, *m_Commands, m_InstanceCount,
+                           m_DrawCount.get(), mesh.GetDecodeTransform(), primitive);
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "Common/Renderer/Model/Model.h"
+#include "Common/Renderer/Mesh/MeshBounds.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+/**
+ * Represents a tile of the masked depth buffer used by the occlusion culling.
+ *
+ * Each tile covers 8x4 pixels, with one bit of coverage per pixel. The depth is stored as two
+ * layers: the reference layer (covering the whole tile) and the working layer (covering the
+ * pixels of the mask), which replaces the reference one once the mask is full.
+ */
+struct OcclusionTile
+{
+    float zMax0 = 1.0f;     ///< Farthest depth of the reference layer.
+    float zMax1 = 0.0f;     ///< Farthest depth of the working layer.
+    uint32_t mask = 0;      ///< Pixels covered by the working layer.
+};
+
+/**
+ * Culls the models hidden behind a set of occluders, entirely on the CPU.
+ *
+ * The `OcclusionCulling` class rasterizes the triangles of the occluders (usually the coarsest
+ * level of detail of large models, such as walls or floors) into a small masked depth buffer,
+ * following the Masked Software Occlusion Culling approach. The buffer is split in horizontal
+ * bands rasterized by the thread pool of the renderer, and the coverage of each tile is evaluated
+ * with SIMD instructions. The bounding box of each model is then tested against the buffer, so
+ * the hidden models can be skipped without reading back any information from the GPU.
+ *
+ * The occluders rasterized are conservative: the triangles crossing the near plane are skipped,
+ * and each triangle uses its farthest depth.
+ *
+ * Copying or moving `OcclusionCulling` objects is disabled to ensure single ownership and
+ * prevent unintended duplication of the buffer.
+ */
+class OcclusionCulling
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    OcclusionCulling(const unsigned int width = 256, const unsigned int height = 128,
+                     const unsigned int threads = 0);
+    /// @brief Delete the occlusion culling.
+    ~OcclusionCulling() = default;
+
+    // Occluders
+    // ----------------------------------------
+    void AddOccluder(const std::shared_ptr<BaseModel>& model,
+                     const unsigned int lod = std::numeric_limits<unsigned int>::max());
+    void RemoveOccluder(const std::shared_ptr<BaseModel>& model);
+    /// @brief Remove all the occluders.
+    void ClearOccluders() { m_Occluders.clear(); }
+
+    // Culling
+    // ----------------------------------------
+    void Render(const glm::mat4& view, const glm::mat4& projection);
+
+    bool IsVisible(const BBox& bbox, const glm::mat4& transform = glm::mat4(1.0f));
+    bool IsVisible(const BaseModel& model);
+
+    // Statistics
+    // ----------------------------------------
+    /**
+     * Represents the information related to the statistics of the occlusion culling.
+     */
+    struct OcclusionStatistics
+    {
+        ///< Number of occluder triangles rasterized.
+        unsigned int triangles = 0;
+        ///< Number of bounding boxes tested.
+        unsigned int tests = 0;
+        ///< Number of bounding boxes found hidden.
+        unsigned int culled = 0;
+    };
+
+    /// @brief Get the statistics since the last render of the occluders.
+    /// @return The occlusion statistics.
+    const OcclusionStatistics& GetStats() const { return m_Stats; }
+
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the number of occluders.
+    /// @return The occluder count.
+    unsigned int GetOccluderNumber() const { return (unsigned int)m_Occluders.size(); }
+    /// @brief Get the size of the depth buffer.
+    /// @return The resolution (in pixels).
+    glm::uvec2 GetResolution() const { return m_Resolution; }
+    std::vector<float> GetDepth() const;
+
+private:
+    // Rasterization
+    // ----------------------------------------
+    void RasterizeBand(const std::vector<glm::vec3>& vertices, const unsigned int rowBegin,
+                       const unsigned int rowEnd);
+
+    // Occlusion culling variables
+    // ----------------------------------------
+private:
+    /**
+     * Represents the geometry of an occluder.
+     */
+    struct Occluder
+    {
+        ///< Model placing the occluder.
+        std::weak_ptr<BaseModel> model;
+        ///< Positions of the triangles (in the space of the model asset).
+        std::vector<glm::vec3> positions;
+        ///< Indices of the triangles.
+        std::vector<unsigned int> indices;
+    };
+
+    ///< Occluders rasterized into the depth buffer.
+    std::vector<Occluder> m_Occluders;
+
+    ///< Size of the depth buffer (in pixels).
+    glm::uvec2 m_Resolution;
+    ///< Number of tiles in each dimension.
+    glm::uvec2 m_Tiles;
+    ///< Tiles of the depth buffer.
+    std::vector<OcclusionTile> m_Buffer;
+    ///< Maximum number of threads rasterizing the buffer (all the workers of the pool if zero).
+    unsigned int m_Threads;
+
+    ///< View-projection used to render the occluders.
+    glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+    ///< Whether the occluders have been rendered.
+    bool m_Rendered = false;
+
+    ///< Statistics of the occlusion culling.
+    OcclusionStatistics m_Stats;
+
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    OcclusionCulling(const OcclusionCulling&) = delete;
+    OcclusionCulling(OcclusionCulling&&) = delete;
+
+    OcclusionCulling& operator=(const OcclusionCulling&) = delete;
+    OcclusionCulling& operator=(OcclusionCulling&&) = delete;
+};
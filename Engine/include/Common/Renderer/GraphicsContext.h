@@ -34,6 +34,7 @@ public:
     // Setter(s)
     // ----------------------------------------
     static void SetWindowHints();
+    static bool SetFallbackWindowHints();
     virtual void SetVerticalSync(bool enabled) = 0;
     
     // Clear
@@ -5,6 +5,8 @@
 #include "Common/Renderer/Light/Light.h"
 
 #include "Common/Renderer/Material/SimpleMaterial.h"
+#include "Common/Renderer/Shader/ComputeShader.h"
+#include "Common/Renderer/Buffer/StorageBuffer.h"
 
 #include "Common/Renderer/Mesh/MeshUtils.h"
 #include "Common/Renderer/Model/ModelUtils.h"
@@ -113,6 +115,7 @@ private:
     // ----------------------------------------
     void UpdateEnvironment();
     void UpdateSphericalHarmonics();
+    std::vector<float> ReduceSphericalHarmonics();
     
     // Render
     // ----------------------------------------
@@ -136,6 +139,12 @@ private:
     FrameBufferLibrary m_Framebuffers;
     ///< Material(s) for pre-processing.
     MaterialLibrary m_Materials;
+    ///< Plane geometry used for pre-processing.
+    std::shared_ptr<BaseModel> m_Plane;
+    ///< Compute shader reducing the spherical harmonics (if supported).
+    std::shared_ptr<ComputeShader> m_SHReduction;
+    ///< Spherical harmonics coefficients computed in the GPU.
+    std::unique_ptr<StorageBuffer> m_SHBuffer;
     
     /// Environment map orientation (pitch, yaw, and roll angles).
     glm::vec3 m_Rotation = glm::vec3(0.0f, -90.0f, 0.0f);
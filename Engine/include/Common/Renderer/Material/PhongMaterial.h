@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common/Renderer/Material/LightedMaterial.h"
+#include "Common/Renderer/Texture/TextureAtlas.h"
 
 /**
  * A base class for implementing Phong shading properties.
@@ -212,6 +213,78 @@ protected:
     std::shared_ptr<Texture> m_SpecularTexture;
 };
 
+/**
+ * A subclass of Phong implementing Phong shading with texture maps packed into texture arrays.
+ *
+ * The `PhongTextureArray` class is a subclass of `Phong` that samples its diffuse and specular
+ * maps from layers of texture arrays (see `TextureAtlas`). The materials whose maps share the
+ * same arrays bind the same textures and only differ by the layer indices and UV transforms, so
+ * their draws can be merged without changing the texture bindings.
+ */
+class PhongTextureArray : public Phong
+{
+public:
+    // Destructor
+    // ----------------------------------------
+    /// @brief Destructor for the phong texture array.
+    virtual ~PhongTextureArray() = default;
+    
+    // Setter(s)
+    // ----------------------------------------
+    /// @brief Set the diffuse texture map for the geometry.
+    /// @param region Location of the texture map in a texture array.
+    void SetDiffuseMap(const TextureRegion& region) { m_DiffuseRegion = region; }
+    /// @brief Set the specular texture map for the geometry.
+    /// @param region Location of the texture map in a texture array.
+    void SetSpecularMap(const TextureRegion& region) { m_SpecularRegion = region; }
+    
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the diffuse map used for the geometry.
+    /// @return The location of the diffuse texture map.
+    const TextureRegion& GetDiffuseMap() const { return m_DiffuseRegion; }
+    /// @brief Get the specular map used for the geometry.
+    /// @return The location of the specular texture map.
+    const TextureRegion& GetSpecularMap() const { return m_SpecularRegion; }
+    
+protected:
+    // Constructor(s)
+    // ----------------------------------------
+    /// @brief Generate a phong texture array.
+    PhongTextureArray() = default;
+    
+protected:
+    // Properties
+    // ----------------------------------------
+    /// @brief Set the material properties into the uniforms of the shader program.
+    /// @param shader The shader program to set the properties for.
+    void SetProperties(const std::shared_ptr<Shader>& shader, unsigned int& slot)
+    {
+        // Bind the array only once if both maps share it
+        unsigned int diffuseSlot = slot++;
+        utils::Texturing::SetTextureMap(shader, "u_Material.DiffuseMap", m_DiffuseRegion.array, diffuseSlot);
+        if (m_SpecularRegion.array == m_DiffuseRegion.array)
+            shader->SetInt("u_Material.SpecularMap", diffuseSlot);
+        else
+            utils::Texturing::SetTextureMap(shader, "u_Material.SpecularMap", m_SpecularRegion.array, slot++);
+        
+        shader->SetFloat("u_Material.DiffuseLayer", (float)m_DiffuseRegion.layer);
+        shader->SetVec4("u_Material.DiffuseTransform", m_DiffuseRegion.transform);
+        shader->SetFloat("u_Material.SpecularLayer", (float)m_SpecularRegion.layer);
+        shader->SetVec4("u_Material.SpecularTransform", m_SpecularRegion.transform);
+        
+        Phong::SetProperties(shader);
+    }
+    
+    // Phong texture array variables
+    // ----------------------------------------
+protected:
+    ///< Location of the diffuse map.
+    TextureRegion m_DiffuseRegion;
+    ///< Location of the specular map.
+    TextureRegion m_SpecularRegion;
+};
+
 /**
  * A material class for Phong shading with color-based lighting.
  *
@@ -309,3 +382,52 @@ public:
     PhongTextureMaterial& operator=(const PhongTextureMaterial&) = delete;
     PhongTextureMaterial& operator=(PhongTextureMaterial&&) = delete;
 };
+
+/**
+ * A material class for Phong shading with texture maps packed into texture arrays.
+ *
+ * The `PhongTextureArrayMaterial` class is a subclass of `LightedMaterial` and
+ * `PhongTextureArray`, providing a material definition for shading 3D models using Phong
+ * lighting with texture maps sampled from texture arrays. It uses a shader specified by the given
+ * file path to apply the shading to the model.
+ *
+ * Copying or moving `PhongTextureArrayMaterial` objects is disabled to ensure single ownership
+ * and prevent unintended duplication of material resources.
+ */
+class PhongTextureArrayMaterial : public LightedMaterial, public PhongTextureArray
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    /// @brief Generate a phong material object with the specified shader file path.
+    /// @param filePath The file path to the shader used by the material.
+    PhongTextureArrayMaterial(const std::filesystem::path& filePath =
+                              std::filesystem::path("Resources/shaders/phong/PhongTextureArray.glsl"))
+        : LightedMaterial(filePath), PhongTextureArray()
+    {
+        // Update material flags
+        m_Flags.ViewDirection = true;
+        m_Flags.NormalMatrix = true;
+    }
+    /// @brief Destructor for the phong texture array material.
+    ~PhongTextureArrayMaterial() override = default;
+    
+protected:
+    // Properties
+    // ----------------------------------------
+    /// @brief Set the material properties into the uniforms of the shader program.
+    void SetMaterialProperties() override
+    {
+        LightedMaterial::SetMaterialProperties();
+        PhongTextureArray::SetProperties(m_Shader, m_Slot);
+    }
+    
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    PhongTextureArrayMaterial(const PhongTextureArrayMaterial&) = delete;
+    PhongTextureArrayMaterial(PhongTextureArrayMaterial&&) = delete;
+
+    PhongTextureArrayMaterial& operator=(const PhongTextureArrayMaterial&) = delete;
+    PhongTextureArrayMaterial& operator=(PhongTextureArrayMaterial&&) = delete;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common/Renderer/Material/Material.h"
+#include "Common/Renderer/Texture/VirtualTexture.h"
 
 /**
  * A base class for materials with a simple color-based shading.
@@ -111,6 +112,65 @@ protected:
     std::shared_ptr<Texture> m_Texture;
 };
 
+/**
+ * A base class for materials with a virtual texture-based shading.
+ *
+ * The `FlatVirtualTexture` class provides a basic material definition for shading 3D models with
+ * a texture streamed by tiles (see `VirtualTexture`).
+ *
+ * Inherit from this class when creating materials that have a single virtual texture.
+ */
+class FlatVirtualTexture
+{
+public:
+    // Destructor
+    // ----------------------------------------
+    /// @brief Destructor for the flat virtual texture.
+    virtual ~FlatVirtualTexture() = default;
+    
+    // Setter(s)
+    // ----------------------------------------
+    /// @brief Set the virtual texture for the geometry.
+    /// @param texture Virtual texture.
+    virtual void SetVirtualTexture(const std::shared_ptr<VirtualTexture>& texture)
+    {
+        m_VirtualTexture = texture;
+    }
+    
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the virtual texture used for the geometry.
+    /// @return The virtual texture.
+    std::shared_ptr<VirtualTexture> GetVirtualTexture() const { return m_VirtualTexture; }
+    
+protected:
+    // Constructor(s)
+    // ----------------------------------------
+    /// @brief Generate a flat virtual texture.
+    FlatVirtualTexture() = default;
+    
+protected:
+    // Properties
+    // ----------------------------------------
+    /// @brief Set the material properties into the uniforms of the shader program.
+    /// @param shader The shader program to set the properties for.
+    /// @param name The uniform name.
+    /// @param slot The first texture slot.
+    /// @param feedback Whether the shader renders the feedback of the virtual texture.
+    void SetProperties(const std::shared_ptr<Shader>& shader,
+                       const std::string& name, unsigned int& slot, const bool feedback = false)
+    {
+        if (m_VirtualTexture)
+            m_VirtualTexture->SetProperties(shader, name, slot, feedback);
+    }
+    
+    // Flat virtual texture variables
+    // ----------------------------------------
+protected:
+    ///< Virtual texture.
+    std::shared_ptr<VirtualTexture> m_VirtualTexture;
+};
+
 /**
  * A material class for simple color-based shading.
  *
@@ -249,3 +309,91 @@ public:
     SimpleMaterial& operator=(const SimpleMaterial&) = delete;
     SimpleMaterial& operator=(SimpleMaterial&&) = delete;
 };
+
+/**
+ * A material class for simple virtual texture-based shading.
+ *
+ * The `SimpleVirtualTextureMaterial` class is a subclass of `Material` and provides a basic
+ * material definition for shading 3D models with a texture streamed by tiles. It uses a shader
+ * specified by the given file path to apply the tiles resident to the model.
+ *
+ * Copying or moving `SimpleVirtualTextureMaterial` objects is disabled to ensure single ownership
+ * and prevent unintended duplication of material resources.
+ */
+class SimpleVirtualTextureMaterial : public Material, public FlatVirtualTexture
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    /// @brief Generate a virtual texture material object with the specified shader file path.
+    /// @param filePath The file path to the shader used by the material.
+    SimpleVirtualTextureMaterial(const std::filesystem::path& filePath =
+                                 std::filesystem::path("Resources/shaders/base/SimpleVirtualTexture.glsl"))
+        : Material(filePath), FlatVirtualTexture()
+    {}
+    /// @brief Destructor for the virtual texture material.
+    ~SimpleVirtualTextureMaterial() override = default;
+    
+protected:
+    // Properties
+    // ----------------------------------------
+    /// @brief Set the material properties into the uniforms of the shader program.
+    void SetMaterialProperties() override
+    {
+        Material::SetMaterialProperties();
+        FlatVirtualTexture::SetProperties(m_Shader, "u_Material.TextureMap", m_Slot);
+    }
+    
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    SimpleVirtualTextureMaterial(const SimpleVirtualTextureMaterial&) = delete;
+    SimpleVirtualTextureMaterial(SimpleVirtualTextureMaterial&&) = delete;
+
+    SimpleVirtualTextureMaterial& operator=(const SimpleVirtualTextureMaterial&) = delete;
+    SimpleVirtualTextureMaterial& operator=(SimpleVirtualTextureMaterial&&) = delete;
+};
+
+/**
+ * A material class rendering the tiles of a virtual texture required by the geometry.
+ *
+ * The `VirtualTextureFeedbackMaterial` class is a subclass of `Material` used to render the
+ * geometry into the feedback framebuffer of a virtual texture (see
+ * `VirtualTexture::BeginFeedback()`), writing the tile required by each pixel.
+ *
+ * Copying or moving `VirtualTextureFeedbackMaterial` objects is disabled to ensure single
+ * ownership and prevent unintended duplication of material resources.
+ */
+class VirtualTextureFeedbackMaterial : public Material, public FlatVirtualTexture
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    /// @brief Generate a virtual texture feedback material with the specified shader file path.
+    /// @param filePath The file path to the shader used by the material.
+    VirtualTextureFeedbackMaterial(const std::filesystem::path& filePath =
+                                   std::filesystem::path("Resources/shaders/base/VirtualTextureFeedback.glsl"))
+        : Material(filePath), FlatVirtualTexture()
+    {}
+    /// @brief Destructor for the virtual texture feedback material.
+    ~VirtualTextureFeedbackMaterial() override = default;
+    
+protected:
+    // Properties
+    // ----------------------------------------
+    /// @brief Set the material properties into the uniforms of the shader program.
+    void SetMaterialProperties() override
+    {
+        Material::SetMaterialProperties();
+        FlatVirtualTexture::SetProperties(m_Shader, "u_Material.TextureMap", m_Slot, true);
+    }
+    
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    VirtualTextureFeedbackMaterial(const VirtualTextureFeedbackMaterial&) = delete;
+    VirtualTextureFeedbackMaterial(VirtualTextureFeedbackMaterial&&) = delete;
+
+    VirtualTextureFeedbackMaterial& operator=(const VirtualTextureFeedbackMaterial&) = delete;
+    VirtualTextureFeedbackMaterial& operator=(VirtualTextureFeedbackMaterial&&) = delete;
+};
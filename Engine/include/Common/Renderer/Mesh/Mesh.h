@@ -8,8 +8,44 @@
 
 #include "Common/Renderer/Renderer.h"
 
+#include "Common/Renderer/Mesh/MeshEncoding.h"
+#include "Common/Renderer/Mesh/MeshBounds.h"
+#include "Common/Renderer/Mesh/MeshSimplification.h"
+#include "Common/Renderer/Mesh/Meshlet.h"
+
+#include "Common/Renderer/Camera/Frustum.h"
+
 #include <glm/glm.hpp>
 
+/**
+ * Enumeration of the policies for the CPU-side copies of the mesh data after its upload.
+ */
+enum class MeshResidency
+{
+    Keep,       ///< Keep the complete vertex and index data.
+    Discard,    ///< Release all the data once it has been uploaded to the GPU.
+    Compact,    ///< Keep only the positions and indices (e.g. for picking).
+};
+
+/**
+ * Represents the memory used by a mesh (or a set of meshes).
+ */
+struct MemoryUsage
+{
+    size_t cpu = 0;     ///< Memory used in the CPU side (in bytes).
+    size_t gpu = 0;     ///< Memory used in the GPU side (in bytes).
+    
+    /// @brief Accumulate the memory used by another resource.
+    /// @param other The memory used by the other resource.
+    /// @return The accumulated memory usage.
+    MemoryUsage& operator+=(const MemoryUsage& other)
+    {
+        cpu += other.cpu;
+        gpu += other.gpu;
+        return *this;
+    }
+};
+
 /**
  * Represents a mesh used for rendering geometry.
  *
@@ -50,6 +86,15 @@ public:
         DefineIndices(indices);
     }
     
+    // Level of detail
+    // ----------------------------------------
+    void GenerateLODs(const unsigned int levels, const float reduction = 0.5f,
+                      const float maxError = 0.05f);
+    
+    // Clustering
+    // ----------------------------------------
+    void GenerateMeshlets(const unsigned int maxVertices = 64, const unsigned int maxTriangles = 124);
+    
     // Setter(s)
     // ----------------------------------------
     /// @brief Sets the material for the mesh.
@@ -58,11 +103,76 @@ public:
     {
         m_Material = material;
     }
+    /// @brief Sets the transformation used to decode the (quantized) vertex positions. It should
+    /// be defined before the vertices, so the compact copy of the positions is decoded correctly.
+    /// @param transform Transformation from the quantized space to the mesh space.
+    void SetDecodeTransform(const glm::mat4& transform)
+    {
+        m_DecodeTransform = transform;
+    }
+    void SetResidency(const MeshResidency &residency);
+    
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the policy used for the CPU-side copies of the mesh data.
+    /// @return The residency policy.
+    MeshResidency GetResidency() const { return m_Residency; }
+    /// @brief Get the positions of the vertices (only kept with the `Compact` policy).
+    /// @return The vertex positions (in mesh space).
+    const std::vector<glm::vec3>& GetPositions() const { return m_Positions; }
+    std::vector<glm::vec3> ReadPositions() const;
+    /// @brief Get the index data of the mesh (released with the `Discard` policy).
+    /// @return The vertex indices of all the levels of detail (see `GetLODRange()`).
+    const std::vector<unsigned int>& GetIndices() const { return m_Indices; }
+    /// @brief Get the bounding box of the mesh.
+    /// @return The bounding box (in mesh space).
+    const BBox& GetBBox() const { return m_BBox; }
+    /// @brief Get the bounding sphere of the mesh.
+    /// @return The bounding sphere (in mesh space).
+    const BSphere& GetBSphere() const { return m_BSphere; }
+    /// @brief Get the number of levels of detail defined for the mesh.
+    /// @return The number of levels (1 if only the original geometry is defined).
+    unsigned int GetLODNumber() const { return m_LODs.empty() ? 1 : (unsigned int)m_LODs.size(); }
+    /// @brief Get the range of the indices defining a level of detail.
+    /// @param lod The level of detail (clamped to the levels defined).
+    /// @return The range of the level in the index data.
+    IndexRange GetLODRange(const unsigned int lod = 0) const
+    {
+        if (m_LODs.empty())
+            return { 0, m_IndexBuffer ? m_IndexBuffer->GetCount() : 0 };
+        return m_LODs[glm::min(lod, (unsigned int)m_LODs.size() - 1)];
+    }
+    /// @brief Get the meshlets defining a level of detail.
+    /// @param lod The level of detail (clamped to the levels defined).
+    /// @return The meshlets of the level, empty if the mesh has not been clustered.
+    const std::vector<Meshlet>& GetMeshlets(const unsigned int lod = 0) const
+    {
+        static const std::vector<Meshlet> empty;
+        if (m_Meshlets.empty())
+            return empty;
+        return m_Meshlets[glm::min(lod, (unsigned int)m_Meshlets.size() - 1)];
+    }
+    /// @brief Get the vertex array of the mesh.
+    /// @return The vertex array (with the vertex and index buffers).
+    const std::shared_ptr<VertexArray>& GetVertexArray() const { return m_VertexArray; }
+    /// @brief Get the transformation used to decode the (quantized) vertex positions.
+    /// @return Transformation from the quantized space to the mesh space.
+    const glm::mat4& GetDecodeTransform() const { return m_DecodeTransform; }
+    MemoryUsage GetMemoryUsage() const;
     
     // Render
     // ----------------------------------------
     void DrawMesh(const glm::mat4& transform = glm::mat4(1.0f),
-                  const PrimitiveType &primitive = PrimitiveType::Triangles);
+                  const PrimitiveType &primitive = PrimitiveType::Triangles,
+                  const std::shared_ptr<Material>& material = nullptr,
+                  const unsigned int lod = 0);
+    
+private:
+    // Mesh data
+    // ----------------------------------------
+    void UpdateIndexBuffer();
+    
+    std::vector<IndexRange> CullMeshlets(const glm::mat4& transform, const unsigned int lod) const;
     
     // Mesh variables
     // ----------------------------------------
@@ -71,6 +181,15 @@ private:
     std::vector<std::vector<VertexData>> m_Vertices;
     ///< Index data of the mesh.
     std::vector<unsigned int> m_Indices;
+    ///< Vertex positions of the mesh (compact copy).
+    std::vector<glm::vec3> m_Positions;
+    ///< Policy for the CPU-side copies of the mesh data.
+    MeshResidency m_Residency = MeshResidency::Keep;
+    
+    ///< Bounding box of the vertices.
+    BBox m_BBox;
+    ///< Bounding sphere of the vertices.
+    BSphere m_BSphere;
     
     ///< Vertex array.
     std::shared_ptr<VertexArray> m_VertexArray;
@@ -78,9 +197,18 @@ private:
     std::shared_ptr<VertexBuffer> m_VertexBuffer;
     ///< Index buffer.
     std::shared_ptr<IndexBuffer> m_IndexBuffer;
+    ///< Ranges of the index buffer defining each level of detail.
+    std::vector<IndexRange> m_LODs;
+    ///< Meshlets of each level of detail.
+    std::vector<std::vector<Meshlet>> m_Meshlets;
+    ///< Limits (vertices, triangles) used to define the meshlets.
+    glm::uvec2 m_MeshletLimits = glm::uvec2(0);
     
     ///< Mesh material
     std::shared_ptr<Material> m_Material;
+    
+    ///< Transformation applied to decode quantized vertex positions.
+    glm::mat4 m_DecodeTransform = glm::mat4(1.0f);
 };
 
 /**
@@ -117,8 +245,23 @@ Mesh<VertexData>::Mesh(const std::vector<VertexData> &vertices,
 template<typename VertexData>
 void Mesh<VertexData>::DefineVertices(const std::vector<VertexData> &vertices, const BufferLayout &layout)
 {
-    // Save the vertex information of the mesh
-    m_Vertices.push_back(vertices);
+    // Compute the bounds of the vertices (from the decoded positions when they are kept)
+    if (m_Residency == MeshResidency::Compact)
+    {
+        m_Positions = utils::Encoding::ReadPositions(vertices.data(), (unsigned int)vertices.size(),
+                                                     layout, m_DecodeTransform);
+        m_BBox = utils::Geometry::ComputeBBox(m_Positions.data(), m_Positions.size());
+        m_BSphere = utils::Geometry::ComputeBSphere(m_Positions.data(), m_Positions.size());
+    }
+    else
+    {
+        utils::Geometry::ComputeBounds(vertices.data(), (unsigned int)vertices.size(), layout,
+                                       m_DecodeTransform, m_BBox, m_BSphere);
+    }
+    
+    // Save the vertex information of the mesh (depending on the residency policy)
+    if (m_Residency == MeshResidency::Keep)
+        m_Vertices.push_back(vertices);
     
     // Copy the vertex data in the buffer and define its layout
     m_VertexBuffer = std::make_shared<VertexBuffer>(vertices.data(),
@@ -137,10 +280,13 @@ void Mesh<VertexData>::DefineVertices(const std::vector<VertexData> &vertices, c
 template<typename VertexData>
 void Mesh<VertexData>::DefineIndices(const std::vector<unsigned int> &indices)
 {
-    // Save the index information of the mesh
-    m_Indices = indices;
+    // Save the index information of the mesh (depending on the residency policy)
+    if (m_Residency != MeshResidency::Discard)
+        m_Indices = indices;
     
-    // Copy the index data in the buffer
+    // Copy the index data in the buffer (replacing the levels of detail and meshlets defined)
+    m_LODs.clear();
+    m_Meshlets.clear();
     m_IndexBuffer = std::make_shared<IndexBuffer>(indices.data(), indices.size());
     
     // Add the buffer information to the vertex array
@@ -152,10 +298,14 @@ void Mesh<VertexData>::DefineIndices(const std::vector<unsigned int> &indices)
  *
  * @param transform Transformation matrix of the geometry.
  * @param primitive The type of primitive to be drawn (e.g., Points, Lines, Triangles).
+ * @param material The material overriding the one defined for the mesh (if defined).
+ * @param lod The level of detail to be drawn (clamped to the levels defined).
  */
 template<typename VertexData>
 void Mesh<VertexData>::DrawMesh(const glm::mat4 &transform,
-                                const PrimitiveType &primitive)
+                                const PrimitiveType &primitive,
+                                const std::shared_ptr<Material>& material,
+                                const unsigned int lod)
 {
     // Verify that the vertex information has been set for the mesh
     if (!m_VertexBuffer  && !m_IndexBuffer)
@@ -164,8 +314,248 @@ void Mesh<VertexData>::DrawMesh(const glm::mat4 &transform,
         return;
     }
     
-    if (m_Material)
-        Renderer::Draw(m_VertexArray, m_Material, transform, primitive);
+    // Select the ranges of the index buffer with the level of detail and the visible meshlets
+    // (their bounds are defined in the decoded mesh space, only the vertices are quantized)
+    std::vector<IndexRange> ranges;
+    if (!m_Meshlets.empty())
+    {
+        ranges = CullMeshlets(transform, lod);
+        if (ranges.empty())
+            return;
+    }
+    else if (!m_LODs.empty())
+        ranges.push_back(GetLODRange(lod));
+    
+    const auto& surface = material ? material : m_Material;
+    if (surface)
+        Renderer::Draw(m_VertexArray, surface, transform * m_DecodeTransform, primitive, ranges);
+    else
+        Renderer::Draw(m_VertexArray, primitive, ranges);
+}
+
+/**
+ * Generate the levels of detail of the mesh by simplifying its triangles.
+ *
+ * Each level reduces the number of triangles of the previous one, while preserving the borders
+ * and attribute seams of the mesh. All the levels are stored in the same index buffer and share
+ * the vertex buffer of the mesh. The positions and indices must be available in the CPU side
+ * (`Keep` or `Compact` residency policies).
+ *
+ * @param levels The number of levels, including the original geometry.
+ * @param reduction The ratio of triangles kept from one level to the next.
+ * @param maxError The maximum error allowed for each level, relative to the mesh extent.
+ */
+template<typename VertexData>
+void Mesh<VertexData>::GenerateLODs(const unsigned int levels, const float reduction,
+                                    const float maxError)
+{
+    // Get the positions of the vertices
+    std::vector<glm::vec3> positions = ReadPositions();
+    if (positions.empty() || m_Indices.empty())
+    {
+        CORE_WARN("Mesh positions and indices are required to generate the levels of detail!");
+        return;
+    }
+    
+    // Simplify each level from the previous one
+    IndexRange base = GetLODRange(0);
+    std::vector<unsigned int> level(m_Indices.begin() + base.offset,
+                                    m_Indices.begin() + base.offset + base.count);
+    std::vector<unsigned int> indices = level;
+    std::vector<IndexRange> lods = { { 0, base.count } };
+    
+    for (unsigned int i = 1; i < levels; i++)
+    {
+        size_t target = (size_t)(level.size() / 3 * reduction) * 3;
+        auto simplified = utils::Geometry::SimplifyMesh(positions, level, target, maxError);
+        
+        // Stop when the error limit prevents any significant reduction
+        if (simplified.empty() || simplified.size() > level.size() * 0.9f)
+            break;
+        
+        lods.push_back({ (unsigned int)indices.size(), (unsigned int)simplified.size() });
+        indices.insert(indices.end(), simplified.begin(), simplified.end());
+        level = std::move(simplified);
+    }
+    
+    // Keep all the levels in the index data (the meshlets are defined again for the new levels)
+    m_Indices = std::move(indices);
+    m_LODs = lods.size() > 1 ? std::move(lods) : std::vector<IndexRange>();
+    
+    if (m_MeshletLimits.x > 0)
+        GenerateMeshlets(m_MeshletLimits.x, m_MeshletLimits.y);
     else
-        Renderer::Draw(m_VertexArray, primitive);
+        UpdateIndexBuffer();
+}
+
+/**
+ * Partition the triangles of each level of detail into meshlets, which are culled individually
+ * (against the view frustum and by their orientation) when the mesh is drawn.
+ *
+ * The indices of each level are reordered, so the triangles of each meshlet are contiguous. The
+ * positions and indices must be available in the CPU side (`Keep` or `Compact` residency
+ * policies).
+ *
+ * @param maxVertices The maximum number of unique vertices in a meshlet.
+ * @param maxTriangles The maximum number of triangles in a meshlet.
+ */
+template<typename VertexData>
+void Mesh<VertexData>::GenerateMeshlets(const unsigned int maxVertices,
+                                        const unsigned int maxTriangles)
+{
+    std::vector<glm::vec3> positions = ReadPositions();
+    if (positions.empty() || m_Indices.empty())
+    {
+        CORE_WARN("Mesh positions and indices are required to generate the meshlets!");
+        return;
+    }
+    
+    m_Meshlets.assign(GetLODNumber(), {});
+    for (unsigned int i = 0; i < GetLODNumber(); i++)
+    {
+        IndexRange range = GetLODRange(i);
+        std::vector<unsigned int> level(m_Indices.begin() + range.offset,
+                                        m_Indices.begin() + range.offset + range.count);
+        
+        // Cluster the level and store it reordered
+        m_Meshlets[i] = utils::Geometry::BuildMeshlets(positions, level, maxVertices, maxTriangles);
+        std::copy(level.begin(), level.end(), m_Indices.begin() + range.offset);
+        for (auto& meshlet : m_Meshlets[i])
+            meshlet.range.offset += range.offset;
+    }
+    m_MeshletLimits = glm::uvec2(maxVertices, maxTriangles);
+    
+    UpdateIndexBuffer();
+}
+
+/**
+ * Get the ranges of the index buffer with the meshlets that are visible from the current scene
+ * view. Meshlets outside the view frustum, or facing away from the view when the face culling
+ * is enabled, are discarded. Consecutive visible meshlets are merged into a single range.
+ *
+ * @param transform Transformation from the mesh space to the world space.
+ * @param lod The level of detail to be drawn.
+ *
+ * @return The ranges of the visible meshlets.
+ */
+template<typename VertexData>
+std::vector<IndexRange> Mesh<VertexData>::CullMeshlets(const glm::mat4& transform,
+                                                      const unsigned int lod) const
+{
+    const glm::mat4& projection = Renderer::GetProjectionMatrix();
+    Frustum frustum(projection * Renderer::GetViewMatrix() * transform);
+    
+    // The orientation can only be checked using the view position of perspective projections
+    auto culling = Renderer::GetFaceCulling();
+    bool orientation = culling.has_value() && projection[2][3] != 0.0f;
+    glm::vec3 view = glm::vec3(glm::inverse(transform) * glm::vec4(Renderer::GetViewPosition(), 1.0f));
+    
+    std::vector<IndexRange> ranges;
+    if (!m_BSphere.IsEmpty() && !frustum.IntersectsSphere(m_BSphere.center, m_BSphere.radius))
+        return ranges;
+    
+    for (const auto& meshlet : GetMeshlets(lod))
+    {
+        if (!frustum.IntersectsSphere(meshlet.center, meshlet.radius))
+            continue;
+        if (orientation && utils::Geometry::IsMeshletFacingAway(meshlet, view, culling.value()))
+            continue;
+        
+        if (!ranges.empty() && ranges.back().offset + ranges.back().count == meshlet.range.offset)
+            ranges.back().count += meshlet.range.count;
+        else
+            ranges.push_back(meshlet.range);
+    }
+    return ranges;
+}
+
+/**
+ * Get the positions of the vertices, from the compact copy or from the vertex data.
+ *
+ * @return The vertex positions (in mesh space), empty if the data has been released.
+ */
+template<typename VertexData>
+std::vector<glm::vec3> Mesh<VertexData>::ReadPositions() const
+{
+    if (!m_Positions.empty())
+        return m_Positions;
+    if (m_Vertices.empty() || !m_VertexBuffer)
+        return {};
+    
+    return utils::Encoding::ReadPositions(m_Vertices.back().data(),
+        (unsigned int)m_Vertices.back().size(), m_VertexBuffer->GetLayout(), m_DecodeTransform);
+}
+
+/**
+ * Copy the index data (all the levels of detail) into the index buffer.
+ */
+template<typename VertexData>
+void Mesh<VertexData>::UpdateIndexBuffer()
+{
+    m_IndexBuffer = std::make_shared<IndexBuffer>(m_Indices.data(), m_Indices.size());
+    m_VertexArray->SetIndexBuffer(m_IndexBuffer);
+}
+
+/**
+ * Define the policy for the CPU-side copies of the mesh data. The policy is applied to the data
+ * already defined, and to any data defined afterwards.
+ *
+ * @param residency The residency policy.
+ *
+ * @note Data already released cannot be recovered when changing to a less restrictive policy.
+ */
+template<typename VertexData>
+void Mesh<VertexData>::SetResidency(const MeshResidency &residency)
+{
+    m_Residency = residency;
+    
+    // Keep a compact copy of the positions before releasing the vertex data
+    if (m_Residency == MeshResidency::Compact && m_Positions.empty() && m_VertexBuffer)
+    {
+        const auto& layout = m_VertexBuffer->GetLayout();
+        for (const auto& vertices : m_Vertices)
+        {
+            auto positions = utils::Encoding::ReadPositions(vertices.data(),
+                (unsigned int)vertices.size(), layout, m_DecodeTransform);
+            if (!positions.empty())
+                m_Positions = std::move(positions);
+        }
+    }
+    
+    // Release the vertex data
+    if (m_Residency != MeshResidency::Keep)
+        std::vector<std::vector<VertexData>>().swap(m_Vertices);
+    // Release all the remaining data
+    if (m_Residency == MeshResidency::Discard)
+    {
+        std::vector<unsigned int>().swap(m_Indices);
+        std::vector<glm::vec3>().swap(m_Positions);
+    }
+}
+
+/**
+ * Get the memory used by the mesh, in the CPU side (data copies) and in the GPU side (buffers).
+ *
+ * @return The memory usage of the mesh.
+ */
+template<typename VertexData>
+MemoryUsage Mesh<VertexData>::GetMemoryUsage() const
+{
+    MemoryUsage usage;
+    
+    // CPU side
+    for (const auto& vertices : m_Vertices)
+        usage.cpu += vertices.capacity() * sizeof(VertexData);
+    usage.cpu += m_Indices.capacity() * sizeof(unsigned int);
+    usage.cpu += m_Positions.capacity() * sizeof(glm::vec3);
+    for (const auto& meshlets : m_Meshlets)
+        usage.cpu += meshlets.capacity() * sizeof(Meshlet);
+    
+    // GPU side
+    if (m_VertexBuffer)
+        usage.gpu += m_VertexBuffer->GetSize();
+    if (m_IndexBuffer)
+        usage.gpu += m_IndexBuffer->GetSize();
+    
+    return usage;
 }
@@ -0,0 +1,302 @@
+#pragma once
+
+#include "Common/Renderer/Mesh/Mesh.h"
+#include "Common/Renderer/Mesh/MeshBounds.h"
+
+#include <glm/glm.hpp>
+
+/**
+ * Represents the geometry shared by the models placed in a scene.
+ *
+ * The `BaseMeshAsset` class holds the data that does not depend on a specific placement of a
+ * model: the set of meshes (submeshes) with their buffers, the bounds and the source of the data.
+ * Assets are reference counted (`std::shared_ptr`), so multiple models can be rendered using the
+ * same geometry while the GPU memory only grows with the number of unique assets.
+ */
+class BaseMeshAsset
+{
+public:
+    // Destructor
+    // ----------------------------------------
+    /// @brief Delete the mesh asset.
+    virtual ~BaseMeshAsset() = default;
+
+    // Render
+    // ----------------------------------------
+    /// @brief Draw all the meshes of the asset.
+    /// @param transform The transformation matrix for the meshes.
+    /// @param materials The materials overriding the ones of each mesh (if defined).
+    /// @param lod The level of detail to be drawn.
+    virtual void Draw(const glm::mat4 &transform,
+                      const std::vector<std::shared_ptr<Material>> &materials,
+                      const unsigned int lod = 0) = 0;
+    
+    // Level of detail
+    // ----------------------------------------
+    /// @brief Generate the levels of detail of all the meshes.
+    /// @param levels The number of levels, including the original geometry.
+    /// @param reduction The ratio of triangles kept from one level to the next.
+    /// @param maxError The maximum error allowed for each level, relative to the mesh extent.
+    virtual void GenerateLODs(const unsigned int levels, const float reduction = 0.5f,
+                              const float maxError = 0.05f) = 0;
+    
+    // Clustering
+    // ----------------------------------------
+    /// @brief Partition all the meshes into meshlets, culled individually when drawn.
+    /// @param maxVertices The maximum number of unique vertices in a meshlet.
+    /// @param maxTriangles The maximum number of triangles in a meshlet.
+    virtual void GenerateMeshlets(const unsigned int maxVertices = 64,
+                                  const unsigned int maxTriangles = 124) = 0;
+
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the number of meshes representing the asset.
+    /// @return The number of meshes.
+    virtual unsigned int GetMeshNumber() const = 0;
+    /// @brief Get the number of levels of detail defined for the asset.
+    /// @return The maximum number of levels defined for its meshes.
+    virtual unsigned int GetLODNumber() const = 0;
+    /// @brief Get the memory used by the asset (CPU-side data copies and GPU buffers).
+    /// @return The memory usage of the asset.
+    virtual MemoryUsage GetMemoryUsage() const = 0;
+    /// @brief Get the triangles of all the meshes at a level of detail (e.g. as occluders). The
+    /// CPU-side copies of the mesh data must be kept (`Keep` or `Compact` policies).
+    /// @param positions The vertex positions (in the space of the asset).
+    /// @param indices The triangle indices, referencing the positions.
+    /// @param lod The level of detail (clamped to the levels defined by each mesh).
+    virtual void GetTriangles(std::vector<glm::vec3> &positions, std::vector<unsigned int> &indices,
+                              const unsigned int lod = 0) const = 0;
+
+    /// @brief Get the bounding box of the asset.
+    /// @return The bounding box.
+    const BBox& GetBBox() const { return m_BBox; }
+    /// @brief Get the bounding sphere of the asset.
+    /// @return The bounding sphere.
+    const BSphere& GetBSphere() const { return m_BSphere; }
+    /// @brief Get the primitive type defining the meshes.
+    /// @return The primitive type.
+    const PrimitiveType& GetPrimitive() const { return m_Primitive; }
+    /// @brief Get the policy used for the CPU-side copies of the mesh data.
+    /// @return The residency policy.
+    const MeshResidency& GetResidency() const { return m_Residency; }
+    /// @brief Get the source (file path) of the asset.
+    /// @return The path to the source, empty if it has been generated.
+    const std::filesystem::path& GetSource() const { return m_Source; }
+
+    // Setter(s)
+    // ----------------------------------------
+    /// @brief Sets the policy for the CPU-side copies of the data of all the meshes.
+    /// @param residency The residency policy.
+    virtual void SetResidency(const MeshResidency &residency) = 0;
+    /// @brief Set the source (file path) of the asset.
+    /// @param source The path to the source.
+    void SetSource(const std::filesystem::path &source) { m_Source = source; }
+
+    // Bounding box definition
+    // ----------------------------------------
+    /// @brief Update the boundaries of the bounding box using a vertex coordinate.
+    /// @param v The vertex coordinate to be considered when updating the bounding box.
+    void UpdateBBoxWithVertex(const glm::vec3 &v)
+    {
+        m_BBox.Extend(v);
+    }
+
+protected:
+    // Constructor(s)
+    // ----------------------------------------
+    /// @brief Define a mesh asset.
+    /// @param primitive The type of the primitive that defines the meshes.
+    BaseMeshAsset(const PrimitiveType &primitive)
+        : m_Primitive(primitive)
+    {}
+
+    // Mesh asset variables
+    // ----------------------------------------
+protected:
+    ///< Bounding box.
+    BBox m_BBox;
+    ///< Bounding sphere.
+    BSphere m_BSphere;
+    ///< Primitive type defined for the meshes.
+    PrimitiveType m_Primitive;
+    ///< Policy for the CPU-side copies of the mesh data.
+    MeshResidency m_Residency = MeshResidency::Keep;
+    ///< Source of the asset.
+    std::filesystem::path m_Source;
+
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    BaseMeshAsset(const BaseMeshAsset&) = delete;
+    BaseMeshAsset(BaseMeshAsset&&) = delete;
+
+    BaseMeshAsset& operator=(const BaseMeshAsset&) = delete;
+    BaseMeshAsset& operator=(BaseMeshAsset&&) = delete;
+};
+
+/**
+ * Represents the geometry (set of meshes) shared by the models placed in a scene.
+ *
+ * @tparam VertexData The type of vertex data used by the meshes.
+ */
+template<typename VertexData>
+class MeshAsset : public BaseMeshAsset
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    /// @brief Define an empty mesh asset.
+    /// @param primitive The type of the primitive that defines the meshes.
+    MeshAsset(const PrimitiveType &primitive = PrimitiveType::Triangles)
+        : BaseMeshAsset(primitive)
+    {}
+    /// @brief Delete the mesh asset.
+    ~MeshAsset() override = default;
+
+    // Mesh definition
+    // ----------------------------------------
+    /// @brief Add a mesh to the asset.
+    /// @param mesh The mesh to be added.
+    void AddMesh(const Mesh<VertexData> &mesh)
+    {
+        m_Meshes.push_back(mesh);
+        m_Meshes.back().SetResidency(m_Residency);
+        
+        // Extend the bounds of the asset with the ones of the mesh
+        m_BBox.Extend(mesh.GetBBox());
+        m_BSphere.Extend(mesh.GetBSphere());
+    }
+    /// @brief Update the bounds of the asset from the ones of its meshes (e.g. after redefining
+    /// the vertices of a mesh).
+    void UpdateBounds()
+    {
+        m_BBox = BBox();
+        m_BSphere = BSphere();
+        for (const auto& mesh : m_Meshes)
+        {
+            m_BBox.Extend(mesh.GetBBox());
+            m_BSphere.Extend(mesh.GetBSphere());
+        }
+    }
+
+    // Render
+    // ----------------------------------------
+    /// @brief Draw all the meshes of the asset.
+    /// @param transform The transformation matrix for the meshes.
+    /// @param materials The materials overriding the ones of each mesh (if defined).
+    /// @param lod The level of detail to be drawn.
+    void Draw(const glm::mat4 &transform,
+              const std::vector<std::shared_ptr<Material>> &materials,
+              const unsigned int lod = 0) override
+    {
+        for (unsigned int i = 0; i < m_Meshes.size(); i++)
+            m_Meshes[i].DrawMesh(transform, m_Primitive, i < materials.size() ? materials[i] : nullptr,
+                                 lod);
+    }
+    
+    // Level of detail
+    // ----------------------------------------
+    /// @brief Generate the levels of detail of all the meshes.
+    /// @param levels The number of levels, including the original geometry.
+    /// @param reduction The ratio of triangles kept from one level to the next.
+    /// @param maxError The maximum error allowed for each level, relative to the mesh extent.
+    void GenerateLODs(const unsigned int levels, const float reduction = 0.5f,
+                      const float maxError = 0.05f) override
+    {
+        if (m_Primitive != PrimitiveType::Triangles)
+        {
+            CORE_WARN("Levels of detail can only be generated for triangle meshes!");
+            return;
+        }
+        
+        for (auto& mesh : m_Meshes)
+            mesh.GenerateLODs(levels, reduction, maxError);
+    }
+    
+    // Clustering
+    // ----------------------------------------
+    /// @brief Partition all the meshes into meshlets, culled individually when drawn.
+    /// @param maxVertices The maximum number of unique vertices in a meshlet.
+    /// @param maxTriangles The maximum number of triangles in a meshlet.
+    void GenerateMeshlets(const unsigned int maxVertices = 64,
+                          const unsigned int maxTriangles = 124) override
+    {
+        if (m_Primitive != PrimitiveType::Triangles)
+        {
+            CORE_WARN("Meshlets can only be generated for triangle meshes!");
+            return;
+        }
+        
+        for (auto& mesh : m_Meshes)
+            mesh.GenerateMeshlets(maxVertices, maxTriangles);
+    }
+
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the number of meshes representing the asset.
+    /// @return The number of meshes.
+    unsigned int GetMeshNumber() const override { return (unsigned int)m_Meshes.size(); }
+    /// @brief Get the number of levels of detail defined for the asset.
+    /// @return The maximum number of levels defined for its meshes.
+    unsigned int GetLODNumber() const override
+    {
+        unsigned int levels = 1;
+        for (const auto& mesh : m_Meshes)
+            levels = glm::max(levels, mesh.GetLODNumber());
+        return levels;
+    }
+    /// @brief Get the meshes of the asset.
+    /// @return The set of meshes.
+    std::vector<Mesh<VertexData>>& GetMeshes() { return m_Meshes; }
+    /// @brief Get the memory used by the asset (CPU-side data copies and GPU buffers).
+    /// @return The memory usage of the asset.
+    MemoryUsage GetMemoryUsage() const override
+    {
+        MemoryUsage usage;
+        for (const auto& mesh : m_Meshes)
+            usage += mesh.GetMemoryUsage();
+        return usage;
+    }
+    /// @brief Get the triangles of all the meshes at a level of detail (e.g. as occluders). The
+    /// CPU-side copies of the mesh data must be kept (`Keep` or `Compact` policies).
+    /// @param positions The vertex positions (in the space of the asset).
+    /// @param indices The triangle indices, referencing the positions.
+    /// @param lod The level of detail (clamped to the levels defined by each mesh).
+    void GetTriangles(std::vector<glm::vec3> &positions, std::vector<unsigned int> &indices,
+                      const unsigned int lod = 0) const override
+    {
+        if (m_Primitive != PrimitiveType::Triangles)
+            return;
+        
+        for (const auto& mesh : m_Meshes)
+        {
+            auto vertices = mesh.ReadPositions();
+            const auto& data = mesh.GetIndices();
+            IndexRange range = mesh.GetLODRange(lod);
+            if (vertices.empty() || data.size() < range.offset + range.count)
+                continue;
+            
+            unsigned int base = (unsigned int)positions.size();
+            positions.insert(positions.end(), vertices.begin(), vertices.end());
+            for (unsigned int i = range.offset; i < range.offset + range.count; i++)
+                indices.push_back(base + data[i]);
+        }
+    }
+
+    // Setter(s)
+    // ----------------------------------------
+    /// @brief Sets the policy for the CPU-side copies of the data of all the meshes.
+    /// @param residency The residency policy.
+    void SetResidency(const MeshResidency &residency) override
+    {
+        m_Residency = residency;
+        for (auto& mesh : m_Meshes)
+            mesh.SetResidency(residency);
+    }
+
+    // Mesh asset variables
+    // ----------------------------------------
+private:
+    ///< Set of meshes defining the asset.
+    std::vector<Mesh<VertexData>> m_Meshes;
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Common/Renderer/Buffer/BufferLayout.h"
+
+#include <glm/glm.hpp>
+
+/**
+ * Represents a bounding box around a 3D model.
+ *
+ * The `BBox` structure defines a bounding box by storing the minimum and maximum coordinates
+ * along the x, y, and z axes. It represents the extent or volume occupied by a 3D model. A box
+ * that has not been extended by any point is empty (its minimum is above its maximum).
+ */
+struct BBox
+{
+    glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());       ///< The minimum coordinates of the bounding box.
+    glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());    ///< The maximum coordinates of the bounding box.
+
+    /// @brief Check if the bounding box does not contain any point.
+    /// @return `true` if the box is empty.
+    bool IsEmpty() const { return glm::any(glm::greaterThan(min, max)); }
+    /// @brief Get the center of the bounding box.
+    /// @return The center, or the origin if the box is empty.
+    glm::vec3 GetCenter() const { return IsEmpty() ? glm::vec3(0.0f) : (min + max) * 0.5f; }
+    /// @brief Get the size of the bounding box along each axis.
+    /// @return The size, or zero if the box is empty.
+    glm::vec3 GetSize() const { return IsEmpty() ? glm::vec3(0.0f) : max - min; }
+
+    /// @brief Extend the bounding box to contain a point.
+    /// @param point The point to be contained.
+    void Extend(const glm::vec3& point)
+    {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+    /// @brief Extend the bounding box to contain another box.
+    /// @param other The box to be contained.
+    void Extend(const BBox& other)
+    {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+};
+
+/**
+ * Represents a bounding sphere around a 3D model. A sphere with a negative radius is empty.
+ */
+struct BSphere
+{
+    glm::vec3 center = glm::vec3(0.0f);     ///< The center of the bounding sphere.
+    float radius = -1.0f;                   ///< The radius of the bounding sphere.
+
+    /// @brief Check if the bounding sphere does not contain any point.
+    /// @return `true` if the sphere is empty.
+    bool IsEmpty() const { return radius < 0.0f; }
+
+    /// @brief Extend the bounding sphere to contain another sphere.
+    /// @param other The sphere to be contained.
+    void Extend(const BSphere& other)
+    {
+        if (other.IsEmpty())
+            return;
+
+        glm::vec3 direction = other.center - center;
+        float distance = glm::length(direction);
+        // One of the spheres already contains the other
+        if (!IsEmpty() && distance + other.radius <= radius)
+            return;
+        if (IsEmpty() || distance + radius <= other.radius)
+        {
+            *this = other;
+            return;
+        }
+
+        float extended = (distance + radius + other.radius) * 0.5f;
+        center += direction * ((extended - radius) / distance);
+        radius = extended;
+    }
+};
+
+namespace utils { namespace Geometry
+{
+
+// Bounding volumes
+// ----------------------------------------
+BBox ComputeBBox(const glm::vec3* positions, const size_t count);
+BSphere ComputeBSphere(const glm::vec3* positions, const size_t count);
+
+/**
+ * Compute the bounding volumes of the positions (`a_Position` attribute) of a vertex stream.
+ *
+ * @param vertices The vertex data.
+ * @param count The number of vertices.
+ * @param layout The layout of the vertex data.
+ * @param decode The transformation used to decode the stored positions.
+ * @param bbox The bounding box of the positions.
+ * @param sphere The bounding sphere of the positions.
+ */
+void ComputeBounds(const void* vertices, const unsigned int count, const BufferLayout& layout,
+                   const glm::mat4& decode, BBox& bbox, BSphere& sphere);
+
+} // namespace Geometry
+} // namespace utils
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "Common/Renderer/Buffer/BufferLayout.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/type_precision.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <cstring>
+
+namespace utils { namespace Encoding
+{
+
+// Quantization
+// ----------------------------------------
+/**
+ * Get the transformation that decodes positions quantized relative to a set of bounds.
+ *
+ * The positions are quantized inside the cube centered at the bounds center, with a half size
+ * equal to the largest half extent of the bounds. A uniform scale is used so the normal matrix
+ * derived from the final transformation remains valid.
+ *
+ * @param min The minimum coordinates of the bounds.
+ * @param max The maximum coordinates of the bounds.
+ *
+ * @return The transformation from the quantized space [-1, 1] to the original space.
+ */
+inline glm::mat4 QuantizationTransform(const glm::vec3& min, const glm::vec3& max)
+{
+    glm::vec3 center = (max + min) * 0.5f;
+    glm::vec3 extent = (max - min) * 0.5f;
+    float scale = glm::max(glm::max(extent.x, extent.y), extent.z);
+    // Degenerated bounds (e.g. a single point)
+    if (scale <= 0.0f)
+        scale = 1.0f;
+
+    glm::mat4 transform = glm::translate(glm::mat4(1.0f), center);
+    return glm::scale(transform, glm::vec3(scale));
+}
+
+/**
+ * Encode a position as a normalized 16-bit signed integer vector (snorm16) relative to the
+ * quantization space defined by `QuantizationTransform()`.
+ *
+ * @param position The position to be encoded.
+ * @param decode The transformation used to decode the quantized positions.
+ *
+ * @return The encoded position. The w component is always 1.
+ */
+inline glm::i16vec4 EncodePosition(const glm::vec3& position, const glm::mat4& decode)
+{
+    // Translation and (uniform) scale stored in the decoding transformation
+    glm::vec3 center = glm::vec3(decode[3]);
+    float scale = decode[0][0];
+
+    glm::vec3 p = glm::clamp((position - center) / scale, glm::vec3(-1.0f), glm::vec3(1.0f));
+    return glm::i16vec4(glm::round(p * 32767.0f), 32767);
+}
+
+// Texture coordinates
+// ----------------------------------------
+/**
+ * Encode texture coordinates as half-float values.
+ *
+ * @param uv The texture coordinates to be encoded.
+ *
+ * @return The encoded coordinates (raw half-float bits).
+ */
+inline glm::u16vec2 EncodeTextureCoord(const glm::vec2& uv)
+{
+    return glm::u16vec2(glm::packHalf1x16(uv.x), glm::packHalf1x16(uv.y));
+}
+
+// Normals
+// ----------------------------------------
+/**
+ * Encode a normal vector in the packed signed 10:10:10:2 format.
+ *
+ * @param normal The (normalized) normal vector.
+ *
+ * @return The packed normal. The w component is set to 0.
+ */
+inline glm::uint32 EncodeNormal(const glm::vec3& normal)
+{
+    return glm::packSnorm3x10_1x2(glm::vec4(normal, 0.0f));
+}
+
+/**
+ * Encode a normal vector using the octahedral mapping.
+ *
+ * The unit sphere is projected onto an octahedron, which is then unfolded into the [-1, 1]
+ * square. The result can be stored as two normalized 16-bit integers (`DataType::Short2`) and
+ * decoded in the vertex shader (see `common/utils/Octahedral.glsl`).
+ *
+ * @param normal The (normalized) normal vector.
+ *
+ * @return The encoded normal (snorm16), +Z if the normal is degenerate (zero or not finite).
+ */
+inline glm::i16vec2 EncodeNormalOctahedral(const glm::vec3& normal)
+{
+    // Degenerate normals (e.g. from degenerate triangles) cannot be projected
+    float length = glm::abs(normal.x) + glm::abs(normal.y) + glm::abs(normal.z);
+    if (!(length > 1e-12f) || !std::isfinite(length))
+        return glm::i16vec2(0);
+
+    // Project onto the octahedron
+    glm::vec3 n = normal / length;
+    glm::vec2 e = glm::vec2(n.x, n.y);
+
+    // Fold the lower hemisphere over the diagonals
+    if (n.z < 0.0f)
+    {
+        glm::vec2 sign = glm::vec2(e.x >= 0.0f ? 1.0f : -1.0f, e.y >= 0.0f ? 1.0f : -1.0f);
+        e = (1.0f - glm::abs(glm::vec2(e.y, e.x))) * sign;
+    }
+
+    return glm::i16vec2(glm::round(glm::clamp(e, -1.0f, 1.0f) * 32767.0f));
+}
+
+/**
+ * Decode a normal vector encoded using the octahedral mapping.
+ *
+ * @param encoded The encoded normal (snorm16).
+ *
+ * @return The normal vector.
+ */
+inline glm::vec3 DecodeNormalOctahedral(const glm::i16vec2& encoded)
+{
+    glm::vec2 e = glm::max(glm::vec2(encoded) / 32767.0f, glm::vec2(-1.0f));
+    glm::vec3 n = glm::vec3(e.x, e.y, 1.0f - glm::abs(e.x) - glm::abs(e.y));
+
+    // Unfold the lower hemisphere
+    float t = glm::max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+
+    return glm::normalize(n);
+}
+
+// Vertex streams
+// ----------------------------------------
+/**
+ * Read the positions (`a_Position` attribute) from a vertex stream defined by a buffer layout
+ * into an existing array.
+ *
+ * Float, normalized 16-bit integer (snorm) and half-float position types are supported.
+ *
+ * @param vertices The vertex data.
+ * @param count The number of vertices.
+ * @param layout The layout of the vertex data.
+ * @param decode The transformation used to decode the stored positions.
+ * @param positions The decoded positions (`count` elements).
+ *
+ * @return `true` if the layout has (supported) positions.
+ */
+inline bool ReadPositions(const void* vertices, const unsigned int count, const BufferLayout& layout,
+                          const glm::mat4& decode, glm::vec3* positions)
+{
+    // Look for the position attribute
+    auto element = std::find_if(layout.begin(), layout.end(), [](const BufferElement& e) {
+        return e.Name == "a_Position";
+    });
+    if (element == layout.end())
+        return false;
+    
+    const char* data = static_cast<const char*>(vertices) + element->Offset;
+    const unsigned int stride = layout.GetStride();
+    const unsigned int components = std::min(utils::OpenGL::GetCompCountOfType(element->Type), 3u);
+    
+    for (unsigned int i = 0; i < count; i++, data += stride)
+    {
+        glm::vec3 p(0.0f);
+        switch (element->Type)
+        {
+            case DataType::Vec2:
+            case DataType::Vec3:
+            case DataType::Vec4:
+                std::memcpy(&p, data, components * sizeof(float));
+                break;
+            case DataType::Short2:
+            case DataType::Short4:
+            {
+                int16_t v[3] = { 0, 0, 0 };
+                std::memcpy(v, data, components * sizeof(int16_t));
+                for (unsigned int c = 0; c < components; c++)
+                    p[c] = element->Normalized ? glm::max(v[c] / 32767.0f, -1.0f) : (float)v[c];
+                break;
+            }
+            case DataType::Half2:
+            case DataType::Half4:
+            {
+                uint16_t v[3] = { 0, 0, 0 };
+                std::memcpy(v, data, components * sizeof(uint16_t));
+                for (unsigned int c = 0; c < components; c++)
+                    p[c] = glm::unpackHalf1x16(v[c]);
+                break;
+            }
+            default:
+                CORE_WARN("Unsupported data type for the vertex positions!");
+                return false;
+        }
+        positions[i] = glm::vec3(decode * glm::vec4(p, 1.0f));
+    }
+    
+    return true;
+}
+
+/**
+ * Read the positions (`a_Position` attribute) from a vertex stream defined by a buffer layout.
+ *
+ * @param vertices The vertex data.
+ * @param count The number of vertices.
+ * @param layout The layout of the vertex data.
+ * @param decode The transformation used to decode the stored positions.
+ *
+ * @return The decoded positions, or an empty vector if the layout has no (supported) positions.
+ */
+inline std::vector<glm::vec3> ReadPositions(const void* vertices, const unsigned int count,
+                                            const BufferLayout& layout,
+                                            const glm::mat4& decode = glm::mat4(1.0f))
+{
+    std::vector<glm::vec3> positions(count);
+    if (!ReadPositions(vertices, count, layout, decode, positions.data()))
+        return {};
+    
+    return positions;
+}
+
+} // namespace Encoding
+} // namespace utils
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace utils { namespace Geometry
+{
+
+// Simplification
+// ----------------------------------------
+std::vector<unsigned int> SimplifyMesh(const std::vector<glm::vec3>& positions,
+                                       const std::vector<unsigned int>& indices,
+                                       const size_t targetIndexCount,
+                                       const float maxError = 0.05f,
+                                       float* resultError = nullptr);
+
+// Level of detail selection
+// ----------------------------------------
+/**
+ * Get the size covered by a bounding sphere on the screen.
+ *
+ * @param center The center of the sphere (world space).
+ * @param radius The radius of the sphere (world space).
+ * @param view The view matrix.
+ * @param projection The projection (perspective or orthographic) matrix.
+ *
+ * @return The diameter of the projected sphere, relative to the viewport height.
+ */
+inline float ProjectedSphereSize(const glm::vec3& center, const float radius,
+                                 const glm::mat4& view, const glm::mat4& projection)
+{
+    // Clip-space w of the center (the view depth for perspective projections, 1 for orthographic)
+    glm::vec4 p = view * glm::vec4(center, 1.0f);
+    float w = projection[2][3] * p.z + projection[3][3];
+
+    // The camera is inside the sphere
+    if (w <= radius * glm::abs(projection[2][3]))
+        return std::numeric_limits<float>::max();
+
+    return radius * glm::abs(projection[1][1]) / w;
+}
+
+/**
+ * Select the level of detail used to render a geometry from its size on the screen.
+ *
+ * Each level is used while the geometry covers less than half the screen size of the
+ * previous one (level 1 below half the viewport height, level 2 below a quarter, ...). The
+ * boundaries are widened by the hysteresis factor in the direction of the change, so the level
+ * does not flicker when the size stays around a boundary.
+ *
+ * @param size The size of the geometry on the screen (relative to the viewport height).
+ * @param current The level of detail currently used.
+ * @param levels The number of levels available.
+ * @param hysteresis The relative margin applied to the boundaries between levels.
+ *
+ * @return The level of detail to be used.
+ */
+inline unsigned int SelectLOD(const float size, const unsigned int current,
+                              const unsigned int levels, const float hysteresis = 0.1f)
+{
+    // Screen size below which a level is used
+    auto boundary = [](unsigned int level) { return std::ldexp(1.0f, -(int)level); };
+
+    unsigned int level = glm::min(current, levels > 0 ? levels - 1 : 0);
+    // Move to coarser levels
+    while (level + 1 < levels && size < boundary(level + 1) * (1.0f - hysteresis))
+        level++;
+    // Move to finer levels
+    while (level > 0 && size > boundary(level) * (1.0f + hysteresis))
+        level--;
+
+    return level;
+}
+
+} // namespace Geometry
+} // namespace utils
@@ -4,6 +4,7 @@
 #include "Common/Renderer/Model/Model.h"
 
 #include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
 
 /**
  * Define a default vertex structure that represents the different data that a vertex may contain.
@@ -56,6 +57,110 @@ struct GeoVertexData<glm::vec4, glm::vec2, glm::vec3>
 namespace utils { namespace Geometry
 {
 
+// Vertex tables
+// ----------------------------------------
+/**
+ * Compile-time vertex and index tables of the fixed primitives (plane and cubes).
+ */
+namespace Tables
+{
+
+///< Positions of the plane vertices.
+constexpr float PlanePositions[4][3] = {
+    {-0.5f, -0.5f, 0.0f},   // bottom left (0)
+    { 0.5f, -0.5f, 0.0f},   // bottom right (1)
+    { 0.5f,  0.5f, 0.0f},   // top right (2)
+    {-0.5f,  0.5f, 0.0f},   // top left (3)
+};
+///< Texture coordinates of the plane vertices.
+constexpr float PlaneTextureCoords[4][2] = {
+    {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f},
+};
+///< Normal vectors of the plane vertices.
+constexpr float PlaneNormals[4][3] = {
+    {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f},
+};
+///< Indices of the plane, two triangles forming a rectangle.
+constexpr unsigned int PlaneIndices[6] = {
+    0, 1, 2,    // first triangle
+    2, 3, 0,    // second triangle
+};
+
+///< Positions of the basic cube vertices (shared between faces).
+constexpr float BasicCubePositions[8][3] = {
+    // Front face
+    {-0.5f, -0.5f,  0.5f},  // bottom left (0)
+    { 0.5f, -0.5f,  0.5f},  // bottom right (1)
+    { 0.5f,  0.5f,  0.5f},  // top right (2)
+    {-0.5f,  0.5f,  0.5f},  // top left (3)
+    // Back face
+    {-0.5f, -0.5f, -0.5f},  // bottom left (4)
+    { 0.5f, -0.5f, -0.5f},  // bottom right (5)
+    { 0.5f,  0.5f, -0.5f},  // top right (6)
+    {-0.5f,  0.5f, -0.5f},  // top left (7)
+};
+///< Texture coordinates of the basic cube vertices.
+constexpr float BasicCubeTextureCoords[8][2] = {
+    // Front face
+    {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f},
+    // Back face
+    {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f},
+};
+///< Indices of the basic cube, 12 triangles forming 6 faces.
+constexpr unsigned int BasicCubeIndices[36] = {
+    0, 1, 2,  2, 3, 0,  // Front face
+    5, 4, 7,  7, 6, 5,  // Back face
+    1, 5, 6,  6, 2, 1,  // Right face
+    4, 0, 3,  3, 7, 4,  // Left face
+    3, 2, 6,  6, 7, 3,  // Top face
+    4, 5, 1,  1, 0, 4,  // Bottom face
+};
+
+///< Positions of the cube vertices (4 vertices per face).
+constexpr float CubePositions[24][3] = {
+    // Front face
+    {-0.5f, -0.5f,  0.5f}, { 0.5f, -0.5f,  0.5f}, { 0.5f,  0.5f,  0.5f}, {-0.5f,  0.5f,  0.5f},
+    // Back face
+    {-0.5f, -0.5f, -0.5f}, { 0.5f, -0.5f, -0.5f}, { 0.5f,  0.5f, -0.5f}, {-0.5f,  0.5f, -0.5f},
+    // Right face
+    { 0.5f, -0.5f,  0.5f}, { 0.5f, -0.5f, -0.5f}, { 0.5f,  0.5f, -0.5f}, { 0.5f,  0.5f,  0.5f},
+    // Left face
+    {-0.5f, -0.5f, -0.5f}, {-0.5f, -0.5f,  0.5f}, {-0.5f,  0.5f,  0.5f}, {-0.5f,  0.5f, -0.5f},
+    // Top face
+    {-0.5f,  0.5f,  0.5f}, { 0.5f,  0.5f,  0.5f}, { 0.5f,  0.5f, -0.5f}, {-0.5f,  0.5f, -0.5f},
+    // Bottom face
+    {-0.5f, -0.5f, -0.5f}, { 0.5f, -0.5f, -0.5f}, { 0.5f, -0.5f,  0.5f}, {-0.5f, -0.5f,  0.5f},
+};
+///< Texture coordinates of the cube vertices.
+constexpr float CubeTextureCoords[24][2] = {
+    {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f},     // Front face
+    {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f},     // Back face
+    {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f},     // Right face
+    {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f},     // Left face
+    {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f},     // Top face
+    {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f},     // Bottom face
+};
+///< Normal vectors of the cube vertices.
+constexpr float CubeNormals[24][3] = {
+    { 0.0f,  0.0f,  1.0f}, { 0.0f,  0.0f,  1.0f}, { 0.0f,  0.0f,  1.0f}, { 0.0f,  0.0f,  1.0f},
+    { 0.0f,  0.0f, -1.0f}, { 0.0f,  0.0f, -1.0f}, { 0.0f,  0.0f, -1.0f}, { 0.0f,  0.0f, -1.0f},
+    { 1.0f,  0.0f,  0.0f}, { 1.0f,  0.0f,  0.0f}, { 1.0f,  0.0f,  0.0f}, { 1.0f,  0.0f,  0.0f},
+    {-1.0f,  0.0f,  0.0f}, {-1.0f,  0.0f,  0.0f}, {-1.0f,  0.0f,  0.0f}, {-1.0f,  0.0f,  0.0f},
+    { 0.0f,  1.0f,  0.0f}, { 0.0f,  1.0f,  0.0f}, { 0.0f,  1.0f,  0.0f}, { 0.0f,  1.0f,  0.0f},
+    { 0.0f, -1.0f,  0.0f}, { 0.0f, -1.0f,  0.0f}, { 0.0f, -1.0f,  0.0f}, { 0.0f, -1.0f,  0.0f},
+};
+///< Indices of the cube, 12 triangles forming 6 faces.
+constexpr unsigned int CubeIndices[36] = {
+    0, 1, 2,  2, 3, 0,          // Front face
+    5, 4, 7,  7, 6, 5,          // Back face
+    8, 9, 10,  10, 11, 8,       // Right face
+    12, 13, 14,  14, 15, 12,    // Left face
+    16, 17, 18,  18, 19, 16,    // Top face
+    20, 21, 22,  22, 23, 20,    // Bottom face
+};
+
+} // namespace Tables
+
 // Geometry
 // ----------------------------------------
 /**
@@ -65,11 +170,7 @@ namespace utils { namespace Geometry
  */
 inline std::vector<unsigned int> IndicesOfPlane()
 {
-    return
-    {
-        0, 1, 2,    // first triangle
-        2, 3, 0,    // second triangle
-    };
+    return std::vector<unsigned int>(std::begin(Tables::PlaneIndices), std::end(Tables::PlaneIndices));
 }
 
 /**
@@ -79,27 +180,8 @@ inline std::vector<unsigned int> IndicesOfPlane()
  */
 inline std::vector<unsigned int> IndicesOfBasicCube()
 {
-    return
-    {
-        // Front face
-        0, 1, 2, // first triangle
-        2, 3, 0, // second triangle
-        // Back face
-        5, 4, 7, // first triangle
-        7, 6, 5, // second triangle
-        // Right face
-        1, 5, 6, // first triangle
-        6, 2, 1, // second triangle
-        // Left face
-        4, 0, 3, // first triangle
-        3, 7, 4, // second triangle
-        // Top face
-        3, 2, 6, // first triangle
-        6, 7, 3, // second triangle
-        // Bottom face
-        4, 5, 1, // first triangle
-        1, 0, 4, // second triangle
-    };
+    return std::vector<unsigned int>(std::begin(Tables::BasicCubeIndices),
+                                     std::end(Tables::BasicCubeIndices));
 }
 
 /**
@@ -109,27 +191,7 @@ inline std::vector<unsigned int> IndicesOfBasicCube()
  */
 inline std::vector<unsigned int> IndicesOfCube()
 {
-    return
-    {
-        // Front face
-        0, 1, 2, // first triangle
-        2, 3, 0, // second triangle
-        // Back face
-        5, 4, 7, // first triangle
-        7, 6, 5, // second triangle
-        // Right face
-        8, 9, 10, // first triangle
-        10, 11, 8, // second triangle
-        // Left face
-        12, 13, 14, // first triangle
-        14, 15, 12, // second triangle
-        // Top face
-        16, 17, 18, // first triangle
-        18, 19, 16, // second triangle
-        // Bottom face
-        20, 21, 22, // first triangle
-        22, 23, 20  // second triangle
-    };
+    return std::vector<unsigned int>(std::begin(Tables::CubeIndices), std::end(Tables::CubeIndices));
 }
 
 /**
@@ -141,6 +203,7 @@ inline std::vector<unsigned int> IndicesOfCube()
 inline std::vector<unsigned int> IndicesOfSphere(int resolution)
 {
     std::vector<unsigned int> indices;
+    indices.reserve(6 * resolution * resolution);
 
     for (int i = 0; i < resolution; i++)
     {
@@ -164,6 +227,18 @@ inline std::vector<unsigned int> IndicesOfSphere(int resolution)
     return indices;
 }
 
+/**
+ * Get a vertex position from a vertex table.
+ *
+ * @param position The position (x, y, z) in the table.
+ *
+ * @return The vertex position in homogeneous coordinates.
+ */
+inline glm::vec4 TablePosition(const float (&position)[3])
+{
+    return glm::vec4(position[0], position[1], position[2], 1.0f);
+}
+
 // Plane geometry
 // ----------------------------------------
 /**
@@ -175,13 +250,9 @@ inline std::vector<unsigned int> IndicesOfSphere(int resolution)
 inline void DefinePlaneGeometry(std::vector<GeoVertexData<glm::vec4>>& vertices,
                                 std::vector<unsigned int>& indices)
 {
-    vertices = {
-        // { position }
-        { {-0.5f, -0.5f, 0.0f, 1.0f} },     // bottom left (0)
-        { { 0.5f, -0.5f, 0.0f, 1.0f} },     // bottom right (1)
-        { { 0.5f,  0.5f, 0.0f, 1.0f} },     // top right (2)
-        { {-0.5f,  0.5f, 0.0f, 1.0f} }      // top left (3)
-    };
+    vertices.resize(std::size(Tables::PlanePositions));
+    for (size_t i = 0; i < vertices.size(); i++)
+        vertices[i].position = TablePosition(Tables::PlanePositions[i]);
     
     indices = IndicesOfPlane();
 }
@@ -195,13 +266,12 @@ inline void DefinePlaneGeometry(std::vector<GeoVertexData<glm::vec4>>& vertices,
 inline void DefinePlaneGeometry(std::vector<GeoVertexData<glm::vec4, glm::vec2>>& vertices,
                                 std::vector<unsigned int>& indices)
 {
-    vertices = {
-        // { position, texture coords }
-        { {-0.5f, -0.5f, 0.0f, 1.0f}, {0.0f,  0.0f} },     // bottom left (0)
-        { { 0.5f, -0.5f, 0.0f, 1.0f}, {1.0f,  0.0f} },     // bottom right (1)
-        { { 0.5f,  0.5f, 0.0f, 1.0f}, {1.0f,  1.0f} },     // top right (2)
-        { {-0.5f,  0.5f, 0.0f, 1.0f}, {0.0f,  1.0f} }      // top left (3)
-    };
+    vertices.resize(std::size(Tables::PlanePositions));
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        vertices[i].position = TablePosition(Tables::PlanePositions[i]);
+        vertices[i].uv = glm::make_vec2(Tables::PlaneTextureCoords[i]);
+    }
     
     indices = IndicesOfPlane();
 }
@@ -215,13 +285,12 @@ inline void DefinePlaneGeometry(std::vector<GeoVertexData<glm::vec4, glm::vec2>>
 inline void DefinePlaneGeometry(std::vector<GeoVertexData<glm::vec4, glm::vec3>>& vertices,
                                 std::vector<unsigned int>& indices)
 {
-    vertices = {
-        // { position, normal }
-        { {-0.5f, -0.5f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f} },     // bottom left (0)
-        { { 0.5f, -0.5f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f} },     // bottom right (1)
-        { { 0.5f,  0.5f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f} },     // top right (2)
-        { {-0.5f,  0.5f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f} }      // top left (3)
-    };
+    vertices.resize(std::size(Tables::PlanePositions));
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        vertices[i].position = TablePosition(Tables::PlanePositions[i]);
+        vertices[i].normal = glm::make_vec3(Tables::PlaneNormals[i]);
+    }
     
     indices = IndicesOfPlane();
 }
@@ -235,13 +304,13 @@ inline void DefinePlaneGeometry(std::vector<GeoVertexData<glm::vec4, glm::vec3>>
 inline void DefinePlaneGeometry(std::vector<GeoVertexData<glm::vec4, glm::vec2, glm::vec3>>& vertices,
                         std::vector<unsigned int>& indices)
 {
-    vertices = {
-        // { position, texture coords, normal }
-        { {-0.5f, -0.5f, 0.0f, 1.0f}, {0.0f,  0.0f}, {0.0f, 0.0f, 1.0f} },     // bottom left (0)
-        { { 0.5f, -0.5f, 0.0f, 1.0f}, {1.0f,  0.0f}, {0.0f, 0.0f, 1.0f} },     // bottom right (1)
-        { { 0.5f,  0.5f, 0.0f, 1.0f}, {1.0f,  1.0f}, {0.0f, 0.0f, 1.0f} },     // top right (2)
-        { {-0.5f,  0.5f, 0.0f, 1.0f}, {0.0f,  1.0f}, {0.0f, 0.0f, 1.0f} }      // top left (3)
-    };
+    vertices.resize(std::size(Tables::PlanePositions));
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        vertices[i].position = TablePosition(Tables::PlanePositions[i]);
+        vertices[i].uv = glm::make_vec2(Tables::PlaneTextureCoords[i]);
+        vertices[i].normal = glm::make_vec3(Tables::PlaneNormals[i]);
+    }
     
     indices = IndicesOfPlane();
 }
@@ -257,18 +326,9 @@ inline void DefinePlaneGeometry(std::vector<GeoVertexData<glm::vec4, glm::vec2,
 inline void DefineCubeGeometry(std::vector<GeoVertexData<glm::vec4>>& vertices,
                         std::vector<unsigned int>& indices)
 {
-    vertices = {
-        // Front face
-        { {-0.5f, -0.5f,  0.5f, 1.0f} },     // bottom left (0)
-        { { 0.5f, -0.5f,  0.5f, 1.0f} },     // bottom right (1)
-        { { 0.5f,  0.5f,  0.5f, 1.0f} },     // top right (2)
-        { {-0.5f,  0.5f,  0.5f, 1.0f} },     // top left (3)
-        // Back face
-        { {-0.5f, -0.5f, -0.5f, 1.0f} },     // bottom left (4)
-        { { 0.5f, -0.5f, -0.5f, 1.0f} },     // bottom right (5)
-        { { 0.5f,  0.5f, -0.5f, 1.0f} },     // top right (6)
-        { {-0.5f,  0.5f, -0.5f, 1.0f} },     // top left (7)
-    };
+    vertices.resize(std::size(Tables::BasicCubePositions));
+    for (size_t i = 0; i < vertices.size(); i++)
+        vertices[i].position = TablePosition(Tables::BasicCubePositions[i]);
     
     indices = IndicesOfBasicCube();
 }
@@ -282,18 +342,12 @@ inline void DefineCubeGeometry(std::vector<GeoVertexData<glm::vec4>>& vertices,
 inline void DefineCubeGeometry(std::vector<GeoVertexData<glm::vec4, glm::vec2>>& vertices,
                         std::vector<unsigned int>& indices)
 {
-    vertices = {
-        // Front face
-        { {-0.5f, -0.5f,  0.5f, 1.0f}, {0.0f, 0.0f} },     // bottom left (0)
-        { { 0.5f, -0.5f,  0.5f, 1.0f}, {1.0f, 0.0f} },     // bottom right (1)
-        { { 0.5f,  0.5f,  0.5f, 1.0f}, {1.0f, 1.0f} },     // top right (2)
-        { {-0.5f,  0.5f,  0.5f, 1.0f}, {0.0f, 1.0f} },     // top left (3)
-        // Back face
-        { {-0.5f, -0.5f, -0.5f, 1.0f}, {0.0f, 0.0f} },     // bottom left (4)
-        { { 0.5f, -0.5f, -0.5f, 1.0f}, {1.0f, 0.0f} },     // bottom right (5)
-        { { 0.5f,  0.5f, -0.5f, 1.0f}, {1.0f, 1.0f} },     // top right (6)
-        { {-0.5f,  0.5f, -0.5f, 1.0f}, {0.0f, 1.0f} },     // top left (7)
-    };
+    vertices.resize(std::size(Tables::BasicCubePositions));
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        vertices[i].position = TablePosition(Tables::BasicCubePositions[i]);
+        vertices[i].uv = glm::make_vec2(Tables::BasicCubeTextureCoords[i]);
+    }
     
     indices = IndicesOfBasicCube();
 }
@@ -307,39 +361,12 @@ inline void DefineCubeGeometry(std::vector<GeoVertexData<glm::vec4, glm::vec2>>&
 inline void DefineCubeGeometry(std::vector<GeoVertexData<glm::vec4, glm::vec3>>& vertices,
                         std::vector<unsigned int>& indices)
 {
-    // Define the vertices with positions and normals
-    vertices = {
-        // Front face
-        { {-0.5f, -0.5f,  0.5f, 1.0f}, {0.0f, 0.0f, 1.0f} },     // bottom left (0)
-        { { 0.5f, -0.5f,  0.5f, 1.0f}, {0.0f, 0.0f, 1.0f} },     // bottom right (1)
-        { { 0.5f,  0.5f,  0.5f, 1.0f}, {0.0f, 0.0f, 1.0f} },     // top right (2)
-        { {-0.5f,  0.5f,  0.5f, 1.0f}, {0.0f, 0.0f, 1.0f} },     // top left (3)
-        // Back face
-        { {-0.5f, -0.5f, -0.5f, 1.0f}, {0.0f, 0.0f, -1.0f} },     // bottom left (4)
-        { { 0.5f, -0.5f, -0.5f, 1.0f}, {0.0f, 0.0f, -1.0f} },     // bottom right (5)
-        { { 0.5f,  0.5f, -0.5f, 1.0f}, {0.0f, 0.0f, -1.0f} },     // top right (6)
-        { {-0.5f,  0.5f, -0.5f, 1.0f}, {0.0f, 0.0f, -1.0f} },     // top left (7)
-        // Right face
-        { { 0.5f, -0.5f,  0.5f, 1.0f}, {1.0f, 0.0f, 0.0f} },     // bottom left (8)
-        { { 0.5f, -0.5f, -0.5f, 1.0f}, {1.0f, 0.0f, 0.0f} },     // bottom right (9)
-        { { 0.5f,  0.5f, -0.5f, 1.0f}, {1.0f, 0.0f, 0.0f} },     // top right (10)
-        { { 0.5f,  0.5f,  0.5f, 1.0f}, {1.0f, 0.0f, 0.0f} },     // top left (11)
-        // Left face
-        { {-0.5f, -0.5f, -0.5f, 1.0f}, {-1.0f, 0.0f, 0.0f} },     // bottom left (12)
-        { {-0.5f, -0.5f,  0.5f, 1.0f}, {-1.0f, 0.0f, 0.0f} },     // bottom right (13)
-        { {-0.5f,  0.5f,  0.5f, 1.0f}, {-1.0f, 0.0f, 0.0f} },     // top right (14)
-        { {-0.5f,  0.5f, -0.5f, 1.0f}, {-1.0f, 0.0f, 0.0f} },     // top left (15)
-        // Top face
-        { {-0.5f,  0.5f,  0.5f, 1.0f}, {0.0f, 1.0f, 0.0f} },     // bottom left (16)
-        { { 0.5f,  0.5f,  0.5f, 1.0f}, {0.0f, 1.0f, 0.0f} },     // bottom right (17)
-        { { 0.5f,  0.5f, -0.5f, 1.0f}, {0.0f, 1.0f, 0.0f} },     // top right (18)
-        { {-0.5f,  0.5f, -0.5f, 1.0f}, {0.0f, 1.0f, 0.0f} },     // top left (19)
-        // Bottom face
-        { {-0.5f, -0.5f, -0.5f, 1.0f}, {0.0f, -1.0f, 0.0f} },     // bottom left (20)
-        { { 0.5f, -0.5f, -0.5f, 1.0f}, {0.0f, -1.0f, 0.0f} },     // bottom right (21)
-        { { 0.5f, -0.5f,  0.5f, 1.0f}, {0.0f, -1.0f, 0.0f} },     // top right (22)
-        { {-0.5f, -0.5f,  0.5f, 1.0f}, {0.0f, -1.0f, 0.0f} }      // top left (23)
-    };
+    vertices.resize(std::size(Tables::CubePositions));
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        vertices[i].position = TablePosition(Tables::CubePositions[i]);
+        vertices[i].normal = glm::make_vec3(Tables::CubeNormals[i]);
+    }
     
     indices = IndicesOfCube();
 }
@@ -353,56 +380,31 @@ inline void DefineCubeGeometry(std::vector<GeoVertexData<glm::vec4, glm::vec3>>&
 inline void DefineCubeGeometry(std::vector<GeoVertexData<glm::vec4, glm::vec2, glm::vec3>>& vertices,
                         std::vector<unsigned int>& indices)
 {
-    // Define the vertices with positions and normals
-    vertices = {
-        // Front face
-        { {-0.5f, -0.5f,  0.5f, 1.0f}, {0.0f, 0.0f}, {0.0f, 0.0f, 1.0f} },     // bottom left (0)
-        { { 0.5f, -0.5f,  0.5f, 1.0f}, {1.0f, 0.0f}, {0.0f, 0.0f, 1.0f} },     // bottom right (1)
-        { { 0.5f,  0.5f,  0.5f, 1.0f}, {1.0f, 1.0f}, {0.0f, 0.0f, 1.0f} },     // top right (2)
-        { {-0.5f,  0.5f,  0.5f, 1.0f}, {0.0f, 1.0f}, {0.0f, 0.0f, 1.0f} },     // top left (3)
-        // Back face
-        { {-0.5f, -0.5f, -0.5f, 1.0f}, {0.0f, 0.0f}, {0.0f, 0.0f, -1.0f} },     // bottom left (4)
-        { { 0.5f, -0.5f, -0.5f, 1.0f}, {1.0f, 0.0f}, {0.0f, 0.0f, -1.0f} },     // bottom right (5)
-        { { 0.5f,  0.5f, -0.5f, 1.0f}, {1.0f, 1.0f}, {0.0f, 0.0f, -1.0f} },     // top right (6)
-        { {-0.5f,  0.5f, -0.5f, 1.0f}, {0.0f, 1.0f}, {0.0f, 0.0f, -1.0f} },     // top left (7)
-        // Right face
-        { { 0.5f, -0.5f,  0.5f, 1.0f}, {0.0f, 0.0f}, {1.0f, 0.0f, 0.0f} },     // bottom left (8)
-        { { 0.5f, -0.5f, -0.5f, 1.0f}, {1.0f, 0.0f}, {1.0f, 0.0f, 0.0f} },     // bottom right (9)
-        { { 0.5f,  0.5f, -0.5f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f, 0.0f} },     // top right (10)
-        { { 0.5f,  0.5f,  0.5f, 1.0f}, {0.0f, 1.0f}, {1.0f, 0.0f, 0.0f} },     // top left (11)
-        // Left face
-        { {-0.5f, -0.5f, -0.5f, 1.0f}, {0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f} },     // bottom left (12)
-        { {-0.5f, -0.5f,  0.5f, 1.0f}, {1.0f, 0.0f}, {-1.0f, 0.0f, 0.0f} },     // bottom right (13)
-        { {-0.5f,  0.5f,  0.5f, 1.0f}, {1.0f, 1.0f}, {-1.0f, 0.0f, 0.0f} },     // top right (14)
-        { {-0.5f,  0.5f, -0.5f, 1.0f}, {0.0f, 1.0f}, {-1.0f, 0.0f, 0.0f} },     // top left (15)
-        // Top face
-        { {-0.5f,  0.5f,  0.5f, 1.0f}, {0.0f, 0.0f}, {0.0f, 1.0f, 0.0f} },     // bottom left (16)
-        { { 0.5f,  0.5f,  0.5f, 1.0f}, {1.0f, 0.0f}, {0.0f, 1.0f, 0.0f} },     // bottom right (17)
-        { { 0.5f,  0.5f, -0.5f, 1.0f}, {1.0f, 1.0f}, {0.0f, 1.0f, 0.0f} },     // top right (18)
-        { {-0.5f,  0.5f, -0.5f, 1.0f}, {0.0f, 1.0f}, {0.0f, 1.0f, 0.0f} },     // top left (19)
-        // Bottom face
-        { {-0.5f, -0.5f, -0.5f, 1.0f}, {0.0f, 0.0f}, {0.0f, -1.0f, 0.0f} },     // bottom left (20)
-        { { 0.5f, -0.5f, -0.5f, 1.0f}, {1.0f, 0.0f}, {0.0f, -1.0f, 0.0f} },     // bottom right (21)
-        { { 0.5f, -0.5f,  0.5f, 1.0f}, {1.0f, 1.0f}, {0.0f, -1.0f, 0.0f} },     // top right (22)
-        { {-0.5f, -0.5f,  0.5f, 1.0f}, {0.0f, 1.0f}, {0.0f, -1.0f, 0.0f} }      // top left (23)
-    };
+    vertices.resize(std::size(Tables::CubePositions));
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        vertices[i].position = TablePosition(Tables::CubePositions[i]);
+        vertices[i].uv = glm::make_vec2(Tables::CubeTextureCoords[i]);
+        vertices[i].normal = glm::make_vec3(Tables::CubeNormals[i]);
+    }
     
     indices = IndicesOfCube();
 }
 
+// Sphere geometry
+// ----------------------------------------
 /**
  * Define the geometry of a sphere with position information.
  *
  * @param vertices Vector to store the vertex data for the sphere (position-only vertices).
  * @param indices Vector to store the indices of the vertices to form triangles.
- * @param radius The radius of the sphere.
  * @param resolution The number of horizontal and vertical segments of the sphere.
  */
 inline void DefineSphereGeometry(std::vector<GeoVertexData<glm::vec4>>& vertices,
-                                std::vector<unsigned int>& indices)
+                                std::vector<unsigned int>& indices, int resolution = 32)
 {
     float radius = 1.0f;
-    int resolution = 32;
+    vertices.reserve((resolution + 1) * (resolution + 1));
 
     // Calculate the vertices of the sphere
     for (int i = 0; i <= resolution; i++)
@@ -424,18 +426,17 @@ inline void DefineSphereGeometry(std::vector<GeoVertexData<glm::vec4>>& vertices
 }
 
 /**
- * Define the geometry of a sphere with position information.
+ * Define the geometry of a sphere with position and texture coordinate information.
  *
- * @param vertices Vector to store the vertex data for the sphere (position-only vertices).
+ * @param vertices Vector to store the vertex data for the sphere (position and texture coordinate vertices).
  * @param indices Vector to store the indices of the vertices to form triangles.
- * @param radius The radius of the sphere.
  * @param resolution The number of horizontal and vertical segments of the sphere.
  */
 inline void DefineSphereGeometry(std::vector<GeoVertexData<glm::vec4, glm::vec2>>& vertices,
-                                std::vector<unsigned int>& indices)
+                                std::vector<unsigned int>& indices, int resolution = 32)
 {
     float radius = 1.0f;
-    int resolution = 32;
+    vertices.reserve((resolution + 1) * (resolution + 1));
 
     // Calculate the vertices of the sphere
     for (int i = 0; i <= resolution; i++)
@@ -457,18 +458,17 @@ inline void DefineSphereGeometry(std::vector<GeoVertexData<glm::vec4, glm::vec2>
 }
 
 /**
- * Define the geometry of a sphere with position information.
+ * Define the geometry of a sphere with position and normal vector information.
  *
- * @param vertices Vector to store the vertex data for the sphere (position-only vertices).
+ * @param vertices Vector to store the vertex data for the sphere (position and normal vector vertices).
  * @param indices Vector to store the indices of the vertices to form triangles.
- * @param radius The radius of the sphere.
  * @param resolution The number of horizontal and vertical segments of the sphere.
  */
 inline void DefineSphereGeometry(std::vector<GeoVertexData<glm::vec4, glm::vec3>>& vertices,
-                                std::vector<unsigned int>& indices)
+                                std::vector<unsigned int>& indices, int resolution = 32)
 {
     float radius = 1.0f;
-    int resolution = 32;
+    vertices.reserve((resolution + 1) * (resolution + 1));
 
     // Calculate the vertices of the sphere
     for (int i = 0; i <= resolution; i++)
@@ -490,18 +490,17 @@ inline void DefineSphereGeometry(std::vector<GeoVertexData<glm::vec4, glm::vec3>
 }
 
 /**
- * Define the geometry of a sphere with position information.
+ * Define the geometry of a sphere with position, texture coordinate, and normal vector information.
  *
- * @param vertices Vector to store the vertex data for the sphere (position-only vertices).
+ * @param vertices Vector to store the vertex data for the sphere (position, texture coordinate, and normal vector vertices).
  * @param indices Vector to store the indices of the vertices to form triangles.
- * @param radius The radius of the sphere.
  * @param resolution The number of horizontal and vertical segments of the sphere.
  */
 inline void DefineSphereGeometry(std::vector<GeoVertexData<glm::vec4, glm::vec2, glm::vec3>>& vertices,
-                                std::vector<unsigned int>& indices)
+                                std::vector<unsigned int>& indices, int resolution = 32)
 {
     float radius = 1.0f;
-    int resolution = 32;
+    vertices.reserve((resolution + 1) * (resolution + 1));
 
     // Calculate the vertices of the sphere
     for (int i = 0; i <= resolution; i++)
@@ -522,5 +521,81 @@ inline void DefineSphereGeometry(std::vector<GeoVertexData<glm::vec4, glm::vec2,
     indices = IndicesOfSphere(resolution);
 }
 
+// Mesh partitioning
+// ----------------------------------------
+/**
+ * Split an indexed mesh into chunks that reference at most a maximum number of vertices.
+ *
+ * The primitives are assigned in order to the current chunk until adding one more would exceed
+ * the vertex limit. Each chunk gets its own (compacted) vertex data and local indices, so that the
+ * default limit allows every chunk to be indexed using 16-bit values.
+ *
+ * @tparam VertexData The type of vertex data used to define the geometry.
+ *
+ * @param vertices The vertex data of the mesh.
+ * @param indices The index data of the mesh.
+ * @param maxVertices The maximum number of vertices referenced by each chunk.
+ * @param primitiveSize The number of indices defining each primitive (e.g. 3 for triangles).
+ *
+ * @return The list of chunks, as pairs of vertex and index data.
+ */
+template<typename VertexData>
+inline std::vector<std::pair<std::vector<VertexData>, std::vector<unsigned int>>>
+    SplitMesh(const std::vector<VertexData>& vertices, const std::vector<unsigned int>& indices,
+              unsigned int maxVertices = 65536, unsigned int primitiveSize = 3)
+{
+    CORE_ASSERT(maxVertices >= primitiveSize, "Invalid vertex limit for splitting the mesh!");
+    
+    std::vector<std::pair<std::vector<VertexData>, std::vector<unsigned int>>> chunks;
+    // Nothing to split
+    if (vertices.size() <= maxVertices)
+    {
+        chunks.emplace_back(vertices, indices);
+        return chunks;
+    }
+    
+    // Mapping of the global vertex indices into the current chunk
+    const unsigned int unmapped = std::numeric_limits<unsigned int>::max();
+    std::vector<unsigned int> remap(vertices.size(), unmapped);
+    std::vector<unsigned int> mapped;
+    
+    chunks.emplace_back();
+    for (size_t p = 0; p + primitiveSize <= indices.size(); p += primitiveSize)
+    {
+        auto* chunk = &chunks.back();
+        
+        // Count the new vertices that the primitive adds to the chunk
+        unsigned int added = 0;
+        for (unsigned int i = 0; i < primitiveSize; i++)
+            added += remap[indices[p + i]] == unmapped ? 1 : 0;
+        
+        // Start a new chunk if the limit would be exceeded
+        if (chunk->first.size() + added > maxVertices)
+        {
+            for (unsigned int index : mapped)
+                remap[index] = unmapped;
+            mapped.clear();
+            
+            chunks.emplace_back();
+            chunk = &chunks.back();
+        }
+        
+        // Add the primitive to the chunk
+        for (unsigned int i = 0; i < primitiveSize; i++)
+        {
+            unsigned int index = indices[p + i];
+            if (remap[index] == unmapped)
+            {
+                remap[index] = (unsigned int)chunk->first.size();
+                chunk->first.push_back(vertices[index]);
+                mapped.push_back(index);
+            }
+            chunk->second.push_back(remap[index]);
+        }
+    }
+    
+    return chunks;
+}
+
 } // namespace Geometry
 } // namespace utils
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Common/Renderer/RendererUtils.h"
+
+#include <glm/glm.hpp>
+
+/**
+ * Represents a small cluster of connected triangles (meshlet) of a mesh.
+ *
+ * The triangles of a meshlet are stored contiguously in the index buffer of the mesh, together
+ * with the bounds used to skip the meshlet when it is outside the view (bounding sphere) or when
+ * all its triangles face away from the camera (normal cone).
+ */
+struct Meshlet
+{
+    IndexRange range;                       ///< Range of the meshlet in the index buffer.
+
+    glm::vec3 center = glm::vec3(0.0f);     ///< Center of the bounding sphere.
+    float radius = 0.0f;                    ///< Radius of the bounding sphere.
+
+    glm::vec3 coneAxis = glm::vec3(0.0f);   ///< Average direction of the triangle normals.
+    float coneCutoff = 1.0f;                ///< Sine of the cone spread angle (1 if the triangle
+                                            ///< normals are too spread for the meshlet to be culled).
+};
+
+namespace utils { namespace Geometry
+{
+
+// Clustering
+// ----------------------------------------
+std::vector<Meshlet> BuildMeshlets(const std::vector<glm::vec3>& positions,
+                                   std::vector<unsigned int>& indices,
+                                   const unsigned int maxVertices = 64,
+                                   const unsigned int maxTriangles = 124);
+
+// Culling
+// ----------------------------------------
+/**
+ * Check if all the triangles of a meshlet are facing away from the camera.
+ *
+ * @param meshlet The meshlet to be checked.
+ * @param cameraPosition The position of the camera (in the space of the meshlet).
+ * @param culledFace The face being culled (front or back faces).
+ *
+ * @return `true` if all the triangles would be culled by the face culling.
+ */
+inline bool IsMeshletFacingAway(const Meshlet& meshlet, const glm::vec3& cameraPosition,
+                                const FaceCulling& culledFace = FaceCulling::Back)
+{
+    if (meshlet.coneCutoff >= 1.0f || culledFace == FaceCulling::FrontAndBack)
+        return false;
+
+    glm::vec3 axis = culledFace == FaceCulling::Back ? meshlet.coneAxis : -meshlet.coneAxis;
+    glm::vec3 direction = meshlet.center - cameraPosition;
+    return glm::dot(direction, axis) >= meshlet.coneCutoff * glm::length(direction) + meshlet.radius;
+}
+
+} // namespace Geometry
+} // namespace utils
@@ -4,6 +4,7 @@
 #include "Common/Renderer/Model/Model.h"
 
 #include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
 
 struct aiNode;
 struct aiScene;
@@ -11,12 +12,16 @@ struct aiMesh;
 
 /**
  * Represents the different data that a vertex from an assimp model contains.
+ *
+ * The vertex data is stored in a compact (quantized) form of 16 bytes: the position is encoded
+ * as snorm16 relative to the bounds of its mesh, the texture coordinates as half-floats, and the
+ * normal vector in the packed signed 10:10:10:2 format.
  */
 struct AssimpVertexData
 {
-    glm::vec4 position;         ///< Vertex position.
-    glm::vec2 uv;               ///< Texture coordinate.
-    glm::vec3 normal;           ///< Normal vector.
+    glm::i16vec4 position;      ///< Vertex position (snorm16, relative to the mesh bounds).
+    glm::u16vec2 uv;            ///< Texture coordinate (half-float).
+    glm::uint32 normal;         ///< Normal vector (snorm 10:10:10:2).
 };
 
 /**
@@ -34,10 +39,18 @@ public:
     /// @brief Define an assimp model from a file source.
     /// @param filePath The path to the model file.
     /// @param primitive The primitive type of the model.
+    /// @param residency The policy for the CPU-side copies of the mesh data.
+    /// @param lodLevels The number of levels of detail generated for each mesh (including the
+    /// original geometry).
+    /// @param meshlets Partition the meshes into meshlets, culled individually when drawn.
     AssimpModel(const std::filesystem::path& filePath,
-                const PrimitiveType &primitive = PrimitiveType::Triangles)
-    : LoadedModel<AssimpVertexData>(filePath, primitive)
+                const PrimitiveType &primitive = PrimitiveType::Triangles,
+                const MeshResidency &residency = MeshResidency::Keep,
+                const unsigned int lodLevels = 1, const bool meshlets = false)
+    : LoadedModel<AssimpVertexData>(filePath, primitive), m_LODLevels(lodLevels),
+      m_Meshlets(meshlets)
     {
+        this->m_Asset->SetResidency(residency);
         LoadModel(filePath);
     }
     
@@ -52,7 +65,15 @@ private:
     // Mesh processing
     // ----------------------------------------
     void ProcessNode(aiNode *node, const aiScene *scene);
-    Mesh<AssimpVertexData> ProcessMesh(aiMesh *mesh);
+    std::vector<Mesh<AssimpVertexData>> ProcessMesh(aiMesh *mesh);
+    
+    // Assimp model variables
+    // ----------------------------------------
+private:
+    ///< Number of levels of detail generated for each mesh.
+    unsigned int m_LODLevels = 1;
+    ///< Partition the meshes into meshlets.
+    bool m_Meshlets = false;
     
     // Disable the copying or moving of this resource
     // ----------------------------------------
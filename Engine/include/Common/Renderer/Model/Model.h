@@ -2,30 +2,23 @@
 
 #include "Common/Core/Library.h"
 #include "Common/Renderer/Mesh/Mesh.h"
+#include "Common/Renderer/Mesh/MeshAsset.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
 
-/**
- * Represents a bounding box around a 3D model.
- *
- * The `BBox` structure defines a bounding box by storing the minimum and maximum coordinates
- * along the x, y, and z axes. It represents the extent or volume occupied by a 3D model.
- */
-struct BBox
-{
-    glm::vec3 min = { 0.0f, 0.0f, 0.0f };   ///< The minimum coordinates of the bounding box.
-    glm::vec3 max = { 0.0f, 0.0f, 0.0f };   ///< The maximum coordinates of the bounding box.
-};
+#include <type_traits>
+#include <typeinfo>
 
 /**
  * Represents a basic model used for rendering geometry.
  *
  * The `BaseModel` class provides functionality for drawing the model with a specified transformation
  * matrix and primitive type. It encapsulates information about the model's position, rotation, scale,
- * model matrix, and up axis direction. Derived classes must implement protected virtual methods
- * for updating the model matrix.
+ * model matrix, and up axis direction, together with the materials overriding the ones of its meshes.
+ * The geometry itself is referenced through a shared (ref-counted) mesh asset, so multiple models
+ * can be placed using the same geometry.
  */
 class BaseModel
 {
@@ -39,8 +32,11 @@ public:
     // ----------------------------------------
     /// @brief Draw the model using the specified transformation matrix.
     /// @param transform The transformation matrix for the model.
-    /// @param primitive The type of primitive to be drawn (e.g., Points, Lines, Triangles).
-    virtual void DrawModelWithTransform(const glm::mat4 &transform = glm::mat4(1.0f)) = 0;
+    virtual void DrawModelWithTransform(const glm::mat4 &transform = glm::mat4(1.0f))
+    {
+        if (m_Asset)
+            m_Asset->Draw(transform, m_Materials, m_LOD);
+    }
     /// @brief Draw the model using the model matrix transformation.
     /// @param primitive The type of primitive to be drawn (e.g., Points, Lines, Triangles).
     void DrawModel()
@@ -49,6 +45,34 @@ public:
         DrawModelWithTransform(m_ModelMatrix);
     }
     
+    // Level of detail
+    // ----------------------------------------
+    /// @brief Generate the levels of detail of the model geometry.
+    /// @param levels The number of levels, including the original geometry.
+    /// @param reduction The ratio of triangles kept from one level to the next.
+    /// @param maxError The maximum error allowed for each level, relative to the mesh extent.
+    /// @note The levels are shared by all the models using the same geometry.
+    void GenerateLODs(const unsigned int levels, const float reduction = 0.5f,
+                      const float maxError = 0.05f)
+    {
+        if (m_Asset)
+            m_Asset->GenerateLODs(levels, reduction, maxError);
+    }
+    void UpdateLOD(const glm::mat4 &view, const glm::mat4 &projection);
+    
+    // Clustering
+    // ----------------------------------------
+    /// @brief Partition the meshes of the model geometry into meshlets, culled individually
+    /// when drawn.
+    /// @param maxVertices The maximum number of unique vertices in a meshlet.
+    /// @param maxTriangles The maximum number of triangles in a meshlet.
+    /// @note The meshlets are shared by all the models using the same geometry.
+    void GenerateMeshlets(const unsigned int maxVertices = 64, const unsigned int maxTriangles = 124)
+    {
+        if (m_Asset)
+            m_Asset->GenerateMeshlets(maxVertices, maxTriangles);
+    }
+    
     // Getter(s)
     // ----------------------------------------
     /// @brief Get the model position (x, y, z).
@@ -61,12 +85,54 @@ public:
     /// @brief Get the model matrix (transformation from model space to world space).
     /// @return The view matrix.
     const glm::mat4& GetModelMatrix() const { return m_ModelMatrix; }
+    /// @brief Get the memory used by the model (CPU-side data copies and GPU buffers).
+    /// @return The memory usage of the model.
+    MemoryUsage GetMemoryUsage() const
+    {
+        return m_Asset ? m_Asset->GetMemoryUsage() : MemoryUsage();
+    }
+    
+    /// @brief Get the number of meshes representing the model.
+    /// @return The number of meshes.
+    int GetMeshNumber() const { return m_Asset ? (int)m_Asset->GetMeshNumber() : 0; }
+    /// @brief Get the level of detail currently used to draw the model.
+    /// @return The level of detail.
+    unsigned int GetLOD() const { return m_LOD; }
+    /// @brief Get the (shared) geometry of the model.
+    /// @return The mesh asset.
+    const std::shared_ptr<BaseMeshAsset>& GetAsset() const { return m_Asset; }
+    
+    // Instancing
+    // ----------------------------------------
+    std::shared_ptr<BaseModel> CreateInstance() const;
     
     // Setter(s)
     // ----------------------------------------
     /// @brief Sets the material for all the meshes in the model.
     /// @param material The material defining the surface of the meshes.
-    virtual void SetMaterial(const std::shared_ptr<Material>& material) = 0;
+    void SetMaterial(const std::shared_ptr<Material>& material)
+    {
+        m_Materials.assign(GetMeshNumber(), material);
+    }
+    /// @brief Sets the material for a specific mesh in the model.
+    /// @param index The index of the mesh to set the material for.
+    /// @param material The material defining the surface of the mesh.
+    void SetMaterialForMesh(unsigned int index, const std::shared_ptr<Material>& material)
+    {
+        if (index >= (unsigned int)GetMeshNumber())
+            return;
+        
+        m_Materials.resize(GetMeshNumber());
+        m_Materials[index] = material;
+    }
+    /// @brief Sets the policy for the CPU-side copies of the data of all the meshes in the model.
+    /// @param residency The residency policy.
+    /// @note The policy is shared by all the models using the same geometry.
+    void SetResidency(const MeshResidency &residency)
+    {
+        if (m_Asset)
+            m_Asset->SetResidency(residency);
+    }
     
     /// @brief Change the model position (x, y, z).
     /// @param position The model center position.
@@ -101,14 +167,14 @@ protected:
     // Constructor(s)
     // ----------------------------------------
     /// @brief Define a base model.
-    /// @param primitives The type of the primitive that defines the model.
-    BaseModel(const PrimitiveType &primitive)
-        : m_Primitive(primitive)
+    /// @param asset The geometry of the model.
+    BaseModel(const std::shared_ptr<BaseMeshAsset> &asset)
+        : m_Asset(asset)
     {}
     
     // Transformation matrices
     // ----------------------------------------
-    virtual void UpdateModelMatrix() = 0;
+    void UpdateModelMatrix();
     
     // Model variables
     // ----------------------------------------
@@ -125,8 +191,12 @@ protected:
     ///< Model up axis direction.
     glm::vec3 m_UpAxis = glm::vec3(0.0f, 1.0f, 0.0f);
     
-    ///< Primitive type defined for the model.
-    PrimitiveType m_Primitive;
+    ///< Geometry of the model (shared between models).
+    std::shared_ptr<BaseMeshAsset> m_Asset;
+    ///< Materials overriding the ones defined for each mesh.
+    std::vector<std::shared_ptr<Material>> m_Materials;
+    ///< Level of detail used to draw the geometry.
+    unsigned int m_LOD = 0;
     
     // Disable the copying or moving of this resource
     // ----------------------------------------
@@ -138,12 +208,128 @@ public:
     BaseModel& operator=(BaseModel&&) = delete;
 };
 
+/**
+ * Represents a placement of an existing geometry in the scene.
+ *
+ * The `ModelInstance` class is a lightweight model that only holds a transformation, the material
+ * overrides and a handle to the shared geometry (mesh asset) it renders.
+ */
+class ModelInstance : public BaseModel
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    /// @brief Define a new instance of a geometry.
+    /// @param asset The geometry of the model.
+    ModelInstance(const std::shared_ptr<BaseMeshAsset> &asset)
+        : BaseModel(asset)
+    {
+        UpdateModelMatrix();
+    }
+    /// @brief Delete the model instance.
+    ~ModelInstance() override = default;
+    
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    ModelInstance(const ModelInstance&) = delete;
+    ModelInstance(ModelInstance&&) = delete;
+
+    ModelInstance& operator=(const ModelInstance&) = delete;
+    ModelInstance& operator=(ModelInstance&&) = delete;
+};
+
+/**
+ * Create a new model (instance) sharing the geometry of this model.
+ *
+ * @return The new model instance.
+ */
+inline std::shared_ptr<BaseModel> BaseModel::CreateInstance() const
+{
+    auto instance = std::make_shared<ModelInstance>(m_Asset);
+    instance->m_Materials = m_Materials;
+    instance->m_UpAxis = m_UpAxis;
+    instance->m_LOD = m_LOD;
+    instance->UpdateModelMatrix();
+    return instance;
+}
+
+/**
+ * Select the level of detail of the model from the size of its bounding sphere on the screen.
+ *
+ * @param view The view matrix of the camera.
+ * @param projection The projection matrix of the camera.
+ */
+inline void BaseModel::UpdateLOD(const glm::mat4 &view, const glm::mat4 &projection)
+{
+    unsigned int levels = m_Asset ? m_Asset->GetLODNumber() : 1;
+    if (levels <= 1)
+    {
+        m_LOD = 0;
+        return;
+    }
+    
+    // Bounding sphere of the model (world space)
+    const BSphere& sphere = m_Asset->GetBSphere();
+    if (sphere.IsEmpty())
+        return;
+    
+    glm::vec3 center = glm::vec3(m_ModelMatrix * glm::vec4(sphere.center, 1.0f));
+    float scale = glm::max(glm::max(glm::length(glm::vec3(m_ModelMatrix[0])),
+        glm::length(glm::vec3(m_ModelMatrix[1]))), glm::length(glm::vec3(m_ModelMatrix[2])));
+    float radius = sphere.radius * scale;
+    
+    float size = utils::Geometry::ProjectedSphereSize(center, radius, view, projection);
+    m_LOD = utils::Geometry::SelectLOD(size, m_LOD, levels);
+}
+
+/**
+ * Update the model matrix with translation, scaling, and rotation transformations.
+ */
+inline void BaseModel::UpdateModelMatrix()
+{
+    // Get the size of the model and its center position
+    const BBox bbox = m_Asset ? m_Asset->GetBBox() : BBox();
+    glm::vec3 center = bbox.GetCenter();
+
+    // Reset the model matrix to the identity
+    m_ModelMatrix = glm::mat4(1.0f);
+
+    // 1. Translate (and center) to the selected position
+    m_ModelMatrix = glm::translate(m_ModelMatrix, -center);
+    m_ModelMatrix = glm::translate(m_ModelMatrix, m_Position);
+
+    // Translate back to the center
+    m_ModelMatrix = glm::translate(m_ModelMatrix, center);
+
+    // 2. Scale the model using the scaling factor
+    m_ModelMatrix = glm::scale(m_ModelMatrix, m_Scale);
+
+    // 3. Rotate with the selected user angle around the center
+    m_ModelMatrix *= glm::toMat4(glm::quat(glm::radians(m_Rotation)));
+    
+    // 4. Rotate the model if the up-axis is defined as other than the Y-axis
+    glm::vec3 referenceAxis = glm::vec3(0.0f, 1.0f, 0.0f);
+    float epsilon = std::numeric_limits<float>::epsilon();
+    
+    if (glm::abs(glm::dot(referenceAxis, m_UpAxis) - 1.0f) > epsilon)
+    {
+        float angle = glm::acos(glm::dot(referenceAxis, m_UpAxis));
+        glm::vec3 axis = glm::normalize(glm::cross(referenceAxis, m_UpAxis));
+        m_ModelMatrix = glm::rotate(m_ModelMatrix, angle, axis);
+    }
+
+    // Translate back to the original position
+    m_ModelMatrix = glm::translate(m_ModelMatrix, -center);
+}
+
 /**
  * A library for managing models used in rendering.
  *
  * The `ModelLibrary` class provides functionality to add, load, retrieve, and check
  * for the existence of models within the library. Each model is associated with
- * a unique name.
+ * a unique name. Models loaded from a file share their geometry (mesh asset) with the models
+ * already loaded from the same file, so the GPU memory scales with the number of unique assets.
  */
 class ModelLibrary : public Library<std::shared_ptr<BaseModel>>
 {
@@ -172,14 +358,89 @@ public:
         Add(name, model);
         return model;
     }
+    
+    /// @brief Loads a model from a file and adds it to the library. If the file has been already
+    /// loaded with the same type and arguments (and its geometry is still in use), a new instance
+    /// of the geometry is created instead.
+    /// @tparam Type The type of object to load.
+    /// @tparam Args The types of arguments to forward to the object constructor.
+    /// @param name The name to associate with the loaded object.
+    /// @param filePath The path to the model file.
+    /// @param args The arguments to forward to the object constructor (after the file path).
+    /// @return The model loaded.
+    template<typename Type, typename... Args>
+    std::shared_ptr<BaseModel> Load(const std::string& name, const std::filesystem::path& filePath,
+                                    Args&&... args)
+    {
+        std::string key = GetKey<Type>(filePath, args...);
+        
+        // Reuse the geometry if it has been already loaded (with the same configuration)
+        auto it = m_Assets.find(key);
+        if (it != m_Assets.end())
+        {
+            if (auto asset = it->second.lock())
+            {
+                auto model = std::make_shared<ModelInstance>(asset);
+                Add(name, model);
+                return model;
+            }
+        }
+        
+        auto model = Create<Type>(name, filePath, std::forward<Args>(args)...);
+        m_Assets[key] = model->GetAsset();
+        return model;
+    }
+    
+private:
+    // Keys
+    // ----------------------------------------
+    /// @brief Get the key identifying the geometry loaded from a file with a configuration.
+    /// @tparam Type The type of object to load.
+    /// @tparam Args The types of arguments forwarded to the object constructor.
+    /// @param filePath The path to the model file.
+    /// @param args The arguments forwarded to the object constructor (after the file path).
+    /// @return The normalized path of the file followed by the type and the arguments.
+    template<typename Type, typename... Args>
+    static std::string GetKey(const std::filesystem::path& filePath, const Args&... args)
+    {
+        std::string key = std::filesystem::absolute(filePath).lexically_normal().string() + "|" +
+            typeid(Type).name();
+        ((key += "|" + GetKeyArgument(args)), ...);
+        return key;
+    }
+    
+    /// @brief Get the representation of an argument in the key of a geometry.
+    /// @tparam Arg The type of the argument (an enumeration, an arithmetic type or a string).
+    /// @param arg The argument.
+    /// @return The argument as a string.
+    template<typename Arg>
+    static std::string GetKeyArgument(const Arg& arg)
+    {
+        if constexpr (std::is_enum_v<Arg>)
+            return std::to_string(static_cast<long long>(arg));
+        else if constexpr (std::is_arithmetic_v<Arg>)
+            return std::to_string(arg);
+        else
+        {
+            static_assert(std::is_convertible_v<const Arg&, std::string>,
+                          "The model arguments must be part of the library key!");
+            return std::string(arg);
+        }
+    }
+    
+    // Library variables
+    // ----------------------------------------
+private:
+    ///< Geometry of the models loaded, indexed by their (normalized) file path and configuration.
+    std::unordered_map<std::string, std::weak_ptr<BaseMeshAsset>> m_Assets;
 };
 
 /**
  * Represents a model used for rendering geometry.
  *
  * The `Model` class inherits from the `BaseModel` class and provides additional
- * functionality specific to defining models. It encapsulates information required to and render
- * a model, such as a collection of meshes.
+ * functionality specific to defining models. It owns a new mesh asset, defining the collection of
+ * meshes required to render the model, which can be shared with other models (instances).
  *
  * @tparam VertexData The type of vertex data used by the meshes in the model.
  */
@@ -191,70 +452,36 @@ public:
     // ----------------------------------------
     /// @brief Define a model.
     /// @param primitive The primitive type of the model.
-    Model(const PrimitiveType &primitive = PrimitiveType::Triangles) : BaseModel(primitive) {};
+    Model(const PrimitiveType &primitive = PrimitiveType::Triangles)
+        : BaseModel(std::make_shared<MeshAsset<VertexData>>(primitive))
+    {}
     /// @brief Define with a specific mesh.
     /// @param mesh The set of meshes defining the model.
     /// @param primitive The primitive type of the model.
     Model(const Mesh<VertexData>& mesh,
           const PrimitiveType &primitive = PrimitiveType::Triangles)
-    : BaseModel(primitive)
+        : Model(primitive)
     {
-        m_Meshes.push_back(mesh);
+        GetMeshAsset()->AddMesh(mesh);
     }
     /// @brief Delete the model.
     virtual ~Model() = default;
     
-    // Render
-    // ----------------------------------------
-    /// @brief Draw the model using the specified transformation matrix.
-    /// @param transform The transformation matrix for the model.
-    /// @param primitive The type of primitive to be drawn (e.g., Points, Lines, Triangles).
-    void DrawModelWithTransform(const glm::mat4 &transform = glm::mat4(1.0f)) override
-    {
-        for(unsigned int i = 0; i < m_Meshes.size(); i++)
-            m_Meshes[i].DrawMesh(transform, m_Primitive);
-    }
-    
     // Getter(s)
     // ----------------------------------------
-    /// @brief Get the number of meshes representing the model.
-    /// @return The number of meshes.
-    int GetMeshNumber() const { return (int)m_Meshes.size(); }
-    
-    // Setter(s)
-    // ----------------------------------------
-    /// @brief Sets the material for all the meshes in the model.
-    /// @param material The material defining the surface of the meshes.
-    void SetMaterial(const std::shared_ptr<Material>& material) override
-    {
-        for(unsigned int i = 0; i < m_Meshes.size(); i++)
-            m_Meshes[i].SetMaterial(material);
-    }
-    /// @brief Sets the material for a specific mesh in the model.
-    /// @param index The index of the mesh to set the material for.
-    /// @param material The material defining the surface of the mesh.
-    void SetMaterialForMesh(unsigned int index, const std::shared_ptr<Material>& material)
+    /// @brief Get the geometry of the model.
+    /// @return The mesh asset.
+    std::shared_ptr<MeshAsset<VertexData>> GetMeshAsset() const
     {
-        if (index >= 0 && index < m_Meshes.size())
-            m_Meshes[index].SetMaterial(material);
+        return std::static_pointer_cast<MeshAsset<VertexData>>(m_Asset);
     }
     
 protected:
     // Bounding box definition
     // ----------------------------------------
-    void UpdateBBoxWithVertex(const glm::vec3 &v);
-    
-    // Transformation matrices
-    // ----------------------------------------
-    void UpdateModelMatrix() override;
-    
-    // Model variables
-    // ----------------------------------------
-protected:
-    ///< Bounding box.
-    BBox m_BBox;
-    ///< Set of meshes defining the model.
-    std::vector<Mesh<VertexData>> m_Meshes;
+    /// @brief Update the boundaries of the bounding box using a vertex coordinate.
+    /// @param v The vertex coordinate to be considered when updating the bounding box.
+    void UpdateBBoxWithVertex(const glm::vec3 &v) { m_Asset->UpdateBBoxWithVertex(v); }
     
     // Disable the copying or moving of this resource
     // ----------------------------------------
@@ -309,7 +536,9 @@ protected:
     LoadedModel(const std::filesystem::path& filePath,
                 const PrimitiveType &primitive)
         : Model<VertexData>(primitive), m_FilePath(filePath)
-    {}
+    {
+        this->m_Asset->SetSource(filePath);
+    }
     
     // Model variables
     // ----------------------------------------
@@ -326,74 +555,3 @@ public:
     LoadedModel& operator=(const LoadedModel&) = delete;
     LoadedModel& operator=(LoadedModel&&) = delete;
 };
-
-/**
- * Update the boundaries of the bounding box using a vertex coordinate.
- *
- * @param v The vertex coordinate to be considered when updating the bounding box.
- */
-template<typename VertexData>
-void Model<VertexData>::UpdateBBoxWithVertex(const glm::vec3& v)
-{
-    // Check if the x-coordinate is smaller than the current minimum x-coordinate
-    if (v.x < m_BBox.min.x)
-        m_BBox.min.x = v.x;
-    // Check if the x-coordinate is greater than the current maximum x-coordinate
-    if (v.x > m_BBox.max.x)
-        m_BBox.max.x = v.x;
-    
-    // Check if the y-coordinate is smaller than the current minimum y-coordinate
-    if (v.y < m_BBox.min.y)
-        m_BBox.min.y = v.y;
-    // Check if the y-coordinate is greater than the current maximum y-coordinate
-    if (v.y > m_BBox.max.y)
-        m_BBox.max.y = v.y;
-    
-    // Check if the z-coordinate is smaller than the current minimum z-coordinate
-    if (v.z < m_BBox.min.z)
-        m_BBox.min.z = v.z;
-    // Check if the z-coordinate is greater than the current maximum z-coordinate
-    if (v.z > m_BBox.max.z)
-        m_BBox.max.z = v.z;
-}
-
-/**
- * Update the model matrix with translation, scaling, and rotation transformations.
- */
-template<typename VertexData>
-void Model<VertexData>::UpdateModelMatrix()
-{
-    // Get the size of the model and its center position
-    glm::vec3 size = m_BBox.max - m_BBox.min;
-    glm::vec3 center = (m_BBox.max + m_BBox.min) / 2.0f;
-
-    // Reset the model matrix to the identity
-    m_ModelMatrix = glm::mat4(1.0f);
-
-    // 1. Translate (and center) to the selected position
-    m_ModelMatrix = glm::translate(m_ModelMatrix, -center);
-    m_ModelMatrix = glm::translate(m_ModelMatrix, m_Position);
-
-    // Translate back to the center
-    m_ModelMatrix = glm::translate(m_ModelMatrix, center);
-
-    // 2. Scale the model using the scaling factor
-    m_ModelMatrix = glm::scale(m_ModelMatrix, m_Scale);
-
-    // 3. Rotate with the selected user angle around the center
-    m_ModelMatrix *= glm::toMat4(glm::quat(glm::radians(m_Rotation)));
-    
-    // 4. Rotate the model if the up-axis is defined as other than the Y-axis
-    glm::vec3 referenceAxis = glm::vec3(0.0f, 1.0f, 0.0f);
-    float epsilon = std::numeric_limits<float>::epsilon();
-    
-    if (glm::abs(glm::dot(referenceAxis, m_UpAxis) - 1.0f) > epsilon)
-    {
-        float angle = glm::acos(glm::dot(referenceAxis, m_UpAxis));
-        glm::vec3 axis = glm::normalize(glm::cross(referenceAxis, m_UpAxis));
-        m_ModelMatrix = glm::rotate(m_ModelMatrix, angle, axis);
-    }
-
-    // Translate back to the original position
-    m_ModelMatrix = glm::translate(m_ModelMatrix, -center);
-}
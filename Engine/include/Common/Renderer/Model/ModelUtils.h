@@ -105,6 +105,82 @@ inline std::shared_ptr<Model<VertexData>>
     return std::make_shared<Model<VertexData>>(mesh);
 }
 
+// Primitive cache
+// ----------------------------------------
+/**
+ * Get the (shared) mesh of a procedural primitive.
+ *
+ * The meshes are generated only once and kept by the primitive library of the renderer, keyed by
+ * the primitive type, the vertex layout (vertex data type) and the resolution. Copies of the
+ * returned mesh share the same vertex array and buffers, so the number of GPU objects does not
+ * grow with the number of models using the primitive. The cached meshes are immutable and do not
+ * keep CPU-side copies.
+ *
+ * @tparam VertexData The type of vertex data used to define the geometry.
+ *
+ * @param type The type of primitive.
+ * @param resolution The number of segments of the primitive (only used for the sphere).
+ *
+ * @return The mesh of the primitive.
+ */
+template<typename VertexData>
+inline Mesh<VertexData> PrimitiveMesh(const PrimitiveGeometry &type, int resolution = 32)
+{
+    // Only the sphere geometry depends on the resolution
+    if (type != PrimitiveGeometry::Sphere)
+        resolution = 0;
+    
+    // Define the geometry of the primitive if it has not been generated yet
+    auto mesh = Renderer::GetPrimitiveLibrary()->Get(typeid(VertexData), type, resolution, [&]()
+    {
+        std::vector<VertexData> vertices;
+        std::vector<unsigned int> indices;
+        switch (type)
+        {
+            case PrimitiveGeometry::Plane:
+                DefinePlaneGeometry(vertices, indices);
+                break;
+            case PrimitiveGeometry::Cube:
+                DefineCubeGeometry(vertices, indices);
+                break;
+            case PrimitiveGeometry::Sphere:
+                DefineSphereGeometry(vertices, indices, resolution);
+                break;
+        }
+        
+        auto primitive = std::make_shared<Mesh<VertexData>>();
+        primitive->SetResidency(MeshResidency::Discard);
+        primitive->DefineMesh(vertices, indices, BufferLayoutGeometry(vertices));
+        return std::shared_ptr<void>(primitive);
+    });
+    
+    return *std::static_pointer_cast<Mesh<VertexData>>(mesh);
+}
+
+/**
+ * Generate a model of a procedural primitive using the specified material.
+ *
+ * @tparam VertexData The type of vertex data used to define the geometry.
+ *
+ * @param type The type of primitive.
+ * @param material A shared pointer to the material to be applied to the model.
+ * @param resolution The number of segments of the primitive (only used for the sphere).
+ *
+ * @return The generated model, sharing the cached geometry of the primitive.
+ */
+template<typename VertexData>
+inline std::shared_ptr<Model<VertexData>>
+    GeneratePrimitiveModel(const PrimitiveGeometry &type, const std::shared_ptr<Material>& material,
+                           int resolution = 32)
+{
+    Mesh<VertexData> mesh = PrimitiveMesh<VertexData>(type, resolution);
+    
+    if (material)
+        mesh.SetMaterial(material);
+    
+    return std::make_shared<Model<VertexData>>(mesh);
+}
+
 /**
  * Generate a model for a plane using the specified material.
  *
@@ -118,7 +194,7 @@ template<typename VertexData>
 inline std::shared_ptr<Model<VertexData>>
     ModelPlane(const std::shared_ptr<Material>& material = nullptr)
 {
-    return GenerateModel<VertexData>(utils::Geometry::DefinePlaneGeometry, material);
+    return GeneratePrimitiveModel<VertexData>(PrimitiveGeometry::Plane, material);
 }
 
 /**
@@ -134,7 +210,7 @@ template<typename VertexData>
 inline std::shared_ptr<Model<VertexData>>
     ModelCube(const std::shared_ptr<Material>& material = nullptr)
 {
-    return GenerateModel<VertexData>(utils::Geometry::DefineCubeGeometry, material);
+    return GeneratePrimitiveModel<VertexData>(PrimitiveGeometry::Cube, material);
 }
 
 /**
@@ -143,17 +219,15 @@ inline std::shared_ptr<Model<VertexData>>
  * @tparam VertexData The type of vertex data used to define the geometry.
  *
  * @param material A shared pointer to the material to be applied to the model.
- * @param radius The radius of the sphere.
- * @param sectorCount The number of sectors (longitude divisions) in the sphere.
- * @param stackCount The number of stacks (latitude divisions) in the sphere.
+ * @param resolution The number of horizontal and vertical segments of the sphere.
  *
  * @return The generated model for the sphere with the specified material.
  */
 template<typename VertexData>
 inline std::shared_ptr<Model<VertexData>>
-    ModelSphere(const std::shared_ptr<Material>& material = nullptr)
+    ModelSphere(const std::shared_ptr<Material>& material = nullptr, int resolution = 32)
 {
-    return GenerateModel<VertexData>(utils::Geometry::DefineSphereGeometry, material);
+    return GeneratePrimitiveModel<VertexData>(PrimitiveGeometry::Sphere, material, resolution);
 }
 
 } // namespace Geometry
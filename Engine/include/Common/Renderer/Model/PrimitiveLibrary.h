@@ -0,0 +1,68 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <typeindex>
+
+/**
+ * Enumeration of the procedural primitives that can be generated.
+ */
+enum class PrimitiveGeometry
+{
+    Plane, Cube, Sphere
+};
+
+/**
+ * Represents a library of the meshes generated for the procedural primitives.
+ *
+ * The `PrimitiveLibrary` class keeps the mesh of each primitive generated, keyed by the type of
+ * vertex data, the primitive type and its resolution, so it is only generated once. The meshes
+ * are stored without their type (see `utils::Geometry::PrimitiveMesh()`), and the library is
+ * owned by the renderer, so the meshes are released with the other GPU resources.
+ *
+ * The library can be accessed from several threads.
+ */
+class PrimitiveLibrary
+{
+public:
+    // Constructor(s)
+    // ----------------------------------------
+    /// @brief Create a new primitive library.
+    PrimitiveLibrary() = default;
+    
+    // Loading
+    // ----------------------------------------
+    std::shared_ptr<void> Get(const std::type_index& vertex, const PrimitiveGeometry type,
+                              const int resolution,
+                              const std::function<std::shared_ptr<void>()>& generate);
+    
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the number of meshes generated.
+    /// @return The mesh count.
+    size_t GetCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Meshes.size();
+    }
+    
+    // Primitive library variables
+    // ----------------------------------------
+private:
+    ///< Meshes generated, indexed by the vertex data type, primitive type and resolution.
+    std::map<std::tuple<std::type_index, PrimitiveGeometry, int>, std::shared_ptr<void>> m_Meshes;
+    ///< Mutex guarding the meshes.
+    mutable std::mutex m_Mutex;
+    
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    PrimitiveLibrary(const PrimitiveLibrary&) = delete;
+    PrimitiveLibrary(PrimitiveLibrary&&) = delete;
+
+    PrimitiveLibrary& operator=(const PrimitiveLibrary&) = delete;
+    PrimitiveLibrary& operator=(PrimitiveLibrary&&) = delete;
+};
@@ -1,18 +1,31 @@
 #pragma once
 
+#include "Common/Core/ThreadPool.h"
+
 #include "Common/Renderer/RendererAPI.h"
 #include "Common/Renderer/RendererUtils.h"
 
 #include "Common/Renderer/Buffer/VertexArray.h"
 #include "Common/Renderer/Buffer/IndexBuffer.h"
 #include "Common/Renderer/Buffer/FrameBuffer.h"
+#include "Common/Renderer/Buffer/StorageBuffer.h"
+#include "Common/Renderer/Buffer/BufferPool.h"
+#include "Common/Renderer/Buffer/RingBuffer.h"
+
+#include "Common/Renderer/Texture/TextureLibrary.h"
+#include "Common/Renderer/Texture/TextureLoader.h"
+#include "Common/Renderer/Texture/TextureResidency.h"
 
 #include "Common/Renderer/Material/Material.h"
+#include "Common/Renderer/Model/PrimitiveLibrary.h"
+#include "Common/Renderer/Shader/ComputeShader.h"
 
 #include "Common/Renderer/Camera/Camera.h"
 
 #include <glm/glm.hpp>
 
+#include <optional>
+
 /**
  * Responsible for rendering geometry using a specified shader program.
  *
@@ -26,6 +39,12 @@ public:
     // Initialization
     // ----------------------------------------
     static void Init();
+    static void Shutdown();
+    
+    // Frame
+    // ----------------------------------------
+    static void BeginFrame();
+    static void EndFrame();
     
     // Scene parametrization
     // ----------------------------------------
@@ -40,17 +59,71 @@ public:
     static void Clear(const BufferState& buffersActive = {});
     static void Clear(const glm::vec4& color, const BufferState& buffersActive = {});
     static void Draw(const std::shared_ptr<VertexArray>& vao,
-                     const PrimitiveType &primitive = PrimitiveType::Triangles);
+                     const PrimitiveType &primitive = PrimitiveType::Triangles,
+                     const std::vector<IndexRange> &ranges = {});
     static void Draw(const std::shared_ptr<VertexArray>& vao,
               const std::shared_ptr<Material>& material,
               const glm::mat4 &transform = glm::mat4(1.0f),
-              const PrimitiveType &primitive = PrimitiveType::Triangles);
+              const PrimitiveType &primitive = PrimitiveType::Triangles,
+              const std::vector<IndexRange> &ranges = {});
+    static void DrawIndirect(const std::shared_ptr<VertexArray>& vao,
+                             const StorageBuffer& commands, const unsigned int maxCount,
+                             const StorageBuffer* drawCount = nullptr,
+                             const PrimitiveType &primitive = PrimitiveType::Triangles);
+    static void DrawIndirect(const std::shared_ptr<VertexArray>& vao,
+                             const std::shared_ptr<Material>& material,
+                             const StorageBuffer& commands, const unsigned int maxCount,
+                             const StorageBuffer* drawCount = nullptr,
+                             const glm::mat4 &transform = glm::mat4(1.0f),
+                             const PrimitiveType &primitive = PrimitiveType::Triangles);
+    
+    // Compute
+    // ----------------------------------------
+    static void Dispatch(const std::shared_ptr<ComputeShader>& shader, const glm::uvec3& groups,
+                         const BarrierState& barriers = {});
+    static void Barrier(const BarrierState& barriers = {});
     
     // Getters(s)
     // ----------------------------------------
     static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
     
     static MaterialLibrary& GetMaterialLibrary() { return s_MaterialLibrary; }
+    
+    /// @brief Get the pool storing the data of the vertex buffers.
+    /// @return The vertex pool.
+    static const std::shared_ptr<BufferPool>& GetVertexPool() { return s_VertexPool; }
+    /// @brief Get the pool storing the data of the index buffers.
+    /// @return The index pool.
+    static const std::shared_ptr<BufferPool>& GetIndexPool() { return s_IndexPool; }
+    /// @brief Get the loader of the textures decoded asynchronously.
+    /// @return The texture loader.
+    static const std::shared_ptr<TextureLoader>& GetTextureLoader() { return s_TextureLoader; }
+    /// @brief Get the library sharing the textures loaded from files.
+    /// @return The texture library.
+    static const std::shared_ptr<TextureLibrary>& GetTextureLibrary() { return s_TextureLibrary; }
+    /// @brief Get the workers running the CPU work split across threads (e.g. rasterization or
+    /// image conversions), not to be waited for from its own tasks.
+    /// @return The thread pool (null before the initialization).
+    static const std::shared_ptr<ThreadPool>& GetThreadPool() { return s_ThreadPool; }
+    /// @brief Get the library sharing the meshes of the procedural primitives.
+    /// @return The primitive library.
+    static const std::shared_ptr<PrimitiveLibrary>& GetPrimitiveLibrary() { return s_PrimitiveLibrary; }
+    
+    /// @brief Get the view position of the scene being rendered.
+    /// @return The view position.
+    static const glm::vec3& GetViewPosition() { return s_SceneData->ViewPosition; }
+    /// @brief Get the view matrix of the scene being rendered.
+    /// @return The view matrix.
+    static const glm::mat4& GetViewMatrix() { return s_SceneData->ViewMatrix; }
+    /// @brief Get the projection matrix of the scene being rendered.
+    /// @return The projection matrix.
+    static const glm::mat4& GetProjectionMatrix() { return s_SceneData->ProjectionMatrix; }
+    /// @brief Get the faces discarded by the face culling.
+    /// @return The culled faces, or no value if the face culling is disabled.
+    static std::optional<FaceCulling> GetFaceCulling()
+    {
+        return s_FaceCullingEnabled ? std::optional<FaceCulling>(s_FaceCulling) : std::nullopt;
+    }
 
     // Setter(s)
     // ----------------------------------------
@@ -59,6 +132,7 @@ public:
     static void SetDepthTesting(const bool enabled);
     static void SetDepthFunction(const DepthFunction depth);
     static void SetFaceCulling(const FaceCulling culling);
+    static void SetFaceCullingEnabled(const bool enabled);
     static void SetCubeMapSeamless(const bool enabled);
     
     // Statistics
@@ -72,11 +146,51 @@ public:
         unsigned int renderPasses = 0;
         ///< Number of times the draw function is called.
         unsigned int drawCalls = 0;
+        ///< Number of times a compute shader is dispatched.
+        unsigned int dispatchCalls = 0;
     };
     
     static void ResetStats();
     static RenderingStatistics GetStats();
     
+    // Memory
+    // ----------------------------------------
+    static void CompactBuffers();
+    
+    // Capabilities
+    // ----------------------------------------
+    /**
+     * Represents the optional features supported by the current graphics context.
+     */
+    struct RendererCapabilities
+    {
+        ///< Compute shaders and shader storage buffers (OpenGL 4.3).
+        bool computeShaders = false;
+        ///< Draw count sourced from a buffer (`glMultiDrawElementsIndirectCount`).
+        bool indirectCount = false;
+        ///< Draw parameters available in the vertex shader (`gl_BaseInstance`, `gl_DrawID`).
+        bool drawParameters = false;
+        ///< Immutable storage that can stay mapped while used by the GPU (`glBufferStorage`).
+        bool bufferStorage = false;
+        ///< Objects edited without being bound, with immutable storage (OpenGL 4.5).
+        bool directStateAccess = false;
+        ///< Copies between textures on the GPU (`glCopyImageSubData`, OpenGL 4.3).
+        bool copyImage = false;
+        ///< S3TC block-compressed textures (BC1, BC3).
+        bool textureCompressionS3TC = false;
+        ///< BPTC block-compressed textures (BC7, OpenGL 4.2).
+        bool textureCompressionBPTC = false;
+    };
+    
+    /// @brief Get the optional features supported by the current graphics context.
+    /// @return The renderer capabilities.
+    static const RendererCapabilities& GetCapabilities() { return s_Capabilities; }
+    
+private:
+    // Material
+    // ----------------------------------------
+    static void PrepareMaterial(const std::shared_ptr<Material>& material, const glm::mat4 &transform);
+    
     // Renderer Structures
     // ----------------------------------------
 private:
@@ -94,6 +208,24 @@ private:
         glm::mat4 ProjectionMatrix = glm::mat4(1.0f);
     };
     
+    /**
+     * Represents the transformation matrices of a draw, with the layout of the `Transform`
+     * uniform block (std140, so the normal matrix columns are padded to four components).
+     */
+    struct TransformData
+    {
+        ///< Model matrix.
+        glm::mat4 Model = glm::mat4(1.0f);
+        ///< View matrix.
+        glm::mat4 View = glm::mat4(1.0f);
+        ///< Projection matrix.
+        glm::mat4 Projection = glm::mat4(1.0f);
+        ///< Normal matrix.
+        glm::mat3x4 Normal = glm::mat3x4(1.0f);
+        ///< Texture matrix (shadow sampling).
+        glm::mat4 Texture = glm::mat4(1.0f);
+    };
+    
     // Renderer variables
     // ----------------------------------------
 private:
@@ -102,4 +234,24 @@ private:
     
     ///< Rendering libraries.
     static inline MaterialLibrary s_MaterialLibrary;
+    
+    ///< Memory pools of the geometry buffers.
+    static inline std::shared_ptr<BufferPool> s_VertexPool;
+    static inline std::shared_ptr<BufferPool> s_IndexPool;
+    ///< Asynchronous loader of the textures.
+    static inline std::shared_ptr<TextureLoader> s_TextureLoader;
+    static inline std::shared_ptr<TextureLibrary> s_TextureLibrary;
+    ///< Per-draw transformation matrices streamed to the GPU.
+    static inline std::unique_ptr<RingBuffer> s_TransformRing;
+    ///< Meshes of the procedural primitives.
+    static inline std::shared_ptr<PrimitiveLibrary> s_PrimitiveLibrary;
+    ///< Workers of the CPU work split across threads.
+    static inline std::shared_ptr<ThreadPool> s_ThreadPool;
+    
+    ///< Features supported by the graphics context.
+    static inline RendererCapabilities s_Capabilities;
+    
+    ///< Face culling state.
+    static inline bool s_FaceCullingEnabled = false;
+    static inline FaceCulling s_FaceCulling = FaceCulling::Back;
 };
@@ -32,8 +32,70 @@ enum class DepthFunction
     Always, Never, Less, Equal, LEqual, Greater, NotEqual, GEqual,
 };
 
+/**
+ * Represents a contiguous range of elements inside an index buffer.
+ */
+struct IndexRange
+{
+    unsigned int offset = 0;    ///< First index of the range.
+    unsigned int count = 0;     ///< Number of indices in the range.
+};
+
+/**
+ * Structure to represent the memory written by the shaders (storage buffers, images) that must
+ * be visible to the operations that follow (memory barrier).
+ */
+struct BarrierState
+{
+    // Constructor(s)
+    // ----------------------------------------
+    /// @brief Generate a barrier state with predefined accesses to be synchronized.
+    /// @param storage Whether the shader storage accesses are synchronized (default: true).
+    /// @param command Whether the indirect command reads are synchronized (default: false).
+    /// @param texture Whether the texture fetches are synchronized (default: false).
+    /// @param image Whether the image load/store accesses are synchronized (default: false).
+    /// @param buffer Whether the buffer reads/writes from the CPU are synchronized (default: false).
+    BarrierState(bool storage = true, bool command = false, bool texture = false,
+                 bool image = false, bool buffer = false)
+        : storageAccess(storage), commandRead(command), textureFetch(texture),
+          imageAccess(image), bufferUpdate(buffer)
+    {}
+    
+    // Barrier state variables
+    // ----------------------------------------
+    bool storageAccess;     ///< Indicates whether the shader storage accesses are synchronized.
+    bool commandRead;       ///< Indicates whether the indirect command reads are synchronized.
+    bool textureFetch;      ///< Indicates whether the texture fetches are synchronized.
+    bool imageAccess;       ///< Indicates whether the image load/store accesses are synchronized.
+    bool bufferUpdate;      ///< Indicates whether the buffer reads/writes (e.g. mapping) are synchronized.
+};
+
 namespace utils { namespace OpenGL
 {
+/**
+ * Convert the barrier state to its corresponding OpenGL mask.
+ *
+ * @param barriers State of the barriers.
+ *
+ * @return Bitwise OR of the barrier bits to be applied.
+ */
+inline GLbitfield BarrierStateToOpenGLMask(const BarrierState& barriers)
+{
+    GLbitfield mask = 0;
+    if (barriers.storageAccess)
+        mask |= GL_SHADER_STORAGE_BARRIER_BIT;
+    if (barriers.commandRead)
+        mask |= GL_COMMAND_BARRIER_BIT;
+    if (barriers.textureFetch)
+        mask |= GL_TEXTURE_FETCH_BARRIER_BIT;
+    if (barriers.imageAccess)
+        mask |= GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+    if (barriers.bufferUpdate)
+        mask |= GL_BUFFER_UPDATE_BARRIER_BIT | GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT;
+    
+    return mask;
+}
+
 /**
  * Convert a PrimitiveType value to the corresponding OpenGL primitive type.
  *
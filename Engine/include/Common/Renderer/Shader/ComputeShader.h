@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Common/Renderer/Shader/Shader.h"
+
+#include <glm/glm.hpp>
+
+/**
+ * Represents a compute program executed on the GPU outside of the graphics pipeline.
+ *
+ * The `ComputeShader` class loads a shader file with a single `#shader compute` section and
+ * provides the information to dispatch it (the size of its work groups). The uniforms are
+ * defined through the underlying shader program, and the dispatch is performed with
+ * `Renderer::Dispatch()`.
+ *
+ * Copying or moving `ComputeShader` objects is disabled to ensure single ownership and prevent
+ * unintended shader duplication.
+ */
+class ComputeShader
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    ComputeShader(const std::string& name, const std::filesystem::path& filePath);
+    ComputeShader(const std::filesystem::path& filePath);
+    /// @brief Delete the compute shader.
+    ~ComputeShader() = default;
+
+    // Usage
+    // ----------------------------------------
+    /// @brief Activate the compute shader.
+    void Bind() const { m_Shader->Bind(); }
+    /// @brief Deactivate the compute shader.
+    void Unbind() const { m_Shader->Unbind(); }
+
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the shader program (e.g. to define its uniforms).
+    /// @return The shader program.
+    const std::shared_ptr<Shader>& GetShader() const { return m_Shader; }
+    /// @brief Get the size of the work groups declared by the shader.
+    /// @return The number of invocations in each dimension of a work group.
+    const glm::uvec3& GetWorkGroupSize() const { return m_WorkGroupSize; }
+    glm::uvec3 GetGroupCount(const glm::uvec3& invocations) const;
+
+    // Compute shader variables
+    // ----------------------------------------
+private:
+    ///< Shader program.
+    std::shared_ptr<Shader> m_Shader;
+    ///< Size of the work groups.
+    glm::uvec3 m_WorkGroupSize = glm::uvec3(1);
+
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    ComputeShader(const ComputeShader&) = delete;
+    ComputeShader(ComputeShader&&) = delete;
+
+    ComputeShader& operator=(const ComputeShader&) = delete;
+    ComputeShader& operator=(ComputeShader&&) = delete;
+};
@@ -4,6 +4,14 @@
 
 #include <glm/glm.hpp>
 
+/**
+ * Enumeration of the binding points of the uniform blocks shared by the shaders.
+ */
+enum class UniformBinding : unsigned int
+{
+    Transform = 0,  ///< Transformation matrices of the draw (`Transform` block).
+};
+
 /**
  * Represents a shader program executed on the GPU.
  *
@@ -36,6 +44,9 @@ public:
     /// @brief Get the name that identifies the shader.
     /// @return The shader's name.
     const std::string& GetName() const { return m_Name; }
+    /// @brief Get the size of the work groups (only defined for compute shaders).
+    /// @return The number of invocations in each dimension of a work group.
+    virtual glm::uvec3 GetWorkGroupSize() const { return glm::uvec3(1); }
     
     // Setter(s)
     // ----------------------------------------
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Common/Renderer/Texture/MipmapGenerator.h"
+#include "Common/Renderer/Texture/TextureUtils.h"
+
+#include <cstdint>
+
+/**
+ * Converts floating-point HDR images into compact formats on the CPU.
+ *
+ * The `HDRConverter` class packs the 32-bit float images decoded from HDR files (e.g. the
+ * environment maps) into the shared exponent format (`TextureFormat::RGB9E5`, 4 bytes per texel)
+ * or into half-floats (`TextureFormat::RGB16H`, 6 bytes per texel), instead of uploading 12 bytes
+ * per texel and letting the driver convert them. Both the video memory and the bytes uploaded
+ * shrink accordingly, and the float image can be released as soon as it has been converted.
+ *
+ * Since the mipmaps of the shared exponent format cannot be generated by the driver (it is not
+ * color-renderable), the converted data contains the complete mip chain if specified, filtered
+ * by the `MipmapGenerator` in floating-point space before converting each level. The rows of each
+ * level are split between the calling thread and the thread pool of the renderer, and the packing
+ * uses SIMD instructions when available.
+ *
+ * Negative and NaN values are converted to zero, and the values above the range of the format are
+ * clamped to its largest value.
+ */
+class HDRConverter
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    HDRConverter(const TextureFormat format = TextureFormat::RGB9E5, const unsigned int threads = 0);
+    
+    // Conversion
+    // ----------------------------------------
+    std::vector<std::vector<uint8_t>> Convert(const float *data, const int width, const int height,
+                                              const int channels, const bool mipmaps = true) const;
+    
+    static bool IsSupported(const TextureFormat format);
+    
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the format of the converted data.
+    /// @return The texture format.
+    TextureFormat GetFormat() const { return m_Format; }
+    /// @brief Get the number of threads converting each level.
+    /// @return The thread count.
+    unsigned int GetThreadCount() const { return m_Threads; }
+    /// @brief Get the settings filtering the mipmaps.
+    /// @return The mipmap settings.
+    const MipmapSettings& GetMipmapSettings() const { return m_Mipmaps; }
+    
+    // Setter(s)
+    // ----------------------------------------
+    /// @brief Change the format of the converted data.
+    /// @param format The texture format (`RGB9E5` or `RGB16H`).
+    void SetFormat(const TextureFormat format) { m_Format = format; }
+    /// @brief Change the settings filtering the mipmaps (using the threads of the converter if unset).
+    /// @param settings The mipmap settings.
+    void SetMipmapSettings(const MipmapSettings& settings) { m_Mipmaps = settings; }
+
+private:
+    // Levels
+    // ----------------------------------------
+    void ConvertLevel(const float *image, const int width, const int height, const int channels,
+                      uint8_t *output) const;
+    
+    // HDR converter variables
+    // ----------------------------------------
+private:
+    ///< Format of the converted data.
+    TextureFormat m_Format = TextureFormat::RGB9E5;
+    ///< Number of threads converting each level.
+    unsigned int m_Threads = 1;
+    ///< Settings filtering the mipmaps.
+    MipmapSettings m_Mipmaps;
+};
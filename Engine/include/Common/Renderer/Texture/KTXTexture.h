@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Common/Core/MappedFile.h"
+
+#include "Common/Renderer/Texture/MipmapGenerator.h"
+#include "Common/Renderer/Texture/Texture.h"
+#include "Common/Renderer/Texture/Texture2D.h"
+#include "Common/Renderer/Texture/TextureEncoder.h"
+
+#include <cstdint>
+
+/**
+ * Reads and writes textures stored in the KTX2 container format.
+ *
+ * The `KTXTexture` class holds the levels of a texture exactly as they are uploaded, so textures
+ * imported once (see `Import()`) are loaded without decoding their images nor generating their
+ * mipmaps at runtime. The files are memory-mapped, and their levels are read directly from the
+ * mapping unless they have to be transformed first: levels supercompressed with zstd are
+ * decompressed (only if the engine is built with zstd), and 16-bit float levels are expanded to
+ * the 32-bit floats uploaded by the textures.
+ *
+ * Both 2D textures and cube maps (six faces) are supported, with uncompressed 8-bit, 16-bit float
+ * and 32-bit float formats, the packed HDR formats (RGB9E5, and the half floats read back as
+ * 16-bit floats), and the block-compressed formats (BC1, BC3, BC4, BC5 and BC7). The
+ * sRGB variants are read as their linear counterparts, like the other images of the engine.
+ *
+ * Copying or moving `KTXTexture` objects is disabled to ensure single ownership of the mapping.
+ */
+class KTXTexture
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    KTXTexture() = default;
+    KTXTexture(const TextureSpecification& spec, const unsigned int levels, const unsigned int faces = 1);
+    
+    // Reading/Writing
+    // ----------------------------------------
+    bool Load(const std::filesystem::path& filePath);
+    bool Save(const std::filesystem::path& filePath, const bool supercompress = false) const;
+    
+    static bool Import(const std::filesystem::path& source, const std::filesystem::path& destination,
+                       const TextureLoadOptions& options = TextureLoadOptions(),
+                       const bool compress = false,
+                       const EncoderQuality quality = EncoderQuality::High,
+                       const bool supercompress = false,
+                       const MipmapSettings& mipmaps = MipmapSettings());
+    
+    // Levels
+    // ----------------------------------------
+    void SetLevel(const unsigned int level, const void *data, const unsigned int face = 0);
+    const void* GetLevel(const unsigned int level, const unsigned int face = 0) const;
+    size_t GetLevelSize(const unsigned int level) const;
+    
+    void UpdateSpecification(TextureSpecification& spec) const;
+    
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the size of the base level.
+    /// @return The width (in texels).
+    int GetWidth() const { return m_Width; }
+    /// @brief Get the size of the base level.
+    /// @return The height (in texels).
+    int GetHeight() const { return m_Height; }
+    /// @brief Get the format of the levels.
+    /// @return The texture format.
+    TextureFormat GetFormat() const { return m_Format; }
+    /// @brief Get the number of levels stored.
+    /// @return The level count.
+    unsigned int GetLevelCount() const { return (unsigned int)m_Levels.size(); }
+    /// @brief Get the number of faces (six for cube maps).
+    /// @return The face count.
+    unsigned int GetFaceCount() const { return m_Faces; }
+    /// @brief Check if the mipmaps must be generated at runtime (only the base level is stored).
+    /// @return `true` if the mipmaps are not stored.
+    bool RequiresMipmaps() const { return m_GenerateMipmaps; }
+    /// @brief Check if the rows are stored from the bottom to the top (flipped vertically).
+    /// @return `true` if the texture is flipped.
+    bool IsFlipped() const { return m_Flipped; }
+    
+    size_t GetDataSize() const;
+
+private:
+    // Storage
+    // ----------------------------------------
+    void Allocate(const unsigned int levels);
+    
+    // KTX texture variables
+    // ----------------------------------------
+private:
+    ///< Size of the base level (in texels).
+    int m_Width = 0, m_Height = 0;
+    ///< Format of the levels.
+    TextureFormat m_Format = TextureFormat::None;
+    ///< Number of faces.
+    unsigned int m_Faces = 1;
+    
+    ///< Whether the mipmaps must be generated at runtime.
+    bool m_GenerateMipmaps = false;
+    ///< Whether the rows are stored from the bottom to the top.
+    bool m_Flipped = false;
+    
+    ///< Mapped content of the file read.
+    std::unique_ptr<MappedFile> m_File;
+    ///< Data of each level (all its faces, one after the other).
+    std::vector<const uint8_t*> m_Levels;
+    ///< Levels owned by the texture (written, decompressed or expanded).
+    std::vector<std::vector<uint8_t>> m_Storage;
+    
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    KTXTexture(const KTXTexture&) = delete;
+    KTXTexture(KTXTexture&&) = delete;
+    
+    KTXTexture& operator=(const KTXTexture&) = delete;
+    KTXTexture& operator=(KTXTexture&&) = delete;
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Common/Renderer/Texture/TextureUtils.h"
+
+#include <cstdint>
+
+/**
+ * Enumeration of the filters used to downsample the mipmaps.
+ */
+enum class MipmapFilter
+{
+    Box,        ///< Average of 2x2 texels (fast, but blurry and prone to aliasing).
+    Kaiser      ///< Kaiser-windowed sinc over 6x6 texels (sharper, without visible aliasing).
+};
+
+/**
+ * Represents the settings used to generate the mipmaps of a texture.
+ */
+struct MipmapSettings
+{
+    ///< Filter downsampling each level.
+    MipmapFilter Filter = MipmapFilter::Kaiser;
+    ///< Whether the color channels of 8-bit images are sRGB encoded (filtered in linear space).
+    bool SRGB = false;
+    ///< Whether the texels wrap around the edges (repeated textures).
+    bool Wrap = false;
+    ///< Alpha test threshold whose coverage is preserved in every level (disabled if zero).
+    float AlphaCutoff = 0.0f;
+    ///< Number of threads filtering each level (the calling thread and the renderer pool if zero).
+    unsigned int Threads = 0;
+};
+
+/**
+ * Generates the mipmaps of images on the CPU.
+ *
+ * The `MipmapGenerator` class replaces the driver generation (`glGenerateMipmap`), whose filter
+ * depends on the driver and can be very slow on software implementations, so the mipmaps can be
+ * built when a texture is imported or decoded. The levels are filtered in linear floating-point
+ * space (converting the sRGB colors if specified), each level being downsampled from the previous
+ * one before it is quantized, and the rows of each level are split among several threads. The
+ * separable filter uses SIMD instructions when available.
+ *
+ * The 8-bit formats (R8 to RGBA8) and the float formats are supported. Negative lobes of the
+ * Kaiser filter are clamped, so bright HDR texels never produce negative values around them.
+ */
+class MipmapGenerator
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    MipmapGenerator(const MipmapSettings& settings = MipmapSettings());
+    
+    // Generation
+    // ----------------------------------------
+    std::vector<std::vector<uint8_t>> Generate(const void *data, const int width, const int height,
+                                               const TextureFormat format) const;
+    
+    static bool IsSupported(const TextureFormat format);
+    
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the settings of the generation.
+    /// @return The mipmap settings.
+    const MipmapSettings& GetSettings() const { return m_Settings; }
+    
+    // Setter(s)
+    // ----------------------------------------
+    /// @brief Change the settings of the generation.
+    /// @param settings The mipmap settings.
+    void SetSettings(const MipmapSettings& settings) { m_Settings = settings; }
+
+private:
+    // Filtering
+    // ----------------------------------------
+    std::vector<float> Downsample(const std::vector<float>& image, const int width, const int height) const;
+    
+    // Mipmap generator variables
+    // ----------------------------------------
+private:
+    ///< Settings of the generation.
+    MipmapSettings m_Settings;
+};
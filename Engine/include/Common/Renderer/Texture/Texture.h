@@ -18,6 +18,7 @@ enum class TextureType
     TEXTURE2D,
     TEXTURE3D,
     TEXTURECUBE,
+    TEXTURE2DARRAY,
 };
 
 /**
@@ -92,8 +93,21 @@ struct TextureSpecification
     bool MipMaps = false;
 };
 
+/**
+ * Enumeration of the categories whose video memory is reported separately.
+ */
+enum class TextureCategory
+{
+    Other = 0,      ///< Textures created directly.
+    Material,       ///< Textures loaded from image files (e.g. material maps).
+    Environment,    ///< Cube maps (e.g. skyboxes and environment maps).
+    Attachment,     ///< Attachments of the framebuffers (never reduced).
+    Virtual         ///< Caches and page tables of the virtual textures (never reduced).
+};
+
 // Forward declarations
 class FrameBuffer;
+class TextureResidency;
 
 /**
  * Represents a texture that can be bound to geometry during rendering.
@@ -102,6 +116,13 @@ class FrameBuffer;
  * Textures can be bound to specific texture slots for use in a `Shader`. The class supports
  * loading texture data with specified specifications using the `TextureSpecification` struct.
  *
+ * When the context supports direct state access (OpenGL 4.5), the textures are created with
+ * immutable storage and edited without being bound, so their creation does not disturb the
+ * bound state. Otherwise, they are bound while being edited.
+ *
+ * Every texture is accounted by the `TextureResidency` manager, which may drop the top levels of
+ * the textures not bound recently when the video memory exceeds its budget.
+ *
  * Copying or moving `Texture` objects is disabled to ensure single ownership and prevent
  * unintended texture duplication.
  */
@@ -118,9 +139,26 @@ public:
     void BindToTextureUnit(const unsigned int slot) const;
     void Unbind() const;
     
+    // Getter(s)
+    // ----------------------------------------
+    virtual size_t GetMemorySize() const;
+    /// @brief Get the category of the texture (reported in the memory statistics).
+    /// @return The texture category.
+    TextureCategory GetCategory() const { return m_Category; }
+    /// @brief Get the last frame in which the texture was bound to a texture unit.
+    /// @return The frame index.
+    uint64_t GetLastBoundFrame() const { return m_LastBound; }
+    
+    // Setter(s)
+    // ----------------------------------------
+    /// @brief Change the category of the texture.
+    /// @param category The texture category.
+    void SetCategory(const TextureCategory category) { m_Category = category; }
+    
     // Friend class definition(s)
     // ----------------------------------------
     friend class FrameBuffer;
+    friend class TextureResidency;
     
 protected:
     // Constructor(s)
@@ -136,6 +174,35 @@ protected:
     // ----------------------------------------
     virtual void CreateTexture(const void *data) = 0;
     
+    void BeginCreation();
+    void EndCreation() const;
+    
+    void SetParameter(const GLenum name, const GLint value) const;
+    void SetParameter(const GLenum name, const float *value) const;
+    void GenerateMipmaps() const;
+    void SetCompressedData(const TextureSpecification& spec, const void *data, const int face = -1) const;
+    void SetLevelData(const TextureSpecification& spec, const unsigned int level, const void *data,
+                      const int face = -1) const;
+    
+    static unsigned int GetMipLevels(const TextureSpecification& spec);
+    static bool UseDirectStateAccess();
+    
+    // Residency
+    // ----------------------------------------
+    /// @brief Check if the top levels of the texture can be dropped to release memory.
+    /// @return `true` if the texture can be reduced.
+    virtual bool CanDropLevels() const { return false; }
+    /// @brief Get the number of top levels dropped.
+    /// @return The dropped level count.
+    virtual unsigned int GetDroppedLevels() const { return 0; }
+    /// @brief Drop the top levels of the texture (restored later from its source).
+    /// @param count The number of levels dropped.
+    /// @return `true` if the levels have been dropped.
+    virtual bool DropLevels(const unsigned int count) { return false; }
+    /// @brief Restore the levels dropped from the texture (possibly asynchronously).
+    /// @return `true` if the levels have been (or are being) restored.
+    virtual bool RestoreLevels() { return false; }
+    
     // Destructor
     // ----------------------------------------
     void ReleaseTexture();
@@ -148,6 +215,11 @@ protected:
     ///< Texture properties.
     TextureSpecification m_Spec;
     
+    ///< Category of the texture.
+    TextureCategory m_Category = TextureCategory::Other;
+    ///< Last frame in which the texture was bound to a texture unit.
+    mutable uint64_t m_LastBound = 0;
+    
     // Disable the copying or moving of this resource
     // ----------------------------------------
 public:
@@ -4,6 +4,7 @@
 #include "Common/Renderer/Texture/Texture.h"
 
 #include <filesystem>
+#include <memory>
 
 /**
  * Represents a 2D texture that can be bound to geometry during rendering.
@@ -25,6 +26,17 @@ public:
     Texture2D(const TextureSpecification& spec, const int& samples = 1);
     Texture2D(const void *data, const TextureSpecification& spec, const int& samples = 1);
     
+    // Update
+    // ----------------------------------------
+    void SetData(const void *data);
+    void SetLevels(const std::vector<const void *>& levels);
+    void SetSubData(const int x, const int y, const int width, const int height, const void *data,
+                    const unsigned int level = 0);
+    
+    // Getter(s)
+    // ----------------------------------------
+    size_t GetMemorySize() const override;
+    
 protected:
     // Target type
     // ----------------------------------------
@@ -34,12 +46,23 @@ protected:
     // ----------------------------------------
     void CreateTexture(const void *data) override;
     
+    // Residency
+    // ----------------------------------------
+    bool CanCopyLevels() const;
+    /// @brief Get the number of top levels dropped.
+    /// @return The dropped level count.
+    unsigned int GetDroppedLevels() const override { return m_DroppedLevels; }
+    bool DropLevels(const unsigned int count) override;
+    
     // Texture variables
     // ----------------------------------------
 protected:
     ///< The number of samples in the texture.
     int m_Samples = 1;
     
+    ///< Number of top levels dropped from the texture.
+    unsigned int m_DroppedLevels = 0;
+    
     // Disable the copying or moving of this resource
     // ----------------------------------------
 public:
@@ -52,6 +75,7 @@ public:
 
 // Forward declarations
 class Texture2DResource;
+class TextureLoader;
 
 /**
  * Utility functions related to texture operations.
@@ -64,6 +88,23 @@ inline bool TextureLoader(std::shared_ptr<Texture2DResource> &texture,
 } // namespace Draw
 } // namespace utils
 
+/**
+ * Represents the options used to load a texture from an image file.
+ */
+struct TextureLoadOptions
+{
+    ///< Flip the image vertically.
+    bool Flip = true;
+    ///< Whether the color channels are sRGB encoded (their mipmaps are filtered in linear space).
+    bool SRGB = false;
+    ///< Compressed format requested (automatic if none or not supported).
+    TextureFormat Format = TextureFormat::None;
+    ///< Packed format the HDR images are converted into (uploaded as floats if none).
+    TextureFormat HDRFormat = TextureFormat::RGB9E5;
+    ///< Multiply the color channels of the 8-bit images by their alpha.
+    bool Premultiply = false;
+};
+
 /**
  * Represents a (loaded) 2D texture used to add details to rendered geometry.
  *
@@ -72,18 +113,27 @@ inline bool TextureLoader(std::shared_ptr<Texture2DResource> &texture,
  * The class supports loading textures from file paths, binding them to specific texture slots for
  * use in a `Shader`, and unbinding them after they have been used.
  *
+ * When the texture residency drops its top levels, they are restored by decoding the file again
+ * through the texture loader (see `RestoreLevels()`), so the textures must be owned by a shared
+ * pointer to be reduced.
+ *
  * Copying or moving `Texture2DResource` objects is disabled to ensure single ownership
  * and prevent unintended texture duplication.
  */
-class Texture2DResource : public Texture2D
+class Texture2DResource : public Texture2D, public std::enable_shared_from_this<Texture2DResource>
 {
 public:
     // Constructor(s)/Destructor
     // ----------------------------------------
     Texture2DResource(const std::filesystem::path& filePath, bool flip = true);
+    Texture2DResource(const std::filesystem::path& filePath, const TextureLoadOptions& options);
     
     // Getter(s)
     // ----------------------------------------
+    /// @brief Check if the texture data has been loaded (textures loaded asynchronously use a
+    /// 1x1 fallback until then).
+    /// @return `true` if the texture contains the data of the file.
+    bool IsLoaded() const { return m_Loaded; }
     /// @brief Get the file path of the texture.
     /// @return The path to the file.
     std::filesystem::path GetPath() const { return m_FilePath; }
@@ -93,17 +143,38 @@ public:
     /// @brief Get the directory where the texture file is located.
     /// @return The directory of the texture.
     std::string GetDirectory() { return m_FilePath.parent_path().string(); }
+    /// @brief Get the packed format the HDR images are converted into.
+    /// @return The texture format (none if uploaded as floats).
+    static TextureFormat GetHDRFormat() { return s_HDRFormat; }
+    
+    // Setter(s)
+    // ----------------------------------------
+    /// @brief Change the packed format the HDR images loaded from now on are converted into.
+    /// @param format The texture format (`RGB9E5` or `RGB16H`), none to upload the floats.
+    static void SetHDRFormat(const TextureFormat format) { s_HDRFormat = format; }
     
     // Friend class definition(s)
     // ----------------------------------------
     friend bool utils::Draw::TextureLoader(std::shared_ptr<Texture2DResource> &texture,
                                            std::filesystem::path &name, const char *label,
                                            const char *filter, const bool &flip);
+    friend class TextureLoader;
         
 private:
+    // Constructor(s)
+    // ----------------------------------------
+    Texture2DResource(const std::filesystem::path& filePath, const TextureLoadOptions& options,
+                      const void *fallback, const TextureSpecification& spec);
+    
+    // Residency
+    // ----------------------------------------
+    bool CanDropLevels() const override;
+    bool RestoreLevels() override;
+    
     // Loading
     // ----------------------------------------
     void LoadFromFile(const std::filesystem::path& filePath);
+    void LoadFromContainer(const std::filesystem::path& filePath);
     
     // Texture variables
     // ----------------------------------------
@@ -111,8 +182,15 @@ private:
     ///< Path to the file.
     std::filesystem::path m_FilePath;
     
-    ///< Texture flipping.
-    bool m_Flip;
+    ///< Options decoding the file (used again to restore the levels dropped).
+    TextureLoadOptions m_Options;
+    ///< Whether the data of the file has been loaded.
+    bool m_Loaded = false;
+    ///< Whether the file is being decoded again to restore the levels dropped.
+    bool m_Restoring = false;
+    
+    ///< Packed format the HDR images are converted into.
+    static inline TextureFormat s_HDRFormat = TextureFormat::RGB9E5;
     
     // Disable the copying or moving of this resource
     // ----------------------------------------
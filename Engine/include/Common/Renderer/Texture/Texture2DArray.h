@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Common/Renderer/Texture/TextureUtils.h"
+#include "Common/Renderer/Texture/Texture.h"
+
+/**
+ * Represents an array of 2D textures (layers) with the same size and format.
+ *
+ * The `Texture2DArray` class provides functionality to create, bind, unbind, and update the
+ * layers of a 2D texture array. All the layers are sampled through a single texture binding
+ * (`sampler2DArray` in a `Shader`), using the layer index as the third texture coordinate. The
+ * number of layers is defined by the depth of the texture specification.
+ *
+ * Copying or moving `Texture2DArray` objects is disabled to ensure single ownership and prevent
+ * unintended texture duplication.
+ */
+class Texture2DArray : public Texture
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    Texture2DArray(const TextureSpecification& spec);
+    Texture2DArray(const void *data, const TextureSpecification& spec);
+    
+    // Update
+    // ----------------------------------------
+    void SetLayer(const unsigned int layer, const void *data);
+    void SetRegion(const unsigned int layer, const int x, const int y, const int width,
+                   const int height, const void *data);
+    void UpdateMipmaps() const;
+    
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the number of layers of the array.
+    /// @return The layer count.
+    unsigned int GetLayers() const { return (unsigned int)m_Spec.Depth; }
+    /// @brief Get the texture properties (the depth is the number of layers).
+    /// @return The texture specifications.
+    const TextureSpecification& GetSpecification() const { return m_Spec; }
+    
+protected:
+    // Target type
+    // ----------------------------------------
+    GLenum TextureTarget() const override;
+    
+    // Texture creation
+    // ----------------------------------------
+    void CreateTexture(const void *data) override;
+    
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    Texture2DArray(const Texture2DArray&) = delete;
+    Texture2DArray(Texture2DArray&&) = delete;
+
+    Texture2DArray& operator=(const Texture2DArray&) = delete;
+    Texture2DArray& operator=(Texture2DArray&&) = delete;
+};
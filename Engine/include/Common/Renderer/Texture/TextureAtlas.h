@@ -0,0 +1,205 @@
+#pragma once
+
+#include "Common/Renderer/Texture/Texture2DArray.h"
+
+#include <glm/glm.hpp>
+
+#include <tuple>
+
+/**
+ * Represents the location of a texture packed into a texture array.
+ *
+ * The texture coordinates of the texture are remapped into the layer with the transform
+ * (`uv * transform.xy + transform.zw`). Textures with a layer of their own use the identity
+ * transform, while the textures packed into an atlas layer are scaled and offset to their region.
+ */
+struct TextureRegion
+{
+    std::shared_ptr<Texture2DArray> array;              ///< Texture array containing the texture.
+    int layer = -1;                                     ///< Layer of the array.
+    glm::vec4 transform = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f); ///< Scale (xy) and offset (zw) of the UVs.
+    
+    /// @brief Check if the texture has been packed.
+    /// @return `true` if the region refers to a layer of a texture array.
+    bool IsValid() const { return array && layer >= 0; }
+    /// @brief Remap texture coordinates (in the [0, 1] range) into the layer.
+    /// @param uv The texture coordinates of the texture.
+    /// @return The texture coordinates in the layer.
+    glm::vec2 Remap(const glm::vec2& uv) const
+    {
+        return uv * glm::vec2(transform.x, transform.y) + glm::vec2(transform.z, transform.w);
+    }
+};
+
+/**
+ * Packs rectangles into a fixed size area, following the top edge (skyline) of the packed ones.
+ *
+ * The `SkylinePacker` class keeps the skyline as a list of horizontal segments and places each
+ * rectangle at the position where its top edge is the lowest (bottom-left heuristic), which
+ * wastes little space when the rectangles are packed from the tallest to the shortest.
+ */
+class SkylinePacker
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    SkylinePacker(const int width = 0, const int height = 0);
+    
+    // Packing
+    // ----------------------------------------
+    bool Pack(const int width, const int height, glm::ivec2& position);
+    void Reset();
+    
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the fraction of the area covered by the packed rectangles.
+    /// @return The occupancy (between 0 and 1).
+    float GetOccupancy() const
+    {
+        return m_Width > 0 && m_Height > 0 ? (float)m_Area / ((float)m_Width * (float)m_Height) : 0.0f;
+    }
+    
+private:
+    // Skyline
+    // ----------------------------------------
+    int Fit(const size_t index, const int width, const int height) const;
+    
+    /**
+     * Represents a horizontal segment of the skyline.
+     */
+    struct Segment
+    {
+        int x = 0;      ///< Left edge of the segment.
+        int y = 0;      ///< Height of the segment.
+        int width = 0;  ///< Width of the segment.
+    };
+    
+    // Skyline packer variables
+    // ----------------------------------------
+private:
+    ///< Size of the packing area.
+    int m_Width = 0, m_Height = 0;
+    ///< Area covered by the packed rectangles.
+    size_t m_Area = 0;
+    ///< Segments of the skyline (from left to right).
+    std::vector<Segment> m_Skyline;
+};
+
+/**
+ * Manages the texture arrays used to share a single texture binding between materials.
+ *
+ * The `TextureAtlas` class packs the textures into layers of `Texture2DArray` objects, grouped by
+ * size and format, so the materials sampling them only differ by the layer index (and UV
+ * transform) and can be drawn one after another without binding other textures. Small textures
+ * are packed together into atlas layers with a skyline packer, adding a padding around each one
+ * (replicating its edges) to limit the bleeding of their neighbours when filtering.
+ *
+ * Since the atlas textures do not cover their whole layer, repeated texture coordinates must be
+ * wrapped in the shader before being remapped (see `PhongTextureArrayMaterial.glsl`).
+ *
+ * Copying or moving `TextureAtlas` objects is disabled to ensure single ownership and prevent
+ * unintended texture duplication.
+ */
+class TextureAtlas
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    TextureAtlas(const unsigned int atlasSize = 1024, const unsigned int threshold = 256,
+                 const unsigned int layers = 8);
+    
+    // Packing
+    // ----------------------------------------
+    TextureRegion Add(const void *data, const TextureSpecification& spec);
+    TextureRegion Load(const std::filesystem::path& filePath, bool flip = true);
+    
+    void Update();
+    
+    // Statistics
+    // ----------------------------------------
+    /**
+     * Represents the information related to the statistics of the texture atlas.
+     */
+    struct AtlasStatistics
+    {
+        ///< Number of texture arrays created.
+        unsigned int arrays = 0;
+        ///< Number of layers in use.
+        unsigned int layers = 0;
+        ///< Number of textures packed into atlas layers.
+        unsigned int atlasTextures = 0;
+        ///< Number of textures with a layer of their own.
+        unsigned int layerTextures = 0;
+        ///< Average occupancy of the atlas layers (between 0 and 1).
+        float occupancy = 0.0f;
+    };
+    
+    AtlasStatistics GetStats() const;
+    
+private:
+    // Layers
+    // ----------------------------------------
+    TextureRegion AllocateLayer(const TextureSpecification& spec, const bool atlas);
+    TextureRegion AddToAtlas(const void *data, const TextureSpecification& spec);
+    
+    // Texture atlas structures
+    // ----------------------------------------
+private:
+    ///< Arrays with the same size and format (and whether they are atlases).
+    using ArrayKey = std::tuple<int, int, TextureFormat, bool>;
+    
+    /**
+     * Represents the arrays with the same size and format.
+     */
+    struct ArrayGroup
+    {
+        ///< Arrays of the group (all full except the last one).
+        std::vector<std::shared_ptr<Texture2DArray>> arrays;
+        ///< Layers in use of the last array.
+        unsigned int used = 0;
+    };
+    
+    /**
+     * Represents an atlas layer, shared by several small textures.
+     */
+    struct AtlasPage
+    {
+        ///< Layer of the atlas.
+        TextureRegion region;
+        ///< Packer of the layer area.
+        SkylinePacker packer;
+    };
+    
+    // Texture atlas variables
+    // ----------------------------------------
+private:
+    ///< Size of the atlas layers (in pixels).
+    unsigned int m_AtlasSize = 1024;
+    ///< Largest size of the textures packed into atlas layers (in pixels).
+    unsigned int m_Threshold = 256;
+    ///< Number of layers of each texture array.
+    unsigned int m_Layers = 8;
+    ///< Padding around the atlas textures (in pixels).
+    unsigned int m_Padding = 4;
+    
+    ///< Texture arrays, grouped by size and format.
+    std::map<ArrayKey, ArrayGroup> m_Groups;
+    ///< Atlas layers of each format.
+    std::map<TextureFormat, std::vector<AtlasPage>> m_Pages;
+    ///< Arrays updated since their mipmaps were generated.
+    std::vector<std::shared_ptr<Texture2DArray>> m_Modified;
+    
+    ///< Number of textures packed into atlas layers.
+    unsigned int m_AtlasTextures = 0;
+    ///< Number of textures with a layer of their own.
+    unsigned int m_LayerTextures = 0;
+    
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas(TextureAtlas&&) = delete;
+
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(TextureAtlas&&) = delete;
+};
@@ -27,6 +27,10 @@ public:
     TextureCube(const void *data, const TextureSpecification& spec);
     TextureCube(const std::vector<const void *>& data, const TextureSpecification& spec);
     
+    // Getter(s)
+    // ----------------------------------------
+    size_t GetMemorySize() const override;
+    
 protected:
     // Target type
     // ----------------------------------------
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Common/Renderer/Texture/MipmapGenerator.h"
+#include "Common/Renderer/Texture/TextureUtils.h"
+
+#include <cstdint>
+
+/**
+ * Enumeration of the trade-offs between the speed and the quality of the block compression.
+ */
+enum class EncoderQuality
+{
+    Fast,   ///< Endpoints from the bounding box of each block (suited for loading at runtime).
+    High    ///< Endpoints fitted to the principal axis and refined with least squares (offline).
+};
+
+/**
+ * Compresses images into block-compressed texture formats on the CPU.
+ *
+ * The `TextureEncoder` class encodes 8-bit images into the BC1, BC3, BC4, BC5 and BC7 formats,
+ * which are read directly by the GPU at a fraction of the memory (and bandwidth) of the
+ * uncompressed images. The blocks of each level are split between the calling thread and the
+ * thread pool of the renderer, and the palette matching of the color blocks uses SIMD
+ * instructions when available.
+ *
+ * Since the mipmaps of compressed textures cannot be generated by the driver, the encoded data
+ * contains the complete mip chain if specified, filtered by the `MipmapGenerator` before encoding
+ * each level (see `SetMipmapSettings()`).
+ *
+ * BC7 blocks are always encoded with mode 6 (a single subset with RGBA endpoints and 4-bit
+ * indices), which keeps the encoder fast while outperforming BC1/BC3 on smooth gradients.
+ */
+class TextureEncoder
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    TextureEncoder(const EncoderQuality quality = EncoderQuality::Fast, const unsigned int threads = 0);
+    
+    // Encoding
+    // ----------------------------------------
+    std::vector<uint8_t> Encode(const void *data, const int width, const int height,
+                                const int channels, const TextureFormat format,
+                                const bool mipmaps = true) const;
+    
+    static TextureFormat SelectFormat(const int channels, const EncoderQuality quality);
+    static bool IsSupported(const TextureFormat format);
+    
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the quality of the encoding.
+    /// @return The encoder quality.
+    EncoderQuality GetQuality() const { return m_Quality; }
+    /// @brief Get the number of threads encoding each level.
+    /// @return The thread count.
+    unsigned int GetThreadCount() const { return m_Threads; }
+    /// @brief Get the settings filtering the mipmaps.
+    /// @return The mipmap settings.
+    const MipmapSettings& GetMipmapSettings() const { return m_Mipmaps; }
+    
+    // Setter(s)
+    // ----------------------------------------
+    /// @brief Change the quality of the encoding.
+    /// @param quality The encoder quality.
+    void SetQuality(const EncoderQuality quality) { m_Quality = quality; }
+    /// @brief Change the settings filtering the mipmaps (using the threads of the encoder if unset).
+    /// @param settings The mipmap settings.
+    void SetMipmapSettings(const MipmapSettings& settings) { m_Mipmaps = settings; }
+
+private:
+    // Levels
+    // ----------------------------------------
+    void EncodeLevel(const uint8_t *image, const int width, const int height,
+                     const TextureFormat format, uint8_t *output) const;
+    
+    // Texture encoder variables
+    // ----------------------------------------
+private:
+    ///< Quality of the encoding.
+    EncoderQuality m_Quality = EncoderQuality::Fast;
+    ///< Number of threads encoding each level.
+    unsigned int m_Threads = 1;
+    ///< Settings filtering the mipmaps.
+    MipmapSettings m_Mipmaps;
+};
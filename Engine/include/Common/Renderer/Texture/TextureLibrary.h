@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Common/Core/Library.h"
+
+#include "Common/Renderer/Texture/Texture2D.h"
+#include "Common/Renderer/Texture/TextureLoader.h"
+
+/**
+ * Represents a library of textures loaded from image files.
+ *
+ * The `TextureLibrary` class shares the textures loaded from the same file with the same options,
+ * so a file referenced by many materials is only decoded and uploaded once. The textures are
+ * identified by the canonical path of their file and the options used to load them (see
+ * `TextureLoadOptions`), and are loaded by the texture loader if defined (or directly otherwise,
+ * with the same options).
+ *
+ * The library holds a reference to each texture, so they stay loaded until `Collect()` evicts
+ * the ones not referenced anywhere else (e.g. after changing the scene).
+ */
+class TextureLibrary : public Library<std::shared_ptr<Texture2DResource>>
+{
+public:
+    // Constructor(s)
+    // ----------------------------------------
+    TextureLibrary(const std::shared_ptr<TextureLoader>& loader = nullptr);
+    
+    // Loading
+    // ----------------------------------------
+    std::shared_ptr<Texture2DResource> Load(const std::filesystem::path& filePath,
+                                            const TextureLoadOptions& options = TextureLoadOptions());
+    
+    // Eviction
+    // ----------------------------------------
+    size_t Collect();
+    
+    // Statistics
+    // ----------------------------------------
+    /**
+     * Represents the information related to the statistics of the texture library.
+     */
+    struct LibraryStatistics
+    {
+        ///< Number of textures in the library.
+        unsigned int textures = 0;
+        ///< Number of references to the textures (outside of the library).
+        unsigned int references = 0;
+        ///< Video memory used by the textures (in bytes).
+        size_t memory = 0;
+        ///< Number of requests served by a texture already loaded (since the creation).
+        unsigned int hits = 0;
+        ///< Number of textures loaded (since the creation).
+        unsigned int loads = 0;
+        ///< Number of textures evicted (since the creation).
+        unsigned int evictions = 0;
+    };
+    
+    LibraryStatistics GetStats() const;
+
+private:
+    // Keys
+    // ----------------------------------------
+    static std::string GetKey(const std::filesystem::path& filePath, const TextureLoadOptions& options);
+    
+    // Texture library variables
+    // ----------------------------------------
+private:
+    ///< Loader decoding the image files (asynchronously).
+    std::shared_ptr<TextureLoader> m_Loader;
+    
+    ///< Statistics of the texture library (counters only).
+    LibraryStatistics m_Stats;
+};
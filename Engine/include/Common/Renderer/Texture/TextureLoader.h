@@ -0,0 +1,213 @@
+#pragma once
+
+#include "Common/Core/ThreadPool.h"
+
+#include "Common/Renderer/Buffer/RingBuffer.h"
+#include "Common/Renderer/Texture/HDRConverter.h"
+#include "Common/Renderer/Texture/KTXTexture.h"
+#include "Common/Renderer/Texture/Texture2D.h"
+#include "Common/Renderer/Texture/TextureEncoder.h"
+
+#include <atomic>
+#include <deque>
+
+/**
+ * Loads 2D textures from image files without stalling the rendering thread.
+ *
+ * The `TextureLoader` class returns the textures immediately, showing a 1x1 fallback texture
+ * until their data is ready. The image files are decoded by worker threads, which also expand the
+ * 8-bit images into RGBA while flipping them (see `utils::Pixels`), so the driver never converts
+ * the data uploaded. The decoded images are uploaded on the rendering thread by `Update()`,
+ * once per frame. The uploads are copied into a ring of pixel unpack buffers, so the driver reads
+ * them asynchronously, and the bytes uploaded each frame are limited by a budget (at least one
+ * image is uploaded per frame, the larger ones directly from the decoded memory).
+ *
+ * Optionally, the 8-bit color images are also block-compressed by the worker threads (see
+ * `TextureEncoder`), reducing both their memory and the bytes uploaded. The mipmaps of the other
+ * images can also be generated by the worker threads (see `MipmapGenerator`) instead of the driver.
+ * The HDR images are converted by the worker threads into a packed format with all their mipmaps
+ * (see `HDRConverter`), releasing their float data before they wait for the upload.
+ *
+ * The textures keep their load options, so their files can be decoded again (see `Reload()`),
+ * e.g. to restore the levels dropped by the texture residency, replacing their data once uploaded.
+ *
+ * KTX2 files are read directly, with their pre-built mipmaps. If importing is enabled, the source
+ * images are also converted once into KTX2 files next to them (named after the image and the
+ * options changing their content), which are loaded instead as long as they are more recent than
+ * the images.
+ *
+ * Copying or moving `TextureLoader` objects is disabled to ensure single ownership of the workers
+ * and the upload buffers.
+ */
+class TextureLoader
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    TextureLoader(const unsigned int budget = 16 * 1024 * 1024, const unsigned int threads = 2);
+    ~TextureLoader();
+    
+    // Loading
+    // ----------------------------------------
+    std::shared_ptr<Texture2DResource> Load(const std::filesystem::path& filePath, bool flip = true);
+    std::shared_ptr<Texture2DResource> Load(const std::filesystem::path& filePath,
+                                            const TextureLoadOptions& options);
+    void Reload(const std::shared_ptr<Texture2DResource>& texture);
+    void Update();
+    
+    // Setter(s)
+    // ----------------------------------------
+    /// @brief Enable the block compression of the images loaded from now on.
+    /// @param enabled Compress the images on the worker threads.
+    /// @param quality The quality of the encoding.
+    void SetCompression(const bool enabled, const EncoderQuality quality = EncoderQuality::Fast)
+    {
+        m_Compression = enabled;
+        m_Quality = quality;
+    }
+    /// @brief Enable the conversion of the source images into KTX2 files loaded from then on.
+    /// @param enabled Import the images on the worker threads.
+    void SetImport(const bool enabled) { m_Import = enabled; }
+    /// @brief Enable the generation of the mipmaps on the worker threads (instead of the driver).
+    /// @param enabled Generate the mipmaps of the uncompressed images on the CPU.
+    /// @param settings The settings filtering the mipmaps.
+    void SetMipmapGeneration(const bool enabled, const MipmapSettings& settings = MipmapSettings())
+    {
+        m_MipmapGeneration = enabled;
+        m_Mipmaps = settings;
+    }
+    
+    // Getter(s)
+    // ----------------------------------------
+    unsigned int GetPendingCount();
+    /// @brief Get the maximum number of bytes uploaded each frame.
+    /// @return The upload budget (in bytes).
+    unsigned int GetBudget() const { return m_Budget; }
+    
+    // Statistics
+    // ----------------------------------------
+    /**
+     * Represents the information related to the statistics of the texture loader.
+     */
+    struct LoaderStatistics
+    {
+        ///< Number of textures uploaded in the last frame.
+        unsigned int uploads = 0;
+        ///< Number of bytes uploaded in the last frame.
+        size_t bytes = 0;
+        ///< Number of textures decoding or waiting to be uploaded.
+        unsigned int pending = 0;
+        ///< Number of textures that could not be loaded (since the creation of the loader).
+        unsigned int failed = 0;
+        ///< Time spent uploading in the last frame (in milliseconds).
+        float uploadTime = 0.0f;
+    };
+    
+    /// @brief Get the statistics of the last update.
+    /// @return The texture loader statistics.
+    const LoaderStatistics& GetStats() const { return m_Stats; }
+    
+private:
+    // Texture loader structures
+    // ----------------------------------------
+    /**
+     * Represents an image decoded by a worker thread.
+     */
+    struct DecodedImage
+    {
+        ///< Texture waiting for the image.
+        std::weak_ptr<Texture2DResource> texture;
+        ///< Decoded data (nullptr if the file could not be decoded).
+        void* data = nullptr;
+        ///< Size of the image (in pixels) and number of channels.
+        int width = 0, height = 0, channels = 0;
+        ///< Extension of the image file.
+        std::string extension;
+        
+        ///< Compressed levels (replacing the decoded data if the image has been compressed).
+        std::vector<uint8_t> compressed;
+        ///< Format of the compressed (or converted) levels.
+        TextureFormat format = TextureFormat::None;
+        
+        ///< Converted base level (replacing the decoded data if the image has been expanded into
+        ///< RGBA, or if the HDR image has been packed).
+        std::vector<uint8_t> converted;
+        
+        ///< Mipmaps generated after the decoded data (level 1 first).
+        std::vector<std::vector<uint8_t>> mipmaps;
+        
+        ///< Levels read from a KTX2 file (replacing the decoded data).
+        std::shared_ptr<KTXTexture> container;
+        
+        /// @brief Check if the image has been loaded.
+        /// @return `true` if the image contains data to be uploaded.
+        bool IsValid() const
+        {
+            return data != nullptr || !compressed.empty() || !converted.empty() || container;
+        }
+        /// @brief Get the number of bytes uploaded for the image.
+        /// @return The size of the data (in bytes).
+        size_t GetSize() const
+        {
+            if (container)
+                return container->GetDataSize();
+            if (!compressed.empty())
+                return compressed.size();
+            size_t size = !converted.empty() ? converted.size() :
+                (size_t)width * height * channels * (extension == ".hdr" ? sizeof(float) : 1);
+            for (const auto& level : mipmaps)
+                size += level.size();
+            return size;
+        }
+    };
+    
+    // Decoding
+    // ----------------------------------------
+    void Decode(const std::weak_ptr<Texture2DResource>& target, const std::filesystem::path& filePath,
+                const TextureLoadOptions& options);
+    
+    // Upload
+    // ----------------------------------------
+    bool Upload(Texture2DResource& texture, const DecodedImage& image);
+    bool UploadContainer(Texture2DResource& texture, const KTXTexture& container);
+    
+    // Texture loader variables
+    // ----------------------------------------
+private:
+    ///< Worker threads decoding the image files.
+    std::unique_ptr<ThreadPool> m_Workers;
+    ///< Ring of pixel unpack buffers (one region per frame in flight).
+    std::unique_ptr<RingBuffer> m_Staging;
+    ///< Maximum number of bytes uploaded each frame.
+    unsigned int m_Budget = 0;
+    
+    ///< Whether the images are compressed by the workers.
+    bool m_Compression = false;
+    ///< Quality of the compression.
+    EncoderQuality m_Quality = EncoderQuality::Fast;
+    ///< Whether the source images are imported into KTX2 files.
+    bool m_Import = false;
+    ///< Whether the mipmaps are generated by the workers.
+    bool m_MipmapGeneration = false;
+    ///< Settings filtering the mipmaps generated.
+    MipmapSettings m_Mipmaps;
+    
+    ///< Decoded images waiting to be uploaded.
+    std::deque<DecodedImage> m_Decoded;
+    ///< Mutex guarding the decoded images.
+    std::mutex m_Mutex;
+    ///< Number of images being decoded.
+    std::atomic<unsigned int> m_Decoding = 0;
+    
+    ///< Statistics of the texture loader.
+    LoaderStatistics m_Stats;
+    
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    TextureLoader(const TextureLoader&) = delete;
+    TextureLoader(TextureLoader&&) = delete;
+
+    TextureLoader& operator=(const TextureLoader&) = delete;
+    TextureLoader& operator=(TextureLoader&&) = delete;
+};
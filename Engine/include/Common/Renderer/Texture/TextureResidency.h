@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Common/Renderer/Texture/Texture.h"
+
+#include <cstdint>
+
+/**
+ * Keeps the video memory used by the textures within a budget.
+ *
+ * The `TextureResidency` class accounts the memory of every texture (including the attachments
+ * of the framebuffers) by category. When the memory exceeds the budget, the top levels of the
+ * textures bound least recently (see `Texture::BindToTextureUnit()`) are dropped, one level at a
+ * time, copying the remaining levels on the GPU (nothing is read back). The levels dropped are
+ * restored from their source once the textures are bound again, as long as they fit in the budget:
+ * the files are decoded again by the texture loader (or their KTX2 levels mapped again), and
+ * uploaded through its pixel unpack buffers.
+ *
+ * Only single sample 2D textures with mipmaps loaded from a file are reduced (never the framebuffer
+ * attachments nor the virtual textures, which stream their own tiles), and a few textures are
+ * updated each frame to avoid stalls. Without a budget (the default), the memory is only accounted.
+ */
+class TextureResidency
+{
+public:
+    // Residency
+    // ----------------------------------------
+    static void Update();
+    
+    static void Register(Texture *texture);
+    static void Unregister(Texture *texture);
+    
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the index of the current frame (incremented by each update).
+    /// @return The frame index.
+    static uint64_t GetFrame() { return s_Frame; }
+    /// @brief Get the maximum video memory used by the textures.
+    /// @return The budget (in bytes), zero if unlimited.
+    static size_t GetBudget() { return s_Budget; }
+    
+    // Setter(s)
+    // ----------------------------------------
+    /// @brief Change the maximum video memory used by the textures.
+    /// @param budget The budget (in bytes), zero if unlimited.
+    static void SetBudget(const size_t budget) { s_Budget = budget; }
+    
+    // Statistics
+    // ----------------------------------------
+    /**
+     * Represents the information related to the statistics of the texture residency.
+     */
+    struct ResidencyStatistics
+    {
+        ///< Video memory used by the textures (in bytes).
+        size_t used = 0;
+        ///< Video memory used by each category of textures (in bytes).
+        std::array<size_t, 5> categories = {};
+        ///< Number of textures accounted.
+        unsigned int textures = 0;
+        ///< Number of textures with dropped levels.
+        unsigned int reduced = 0;
+        ///< Number of levels dropped in the last update.
+        unsigned int dropped = 0;
+        ///< Number of textures restored in the last update.
+        unsigned int restored = 0;
+    };
+    
+    /// @brief Get the statistics of the last update.
+    /// @return The texture residency statistics.
+    static const ResidencyStatistics& GetStats() { return s_Stats; }
+    
+    // Texture residency variables
+    // ----------------------------------------
+private:
+    ///< Index of the current frame.
+    static inline uint64_t s_Frame = 0;
+    ///< Maximum video memory used by the textures (unlimited if zero).
+    static inline size_t s_Budget = 0;
+    
+    ///< Statistics of the texture residency.
+    static ResidencyStatistics s_Stats;
+};
+
+/**
+ * Utility functions related to texture operations.
+ */
+namespace utils {
+/// @brief Namespace containing utility functions for texturing operations.
+namespace Texturing {
+
+/**
+ * Get the name of a texture category.
+ *
+ * @param category The texture category.
+ *
+ * @return The name of the category.
+ */
+inline const char* TextureCategoryToString(const TextureCategory category)
+{
+    switch (category)
+    {
+        case TextureCategory::Other: return "Other";
+        case TextureCategory::Material: return "Material";
+        case TextureCategory::Environment: return "Environment";
+        case TextureCategory::Attachment: return "Attachment";
+        case TextureCategory::Virtual: return "Virtual";
+    }
+    return "Unknown";
+}
+
+} // namespace Texturing
+} // namespace utils
@@ -2,6 +2,10 @@
 
 #include <GL/glew.h>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
 /**
  * Enumeration of internal texture formats used for specifying pixel formats in textures.
  *
@@ -28,12 +32,23 @@ enum class TextureFormat
     RGB32F,             ///< 32-bit float per channel, 96-bit total (HDR, no alpha)
     RGBA32F,            ///< 32-bit float per channel, 128-bit total (HDR color texture)
     
+    // Packed HDR formats (uploaded from packed data instead of floats)
+    RGB9E5,             ///< 9-bit mantissa per channel with a shared 5-bit exponent, 32-bit total (HDR, no alpha)
+    RGB16H,             ///< 16-bit half-float per channel, 48-bit total, uploaded from half-floats (HDR, no alpha)
+    
     // Integer formats
     R8UI,               ///< 8-bit unsigned integer (usually used for IDs)
     RG8UI,              ///< 8-bit unsigned integer per channel (two channels, IDs)
     RGB8UI,             ///< 8-bit unsigned integer per channel (three channels, IDs)
     RGBA8UI,            ///< 8-bit unsigned integer per channel (four channels, IDs)
     
+    // Compressed formats (4x4 texel blocks)
+    BC1,                ///< 4 bits per texel, RGB (S3TC DXT1, opaque color maps)
+    BC3,                ///< 8 bits per texel, RGBA (S3TC DXT5, color maps with alpha)
+    BC4,                ///< 4 bits per texel, single channel (RGTC1, masks and roughness)
+    BC5,                ///< 8 bits per texel, two channels (RGTC2, tangent-space normal maps)
+    BC7,                ///< 8 bits per texel, RGBA (BPTC, high quality color maps)
+    
     // Depth/stencil formats
     DEPTH16,             ///< 8-bit depth (depth buffer)
     DEPTH24,             ///< 24-bit depth (depth buffer)
@@ -106,7 +121,9 @@ inline GLenum TextureFormatToOpenGLBaseType(TextureFormat format)
         case TextureFormat::RG32F: return GL_RG;
         case TextureFormat::RGB8:
         case TextureFormat::RGB16F:
-        case TextureFormat::RGB32F: return GL_RGB;
+        case TextureFormat::RGB32F:
+        case TextureFormat::RGB9E5:
+        case TextureFormat::RGB16H: return GL_RGB;
         case TextureFormat::RGBA8:
         case TextureFormat::RGBA16F:
         case TextureFormat::RGBA32F: return GL_RGBA;
@@ -116,6 +133,12 @@ inline GLenum TextureFormatToOpenGLBaseType(TextureFormat format)
         case TextureFormat::RGB8UI: return GL_RGB_INTEGER;
         case TextureFormat::RGBA8UI: return GL_RGBA_INTEGER;
             
+        case TextureFormat::BC4: return GL_RED;
+        case TextureFormat::BC5: return GL_RG;
+        case TextureFormat::BC1: return GL_RGB;
+        case TextureFormat::BC3:
+        case TextureFormat::BC7: return GL_RGBA;
+            
         case TextureFormat::DEPTH16: return GL_DEPTH_COMPONENT16;
         case TextureFormat::DEPTH24: return GL_DEPTH_COMPONENT24;
         case TextureFormat::DEPTH32: return GL_DEPTH_COMPONENT32;
@@ -144,7 +167,7 @@ inline GLenum TextureFormatToOpenGLInternalType(TextureFormat format)
         case TextureFormat::R8: return GL_R8;
         case TextureFormat::RG8: return GL_RG8;
         case TextureFormat::RGB8: return GL_RGB8;
-        case TextureFormat::RGBA8: return GL_RGBA16;
+        case TextureFormat::RGBA8: return GL_RGBA8;
             
         case TextureFormat::R16F: return GL_R16F;
         case TextureFormat::RG16F: return GL_RG16F;
@@ -156,11 +179,20 @@ inline GLenum TextureFormatToOpenGLInternalType(TextureFormat format)
         case TextureFormat::RGB32F: return GL_RGB32F;
         case TextureFormat::RGBA32F: return GL_RGBA32F;
             
+        case TextureFormat::RGB9E5: return GL_RGB9_E5;
+        case TextureFormat::RGB16H: return GL_RGB16F;
+            
         case TextureFormat::R8UI: return GL_R8UI;
         case TextureFormat::RG8UI: return GL_RG8UI;
         case TextureFormat::RGB8UI: return GL_RGB8UI;
         case TextureFormat::RGBA8UI: return GL_RGBA8UI;
             
+        case TextureFormat::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case TextureFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case TextureFormat::BC4: return GL_COMPRESSED_RED_RGTC1;
+        case TextureFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+        case TextureFormat::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+            
         case TextureFormat::DEPTH16:
         case TextureFormat::DEPTH24:
         case TextureFormat::DEPTH32:
@@ -172,6 +204,61 @@ inline GLenum TextureFormatToOpenGLInternalType(TextureFormat format)
     return 0;
 }
 
+/**
+ * Convert the texture format to its corresponding OpenGL sized format, used to allocate the
+ * immutable storage of the textures.
+ *
+ * @param format The texture format.
+ *
+ * @return OpenGL texture (sized) format.
+ *
+ * @note If the input format is not recognized, the function will assert with an error.
+ */
+inline GLenum TextureFormatToOpenGLStorageType(TextureFormat format)
+{
+    switch (format)
+    {
+        case TextureFormat::None: return 0;
+        case TextureFormat::R8: return GL_R8;
+        case TextureFormat::RG8: return GL_RG8;
+        case TextureFormat::RGB8: return GL_RGB8;
+        case TextureFormat::RGBA8: return GL_RGBA8;
+            
+        case TextureFormat::R16F: return GL_R16F;
+        case TextureFormat::RG16F: return GL_RG16F;
+        case TextureFormat::RGB16F: return GL_RGB16F;
+        case TextureFormat::RGBA16F: return GL_RGBA16F;
+            
+        case TextureFormat::R32F: return GL_R32F;
+        case TextureFormat::RG32F: return GL_RG32F;
+        case TextureFormat::RGB32F: return GL_RGB32F;
+        case TextureFormat::RGBA32F: return GL_RGBA32F;
+            
+        case TextureFormat::RGB9E5: return GL_RGB9_E5;
+        case TextureFormat::RGB16H: return GL_RGB16F;
+            
+        case TextureFormat::R8UI: return GL_R8UI;
+        case TextureFormat::RG8UI: return GL_RG8UI;
+        case TextureFormat::RGB8UI: return GL_RGB8UI;
+        case TextureFormat::RGBA8UI: return GL_RGBA8UI;
+            
+        case TextureFormat::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case TextureFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case TextureFormat::BC4: return GL_COMPRESSED_RED_RGTC1;
+        case TextureFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+        case TextureFormat::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+            
+        case TextureFormat::DEPTH16: return GL_DEPTH_COMPONENT16;
+        case TextureFormat::DEPTH24: return GL_DEPTH_COMPONENT24;
+        case TextureFormat::DEPTH32: return GL_DEPTH_COMPONENT32;
+        case TextureFormat::DEPTH32F: return GL_DEPTH_COMPONENT32F;
+        case TextureFormat::DEPTH24STENCIL8: return GL_DEPTH24_STENCIL8;
+    }
+    
+    CORE_ASSERT(false, "Unknown texture format!");
+    return 0;
+}
+
 /**
  * Convert the texture format to its corresponding OpenGL (pixel) data type.
  *
@@ -193,7 +280,13 @@ inline GLenum TextureFormatToOpenGLDataType(TextureFormat format)
         case TextureFormat::R8UI:
         case TextureFormat::RG8UI:
         case TextureFormat::RGB8UI:
-        case TextureFormat::RGBA8UI: return GL_UNSIGNED_BYTE;
+        case TextureFormat::RGBA8UI:
+        
+        case TextureFormat::BC1:
+        case TextureFormat::BC3:
+        case TextureFormat::BC4:
+        case TextureFormat::BC5:
+        case TextureFormat::BC7: return GL_UNSIGNED_BYTE;
             
         case TextureFormat::DEPTH16:
         case TextureFormat::DEPTH24:
@@ -210,6 +303,9 @@ inline GLenum TextureFormatToOpenGLDataType(TextureFormat format)
         case TextureFormat::RGB32F:
         case TextureFormat::RGBA32F:
         case TextureFormat::DEPTH32F: return GL_FLOAT;
+            
+        case TextureFormat::RGB9E5: return GL_UNSIGNED_INT_5_9_9_9_REV;
+        case TextureFormat::RGB16H: return GL_HALF_FLOAT;
     }
     
     CORE_ASSERT(false, "Unknown texture format!");
@@ -251,10 +347,19 @@ inline GLenum TextureFormatToOpenGLDepthType(TextureFormat format)
         case TextureFormat::RGB32F:
         case TextureFormat::RGBA32F:
             
+        case TextureFormat::RGB9E5:
+        case TextureFormat::RGB16H:
+            
         case TextureFormat::R8UI:
         case TextureFormat::RG8UI:
         case TextureFormat::RGB8UI:
-        case TextureFormat::RGBA8UI: break;
+        case TextureFormat::RGBA8UI:
+            
+        case TextureFormat::BC1:
+        case TextureFormat::BC3:
+        case TextureFormat::BC4:
+        case TextureFormat::BC5:
+        case TextureFormat::BC7: break;
     }
     
     CORE_ASSERT(false, "Unknown depth texture format!");
@@ -277,22 +382,29 @@ inline int TextureFormatToChannelNumber(TextureFormat format)
         case TextureFormat::R8:
         case TextureFormat::R16F:
         case TextureFormat::R32F:
-        case TextureFormat::R8UI: return 1;
+        case TextureFormat::R8UI:
+        case TextureFormat::BC4: return 1;
             
         case TextureFormat::RG8:
         case TextureFormat::RG16F:
         case TextureFormat::RG32F:
-        case TextureFormat::RG8UI: return 2;
+        case TextureFormat::RG8UI:
+        case TextureFormat::BC5: return 2;
         
         case TextureFormat::RGB32F:
         case TextureFormat::RGB16F:
         case TextureFormat::RGB8:
-        case TextureFormat::RGB8UI: return 3;
+        case TextureFormat::RGB8UI:
+        case TextureFormat::RGB9E5:
+        case TextureFormat::RGB16H:
+        case TextureFormat::BC1: return 3;
             
         case TextureFormat::RGBA32F:
         case TextureFormat::RGBA16F:
         case TextureFormat::RGBA8:
-        case TextureFormat::RGBA8UI: return 4;
+        case TextureFormat::RGBA8UI:
+        case TextureFormat::BC3:
+        case TextureFormat::BC7: return 4;
             
         case TextureFormat::None:
         case TextureFormat::DEPTH16:
@@ -341,16 +453,144 @@ inline bool IsDepthFormat(TextureFormat format)
         case TextureFormat::RGB32F:
         case TextureFormat::RGBA32F:
             
+        case TextureFormat::RGB9E5:
+        case TextureFormat::RGB16H:
+            
         case TextureFormat::R8UI:
         case TextureFormat::RG8UI:
         case TextureFormat::RGB8UI:
-        case TextureFormat::RGBA8UI: return false;
+        case TextureFormat::RGBA8UI:
+            
+        case TextureFormat::BC1:
+        case TextureFormat::BC3:
+        case TextureFormat::BC4:
+        case TextureFormat::BC5:
+        case TextureFormat::BC7: return false;
     }
     
     CORE_ASSERT(false, "Unknown texture format!");
     return false;
 }
 
+/**
+ * Verify if a texture format is block-compressed.
+ *
+ * @param format The texture format.
+ *
+ * @return Whether the format is a compressed format.
+ */
+inline bool IsCompressedFormat(TextureFormat format)
+{
+    return format == TextureFormat::BC1 || format == TextureFormat::BC3 || format == TextureFormat::BC4 ||
+           format == TextureFormat::BC5 || format == TextureFormat::BC7;
+}
+
+/**
+ * Verify if the mipmaps of a texture format can be generated by the driver.
+ *
+ * @param format The texture format.
+ *
+ * @return Whether the format is color-renderable (unlike the shared exponent format) and
+ * uncompressed.
+ */
+inline bool CanGenerateMipmaps(TextureFormat format)
+{
+    return format != TextureFormat::RGB9E5 && !IsCompressedFormat(format);
+}
+
+/**
+ * Define the size of a pixel of the (client) data uploaded for a texture format.
+ *
+ * @param format The texture format.
+ *
+ * @return The pixel size (in bytes), zero for depth and compressed formats.
+ */
+inline unsigned int TextureFormatToPixelSize(TextureFormat format)
+{
+    if (IsDepthFormat(format) || IsCompressedFormat(format))
+        return 0;
+    
+    // The shared exponent format packs the three channels into a single integer
+    GLenum type = TextureFormatToOpenGLDataType(format);
+    if (type == GL_UNSIGNED_INT_5_9_9_9_REV)
+        return sizeof(uint32_t);
+    
+    unsigned int size = type == GL_FLOAT ? sizeof(float) : type == GL_HALF_FLOAT ? sizeof(uint16_t) : 1;
+    return size * (unsigned int)TextureFormatToChannelNumber(format);
+}
+
+/**
+ * Define the size of a 4x4 block of texels for a compressed texture format.
+ *
+ * @param format The texture format.
+ *
+ * @return The block size (in bytes), zero for uncompressed formats.
+ */
+inline unsigned int TextureFormatToBlockSize(TextureFormat format)
+{
+    switch (format)
+    {
+        case TextureFormat::BC1:
+        case TextureFormat::BC4: return 8;
+        case TextureFormat::BC3:
+        case TextureFormat::BC5:
+        case TextureFormat::BC7: return 16;
+        default: return 0;
+    }
+}
+
+/**
+ * Define the size of the data of a texture level.
+ *
+ * @param format The texture format.
+ * @param width The width of the level (in texels).
+ * @param height The height of the level (in texels).
+ *
+ * @return The size of the level (in bytes).
+ */
+inline size_t TextureFormatToImageSize(TextureFormat format, const unsigned int width,
+                                       const unsigned int height)
+{
+    if (IsCompressedFormat(format))
+        return (size_t)((width + 3) / 4) * ((height + 3) / 4) * TextureFormatToBlockSize(format);
+    return (size_t)width * height * TextureFormatToPixelSize(format);
+}
+
+/**
+ * Estimate the video memory used by a texture level (the size of the internal format, which may
+ * differ from the client data, e.g. for half floats).
+ *
+ * @param format The texture format.
+ * @param width The width of the level (in texels).
+ * @param height The height of the level (in texels).
+ *
+ * @return The size of the level in video memory (in bytes).
+ */
+inline size_t TextureFormatToMemorySize(TextureFormat format, const unsigned int width,
+                                        const unsigned int height)
+{
+    if (IsCompressedFormat(format))
+        return TextureFormatToImageSize(format, width, height);
+    
+    size_t texel = 0;
+    switch (format)
+    {
+        case TextureFormat::None: texel = 0; break;
+        case TextureFormat::DEPTH16: texel = 2; break;
+        case TextureFormat::DEPTH24:
+        case TextureFormat::DEPTH32:
+        case TextureFormat::DEPTH32F:
+        case TextureFormat::DEPTH24STENCIL8: texel = 4; break;
+        case TextureFormat::R16F:
+        case TextureFormat::RG16F:
+        case TextureFormat::RGB16F:
+        case TextureFormat::RGBA16F:
+        case TextureFormat::RGB16H: texel = 2 * TextureFormatToChannelNumber(format); break;
+        default: texel = TextureFormatToPixelSize(format); break;
+    }
+    return (size_t)width * height * texel;
+}
+
 /**
  * Convert the texture wrap mode to its corresponding OpenGL type.
  *
@@ -435,12 +675,20 @@ inline void* AllocateBufferForFormat(TextureFormat format, unsigned int bufferSi
         case TextureFormat::R8UI:
         case TextureFormat::RG8UI:
         case TextureFormat::RGB8UI:
-        case TextureFormat::RGBA8UI: return static_cast<void*>(new char[bufferSize]);
+        case TextureFormat::RGBA8UI:
+        case TextureFormat::BC1:
+        case TextureFormat::BC3:
+        case TextureFormat::BC4:
+        case TextureFormat::BC5:
+        case TextureFormat::BC7: return static_cast<void*>(new char[bufferSize]);
             
         case TextureFormat::DEPTH16:
         case TextureFormat::DEPTH24:
         case TextureFormat::DEPTH32:
-        case TextureFormat::DEPTH24STENCIL8: return static_cast<void*>(new int[bufferSize]);
+        case TextureFormat::DEPTH24STENCIL8:
+        case TextureFormat::RGB9E5: return static_cast<void*>(new int[bufferSize]);
+            
+        case TextureFormat::RGB16H: return static_cast<void*>(new uint16_t[bufferSize]);
             
         case TextureFormat::R16F:
         case TextureFormat::RG16F:
@@ -482,6 +730,11 @@ inline void DeallocateBufferForFormat(TextureFormat format, void* buffer)
         case TextureFormat::RG8UI:
         case TextureFormat::RGB8UI:
         case TextureFormat::RGBA8UI:
+        case TextureFormat::BC1:
+        case TextureFormat::BC3:
+        case TextureFormat::BC4:
+        case TextureFormat::BC5:
+        case TextureFormat::BC7:
             delete[] static_cast<char*>(buffer);
             break;
 
@@ -489,8 +742,13 @@ inline void DeallocateBufferForFormat(TextureFormat format, void* buffer)
         case TextureFormat::DEPTH24:
         case TextureFormat::DEPTH32:
         case TextureFormat::DEPTH24STENCIL8:
+        case TextureFormat::RGB9E5:
             delete[] static_cast<int*>(buffer);
             break;
+            
+        case TextureFormat::RGB16H:
+            delete[] static_cast<uint16_t*>(buffer);
+            break;
 
         case TextureFormat::R16F:
         case TextureFormat::RG16F:
@@ -510,4 +768,46 @@ inline void DeallocateBufferForFormat(TextureFormat format, void* buffer)
     }
 }
 
+/// @brief Namespace containing the kernels converting pixel data, selected at runtime for the
+/// SIMD instructions supported by the CPU (with scalar fallbacks).
+namespace Pixels
+{
+/**
+ * Represents the instruction sets supported by the CPU (and the operating system).
+ */
+struct CPUFeatures
+{
+    ///< 128-bit integer and float instructions (always available on x86-64).
+    bool sse2 = false;
+    ///< Byte shuffles.
+    bool ssse3 = false;
+    ///< 256-bit integer instructions and gathers.
+    bool avx2 = false;
+    ///< Conversions between floats and half-floats.
+    bool f16c = false;
+};
+
+const CPUFeatures& GetCPUFeatures();
+
+// Layout
+// ----------------------------------------
+void ExpandToRGBA(const uint8_t *source, const int channels, uint8_t *destination, const size_t texels);
+void ExpandImageToRGBA(const uint8_t *source, const int width, const int height, const int channels,
+                       const bool flip, uint8_t *destination);
+void FlipVertically(void *data, const size_t rowSize, const unsigned int rows);
+void Swizzle(uint8_t *data, const size_t texels, const std::array<uint8_t, 4>& order);
+
+// Color
+// ----------------------------------------
+void SRGBToLinear(const uint8_t *source, float *destination, const size_t count);
+void LinearToSRGB(const float *source, uint8_t *destination, const size_t count);
+void PremultiplyAlpha(uint8_t *data, const size_t texels);
+
+// Floating-point
+// ----------------------------------------
+void FloatToHalf(const float *source, uint16_t *destination, const size_t count);
+void HalfToFloat(const uint16_t *source, float *destination, const size_t count);
+
+} // namespace Pixels
+
 } // namespace utils
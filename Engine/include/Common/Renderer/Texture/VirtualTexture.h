@@ -0,0 +1,253 @@
+#pragma once
+
+#include "Common/Core/MappedFile.h"
+#include "Common/Core/ThreadPool.h"
+
+#include "Common/Renderer/Buffer/FrameBuffer.h"
+#include "Common/Renderer/Buffer/StorageBuffer.h"
+#include "Common/Renderer/Shader/Shader.h"
+#include "Common/Renderer/Texture/MipmapGenerator.h"
+#include "Common/Renderer/Texture/Texture2D.h"
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+
+/**
+ * Represents a texture streamed by tiles from a file larger than the video memory.
+ *
+ * The `VirtualTexture` class keeps only the tiles visible on screen in a cache texture of fixed
+ * size (the budget), so the video memory used is independent of the size of the source. The
+ * tiles are read from a tiled file (see `Import()`), which stores every level of the texture
+ * split into tiles with a border (so they are filtered bilinearly without seams), one after the
+ * other: the offset of each tile in the file is given by its index.
+ *
+ * Each frame:
+ * - The geometry is rendered with the feedback shader into a low resolution framebuffer (between
+ *   `BeginFeedback()` and `EndFeedback()`), writing the tile required by each pixel. The
+ *   framebuffer is read back asynchronously into a pixel pack buffer.
+ * - `Update()` reads the feedback of a previous frame once available, requests the tiles missing
+ *   to the worker threads (the coarser levels first), and uploads the tiles read by the workers
+ *   into the cache, replacing the tiles used least recently.
+ *
+ * The shaders find the tiles through the page table, a texture with one texel per tile (and one
+ * level per level of the texture) holding the location of the tile in the cache. Tiles missing are
+ * replaced by the closest coarser tile resident, and the tile of the coarsest level is always
+ * resident, so the texture is always sampled (with less detail until the tiles are streamed).
+ *
+ * Copying or moving `VirtualTexture` objects is disabled to ensure single ownership of the
+ * textures, the mapping and the workers.
+ */
+class VirtualTexture
+{
+public:
+    // Constructor(s)/Destructor
+    // ----------------------------------------
+    VirtualTexture(const std::filesystem::path& filePath, const size_t budget = 32 * 1024 * 1024,
+                   const unsigned int feedbackWidth = 160, const unsigned int feedbackHeight = 90,
+                   const unsigned int threads = 2);
+    ~VirtualTexture();
+    
+    // Import
+    // ----------------------------------------
+    static bool Import(const std::filesystem::path& source, const std::filesystem::path& destination,
+                       const unsigned int tileSize = 128, const unsigned int border = 4,
+                       const bool flip = true, const MipmapSettings& mipmaps = MipmapSettings());
+    
+    // Feedback
+    // ----------------------------------------
+    void BeginFeedback(const unsigned int width, const unsigned int height);
+    void EndFeedback();
+    
+    // Streaming
+    // ----------------------------------------
+    void Update();
+    
+    // Properties
+    // ----------------------------------------
+    void SetProperties(const std::shared_ptr<Shader>& shader, const std::string& name,
+                       unsigned int& slot, const bool feedback = false) const;
+    
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Check if the tiled file has been read.
+    /// @return `true` if the texture can be sampled.
+    bool IsLoaded() const { return m_Cache != nullptr; }
+    /// @brief Get the size of the source image.
+    /// @return The width (in texels).
+    unsigned int GetWidth() const { return m_Width; }
+    /// @brief Get the size of the source image.
+    /// @return The height (in texels).
+    unsigned int GetHeight() const { return m_Height; }
+    /// @brief Get the number of levels of the texture.
+    /// @return The level count.
+    unsigned int GetLevelCount() const { return m_Levels; }
+    /// @brief Get the framebuffer where the tiles required are rendered.
+    /// @return The feedback framebuffer.
+    const std::shared_ptr<FrameBuffer>& GetFeedback() const { return m_Feedback; }
+    /// @brief Get the texture holding the resident tiles.
+    /// @return The cache texture.
+    const std::shared_ptr<Texture2D>& GetCache() const { return m_Cache; }
+    /// @brief Get the texture locating the tiles in the cache.
+    /// @return The page table texture.
+    const std::shared_ptr<Texture2D>& GetPageTable() const { return m_PageTable; }
+    
+    // Statistics
+    // ----------------------------------------
+    /**
+     * Represents the information related to the statistics of the virtual texture.
+     */
+    struct VirtualStatistics
+    {
+        ///< Number of tiles resident in the cache.
+        unsigned int resident = 0;
+        ///< Number of tiles the cache can hold.
+        unsigned int capacity = 0;
+        ///< Number of tiles being read by the workers or waiting to be uploaded.
+        unsigned int pending = 0;
+        ///< Number of tiles required by the last feedback read.
+        unsigned int visible = 0;
+        ///< Number of tiles uploaded in the last update.
+        unsigned int uploads = 0;
+        ///< Number of tiles evicted (since the creation).
+        unsigned int evictions = 0;
+        ///< Video memory used by the cache and the page table (in bytes).
+        size_t memory = 0;
+    };
+    
+    /// @brief Get the statistics of the last update.
+    /// @return The virtual texture statistics.
+    const VirtualStatistics& GetStats() const { return m_Stats; }
+
+private:
+    // Virtual texture structures
+    // ----------------------------------------
+    /**
+     * Represents a slot of the cache holding a tile.
+     */
+    struct CacheSlot
+    {
+        ///< Tile held (invalid if the slot is free).
+        uint32_t tile = UINT32_MAX;
+        ///< Index of the last frame the tile has been required.
+        uint64_t lastUsed = 0;
+    };
+    
+    /**
+     * Represents a tile read by a worker thread.
+     */
+    struct LoadedTile
+    {
+        ///< Tile read.
+        uint32_t tile = 0;
+        ///< Texels of the tile (with its border).
+        std::vector<uint8_t> data;
+    };
+    
+    /**
+     * Represents a read back of the feedback framebuffer.
+     */
+    struct FeedbackReadback
+    {
+        ///< Pixel pack buffer receiving the feedback.
+        std::unique_ptr<StorageBuffer> buffer;
+        ///< Fence signaled once the feedback has been copied (null if no read back is pending).
+        GLsync fence = nullptr;
+    };
+    
+    // Tiles
+    // ----------------------------------------
+    /// @brief Identify a tile by its level and position.
+    /// @param level The level of the tile.
+    /// @param x The position of the tile (in tiles).
+    /// @param y The position of the tile (in tiles).
+    /// @return The tile key.
+    static uint32_t GetTileKey(const unsigned int level, const unsigned int x, const unsigned int y)
+    {
+        return (level << 24) | (y << 12) | x;
+    }
+    /// @brief Get the tile covering a tile in the next (coarser) level.
+    /// @param tile The tile key.
+    /// @return The key of the parent tile.
+    static uint32_t GetParentTile(const uint32_t tile)
+    {
+        return GetTileKey((tile >> 24) + 1, (tile & 0xFFF) >> 1, ((tile >> 12) & 0xFFF) >> 1);
+    }
+    size_t GetTileIndex(const uint32_t tile) const;
+    std::vector<uint8_t> ReadTile(const uint32_t tile) const;
+    
+    void ReadFeedback(const uint8_t *pixels, const size_t count);
+    void Request(const uint32_t tile);
+    bool Upload(const LoadedTile& tile);
+    
+    // Page table
+    // ----------------------------------------
+    void UpdatePageTable(const uint32_t tile);
+    void UploadPageTable();
+    
+    // Virtual texture variables
+    // ----------------------------------------
+private:
+    ///< Size of the source image (in texels).
+    unsigned int m_Width = 0, m_Height = 0;
+    ///< Size of the tiles without their border, and size of their border (in texels).
+    unsigned int m_TileSize = 0, m_Border = 0;
+    ///< Number of tiles of the base level (powers of two).
+    unsigned int m_TilesX = 0, m_TilesY = 0;
+    ///< Number of levels (until a single tile covers the texture).
+    unsigned int m_Levels = 0;
+    
+    ///< Mapped content of the tiled file.
+    std::unique_ptr<MappedFile> m_File;
+    ///< Worker threads reading the tiles.
+    std::unique_ptr<ThreadPool> m_Workers;
+    
+    ///< Texture holding the resident tiles.
+    std::shared_ptr<Texture2D> m_Cache;
+    ///< Number of slots of the cache (on each side).
+    unsigned int m_CacheSlots = 0;
+    ///< Slots of the cache.
+    std::vector<CacheSlot> m_Slots;
+    ///< Slot of each resident tile.
+    std::unordered_map<uint32_t, unsigned int> m_Resident;
+    
+    ///< Texture locating the tiles in the cache (one level per level of the texture).
+    std::shared_ptr<Texture2D> m_PageTable;
+    ///< Entries of the page table (RGBA8 texels for each level).
+    std::vector<std::vector<uint32_t>> m_Entries;
+    ///< Rows of each level of the page table modified since the last upload (first and last).
+    std::vector<std::pair<unsigned int, unsigned int>> m_DirtyRows;
+    
+    ///< Framebuffer where the tiles required are rendered.
+    std::shared_ptr<FrameBuffer> m_Feedback;
+    ///< Ring of read backs of the feedback (one per frame in flight).
+    std::array<FeedbackReadback, 3> m_Readbacks;
+    ///< Index of the next read back issued.
+    unsigned int m_Readback = 0;
+    ///< Bias of the level selected in the feedback (rendered at a lower resolution).
+    float m_FeedbackBias = 0.0f;
+    
+    ///< Tiles requested to the workers (and not uploaded yet).
+    std::unordered_set<uint32_t> m_Requested;
+    ///< Tiles read waiting to be uploaded.
+    std::deque<LoadedTile> m_Loaded;
+    ///< Mutex guarding the tiles read.
+    std::mutex m_Mutex;
+    
+    ///< Index of the current frame (incremented by each update).
+    uint64_t m_Frame = 0;
+    
+    ///< Statistics of the virtual texture.
+    VirtualStatistics m_Stats;
+    
+    // Disable the copying or moving of this resource
+    // ----------------------------------------
+public:
+    VirtualTexture(const VirtualTexture&) = delete;
+    VirtualTexture(VirtualTexture&&) = delete;
+    
+    VirtualTexture& operator=(const VirtualTexture&) = delete;
+    VirtualTexture& operator=(VirtualTexture&&) = delete;
+};
@@ -3,6 +3,8 @@
 #include "Common/Renderer/Light/Light.h"
 #include "Common/Renderer/Light/EnvironmentLight.h"
 
+#include "Common/Renderer/Culling/OcclusionCulling.h"
+
 #include "Common/Scene/Viewport.h"
 
 /**
@@ -126,6 +128,16 @@ public:
     /// @return The defined render passes with its specifications.
     RenderPassLibrary& GetRenderPasses() { return m_RenderPasses; }
     
+    /// @brief Get the occlusion culling of the scene models.
+    /// @return The occlusion culling (null if disabled).
+    const std::shared_ptr<OcclusionCulling>& GetOcclusionCulling() const { return m_Occlusion; }
+    
+    // Setter(s)
+    // ----------------------------------------
+    /// @brief Define the occlusion culling of the models drawn from the scene camera.
+    /// @param occlusion The occlusion culling (null to disable it).
+    void SetOcclusionCulling(const std::shared_ptr<OcclusionCulling>& occlusion) { m_Occlusion = occlusion; }
+    
     // Render
     // ----------------------------------------
     void Draw();
@@ -156,4 +168,7 @@ private:
     
     ///< Render passes for the rendering of the scene.
     RenderPassLibrary m_RenderPasses;
+    
+    ///< Occlusion culling of the models (optional).
+    std::shared_ptr<OcclusionCulling> m_Occlusion;
 };
@@ -11,6 +11,8 @@
 // --------------------------------------------
 #include "Common/Core/Window.h"
 #include "Common/Core/Application.h"
+#include "Common/Core/ThreadPool.h"
+#include "Common/Core/MappedFile.h"
 
 // --------------------------------------------
 // Inputs
@@ -42,13 +44,27 @@
 #include "Common/Renderer/Buffer/IndexBuffer.h"
 #include "Common/Renderer/Buffer/VertexArray.h"
 #include "Common/Renderer/Buffer/FrameBuffer.h"
+#include "Common/Renderer/Buffer/StorageBuffer.h"
+#include "Common/Renderer/Buffer/RingBuffer.h"
+#include "Common/Renderer/Buffer/BufferPool.h"
 
 #include "Common/Renderer/Shader/Shader.h"
+#include "Common/Renderer/Shader/ComputeShader.h"
 #include "Common/Renderer/Texture/Texture.h"
 #include "Common/Renderer/Texture/Texture1D.h"
 #include "Common/Renderer/Texture/Texture2D.h"
 #include "Common/Renderer/Texture/Texture3D.h"
 #include "Common/Renderer/Texture/TextureCube.h"
+#include "Common/Renderer/Texture/Texture2DArray.h"
+#include "Common/Renderer/Texture/TextureAtlas.h"
+#include "Common/Renderer/Texture/MipmapGenerator.h"
+#include "Common/Renderer/Texture/TextureEncoder.h"
+#include "Common/Renderer/Texture/HDRConverter.h"
+#include "Common/Renderer/Texture/KTXTexture.h"
+#include "Common/Renderer/Texture/TextureLoader.h"
+#include "Common/Renderer/Texture/TextureLibrary.h"
+#include "Common/Renderer/Texture/TextureResidency.h"
+#include "Common/Renderer/Texture/VirtualTexture.h"
 
 #include "Common/Renderer/Light/ShadowCamera.h"
 #include "Common/Renderer/Light/Light.h"
@@ -62,12 +78,21 @@
 #include "Common/Renderer/Material/PhongMaterial.h"
 
 #include "Common/Renderer/Mesh/Mesh.h"
+#include "Common/Renderer/Mesh/MeshAsset.h"
 #include "Common/Renderer/Model/Model.h"
 #include "Common/Renderer/Model/AssimpModel.h"
 
 #include "Common/Renderer/Mesh/MeshUtils.h"
+#include "Common/Renderer/Mesh/MeshEncoding.h"
+#include "Common/Renderer/Mesh/MeshBounds.h"
+#include "Common/Renderer/Mesh/MeshSimplification.h"
+#include "Common/Renderer/Mesh/Meshlet.h"
 #include "Common/Renderer/Model/ModelUtils.h"
+#include "Common/Renderer/Model/PrimitiveLibrary.h"
 
+#include "Common/Renderer/Camera/Frustum.h"
+#include "Common/Renderer/Culling/GPUCulling.h"
+#include "Common/Renderer/Culling/OcclusionCulling.h"
 #include "Common/Renderer/Camera/PerspectiveCamera.h"
 #include "Common/Renderer/Camera/OrthographicCamera.h"
 
@@ -24,6 +24,7 @@ public:
     // Setter(s)
     // ----------------------------------------
     static void SetWindowHints();
+    static bool SetFallbackWindowHints();
     void SetVerticalSync(bool enabled) override;
     
     // Buffers
@@ -40,4 +41,7 @@ public:
 private:
     ///< Native window (GLFW).
     GLFWwindow* m_WindowHandle;
+    
+    ///< Index of the context version requested (from the most recent version supported).
+    static inline unsigned int s_VersionIndex = 0;
 };
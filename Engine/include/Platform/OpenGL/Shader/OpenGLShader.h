@@ -28,6 +28,7 @@ public:
     // Getter(s)
     // ----------------------------------------
     int GetUniformLocation(const std::string& name);
+    glm::uvec3 GetWorkGroupSize() const override;
     
     // Setter(s)
     // ----------------------------------------
@@ -57,15 +58,19 @@ private:
         std::string FragmentSource;
         ///< Geometry shader source code
         std::string GeometrySource;
+        ///< Compute shader source code
+        std::string ComputeSource;
         
         // Constructor(s)/Destructor
         // ----------------------------------------
         /// @brief Define the shader program source.
         /// @param vs Vertex shader source.
         /// @param fs Fragment shader source.
+        /// @param gs Geometry shader source.
+        /// @param cs Compute shader source.
         OpenGLShaderSource(const std::string& vs, const std::string& fs,
-            const std::string& gs = "")
-            : VertexSource(vs), FragmentSource(fs), GeometrySource(gs)
+            const std::string& gs = "", const std::string& cs = "")
+            : VertexSource(vs), FragmentSource(fs), GeometrySource(gs), ComputeSource(cs)
         {}
         /// @brief Delete the shader program source.
         ~OpenGLShaderSource() = default;
@@ -78,6 +83,7 @@ private:
     unsigned int CreateShader(const std::string& vertexShader,
                               const std::string& fragmentShader,
                               const std::string& gemetryShader = "");
+    unsigned int CreateComputeShader(const std::string& computeShader);
     // Parsing
     // ----------------------------------------
     OpenGLShaderSource ParseShader(const std::filesystem::path& filepath);
@@ -87,6 +93,8 @@ private:
 private:
     ///< ID of the shader program.
     unsigned int m_ID = 0;
+    ///< Size of the work groups (compute shaders).
+    glm::uvec3 m_WorkGroupSize = glm::uvec3(1);
     ///< Cache of uniform locations.
     std::unordered_map<std::string, int> m_UniformBuffer;
     
@@ -35,6 +35,14 @@ Application::Application(const std::string& name, const int width,
     Renderer::Init();
 }
 
+/**
+ * Delete the application, releasing the renderer before its window (and context) is destroyed.
+ */
+Application::~Application()
+{
+    Renderer::Shutdown();
+}
+
 /**
  * Add a new rendering layer to the application.
  *
@@ -90,10 +98,22 @@ void Application::Run()
         Timestep deltaTime = (float)(timer.Elapsed());
         timer.Reset();
         
+        // Start writing the dynamic data of the frame
+        Renderer::BeginFrame();
+        
+        // Upload the textures loaded in the background
+        Renderer::GetTextureLoader()->Update();
+        
+        // Keep the textures within the video memory budget
+        TextureResidency::Update();
+        
         // Render layers (from bottom to top)
         for (std::shared_ptr<Layer>& layer : m_LayerStack)
             layer->OnUpdate(deltaTime);
         
+        // Fence the dynamic data once all the draw calls are submitted
+        Renderer::EndFrame();
+        
         // Update the window
         m_Window->OnUpdate();
     }
@@ -0,0 +1,75 @@
+#include "enginepch.h"
+#include "Common/Core/MappedFile.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+/**
+ * Map the content of a file into memory.
+ *
+ * @param filePath The file path.
+ */
+MappedFile::MappedFile(const std::filesystem::path& filePath)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileW(filePath.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+    m_File = file;
+    
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        return;
+    
+    m_Mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_Mapping)
+        return;
+    
+    m_Data = static_cast<const uint8_t*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+    m_Size = m_Data ? (size_t)size.QuadPart : 0;
+#else
+    int file = open(filePath.string().c_str(), O_RDONLY);
+    if (file < 0)
+        return;
+    
+    // The mapping remains valid once the file is closed
+    struct stat info;
+    if (fstat(file, &info) == 0 && info.st_size > 0)
+    {
+        void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data != MAP_FAILED)
+        {
+            m_Data = static_cast<const uint8_t*>(data);
+            m_Size = (size_t)info.st_size;
+        }
+    }
+    close(file);
+#endif
+}
+
+/**
+ * Unmap the content of the file.
+ */
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+    if (m_Data)
+        UnmapViewOfFile(m_Data);
+    if (m_Mapping)
+        CloseHandle(m_Mapping);
+    if (m_File)
+        CloseHandle(m_File);
+#else
+    if (m_Data)
+        munmap(const_cast<uint8_t*>(m_Data), m_Size);
+#endif
+}
@@ -0,0 +1,58 @@
+#include "enginepch.h"
+#include "Common/Core/ThreadPool.h"
+
+/**
+ * Start the worker threads of the pool.
+ *
+ * @param threads The number of worker threads (all the hardware threads except the calling one
+ * if zero).
+ */
+ThreadPool::ThreadPool(const unsigned int threads)
+{
+    unsigned int count = threads;
+    if (count == 0)
+    {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        count = hardware > 1 ? hardware - 1 : 1;
+    }
+    
+    m_Workers.reserve(count);
+    for (unsigned int i = 0; i < count; i++)
+        m_Workers.emplace_back(&ThreadPool::Run, this);
+}
+
+/**
+ * Finish the pending tasks and join the worker threads.
+ */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_Condition.notify_all();
+    
+    for (auto& worker : m_Workers)
+        worker.join();
+}
+
+/**
+ * Run the submitted tasks until the pool is stopped (loop of each worker thread).
+ */
+void ThreadPool::Run()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Condition.wait(lock, [this]() { return m_Stop || !m_Tasks.empty(); });
+            if (m_Tasks.empty())
+                return;
+            
+            task = std::move(m_Tasks.front());
+            m_Tasks.pop();
+        }
+        task();
+    }
+}
@@ -259,6 +259,10 @@ void Window::Init()
     // Create a windowed mode window and its OpenGL context
     m_Window = glfwCreateWindow(m_Data.Width, m_Data.Height,
                                 m_Data.Title.c_str(), nullptr, nullptr);
+    // Retry with the fallback configurations of the context (e.g. older versions)
+    while (!m_Window && GraphicsContext::SetFallbackWindowHints())
+        m_Window = glfwCreateWindow(m_Data.Width, m_Data.Height,
+                                    m_Data.Title.c_str(), nullptr, nullptr);
     CORE_ASSERT(m_Window, "Failed to create a GLFW window!");
     ++g_WindowCount;
     
@@ -126,6 +126,59 @@ void GuiLayer::GUIStats(Timestep ts)
     ImGui::Separator();
     ImGui::Text("Render Passes: %d", stats.renderPasses);
     ImGui::Text("Draw Calls: %d", stats.drawCalls);
+    ImGui::Separator();
+    
+    // Memory pools of the geometry
+    auto pools = { std::make_pair("Vertex", Renderer::GetVertexPool()),
+                   std::make_pair("Index", Renderer::GetIndexPool()) };
+    for (const auto& [name, pool] : pools)
+    {
+        if (!pool)
+            continue;
+        
+        auto poolStats = pool->GetStats();
+        ImGui::Text("%s Pool: %.2f / %.2f MB (%d allocations)", name,
+                    poolStats.used / (1024.0f * 1024.0f), poolStats.capacity / (1024.0f * 1024.0f),
+                    poolStats.allocations);
+        ImGui::Text("  Utilization: %.1f%% - Fragmentation: %.1f%%",
+                    poolStats.GetUtilization() * 100.0f, poolStats.GetFragmentation() * 100.0f);
+    }
+    
+    // Textures loaded in the background
+    if (auto& loader = Renderer::GetTextureLoader())
+    {
+        auto& loaderStats = loader->GetStats();
+        ImGui::Separator();
+        ImGui::Text("Textures Loading: %d (%d failed)", loaderStats.pending, loaderStats.failed);
+        ImGui::Text("  Uploaded: %d (%.2f MB, %.2f ms)", loaderStats.uploads,
+                    loaderStats.bytes / (1024.0f * 1024.0f), loaderStats.uploadTime);
+    }
+    
+    // Textures shared by the library
+    if (auto& library = Renderer::GetTextureLibrary())
+    {
+        auto libraryStats = library->GetStats();
+        ImGui::Separator();
+        ImGui::Text("Textures: %d (%.2f MB, %d references)", libraryStats.textures,
+                    libraryStats.memory / (1024.0f * 1024.0f), libraryStats.references);
+        ImGui::Text("  Loads: %d - Hits: %d - Evictions: %d", libraryStats.loads, libraryStats.hits,
+                    libraryStats.evictions);
+    }
+    
+    // Video memory of the textures (by category)
+    auto& residencyStats = TextureResidency::GetStats();
+    ImGui::Separator();
+    if (TextureResidency::GetBudget() > 0)
+        ImGui::Text("Texture Memory: %.2f / %.2f MB (%d textures)", residencyStats.used / (1024.0f * 1024.0f),
+                    TextureResidency::GetBudget() / (1024.0f * 1024.0f), residencyStats.textures);
+    else
+        ImGui::Text("Texture Memory: %.2f MB (%d textures)", residencyStats.used / (1024.0f * 1024.0f),
+                    residencyStats.textures);
+    for (size_t i = 0; i < residencyStats.categories.size(); i++)
+        ImGui::Text("  %s: %.2f MB", utils::Texturing::TextureCategoryToString((TextureCategory)i),
+                    residencyStats.categories[i] / (1024.0f * 1024.0f));
+    ImGui::Text("  Reduced: %d (%d dropped, %d restored)", residencyStats.reduced, residencyStats.dropped,
+                residencyStats.restored);
     
     ImGui::End();
 }
@@ -0,0 +1,581 @@
+#include "enginepch.h"
+#include "Common/Renderer/Buffer/BufferPool.h"
+
+#include "Common/Renderer/Renderer.h"
+
+#include <bit>
+
+// Number of second level lists of each first level (log2)
+static const unsigned int g_SecondLevelLog2 = 4;
+static const unsigned int g_SecondLevelCount = 1u << g_SecondLevelLog2;
+// Number of first level lists (sizes up to 2^32 allocation units)
+static const unsigned int g_FirstLevelCount = 32 - g_SecondLevelLog2 + 1;
+
+// Invalid block index
+static const unsigned int g_NullBlock = std::numeric_limits<unsigned int>::max();
+
+/**
+ * Get the lists of the free blocks of a given size.
+ *
+ * The sizes smaller than the number of second level lists are classified linearly, while the
+ * larger ones are classified by their power of two (first level) and subdivided linearly
+ * (second level).
+ *
+ * @param units The size of the block (in allocation units).
+ * @param fl The first level index.
+ * @param sl The second level index.
+ */
+static void MapSize(const unsigned int units, unsigned int& fl, unsigned int& sl)
+{
+    if (units < g_SecondLevelCount)
+    {
+        fl = 0;
+        sl = units;
+        return;
+    }
+
+    unsigned int log = (unsigned int)std::bit_width(units) - 1;
+    fl = log - g_SecondLevelLog2 + 1;
+    sl = (units >> (log - g_SecondLevelLog2)) - g_SecondLevelCount;
+}
+
+/**
+ * Round a size up to the smallest size of the next list, so any block of that list is large
+ * enough for it.
+ *
+ * @param units The size (in allocation units).
+ *
+ * @return The rounded size (in allocation units).
+ */
+static uint64_t RoundSize(const unsigned int units)
+{
+    if (units < g_SecondLevelCount)
+        return units;
+
+    unsigned int log = (unsigned int)std::bit_width(units) - 1;
+    uint64_t step = 1ull << (log - g_SecondLevelLog2);
+    return (units + step - 1) / step * step;
+}
+
+/**
+ * Generate a buffer with uninitialized memory, without modifying the bound buffers when
+ * direct state access is supported.
+ *
+ * @param size Size of the buffer (in bytes).
+ *
+ * @return The ID of the buffer.
+ */
+static unsigned int CreateBuffer(const unsigned int size)
+{
+    unsigned int id = 0;
+    if (Renderer::GetCapabilities().directStateAccess)
+    {
+        glCreateBuffers(1, &id);
+        glNamedBufferStorage(id, (GLsizeiptr)size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+        return id;
+    }
+    
+    glGenBuffers(1, &id);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, id);
+    glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)size, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return id;
+}
+
+/**
+ * Define an empty buffer pool.
+ *
+ * @param pageSize The default size of the buffers allocated by the pool (in bytes).
+ * @param alignment The alignment of the allocations (in bytes).
+ */
+BufferPool::BufferPool(const unsigned int pageSize, const unsigned int alignment)
+    : m_PageSize(pageSize), m_Alignment(glm::max(alignment, 1u))
+{
+    m_FreeLists.resize(g_FirstLevelCount);
+    for (auto& list : m_FreeLists)
+        list.fill(g_NullBlock);
+    m_SecondLevelMap.resize(g_FirstLevelCount, 0);
+}
+
+/**
+ * Delete the buffers of the pool.
+ */
+BufferPool::~BufferPool()
+{
+    for (auto& page : m_Pages)
+    {
+        if (page.id)
+            glDeleteBuffers(1, &page.id);
+    }
+}
+
+/**
+ * Allocate a range of the pool.
+ *
+ * @param size Size of the range (in bytes).
+ *
+ * @return The allocation, invalid if the size is zero.
+ */
+BufferAllocation BufferPool::Allocate(const unsigned int size)
+{
+    if (size == 0)
+        return {};
+
+    // Look for a block large enough, adding a page if none is found
+    unsigned int units = (size + m_Alignment - 1) / m_Alignment;
+    unsigned int block = FindFreeBlock(units);
+    if (block == g_NullBlock)
+    {
+        uint64_t pageSize = glm::max((uint64_t)m_PageSize, RoundSize(units) * m_Alignment);
+        CORE_ASSERT(pageSize <= std::numeric_limits<unsigned int>::max(),
+                    "The range exceeds the maximum size of the buffer pool!");
+        AddPage((unsigned int)pageSize);
+        block = FindFreeBlock(units);
+    }
+    CORE_ASSERT(block != g_NullBlock, "Failed to allocate a range of the buffer pool!");
+    RemoveFreeBlock(block);
+
+    // Return the remaining part of the block to the free lists
+    unsigned int bytes = units * m_Alignment;
+    if (m_Blocks[block].size > bytes)
+    {
+        unsigned int remaining = CreateBlock();
+        Block& current = m_Blocks[block];
+        Block& next = m_Blocks[remaining];
+
+        next.page = current.page;
+        next.offset = current.offset + bytes;
+        next.size = current.size - bytes;
+        next.prevPhysical = block;
+        next.nextPhysical = current.nextPhysical;
+        if (current.nextPhysical != g_NullBlock)
+            m_Blocks[current.nextPhysical].prevPhysical = remaining;
+        current.nextPhysical = remaining;
+        current.size = bytes;
+
+        InsertFreeBlock(remaining);
+    }
+    m_Blocks[block].free = false;
+
+    m_Allocations++;
+    m_Used += bytes;
+
+    BufferAllocation allocation;
+    allocation.handle = block;
+    return allocation;
+}
+
+/**
+ * Release a range of the pool, merging it with its free neighbours.
+ *
+ * @param allocation The allocation (invalidated).
+ */
+void BufferPool::Free(BufferAllocation& allocation)
+{
+    if (!allocation.IsValid())
+        return;
+
+    unsigned int block = allocation.handle;
+    allocation = BufferAllocation();
+    CORE_ASSERT(!m_Blocks[block].free, "The range of the buffer pool is already free!");
+
+    m_Allocations--;
+    m_Used -= m_Blocks[block].size;
+
+    // Merge with the previous block
+    unsigned int prev = m_Blocks[block].prevPhysical;
+    if (prev != g_NullBlock && m_Blocks[prev].free)
+    {
+        RemoveFreeBlock(prev);
+        m_Blocks[prev].size += m_Blocks[block].size;
+        m_Blocks[prev].nextPhysical = m_Blocks[block].nextPhysical;
+        if (m_Blocks[block].nextPhysical != g_NullBlock)
+            m_Blocks[m_Blocks[block].nextPhysical].prevPhysical = prev;
+        ReleaseBlock(block);
+        block = prev;
+    }
+
+    // Merge with the next block
+    unsigned int next = m_Blocks[block].nextPhysical;
+    if (next != g_NullBlock && m_Blocks[next].free)
+    {
+        RemoveFreeBlock(next);
+        m_Blocks[block].size += m_Blocks[next].size;
+        m_Blocks[block].nextPhysical = m_Blocks[next].nextPhysical;
+        if (m_Blocks[next].nextPhysical != g_NullBlock)
+            m_Blocks[m_Blocks[next].nextPhysical].prevPhysical = block;
+        ReleaseBlock(next);
+    }
+
+    InsertFreeBlock(block);
+}
+
+/**
+ * Update the content of an allocated range.
+ *
+ * @param allocation The allocation.
+ * @param data The new data.
+ * @param size Size of the data (in bytes).
+ * @param offset Offset of the data in the range (in bytes).
+ */
+void BufferPool::SetData(const BufferAllocation& allocation, const void *data,
+                         const unsigned int size, const unsigned int offset)
+{
+    if (!allocation.IsValid() || !data || size == 0)
+        return;
+
+    const Block& block = m_Blocks[allocation.handle];
+    CORE_ASSERT(offset + size <= block.size, "Data exceeds the size of the allocated range!");
+
+    if (Renderer::GetCapabilities().directStateAccess)
+    {
+        glNamedBufferSubData(m_Pages[block.page].id, (GLintptr)(block.offset + offset),
+                             (GLsizeiptr)size, data);
+        return;
+    }
+    
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_Pages[block.page].id);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)(block.offset + offset), (GLsizeiptr)size, data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+/**
+ * Compact the allocated ranges of each fragmented page into its beginning, leaving a single free
+ * block at its end. The allocations are moved on the GPU, so this should be done at load
+ * boundaries, when no command using them is pending.
+ */
+void BufferPool::Defragment()
+{
+    bool moved = false;
+    for (unsigned int p = 0; p < m_Pages.size(); p++)
+    {
+        Page& page = m_Pages[p];
+        if (!page.id)
+            continue;
+
+        // Only the pages with a free block before an allocated one are fragmented
+        bool fragmented = false;
+        bool gap = false;
+        std::vector<unsigned int> allocated;
+        for (unsigned int b = page.first; b != g_NullBlock; b = m_Blocks[b].nextPhysical)
+        {
+            if (m_Blocks[b].free)
+                gap = true;
+            else
+            {
+                fragmented = fragmented || gap;
+                allocated.push_back(b);
+            }
+        }
+        if (!fragmented)
+            continue;
+
+        // Copy the allocated blocks into a new buffer, one after the other
+        bool dsa = Renderer::GetCapabilities().directStateAccess;
+        unsigned int id = CreateBuffer(page.size);
+        if (!dsa)
+        {
+            glBindBuffer(GL_COPY_READ_BUFFER, page.id);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, id);
+        }
+
+        unsigned int cursor = 0;
+        for (unsigned int b : allocated)
+        {
+            Block& block = m_Blocks[b];
+            if (dsa)
+                glCopyNamedBufferSubData(page.id, id, (GLintptr)block.offset, (GLintptr)cursor,
+                                         (GLsizeiptr)block.size);
+            else
+                glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, (GLintptr)block.offset,
+                                    (GLintptr)cursor, (GLsizeiptr)block.size);
+            block.offset = cursor;
+            cursor += block.size;
+        }
+        if (!dsa)
+        {
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &page.id);
+        page.id = id;
+
+        // Release the free blocks of the page
+        for (unsigned int b = page.first; b != g_NullBlock;)
+        {
+            unsigned int next = m_Blocks[b].nextPhysical;
+            if (m_Blocks[b].free)
+            {
+                RemoveFreeBlock(b);
+                ReleaseBlock(b);
+            }
+            b = next;
+        }
+
+        // Link the allocated blocks, followed by the remaining space
+        if (cursor < page.size)
+        {
+            unsigned int tail = CreateBlock();
+            m_Blocks[tail].page = p;
+            m_Blocks[tail].offset = cursor;
+            m_Blocks[tail].size = page.size - cursor;
+            allocated.push_back(tail);
+        }
+        for (unsigned int i = 0; i < allocated.size(); i++)
+        {
+            m_Blocks[allocated[i]].prevPhysical = i > 0 ? allocated[i - 1] : g_NullBlock;
+            m_Blocks[allocated[i]].nextPhysical = i + 1 < allocated.size() ? allocated[i + 1] : g_NullBlock;
+        }
+        page.first = allocated.front();
+        if (cursor < page.size)
+            InsertFreeBlock(allocated.back());
+
+        moved = true;
+    }
+
+    if (moved)
+        m_Generation++;
+}
+
+/**
+ * Release the pages without any allocated range.
+ */
+void BufferPool::Trim()
+{
+    for (auto& page : m_Pages)
+    {
+        if (!page.id)
+            continue;
+
+        const Block& block = m_Blocks[page.first];
+        if (!block.free || block.nextPhysical != g_NullBlock)
+            continue;
+
+        RemoveFreeBlock(page.first);
+        ReleaseBlock(page.first);
+        glDeleteBuffers(1, &page.id);
+        page = Page();
+    }
+}
+
+/**
+ * Get the buffer containing an allocated range.
+ *
+ * @param allocation The allocation.
+ *
+ * @return The ID of the buffer.
+ */
+unsigned int BufferPool::GetBuffer(const BufferAllocation& allocation) const
+{
+    return allocation.IsValid() ? m_Pages[m_Blocks[allocation.handle].page].id : 0;
+}
+
+/**
+ * Get the offset of an allocated range in its buffer.
+ *
+ * @param allocation The allocation.
+ *
+ * @return The offset (in bytes).
+ */
+unsigned int BufferPool::GetOffset(const BufferAllocation& allocation) const
+{
+    return allocation.IsValid() ? m_Blocks[allocation.handle].offset : 0;
+}
+
+/**
+ * Get the size of an allocated range (including the alignment).
+ *
+ * @param allocation The allocation.
+ *
+ * @return The size (in bytes).
+ */
+unsigned int BufferPool::GetSize(const BufferAllocation& allocation) const
+{
+    return allocation.IsValid() ? m_Blocks[allocation.handle].size : 0;
+}
+
+/**
+ * Get the current statistics of the pool.
+ *
+ * @return The buffer pool statistics.
+ */
+BufferPool::PoolStatistics BufferPool::GetStats() const
+{
+    PoolStatistics stats;
+    stats.allocations = m_Allocations;
+    stats.used = m_Used;
+
+    for (const auto& page : m_Pages)
+    {
+        if (!page.id)
+            continue;
+
+        stats.pages++;
+        stats.capacity += page.size;
+        for (unsigned int b = page.first; b != g_NullBlock; b = m_Blocks[b].nextPhysical)
+        {
+            if (!m_Blocks[b].free)
+                continue;
+
+            stats.freeBlocks++;
+            stats.largestFree = glm::max(stats.largestFree, (size_t)m_Blocks[b].size);
+        }
+    }
+
+    return stats;
+}
+
+/**
+ * Allocate a new buffer, available as a single free block.
+ *
+ * @param size Size of the buffer (in bytes).
+ */
+void BufferPool::AddPage(const unsigned int size)
+{
+    // Reuse the slot of a released page
+    unsigned int index = (unsigned int)m_Pages.size();
+    for (unsigned int p = 0; p < m_Pages.size(); p++)
+    {
+        if (!m_Pages[p].id)
+        {
+            index = p;
+            break;
+        }
+    }
+    if (index == m_Pages.size())
+        m_Pages.emplace_back();
+
+    Page& page = m_Pages[index];
+    page.size = size;
+    page.id = CreateBuffer(size);
+
+    unsigned int block = CreateBlock();
+    m_Blocks[block].page = index;
+    m_Blocks[block].offset = 0;
+    m_Blocks[block].size = size;
+    page.first = block;
+
+    InsertFreeBlock(block);
+}
+
+/**
+ * Get an unused block.
+ *
+ * @return The index of the block.
+ */
+unsigned int BufferPool::CreateBlock()
+{
+    unsigned int block;
+    if (!m_UnusedBlocks.empty())
+    {
+        block = m_UnusedBlocks.back();
+        m_UnusedBlocks.pop_back();
+    }
+    else
+    {
+        block = (unsigned int)m_Blocks.size();
+        m_Blocks.emplace_back();
+    }
+
+    m_Blocks[block] = Block();
+    m_Blocks[block].prevPhysical = m_Blocks[block].nextPhysical = g_NullBlock;
+    m_Blocks[block].prevFree = m_Blocks[block].nextFree = g_NullBlock;
+    return block;
+}
+
+/**
+ * Mark a block as unused, so it can be reused later.
+ *
+ * @param block The index of the block.
+ */
+void BufferPool::ReleaseBlock(const unsigned int block)
+{
+    m_Blocks[block].free = false;
+    m_UnusedBlocks.push_back(block);
+}
+
+/**
+ * Add a block to the free list of its size.
+ *
+ * @param block The index of the block.
+ */
+void BufferPool::InsertFreeBlock(const unsigned int block)
+{
+    unsigned int fl, sl;
+    MapSize(m_Blocks[block].size / m_Alignment, fl, sl);
+
+    Block& current = m_Blocks[block];
+    current.free = true;
+    current.prevFree = g_NullBlock;
+    current.nextFree = m_FreeLists[fl][sl];
+    if (current.nextFree != g_NullBlock)
+        m_Blocks[current.nextFree].prevFree = block;
+
+    m_FreeLists[fl][sl] = block;
+    m_FirstLevelMap |= 1u << fl;
+    m_SecondLevelMap[fl] |= 1u << sl;
+}
+
+/**
+ * Remove a block from the free list of its size.
+ *
+ * @param block The index of the block.
+ */
+void BufferPool::RemoveFreeBlock(const unsigned int block)
+{
+    unsigned int fl, sl;
+    MapSize(m_Blocks[block].size / m_Alignment, fl, sl);
+
+    Block& current = m_Blocks[block];
+    if (current.prevFree != g_NullBlock)
+        m_Blocks[current.prevFree].nextFree = current.nextFree;
+    if (current.nextFree != g_NullBlock)
+        m_Blocks[current.nextFree].prevFree = current.prevFree;
+
+    // Update the bitmaps if the list becomes empty
+    if (m_FreeLists[fl][sl] == block)
+    {
+        m_FreeLists[fl][sl] = current.nextFree;
+        if (current.nextFree == g_NullBlock)
+        {
+            m_SecondLevelMap[fl] &= ~(1u << sl);
+            if (m_SecondLevelMap[fl] == 0)
+                m_FirstLevelMap &= ~(1u << fl);
+        }
+    }
+
+    current.free = false;
+    current.prevFree = current.nextFree = g_NullBlock;
+}
+
+/**
+ * Find a free block large enough for a given size.
+ *
+ * @param units The size required (in allocation units).
+ *
+ * @return The index of the block, or an invalid index if none is available.
+ */
+unsigned int BufferPool::FindFreeBlock(const unsigned int units) const
+{
+    uint64_t rounded = RoundSize(units);
+    if (rounded > std::numeric_limits<unsigned int>::max())
+        return g_NullBlock;
+
+    unsigned int fl, sl;
+    MapSize((unsigned int)rounded, fl, sl);
+
+    // Look in the lists of the same first level, then in the larger ones
+    uint32_t secondMap = m_SecondLevelMap[fl] & (~0u << sl);
+    if (secondMap == 0)
+    {
+        uint32_t firstMap = fl + 1 < 32 ? m_FirstLevelMap & (~0u << (fl + 1)) : 0;
+        if (firstMap == 0)
+            return g_NullBlock;
+
+        fl = (unsigned int)std::countr_zero(firstMap);
+        secondMap = m_SecondLevelMap[fl];
+    }
+    sl = (unsigned int)std::countr_zero(secondMap);
+
+    return m_FreeLists[fl][sl];
+}
@@ -6,6 +6,8 @@
 #include "Common/Renderer/Texture/Texture3D.h"
 #include "Common/Renderer/Texture/TextureCube.h"
 
+#include "Common/Renderer/Renderer.h"
+
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
 
@@ -112,8 +114,12 @@ void FrameBuffer::BindForDrawAttachmentCube(const unsigned int index, const unsi
     
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_ID);
     glViewport(0, 0, m_Spec.Width, m_Spec.Height > 0 ? m_Spec.Height : 1);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face,
-                           m_ColorAttachments[index]->m_ID, level);
+    if (Renderer::GetCapabilities().directStateAccess)
+        glNamedFramebufferTextureLayer(m_ID, GL_COLOR_ATTACHMENT0, m_ColorAttachments[index]->m_ID,
+                                       level, face);
+    else
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face,
+                               m_ColorAttachments[index]->m_ID, level);
 }
 
 /**
@@ -125,10 +131,7 @@ void FrameBuffer::Unbind(const bool& genMipMaps) const
     if (m_Spec.MipMaps && genMipMaps)
     {
         for (auto& attachment : m_ColorAttachments)
-        {
-            attachment->Bind();
-            glGenerateMipmap(attachment->TextureTarget());
-        }
+            attachment->GenerateMipmaps();
     }
     
     // Bind to the default buffer
@@ -268,9 +271,15 @@ void FrameBuffer::Invalidate()
         m_DepthAttachment = 0;
     }
     
-    // Create the framebuffer
-    glGenFramebuffers(1, &m_ID);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_ID);
+    // Create the framebuffer (bound to be edited if direct state access is not supported)
+    bool dsa = Renderer::GetCapabilities().directStateAccess;
+    if (dsa)
+        glCreateFramebuffers(1, &m_ID);
+    else
+    {
+        glGenFramebuffers(1, &m_ID);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_ID);
+    }
     
     // Color attachments
     if (!m_ColorAttachmentsSpec.empty())
@@ -310,6 +319,18 @@ void FrameBuffer::Invalidate()
             
             // Create the texture for the color attachment
             m_ColorAttachments[i]->CreateTexture(nullptr);
+            m_ColorAttachments[i]->m_Category = TextureCategory::Attachment;
+            
+            // Attach the texture (the first layer of the 3D and cube textures)
+            if (dsa)
+            {
+                if (type == TextureType::TEXTURE3D || type == TextureType::TEXTURECUBE)
+                    glNamedFramebufferTextureLayer(m_ID, GL_COLOR_ATTACHMENT0 + i,
+                                                   m_ColorAttachments[i]->m_ID, 0, 0);
+                else
+                    glNamedFramebufferTexture(m_ID, GL_COLOR_ATTACHMENT0 + i, m_ColorAttachments[i]->m_ID, 0);
+                continue;
+            }
             
             switch (type)
             {
@@ -342,8 +363,14 @@ void FrameBuffer::Invalidate()
     {
         m_DepthAttachment = std::make_shared<Texture2D>(m_DepthAttachmentSpec, m_Spec.Samples);
         m_DepthAttachment->CreateTexture(nullptr);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, utils::OpenGL::TextureFormatToOpenGLDepthType(m_DepthAttachment->m_Spec.Format),
-                               m_DepthAttachment->TextureTarget(), m_DepthAttachment->m_ID, 0);
+        m_DepthAttachment->m_Category = TextureCategory::Attachment;
+        
+        GLenum attachment = utils::OpenGL::TextureFormatToOpenGLDepthType(m_DepthAttachment->m_Spec.Format);
+        if (dsa)
+            glNamedFramebufferTexture(m_ID, attachment, m_DepthAttachment->m_ID, 0);
+        else
+            glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, m_DepthAttachment->TextureTarget(),
+                                   m_DepthAttachment->m_ID, 0);
     }
     
     // Draw the color attachments
@@ -352,12 +379,25 @@ void FrameBuffer::Invalidate()
         CORE_ASSERT(m_ColorAttachments.size() <= 4,
                     "Using more than 4 color attachments in the Framebuffer!");
         GLenum buffers[4] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3 };
-        glDrawBuffers((int)m_ColorAttachments.size(), buffers);
+        if (dsa)
+            glNamedFramebufferDrawBuffers(m_ID, (int)m_ColorAttachments.size(), buffers);
+        else
+            glDrawBuffers((int)m_ColorAttachments.size(), buffers);
     }
     // Only depth-pass
     else if (m_ColorAttachments.empty())
     {
-        glDrawBuffer(GL_NONE);
+        if (dsa)
+            glNamedFramebufferDrawBuffer(m_ID, GL_NONE);
+        else
+            glDrawBuffer(GL_NONE);
+    }
+    
+    if (dsa)
+    {
+        CORE_ASSERT(glCheckNamedFramebufferStatus(m_ID, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE,
+                    "Framebuffer is incomplete!");
+        return;
     }
     
     CORE_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer is incomplete!");
@@ -1,37 +1,62 @@
 #include "enginepch.h"
 #include "Common/Renderer/Buffer/IndexBuffer.h"
 
+#include "Common/Renderer/Renderer.h"
+
 #include <GL/glew.h>
 
 /**
  * Generate an index buffer and link it to the input indices.
  *
+ * The indices are stored using 16-bit values if all of them fit in that range.
+ *
  * @param indices Index information for the vertices.
  * @param count Number of indices.
  */
 IndexBuffer::IndexBuffer(const unsigned int *indices, const unsigned int count)
     : m_Count(count)
 {
-    glGenBuffers(1, &m_ID);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ID);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)(count * sizeof(unsigned int)),
-        indices, GL_STATIC_DRAW);
+    // Find the largest index referenced
+    unsigned int maxIndex = 0;
+    for (unsigned int i = 0; i < count; i++)
+        maxIndex = std::max(maxIndex, indices[i]);
+    
+    // Define the buffer with the smallest index type possible
+    if (maxIndex <= std::numeric_limits<uint16_t>::max())
+    {
+        std::vector<uint16_t> data(indices, indices + count);
+        DefineBuffer(data.data(), IndexType::UInt16);
+    }
+    else
+        DefineBuffer(indices, IndexType::UInt32);
+}
+
+/**
+ * Generate an index buffer and link it to the input (16-bit) indices.
+ *
+ * @param indices Index information for the vertices.
+ * @param count Number of indices.
+ */
+IndexBuffer::IndexBuffer(const uint16_t *indices, const unsigned int count)
+    : m_Count(count)
+{
+    DefineBuffer(indices, IndexType::UInt16);
 }
 
 /**
- * Delete the index buffer.
+ * Release the range of the index buffer.
  */
 IndexBuffer::~IndexBuffer()
 {
-    glDeleteBuffers(1, &m_ID);
+    m_Pool->Free(m_Allocation);
 }
 
 /**
- * Bind the index buffer.
+ * Bind the buffer containing the indices.
  */
 void IndexBuffer::Bind() const
 {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ID);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Pool->GetBuffer(m_Allocation));
 }
 
 /**
@@ -41,3 +66,19 @@ void IndexBuffer::Unbind() const
 {
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
+
+/**
+ * Allocate a range of the index pool and copy the index data into it.
+ *
+ * @param indices Index information for the vertices.
+ * @param type Data type of the indices.
+ */
+void IndexBuffer::DefineBuffer(const void *indices, IndexType type)
+{
+    m_Type = type;
+    m_Pool = Renderer::GetIndexPool();
+    CORE_ASSERT(m_Pool, "The renderer must be initialized before creating index buffers!");
+    
+    m_Allocation = m_Pool->Allocate(GetSize());
+    m_Pool->SetData(m_Allocation, indices, GetSize());
+}
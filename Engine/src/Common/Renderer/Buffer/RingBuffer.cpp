@@ -0,0 +1,266 @@
+#include "enginepch.h"
+#include "Common/Renderer/Buffer/RingBuffer.h"
+
+#include "Common/Core/Timer.h"
+#include "Common/Renderer/Renderer.h"
+
+#include <cstring>
+
+// Time waited for a fence before flushing the commands again (in nanoseconds)
+static const GLuint64 g_FenceTimeout = 1000000;
+
+/**
+ * Generate a ring buffer and allocate the memory of all its frame regions.
+ *
+ * @param size Size of the region of each frame (in bytes).
+ * @param frames Number of frames in flight.
+ */
+RingBuffer::RingBuffer(const unsigned int size, const unsigned int frames)
+    : m_Frames(glm::max(frames, 1u)), m_Persistent(Renderer::GetCapabilities().bufferStorage)
+{
+    m_Alignment = QueryAlignment();
+
+    // Keep every frame region aligned
+    m_FrameSize = (size + m_Alignment - 1) / m_Alignment * m_Alignment;
+    GLsizeiptr total = (GLsizeiptr)m_FrameSize * m_Frames;
+
+    glGenBuffers(1, &m_ID);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_ID);
+    if (m_Persistent)
+    {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, total, nullptr, flags);
+        m_Data = static_cast<uint8_t*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, total, flags));
+
+        m_Persistent = m_Data != nullptr;
+        if (!m_Persistent)
+            CORE_WARN("Failed to map the ring buffer persistently!");
+    }
+    if (!m_Persistent)
+    {
+        // The immutable storage cannot be reallocated, so a new buffer is required
+        if (m_Data == nullptr && Renderer::GetCapabilities().bufferStorage)
+        {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            glDeleteBuffers(1, &m_ID);
+            glGenBuffers(1, &m_ID);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, m_ID);
+        }
+        glBufferData(GL_COPY_WRITE_BUFFER, total, nullptr, GL_STREAM_DRAW);
+        m_Staging.resize(m_FrameSize);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    m_Fences.resize(m_Frames, nullptr);
+}
+
+/**
+ * Delete the ring buffer.
+ */
+RingBuffer::~RingBuffer()
+{
+    for (auto& fence : m_Fences)
+    {
+        if (fence)
+            glDeleteSync(fence);
+    }
+
+    if (m_Persistent)
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_ID);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+    glDeleteBuffers(1, &m_ID);
+}
+
+/**
+ * Get the alignment required to bind the allocations as uniform or shader storage ranges.
+ *
+ * @return The alignment (in bytes).
+ */
+unsigned int RingBuffer::QueryAlignment()
+{
+    GLint alignment = 1;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    unsigned int result = (unsigned int)glm::max(alignment, 1);
+    if (Renderer::GetCapabilities().computeShaders)
+    {
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        result = glm::max(result, (unsigned int)alignment);
+    }
+    return result;
+}
+
+/**
+ * Start writing into the next frame region, waiting until the GPU has consumed it.
+ */
+void RingBuffer::BeginFrame()
+{
+    m_Stats = RingStatistics();
+    Advance();
+}
+
+/**
+ * Finish writing into the frame region, once all the commands using it have been submitted.
+ */
+void RingBuffer::EndFrame()
+{
+    Flush();
+
+    GLsync& fence = m_Fences[m_Frame];
+    if (fence)
+        glDeleteSync(fence);
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+/**
+ * Continue the current frame in the next region, when the frame writes more than a region holds.
+ * The current region is fenced as if the frame ended, and the statistics keep accumulating.
+ */
+void RingBuffer::NextRegion()
+{
+    EndFrame();
+    Advance();
+    m_Stats.extraRegions++;
+}
+
+/**
+ * Move on to the next region, waiting until the GPU has consumed it.
+ */
+void RingBuffer::Advance()
+{
+    m_Frame = (m_Frame + 1) % m_Frames;
+    m_Head = 0;
+    m_Flushed = 0;
+
+    GLsync& fence = m_Fences[m_Frame];
+    if (!fence)
+        return;
+
+    // Only measure the time if the region is still in use
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED)
+    {
+        Timer timer;
+        m_Stats.fenceWaits++;
+        do
+        {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, g_FenceTimeout);
+        }
+        while (status == GL_TIMEOUT_EXPIRED);
+        m_Stats.waitTime += timer.ElapsedMilliseconds();
+    }
+    if (status == GL_WAIT_FAILED)
+        CORE_WARN("Failed to wait for the ring buffer fence!");
+
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+/**
+ * Allocate a region in the current frame.
+ *
+ * @param size Size of the region (in bytes).
+ * @param alignment The alignment of the region (the binding alignment if zero).
+ *
+ * @return The region to be written, invalid if the frame region is full.
+ */
+RingAllocation RingBuffer::Allocate(const unsigned int size, const unsigned int alignment)
+{
+    unsigned int align = alignment > 0 ? alignment : m_Alignment;
+    unsigned int offset = (m_Head + align - 1) / align * align;
+    if (size == 0 || offset + size > m_FrameSize)
+    {
+        if (m_Stats.overflows++ == 0 && size > 0)
+            CORE_WARN("The ring buffer frame region ({0} bytes) is full!", m_FrameSize);
+        return {};
+    }
+
+    m_Stats.allocations++;
+    m_Stats.bytes += offset + size - m_Head;
+    m_Head = offset + size;
+
+    RingAllocation allocation;
+    allocation.data = m_Persistent ? m_Data + GetFrameOffset() + offset : m_Staging.data() + offset;
+    allocation.offset = GetFrameOffset() + offset;
+    allocation.size = size;
+    return allocation;
+}
+
+/**
+ * Allocate a region in the current frame and copy data into it.
+ *
+ * @param data The data to be copied.
+ * @param size Size of the data (in bytes).
+ * @param alignment The alignment of the region (the binding alignment if zero).
+ *
+ * @return The region written, invalid if the frame region is full.
+ */
+RingAllocation RingBuffer::Push(const void *data, const unsigned int size,
+                                const unsigned int alignment)
+{
+    RingAllocation allocation = Allocate(size, alignment);
+    if (allocation.IsValid())
+        std::memcpy(allocation.data, data, size);
+    return allocation;
+}
+
+/**
+ * Bind the ring buffer to a target (e.g. to read streaming vertices at the allocation offsets).
+ *
+ * @param target The target the buffer is bound to.
+ */
+void RingBuffer::Bind(const StorageTarget& target)
+{
+    Flush();
+    glBindBuffer(utils::OpenGL::StorageTargetToOpenGLTarget(target), m_ID);
+}
+
+/**
+ * Unbind the ring buffer from a target.
+ *
+ * @param target The target the buffer was bound to.
+ */
+void RingBuffer::Unbind(const StorageTarget& target) const
+{
+    glBindBuffer(utils::OpenGL::StorageTargetToOpenGLTarget(target), 0);
+}
+
+/**
+ * Bind an allocation to an indexed binding point (`layout(binding = index)` in the shaders).
+ *
+ * @param target The indexed target (uniform or shader storage).
+ * @param index The binding point.
+ * @param allocation The region of the current frame.
+ */
+void RingBuffer::BindRange(const StorageTarget& target, const unsigned int index,
+                           const RingAllocation& allocation)
+{
+    CORE_ASSERT(target == StorageTarget::Uniform || target == StorageTarget::ShaderStorage,
+                "Only uniform and shader storage ranges can be bound!");
+    if (!allocation.IsValid())
+        return;
+
+    Flush();
+    glBindBufferRange(utils::OpenGL::StorageTargetToOpenGLTarget(target), index, m_ID,
+                      (GLintptr)allocation.offset, (GLsizeiptr)allocation.size);
+}
+
+/**
+ * Upload the data written since the last upload (only for non-persistent buffers), in a single
+ * contiguous update. The allocations written between two bindings are uploaded together, so the
+ * data bound right after being written (e.g. per-draw data) costs one update per binding.
+ */
+void RingBuffer::Flush()
+{
+    if (m_Persistent || m_Flushed == m_Head)
+        return;
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_ID);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)(GetFrameOffset() + m_Flushed),
+                    (GLsizeiptr)(m_Head - m_Flushed), m_Staging.data() + m_Flushed);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    m_Flushed = m_Head;
+}
@@ -0,0 +1,168 @@
+#include "enginepch.h"
+#include "Common/Renderer/Buffer/StorageBuffer.h"
+
+#include "Common/Renderer/Renderer.h"
+
+#include <GL/glew.h>
+
+/**
+ * Generate a storage buffer and allocate its memory.
+ *
+ * @param size Size of the buffer (in bytes).
+ * @param data Initial data of the buffer (uninitialized if null).
+ */
+StorageBuffer::StorageBuffer(const unsigned int size, const void *data)
+    : m_Size(size)
+{
+    // Define immutable storage, updated and mapped without binding the buffer
+    if (Renderer::GetCapabilities().directStateAccess)
+    {
+        glCreateBuffers(1, &m_ID);
+        glNamedBufferStorage(m_ID, (GLsizeiptr)size, data,
+                             GL_DYNAMIC_STORAGE_BIT | GL_MAP_READ_BIT | GL_MAP_WRITE_BIT);
+        return;
+    }
+    
+    glGenBuffers(1, &m_ID);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_ID);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, (GLsizeiptr)size, data, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/**
+ * Delete the storage buffer.
+ */
+StorageBuffer::~StorageBuffer()
+{
+    glDeleteBuffers(1, &m_ID);
+}
+
+/**
+ * Bind the storage buffer to a target.
+ *
+ * @param target The target the buffer is bound to.
+ */
+void StorageBuffer::Bind(const StorageTarget& target) const
+{
+    glBindBuffer(utils::OpenGL::StorageTargetToOpenGLTarget(target), m_ID);
+}
+
+/**
+ * Unbind the storage buffer from a target.
+ *
+ * @param target The target the buffer was bound to.
+ */
+void StorageBuffer::Unbind(const StorageTarget& target) const
+{
+    glBindBuffer(utils::OpenGL::StorageTargetToOpenGLTarget(target), 0);
+}
+
+/**
+ * Bind the storage buffer to an indexed binding point of the shader storage target
+ * (`layout(std430, binding = index)` in the shaders).
+ *
+ * @param index The binding point.
+ */
+void StorageBuffer::BindBase(const unsigned int index) const
+{
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, index, m_ID);
+}
+
+/**
+ * Update a region of the buffer.
+ *
+ * @param data The new data.
+ * @param size Size of the data (in bytes).
+ * @param offset Offset of the region in the buffer (in bytes).
+ */
+void StorageBuffer::SetData(const void *data, const unsigned int size, const unsigned int offset)
+{
+    CORE_ASSERT(offset + size <= m_Size, "Data exceeds the size of the storage buffer!");
+
+    if (Renderer::GetCapabilities().directStateAccess)
+    {
+        glNamedBufferSubData(m_ID, (GLintptr)offset, (GLsizeiptr)size, data);
+        return;
+    }
+    
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_ID);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, (GLintptr)offset, (GLsizeiptr)size, data);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/**
+ * Map a region of the buffer into the client memory. The commands that wrote into the buffer
+ * must be synchronized beforehand (see `Renderer::Barrier()`), and the buffer must be unmapped
+ * before being used by the GPU again.
+ *
+ * @param access The access to the mapped memory.
+ * @param offset Offset of the region (in bytes).
+ * @param size Size of the region (the rest of the buffer if zero).
+ *
+ * @return The mapped memory, or null if the mapping failed.
+ */
+void* StorageBuffer::Map(const StorageAccess& access, const unsigned int offset,
+                         const unsigned int size)
+{
+    CORE_ASSERT(!m_Mapped, "The storage buffer is already mapped!");
+    CORE_ASSERT(offset < m_Size, "Mapped region exceeds the size of the storage buffer!");
+
+    unsigned int length = size > 0 ? size : m_Size - offset;
+    CORE_ASSERT(offset + length <= m_Size, "Mapped region exceeds the size of the storage buffer!");
+
+    void* data = nullptr;
+    if (Renderer::GetCapabilities().directStateAccess)
+        data = glMapNamedBufferRange(m_ID, (GLintptr)offset, (GLsizeiptr)length,
+                                     utils::OpenGL::StorageAccessToOpenGLFlags(access));
+    else
+    {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_ID);
+        data = glMapBufferRange(GL_SHADER_STORAGE_BUFFER, (GLintptr)offset, (GLsizeiptr)length,
+                                utils::OpenGL::StorageAccessToOpenGLFlags(access));
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+
+    m_Mapped = data != nullptr;
+    if (!m_Mapped)
+        CORE_WARN("Failed to map the storage buffer!");
+    return data;
+}
+
+/**
+ * Release the mapping of the buffer.
+ */
+void StorageBuffer::Unmap()
+{
+    if (!m_Mapped)
+        return;
+
+    GLboolean valid = GL_TRUE;
+    if (Renderer::GetCapabilities().directStateAccess)
+        valid = glUnmapNamedBuffer(m_ID);
+    else
+    {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_ID);
+        valid = glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+    if (valid == GL_FALSE)
+        CORE_WARN("The content of the storage buffer was corrupted while mapped!");
+
+    m_Mapped = false;
+}
+
+/**
+ * Reset the content of the buffer to zero.
+ */
+void StorageBuffer::Clear()
+{
+    if (Renderer::GetCapabilities().directStateAccess)
+    {
+        glClearNamedBufferData(m_ID, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+        return;
+    }
+    
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_ID);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
@@ -1,6 +1,8 @@
 #include "enginepch.h"
 #include "Common/Renderer/Buffer/VertexArray.h"
 
+#include "Common/Renderer/Renderer.h"
+
 #include <GL/glew.h>
 
 /**
@@ -8,7 +10,10 @@
  */
 VertexArray::VertexArray()
 {
-    glGenVertexArrays(1, &m_ID);
+    if (Renderer::GetCapabilities().directStateAccess)
+        glCreateVertexArrays(1, &m_ID);
+    else
+        glGenVertexArrays(1, &m_ID);
 }
 
 /**
@@ -30,26 +35,11 @@ void VertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer>& vbo)
     CORE_ASSERT(vbo->GetLayout().GetElements().size(),
                 "Vertex buffer has no layout!");
     
-    // Bind the vertex array and the buffer
-    Bind();
-    vbo->Bind();
-    // Define the vertex attribute pointers
-    const auto& layout = vbo->GetLayout();
-    for (const auto& element : layout)
-    {
-        glVertexAttribPointer(m_Index, utils::OpenGL::GetCompCountOfType(element.Type),
-            utils::OpenGL::DataTypeToOpenGLType(element.Type), element.Normalized,
-            layout.GetStride(), (const void*)(size_t)element.Offset);
-        glEnableVertexAttribArray(m_Index);
-        m_Index++;
-    }
-    
-    vbo->Unbind();
-    Unbind();
-    
     // Add to the list of vertex buffers linked
     m_VertexBuffers.push_back(vbo);
     
+    // Define the vertex attribute pointers
+    DefineAttributes();
 }
 
 /**
@@ -57,6 +47,10 @@ void VertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer>& vbo)
  */
 void VertexArray::Bind() const
 {
+    // Update the attributes if the vertex data has been moved
+    if (m_Generation != Renderer::GetVertexPool()->GetGeneration())
+        DefineAttributes();
+    
     glBindVertexArray(m_ID);
 }
 
@@ -67,3 +61,58 @@ void VertexArray::Unbind() const
 {
     glBindVertexArray(0);
 }
+
+/**
+ * Define the vertex attribute pointers of all the linked vertex buffers, at the current location
+ * of their data in the vertex pool.
+ *
+ * With direct state access, each vertex buffer is attached to its own binding point and the
+ * attributes are defined without binding the vertex array. Otherwise, the vertex array is bound
+ * while being edited.
+ */
+void VertexArray::DefineAttributes() const
+{
+    if (Renderer::GetCapabilities().directStateAccess)
+    {
+        unsigned int index = 0;
+        for (unsigned int binding = 0; binding < m_VertexBuffers.size(); binding++)
+        {
+            const auto& vbo = m_VertexBuffers[binding];
+            const auto& layout = vbo->GetLayout();
+            glVertexArrayVertexBuffer(m_ID, binding, vbo->GetBuffer(), vbo->GetOffset(), layout.GetStride());
+            for (const auto& element : layout)
+            {
+                glEnableVertexArrayAttrib(m_ID, index);
+                glVertexArrayAttribFormat(m_ID, index, utils::OpenGL::GetCompCountOfType(element.Type),
+                    utils::OpenGL::DataTypeToOpenGLType(element.Type), element.Normalized, element.Offset);
+                glVertexArrayAttribBinding(m_ID, index, binding);
+                index++;
+            }
+        }
+        
+        m_Generation = Renderer::GetVertexPool()->GetGeneration();
+        return;
+    }
+    
+    glBindVertexArray(m_ID);
+    
+    unsigned int index = 0;
+    for (const auto& vbo : m_VertexBuffers)
+    {
+        vbo->Bind();
+        const auto& layout = vbo->GetLayout();
+        for (const auto& element : layout)
+        {
+            glVertexAttribPointer(index, utils::OpenGL::GetCompCountOfType(element.Type),
+                utils::OpenGL::DataTypeToOpenGLType(element.Type), element.Normalized,
+                layout.GetStride(), (const void*)(size_t)(vbo->GetOffset() + element.Offset));
+            glEnableVertexAttribArray(index);
+            index++;
+        }
+        vbo->Unbind();
+    }
+    
+    glBindVertexArray(0);
+    
+    m_Generation = Renderer::GetVertexPool()->GetGeneration();
+}
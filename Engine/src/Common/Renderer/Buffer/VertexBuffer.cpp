@@ -1,37 +1,41 @@
 #include "enginepch.h"
 #include "Common/Renderer/Buffer/VertexBuffer.h"
 
+#include "Common/Renderer/Renderer.h"
+
 #include <GL/glew.h>
 
 /**
- * Generate a vertex buffer and link it to the input vertex data.
+ * Allocate a vertex buffer from the vertex pool and copy the input vertex data into it.
  *
  * @param vertices Vertices to be rendered.
  * @param size Size of vertices in bytes.
+ * @param count Number of vertices.
  */
 VertexBuffer::VertexBuffer(const void *vertices, const unsigned int size,
                            const unsigned int count)
-    : m_Count(count)
+    : m_Count(count), m_Size(size), m_Pool(Renderer::GetVertexPool())
 {
-    glGenBuffers(1, &m_ID);
-    glBindBuffer(GL_ARRAY_BUFFER, m_ID);
-    glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+    CORE_ASSERT(m_Pool, "The renderer must be initialized before creating vertex buffers!");
+    
+    m_Allocation = m_Pool->Allocate(size);
+    m_Pool->SetData(m_Allocation, vertices, size);
 }
 
 /**
- * Delete the vertex buffer.
+ * Release the range of the vertex buffer.
  */
 VertexBuffer::~VertexBuffer()
 {
-    glDeleteBuffers(1, &m_ID);
+    m_Pool->Free(m_Allocation);
 }
 
 /**
- * Bind the vertex buffer.
+ * Bind the buffer containing the vertex data.
  */
 void VertexBuffer::Bind() const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, m_ID);
+    glBindBuffer(GL_ARRAY_BUFFER, m_Pool->GetBuffer(m_Allocation));
 }
 
 /**
@@ -0,0 +1,151 @@
+#include "enginepch.h"
+#include "Common/Renderer/Culling/GPUCulling.h"
+
+#include "Common/Renderer/Camera/Frustum.h"
+
+// Maximum number of levels of detail selected by the compute shader
+static const unsigned int g_MaxLODs = 8;
+
+/**
+ * Represents the arguments of an indexed indirect draw call.
+ */
+struct DrawElementsIndirectCommand
+{
+    unsigned int count;
+    unsigned int instanceCount;
+    unsigned int firstIndex;
+    int baseVertex;
+    unsigned int baseInstance;
+};
+
+/**
+ * Generate the resources to cull a set of instances on the GPU.
+ *
+ * @param capacity The maximum number of instances.
+ */
+GPUCulling::GPUCulling(const unsigned int capacity)
+    : m_Capacity(capacity)
+{
+    CORE_ASSERT(IsSupported(), "GPU culling is not supported by the current context!");
+
+    m_Shader = std::make_shared<ComputeShader>("Resources/shaders/culling/InstanceCulling.glsl");
+
+    m_Instances = std::make_unique<StorageBuffer>(capacity * (unsigned int)sizeof(glm::mat4));
+    m_Commands = std::make_unique<StorageBuffer>(capacity * (unsigned int)sizeof(DrawElementsIndirectCommand));
+    m_DrawCount = std::make_unique<StorageBuffer>((unsigned int)sizeof(unsigned int));
+}
+
+/**
+ * Define the transformations of the instances.
+ *
+ * @param transforms The model matrix of each instance.
+ */
+void GPUCulling::SetInstances(const std::vector<glm::mat4>& transforms)
+{
+    if (transforms.size() > m_Capacity)
+        CORE_WARN("Only {0} of the {1} instances can be culled!", m_Capacity, transforms.size());
+
+    m_InstanceCount = (unsigned int)std::min<size_t>(transforms.size(), m_Capacity);
+    if (m_InstanceCount > 0)
+        m_Instances->SetData(transforms.data(), m_InstanceCount * (unsigned int)sizeof(glm::mat4));
+}
+
+/**
+ * Define the depth pyramid used for the occlusion culling.
+ *
+ * Each level of the pyramid must store the farthest depth of the region covered by its texels,
+ * and the view-projection must be the one used to render the depth (usually from the previous
+ * frame, so the instances that became visible are drawn one frame late).
+ *
+ * @param pyramid The depth pyramid (no occlusion culling if null).
+ * @param viewProjection The view-projection used to render the depth.
+ */
+void GPUCulling::SetDepthPyramid(const std::shared_ptr<Texture>& pyramid,
+                                 const glm::mat4& viewProjection)
+{
+    m_DepthPyramid = pyramid;
+    m_PyramidViewProjection = viewProjection;
+}
+
+/**
+ * Check if the current context supports the culling on the GPU.
+ *
+ * @return `true` if the compute shaders and draw parameters are available.
+ */
+bool GPUCulling::IsSupported()
+{
+    const auto& capabilities = Renderer::GetCapabilities();
+    return capabilities.computeShaders && capabilities.drawParameters;
+}
+
+/**
+ * Read back the number of instances visible in the last draw. This stalls until the GPU has
+ * completed the culling, so it should only be used for debugging or statistics.
+ *
+ * @return The number of visible instances.
+ */
+unsigned int GPUCulling::ReadVisibleCount()
+{
+    Renderer::Barrier({ false, false, false, false, true });
+    
+    unsigned int* data = m_DrawCount->Map<unsigned int>();
+    unsigned int count = data ? *data : 0;
+    m_DrawCount->Unmap();
+    return count;
+}
+
+/**
+ * Cull the instances and write the draw commands of the visible ones.
+ *
+ * @param sphere The bounding sphere of the mesh (mesh space).
+ * @param lods The index ranges of the levels of detail of the mesh.
+ */
+void GPUCulling::Cull(const BSphere& sphere, const std::vector<IndexRange>& lods)
+{
+    // Reset the commands (when they are all executed) and their count
+    if (!Renderer::GetCapabilities().indirectCount)
+        m_Commands->Clear();
+    m_DrawCount->Clear();
+
+    m_Shader->Bind();
+    auto& shader = m_Shader->GetShader();
+
+    // Geometry
+    shader->SetInt("u_InstanceCount", (int)m_InstanceCount);
+    shader->SetVec4("u_Sphere", glm::vec4(sphere.center, glm::max(sphere.radius, 0.0f)));
+
+    unsigned int levels = glm::min((unsigned int)lods.size(), g_MaxLODs);
+    shader->SetInt("u_LODNumber", (int)levels);
+    for (unsigned int i = 0; i < levels; i++)
+    {
+        shader->SetInt("u_LODOffsets[" + std::to_string(i) + "]", (int)lods[i].offset);
+        shader->SetInt("u_LODCounts[" + std::to_string(i) + "]", (int)lods[i].count);
+    }
+
+    // View
+    const glm::mat4& view = Renderer::GetViewMatrix();
+    const glm::mat4& projection = Renderer::GetProjectionMatrix();
+    Frustum frustum(projection * view);
+    for (unsigned int i = 0; i < frustum.planes.size(); i++)
+        shader->SetVec4("u_Planes[" + std::to_string(i) + "]", frustum.planes[i]);
+    shader->SetMat4("u_View", view);
+    shader->SetMat4("u_Projection", projection);
+
+    // Occlusion
+    shader->SetBool("u_Occlusion", m_DepthPyramid != nullptr);
+    if (m_DepthPyramid)
+    {
+        m_DepthPyramid->BindToTextureUnit(0);
+        shader->SetInt("u_DepthPyramid", 0);
+        shader->SetMat4("u_PyramidViewProjection", m_PyramidViewProjection);
+    }
+
+    // Cull the instances, making the commands visible to the indirect draw
+    m_Instances->BindBase(0);
+    m_Commands->BindBase(1);
+    m_DrawCount->BindBase(2);
+    Renderer::Dispatch(m_Shader, m_Shader->GetGroupCount(glm::uvec3(m_InstanceCount, 1, 1)),
+                       { true, true });
+
+    m_Shader->Unbind();
+}
@@ -0,0 +1,402 @@
+#include "enginepch.h"
+#include "Common/Renderer/Culling/OcclusionCulling.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define OCCLUSION_SIMD_SSE
+#endif
+
+// Size of the tiles of the depth buffer (in pixels)
+static const unsigned int g_TileWidth = 8;
+static const unsigned int g_TileHeight = 4;
+
+// Minimum clip-space w of the vertices rasterized (in front of the camera)
+static const float g_MinW = 1e-5f;
+
+/**
+ * Compute the pixels of a tile covered by a triangle.
+ *
+ * The edge functions are evaluated at the center of the pixels, four pixels of a row at a time.
+ * A pixel is covered when it is strictly inside the three edges.
+ *
+ * @param a The x coefficients of the edge functions.
+ * @param b The y coefficients of the edge functions.
+ * @param c The constant terms of the edge functions.
+ * @param x The x coordinate of the tile (in pixels).
+ * @param y The y coordinate of the tile (in pixels).
+ *
+ * @return The coverage mask (bit `row * 8 + column`).
+ */
+static uint32_t ComputeCoverage(const float a[3], const float b[3], const float c[3],
+                                const float x, const float y)
+{
+    uint32_t mask = 0;
+
+#if defined(OCCLUSION_SIMD_SSE)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    for (unsigned int h = 0; h < g_TileWidth / 4; h++)
+    {
+        // Contribution of the columns to each edge function
+        __m128 px = _mm_add_ps(_mm_set1_ps(x + (float)(h * 4)), offsets);
+        __m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[0]), px), _mm_set1_ps(c[0]));
+        __m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[1]), px), _mm_set1_ps(c[1]));
+        __m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[2]), px), _mm_set1_ps(c[2]));
+
+        for (unsigned int r = 0; r < g_TileHeight; r++)
+        {
+            float py = y + (float)r + 0.5f;
+            __m128 inside = _mm_and_ps(
+                _mm_and_ps(_mm_cmpgt_ps(_mm_add_ps(e0, _mm_set1_ps(b[0] * py)), zero),
+                           _mm_cmpgt_ps(_mm_add_ps(e1, _mm_set1_ps(b[1] * py)), zero)),
+                _mm_cmpgt_ps(_mm_add_ps(e2, _mm_set1_ps(b[2] * py)), zero));
+            mask |= (uint32_t)_mm_movemask_ps(inside) << (r * g_TileWidth + h * 4);
+        }
+    }
+#else
+    for (unsigned int r = 0; r < g_TileHeight; r++)
+    {
+        float py = y + (float)r + 0.5f;
+        for (unsigned int col = 0; col < g_TileWidth; col++)
+        {
+            float px = x + (float)col + 0.5f;
+            bool inside = true;
+            for (unsigned int e = 0; e < 3; e++)
+                inside = inside && (a[e] * px + b[e] * py + c[e] > 0.0f);
+            if (inside)
+                mask |= 1u << (r * g_TileWidth + col);
+        }
+    }
+#endif
+
+    return mask;
+}
+
+/**
+ * Merge the coverage of a triangle into a tile.
+ *
+ * The triangle is added to the working layer, unless the working layer is farther from the
+ * triangle than from the reference layer (then it is discarded and restarted). Once the working
+ * layer covers the whole tile, it becomes the reference layer.
+ *
+ * @param tile The tile to be updated.
+ * @param coverage The pixels of the tile covered by the triangle.
+ * @param depth The (farthest) depth of the triangle.
+ */
+static void UpdateTile(OcclusionTile& tile, const uint32_t coverage, const float depth)
+{
+    if (coverage == 0 || depth >= tile.zMax0)
+        return;
+
+    // Discard the working layer if the triangle is far from it
+    if (tile.zMax1 - depth > tile.zMax0 - tile.zMax1)
+    {
+        tile.zMax1 = 0.0f;
+        tile.mask = 0;
+    }
+
+    tile.zMax1 = glm::max(tile.zMax1, depth);
+    tile.mask |= coverage;
+
+    // The working layer covers the whole tile
+    if (tile.mask == ~0u)
+    {
+        tile.zMax0 = glm::min(tile.zMax0, tile.zMax1);
+        tile.zMax1 = 0.0f;
+        tile.mask = 0;
+    }
+}
+
+/**
+ * Define an occlusion culling with an empty depth buffer.
+ *
+ * @param width The width of the depth buffer (multiple of 8 pixels).
+ * @param height The height of the depth buffer (multiple of 4 pixels).
+ * @param threads The maximum number of threads rasterizing the buffer (the calling thread and the
+ * workers of the renderer thread pool if zero).
+ */
+OcclusionCulling::OcclusionCulling(const unsigned int width, const unsigned int height,
+                                   const unsigned int threads)
+    : m_Resolution(width, height), m_Threads(threads)
+{
+    CORE_ASSERT(width % g_TileWidth == 0 && height % g_TileHeight == 0,
+                "The occlusion buffer size must be a multiple of the tile size!");
+
+    m_Tiles = glm::uvec2(width / g_TileWidth, height / g_TileHeight);
+    m_Buffer.resize(m_Tiles.x * m_Tiles.y);
+}
+
+/**
+ * Add a model as an occluder.
+ *
+ * The triangles are copied from the geometry of the model when added, so the CPU-side copies
+ * of its mesh data must be kept (`Keep` or `Compact` policies). The model placement is read
+ * each time the occluders are rendered.
+ *
+ * @param model The model hiding the ones behind it.
+ * @param lod The level of detail used as occluder (the coarsest one by default).
+ */
+void OcclusionCulling::AddOccluder(const std::shared_ptr<BaseModel>& model, const unsigned int lod)
+{
+    if (!model || !model->GetAsset())
+        return;
+
+    Occluder occluder;
+    occluder.model = model;
+    model->GetAsset()->GetTriangles(occluder.positions, occluder.indices, lod);
+    if (occluder.indices.empty())
+    {
+        CORE_WARN("The occluder does not define any triangle!");
+        return;
+    }
+
+    m_Occluders.push_back(std::move(occluder));
+}
+
+/**
+ * Remove a model from the occluders.
+ *
+ * @param model The occluder model.
+ */
+void OcclusionCulling::RemoveOccluder(const std::shared_ptr<BaseModel>& model)
+{
+    m_Occluders.erase(std::remove_if(m_Occluders.begin(), m_Occluders.end(),
+        [&model](const Occluder& occluder) { return occluder.model.lock() == model; }),
+        m_Occluders.end());
+}
+
+/**
+ * Rasterize the occluders into the depth buffer.
+ *
+ * @param view The view matrix of the camera.
+ * @param projection The projection matrix of the camera.
+ */
+void OcclusionCulling::Render(const glm::mat4& view, const glm::mat4& projection)
+{
+    m_ViewProjection = projection * view;
+    m_Stats = OcclusionStatistics();
+    std::fill(m_Buffer.begin(), m_Buffer.end(), OcclusionTile());
+
+    // Transform the triangles of the occluders into the screen (pixels, depth)
+    std::vector<glm::vec3> vertices;
+    std::vector<glm::vec4> clip;
+    const glm::vec2 size(m_Resolution);
+    for (const auto& occluder : m_Occluders)
+    {
+        auto model = occluder.model.lock();
+        if (!model)
+            continue;
+
+        glm::mat4 transform = m_ViewProjection * model->GetModelMatrix();
+        clip.resize(occluder.positions.size());
+        for (size_t i = 0; i < occluder.positions.size(); i++)
+            clip[i] = transform * glm::vec4(occluder.positions[i], 1.0f);
+
+        for (size_t i = 0; i + 2 < occluder.indices.size(); i += 3)
+        {
+            const glm::vec4& p0 = clip[occluder.indices[i]];
+            const glm::vec4& p1 = clip[occluder.indices[i + 1]];
+            const glm::vec4& p2 = clip[occluder.indices[i + 2]];
+
+            // Skip the triangles crossing the near plane, or outside the same side of the view
+            if (p0.w <= g_MinW || p1.w <= g_MinW || p2.w <= g_MinW)
+                continue;
+            if ((p0.x > p0.w && p1.x > p1.w && p2.x > p2.w) ||
+                (p0.x < -p0.w && p1.x < -p1.w && p2.x < -p2.w) ||
+                (p0.y > p0.w && p1.y > p1.w && p2.y > p2.w) ||
+                (p0.y < -p0.w && p1.y < -p1.w && p2.y < -p2.w) ||
+                (p0.z > p0.w && p1.z > p1.w && p2.z > p2.w))
+                continue;
+
+            for (const glm::vec4* p : { &p0, &p1, &p2 })
+            {
+                glm::vec3 ndc = glm::vec3(*p) / p->w;
+                vertices.emplace_back((ndc.x * 0.5f + 0.5f) * size.x, (ndc.y * 0.5f + 0.5f) * size.y,
+                                      glm::clamp(ndc.z * 0.5f + 0.5f, 0.0f, 1.0f));
+            }
+        }
+    }
+    m_Stats.triangles = (unsigned int)(vertices.size() / 3);
+
+    // Rasterize the triangles, the calling thread and the workers of the pool each covering a
+    // band of tile rows
+    const auto& pool = Renderer::GetThreadPool();
+    unsigned int threads = pool ? pool->GetThreadCount() + 1 : 1;
+    threads = glm::min(m_Threads > 0 ? glm::min(m_Threads, threads) : threads, m_Tiles.y);
+    std::vector<std::future<void>> bands;
+    for (unsigned int t = 1; t < threads; t++)
+    {
+        unsigned int rowBegin = t * m_Tiles.y / threads, rowEnd = (t + 1) * m_Tiles.y / threads;
+        bands.push_back(pool->Submit([this, &vertices, rowBegin, rowEnd]()
+        {
+            RasterizeBand(vertices, rowBegin, rowEnd);
+        }));
+    }
+    RasterizeBand(vertices, 0, m_Tiles.y / threads);
+    for (auto& band : bands)
+        band.get();
+
+    m_Rendered = true;
+}
+
+/**
+ * Rasterize the triangles into a band of tile rows.
+ *
+ * @param vertices The vertices of the triangles (pixels, depth).
+ * @param rowBegin The first tile row of the band.
+ * @param rowEnd The tile row after the band.
+ */
+void OcclusionCulling::RasterizeBand(const std::vector<glm::vec3>& vertices,
+                                     const unsigned int rowBegin, const unsigned int rowEnd)
+{
+    const float bandMin = (float)(rowBegin * g_TileHeight);
+    const float bandMax = (float)(rowEnd * g_TileHeight);
+
+    for (size_t i = 0; i + 2 < vertices.size(); i += 3)
+    {
+        const glm::vec3& v0 = vertices[i];
+        const glm::vec3& v1 = vertices[i + 1];
+        const glm::vec3& v2 = vertices[i + 2];
+
+        // Bounds of the triangle, clamped to the band
+        glm::vec2 min = glm::min(glm::vec2(v0), glm::min(glm::vec2(v1), glm::vec2(v2)));
+        glm::vec2 max = glm::max(glm::vec2(v0), glm::max(glm::vec2(v1), glm::vec2(v2)));
+        if (max.y <= bandMin || min.y >= bandMax || max.x <= 0.0f || min.x >= (float)m_Resolution.x)
+            continue;
+
+        // Edge functions, positive inside the triangle
+        float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+        if (glm::abs(area) < 1e-6f)
+            continue;
+        float orientation = area > 0.0f ? 1.0f : -1.0f;
+
+        const glm::vec3* v[3] = { &v0, &v1, &v2 };
+        float a[3], b[3], c[3];
+        for (unsigned int e = 0; e < 3; e++)
+        {
+            const glm::vec3& p = *v[e];
+            const glm::vec3& q = *v[(e + 1) % 3];
+            a[e] = (p.y - q.y) * orientation;
+            b[e] = (q.x - p.x) * orientation;
+            c[e] = -(a[e] * p.x + b[e] * p.y);
+        }
+
+        // Conservative depth of the triangle (farthest vertex)
+        float depth = glm::max(v0.z, glm::max(v1.z, v2.z));
+
+        // Tiles overlapped (the bounds are clamped to the screen before being converted, since
+        // the vertices close to the near plane can be projected arbitrarily far)
+        min = glm::clamp(min, glm::vec2(0.0f), glm::vec2(m_Resolution));
+        max = glm::clamp(max, glm::vec2(0.0f), glm::vec2(m_Resolution));
+        unsigned int tx0 = (unsigned int)min.x / g_TileWidth;
+        unsigned int tx1 = glm::min((unsigned int)max.x / g_TileWidth, m_Tiles.x - 1);
+        unsigned int ty0 = glm::max((unsigned int)min.y / g_TileHeight, rowBegin);
+        unsigned int ty1 = glm::min((unsigned int)max.y / g_TileHeight, rowEnd - 1);
+
+        for (unsigned int ty = ty0; ty <= ty1; ty++)
+        {
+            for (unsigned int tx = tx0; tx <= tx1; tx++)
+            {
+                OcclusionTile& tile = m_Buffer[ty * m_Tiles.x + tx];
+                if (depth >= tile.zMax0)
+                    continue;
+
+                uint32_t coverage = ComputeCoverage(a, b, c, (float)(tx * g_TileWidth),
+                                                    (float)(ty * g_TileHeight));
+                UpdateTile(tile, coverage, depth);
+            }
+        }
+    }
+}
+
+/**
+ * Check if a bounding box is (at least partially) visible behind the occluders.
+ *
+ * The boxes crossing the near plane or outside the screen are considered visible, as the
+ * occlusion culling does not replace the frustum culling.
+ *
+ * @param bbox The bounding box.
+ * @param transform The transformation of the box into world space.
+ *
+ * @return `true` if the box may be visible.
+ */
+bool OcclusionCulling::IsVisible(const BBox& bbox, const glm::mat4& transform)
+{
+    if (!m_Rendered || bbox.IsEmpty())
+        return true;
+    m_Stats.tests++;
+
+    // Project the corners of the box into the screen
+    glm::mat4 mvp = m_ViewProjection * transform;
+    glm::vec2 min(std::numeric_limits<float>::max());
+    glm::vec2 max(std::numeric_limits<float>::lowest());
+    float depth = 1.0f;
+    for (unsigned int i = 0; i < 8; i++)
+    {
+        glm::vec3 corner((i & 1) ? bbox.max.x : bbox.min.x,
+                         (i & 2) ? bbox.max.y : bbox.min.y,
+                         (i & 4) ? bbox.max.z : bbox.min.z);
+        glm::vec4 p = mvp * glm::vec4(corner, 1.0f);
+        if (p.w <= g_MinW)
+            return true;
+
+        glm::vec3 ndc = glm::vec3(p) / p.w;
+        min = glm::min(min, glm::vec2(ndc));
+        max = glm::max(max, glm::vec2(ndc));
+        depth = glm::min(depth, ndc.z * 0.5f + 0.5f);
+    }
+
+    const glm::vec2 size(m_Resolution);
+    min = (min * 0.5f + 0.5f) * size;
+    max = (max * 0.5f + 0.5f) * size;
+    if (max.x <= 0.0f || max.y <= 0.0f || min.x >= size.x || min.y >= size.y)
+        return true;
+
+    // The box is hidden if it is behind the reference depth of all the tiles it overlaps (clamped
+    // to the screen before being converted)
+    min = glm::clamp(min, glm::vec2(0.0f), size);
+    max = glm::clamp(max, glm::vec2(0.0f), size);
+    unsigned int tx0 = (unsigned int)min.x / g_TileWidth;
+    unsigned int tx1 = glm::min((unsigned int)max.x / g_TileWidth, m_Tiles.x - 1);
+    unsigned int ty0 = (unsigned int)min.y / g_TileHeight;
+    unsigned int ty1 = glm::min((unsigned int)max.y / g_TileHeight, m_Tiles.y - 1);
+    for (unsigned int ty = ty0; ty <= ty1; ty++)
+    {
+        for (unsigned int tx = tx0; tx <= tx1; tx++)
+        {
+            if (depth < m_Buffer[ty * m_Tiles.x + tx].zMax0)
+                return true;
+        }
+    }
+
+    m_Stats.culled++;
+    return false;
+}
+
+/**
+ * Check if a model is (at least partially) visible behind the occluders.
+ *
+ * @param model The model.
+ *
+ * @return `true` if the model may be visible.
+ */
+bool OcclusionCulling::IsVisible(const BaseModel& model)
+{
+    if (!model.GetAsset())
+        return true;
+
+    return IsVisible(model.GetAsset()->GetBBox(), model.GetModelMatrix());
+}
+
+/**
+ * Get the reference depth of the tiles of the buffer (e.g. for debugging).
+ *
+ * @return The farthest depth of each tile, row by row.
+ */
+std::vector<float> OcclusionCulling::GetDepth() const
+{
+    std::vector<float> depth(m_Buffer.size());
+    for (size_t i = 0; i < m_Buffer.size(); i++)
+        depth[i] = m_Buffer[i].zMax0;
+    return depth;
+}
@@ -70,3 +70,21 @@ void GraphicsContext::SetWindowHints()
     
     CORE_ASSERT(false, "Unknown Renderer API!");
 }
+
+/**
+ *  Sets the window hints for the next (less demanding) configuration of the graphics context,
+ *  used when the window could not be created with the current one.
+ *
+ *  @return `true` if a fallback configuration has been defined.
+ */
+bool GraphicsContext::SetFallbackWindowHints()
+{
+    switch (Renderer::GetAPI())
+    {
+        case RendererAPI::API::OpenGL:
+            return OpenGLContext::SetFallbackWindowHints();
+            
+        default:
+            return false;
+    }
+}
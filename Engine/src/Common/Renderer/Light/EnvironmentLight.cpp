@@ -74,10 +74,16 @@ void EnvironmentLight::InitEnvironmentMaterials()
     m_Materials.Create<SimpleTextureMaterial>("Equirectangular",
         "Resources/shaders/environment/EquirectangularMap.glsl");
     
-    // Spherical harmonics
+    // Spherical harmonics (reduced in a compute shader when supported)
     auto sphericalHarmonics = m_Materials.Create<SimpleTextureMaterial>("SphericalHarmonics",
        "Resources/shaders/environment/SphericalHarmonicsSampling.glsl");
     sphericalHarmonics->SetTextureMap(environment);
+    if (Renderer::GetCapabilities().computeShaders)
+    {
+        m_SHReduction = std::make_shared<ComputeShader>(
+            "Resources/shaders/environment/SphericalHarmonicsReduction.glsl");
+        m_SHBuffer = std::make_unique<StorageBuffer>(9 * (unsigned int)sizeof(glm::vec4));
+    }
     
     // Irradiance mapping
     auto irradiance = m_Materials.Create<SimpleTextureMaterial>("Irradiance",
@@ -160,15 +166,27 @@ void EnvironmentLight::DefineLightProperties(const std::shared_ptr<Shader> &shad
  */
 void EnvironmentLight::UpdateSphericalHarmonics()
 {
+    // Compute the coefficients without the render pass if possible
+    if (m_SHReduction)
+    {
+        auto coefficients = ReduceSphericalHarmonics();
+        m_Coefficients.UpdateIsotropicMatrix(coefficients);
+        m_Coefficients.UpdateAnisotropicMatrix(coefficients);
+        return;
+    }
+    
     // Retrieve the spherical harmonics material
     auto material = std::dynamic_pointer_cast<SimpleTextureMaterial>(m_Materials.Get("SphericalHarmonics"));
     if (!material)
         return;
     
-    // Create a plane geometry (to render to) using the material
-    using VertexData = GeoVertexData<glm::vec4>;
-    auto geometry = utils::Geometry::ModelPlane<VertexData>(material);
-    geometry->SetScale(glm::vec3(2.0f));
+    // Define the plane geometry (to render to) using the material, sharing the cached primitive
+    if (!m_Plane)
+    {
+        using VertexData = GeoVertexData<glm::vec4>;
+        m_Plane = utils::Geometry::ModelPlane<VertexData>(material);
+        m_Plane->SetScale(glm::vec3(2.0f));
+    }
     
     // Get the spherical harmonics framebuffer
     auto& framebuffer = m_Framebuffers.Get("SphericalHarmonics");
@@ -180,8 +198,8 @@ void EnvironmentLight::UpdateSphericalHarmonics()
     
     Renderer::BeginScene();
     Renderer::Clear(framebuffer->GetActiveBuffers());
-    geometry->SetMaterial(material);
-    geometry->DrawModel();
+    m_Plane->SetMaterial(material);
+    m_Plane->DrawModel();
     Renderer::EndScene();
     
     framebuffer->Unbind();
@@ -191,6 +209,40 @@ void EnvironmentLight::UpdateSphericalHarmonics()
     m_Coefficients.UpdateAnisotropicMatrix(framebuffer->GetAttachmentData<float>(0));
 }
 
+/**
+ * Computes the spherical harmonic coefficients of the environment in a compute shader, with
+ * all the samples reduced in a single work group.
+ *
+ * @return The 9 coefficients, stored with interleaved RGB values.
+ */
+std::vector<float> EnvironmentLight::ReduceSphericalHarmonics()
+{
+    auto& environment = m_Framebuffers.Get("Environment")->GetColorAttachment(0);
+    
+    // Project the environment into the coefficients
+    m_SHReduction->Bind();
+    environment->BindToTextureUnit(0);
+    m_SHReduction->GetShader()->SetInt("u_Material.TextureMap", 0);
+    m_SHBuffer->BindBase(0);
+    Renderer::Dispatch(m_SHReduction, glm::uvec3(1), { false, false, false, false, true });
+    m_SHReduction->Unbind();
+    
+    // Retrieve the information of the coefficients
+    std::vector<float> coefficients(9 * 3, 0.0f);
+    glm::vec4* data = m_SHBuffer->Map<glm::vec4>();
+    if (data)
+    {
+        for (unsigned int i = 0; i < 9; i++)
+        {
+            for (unsigned int c = 0; c < 3; c++)
+                coefficients[i * 3 + c] = data[i][c];
+        }
+    }
+    m_SHBuffer->Unmap();
+    
+    return coefficients;
+}
+
 /**
  * Updates the environment lighting information.
  *
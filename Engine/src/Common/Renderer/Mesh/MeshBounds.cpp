@@ -0,0 +1,280 @@
+#include "enginepch.h"
+#include "Common/Renderer/Mesh/MeshBounds.h"
+
+#include "Common/Renderer/Mesh/MeshEncoding.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define BOUNDS_SIMD_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define BOUNDS_SIMD_NEON
+#endif
+
+// Number of positions decoded at once when computing the bounds of a vertex stream
+static const unsigned int g_BoundsChunkSize = 1024;
+
+/**
+ * Compute the bounding box of a set of positions, four at a time.
+ *
+ * The positions (x, y, z) are packed in memory, so four of them fill exactly three vector
+ * registers: (x0 y0 z0 x1), (y1 z1 x2 y2) and (z2 x3 y3 z3). Each register keeps its own
+ * minimum/maximum, and the lanes are folded into the components at the end.
+ *
+ * @param positions The positions.
+ * @param count The number of positions.
+ * @param bbox The bounding box to be extended.
+ *
+ * @return The number of positions processed (a multiple of four).
+ */
+static size_t ComputeBBoxVectorized(const glm::vec3* positions, const size_t count, BBox& bbox)
+{
+    const size_t vectorized = count & ~size_t(3);
+    if (vectorized == 0)
+        return 0;
+
+    const float* data = &positions[0].x;
+    float min[3][4], max[3][4];
+
+#if defined(BOUNDS_SIMD_SSE)
+    __m128 min0 = _mm_loadu_ps(data), min1 = _mm_loadu_ps(data + 4), min2 = _mm_loadu_ps(data + 8);
+    __m128 max0 = min0, max1 = min1, max2 = min2;
+    for (size_t i = 4; i < vectorized; i += 4)
+    {
+        const float* p = data + i * 3;
+        __m128 r0 = _mm_loadu_ps(p), r1 = _mm_loadu_ps(p + 4), r2 = _mm_loadu_ps(p + 8);
+        min0 = _mm_min_ps(min0, r0); max0 = _mm_max_ps(max0, r0);
+        min1 = _mm_min_ps(min1, r1); max1 = _mm_max_ps(max1, r1);
+        min2 = _mm_min_ps(min2, r2); max2 = _mm_max_ps(max2, r2);
+    }
+    _mm_storeu_ps(min[0], min0); _mm_storeu_ps(min[1], min1); _mm_storeu_ps(min[2], min2);
+    _mm_storeu_ps(max[0], max0); _mm_storeu_ps(max[1], max1); _mm_storeu_ps(max[2], max2);
+#elif defined(BOUNDS_SIMD_NEON)
+    float32x4_t min0 = vld1q_f32(data), min1 = vld1q_f32(data + 4), min2 = vld1q_f32(data + 8);
+    float32x4_t max0 = min0, max1 = min1, max2 = min2;
+    for (size_t i = 4; i < vectorized; i += 4)
+    {
+        const float* p = data + i * 3;
+        float32x4_t r0 = vld1q_f32(p), r1 = vld1q_f32(p + 4), r2 = vld1q_f32(p + 8);
+        min0 = vminq_f32(min0, r0); max0 = vmaxq_f32(max0, r0);
+        min1 = vminq_f32(min1, r1); max1 = vmaxq_f32(max1, r1);
+        min2 = vminq_f32(min2, r2); max2 = vmaxq_f32(max2, r2);
+    }
+    vst1q_f32(min[0], min0); vst1q_f32(min[1], min1); vst1q_f32(min[2], min2);
+    vst1q_f32(max[0], max0); vst1q_f32(max[1], max1); vst1q_f32(max[2], max2);
+#else
+    for (unsigned int r = 0; r < 3; r++)
+        for (unsigned int l = 0; l < 4; l++)
+            min[r][l] = max[r][l] = data[r * 4 + l];
+    for (size_t i = 4; i < vectorized; i += 4)
+    {
+        const float* p = data + i * 3;
+        for (unsigned int r = 0; r < 3; r++)
+        {
+            for (unsigned int l = 0; l < 4; l++)
+            {
+                min[r][l] = std::min(min[r][l], p[r * 4 + l]);
+                max[r][l] = std::max(max[r][l], p[r * 4 + l]);
+            }
+        }
+    }
+#endif
+
+    // Fold the lanes into the components (the lane at register r, index l holds the
+    // component (4r + l) % 3)
+    for (unsigned int r = 0; r < 3; r++)
+    {
+        for (unsigned int l = 0; l < 4; l++)
+        {
+            unsigned int c = (r * 4 + l) % 3;
+            bbox.min[c] = std::min(bbox.min[c], min[r][l]);
+            bbox.max[c] = std::max(bbox.max[c], max[r][l]);
+        }
+    }
+
+    return vectorized;
+}
+
+/**
+ * Find the extreme positions along the x, y and z axes (keeping the first ones found).
+ *
+ * @param positions The positions.
+ * @param count The number of positions.
+ * @param min The positions with the minimum coordinate along each axis (to be updated).
+ * @param max The positions with the maximum coordinate along each axis (to be updated).
+ */
+static void FindExtremes(const glm::vec3* positions, const size_t count, glm::vec3 (&min)[3],
+                         glm::vec3 (&max)[3])
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        for (int c = 0; c < 3; c++)
+        {
+            if (positions[i][c] < min[c][c])
+                min[c] = positions[i];
+            if (positions[i][c] > max[c][c])
+                max[c] = positions[i];
+        }
+    }
+}
+
+/**
+ * Define the initial sphere of the Ritter's algorithm from the most distant pair among the
+ * extreme positions along the x, y and z axes (EPOS-6).
+ *
+ * @param min The positions with the minimum coordinate along each axis.
+ * @param max The positions with the maximum coordinate along each axis.
+ *
+ * @return The initial sphere.
+ */
+static BSphere InitialSphere(const glm::vec3 (&min)[3], const glm::vec3 (&max)[3])
+{
+    int axis = 0;
+    float distance = -1.0f;
+    for (int c = 0; c < 3; c++)
+    {
+        glm::vec3 d = max[c] - min[c];
+        if (glm::dot(d, d) > distance)
+        {
+            distance = glm::dot(d, d);
+            axis = c;
+        }
+    }
+
+    BSphere sphere;
+    sphere.center = (min[axis] + max[axis]) * 0.5f;
+    sphere.radius = glm::sqrt(distance) * 0.5f;
+    return sphere;
+}
+
+/**
+ * Grow a sphere to contain the positions outside of it.
+ *
+ * @param positions The positions.
+ * @param count The number of positions.
+ * @param sphere The sphere to be grown.
+ */
+static void GrowSphere(const glm::vec3* positions, const size_t count, BSphere& sphere)
+{
+    float radius2 = sphere.radius * sphere.radius;
+    for (size_t i = 0; i < count; i++)
+    {
+        glm::vec3 d = positions[i] - sphere.center;
+        float distance2 = glm::dot(d, d);
+        if (distance2 <= radius2)
+            continue;
+
+        float length = glm::sqrt(distance2);
+        float radius = (sphere.radius + length) * 0.5f;
+        sphere.center += d * ((radius - sphere.radius) / length);
+        sphere.radius = radius;
+        radius2 = radius * radius;
+    }
+}
+
+namespace utils { namespace Geometry
+{
+
+/**
+ * Compute the bounding box of a set of positions.
+ *
+ * @param positions The positions.
+ * @param count The number of positions.
+ *
+ * @return The bounding box, empty if there are no positions.
+ */
+BBox ComputeBBox(const glm::vec3* positions, const size_t count)
+{
+    static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "The positions must be tightly packed!");
+
+    BBox bbox;
+    size_t processed = ComputeBBoxVectorized(positions, count, bbox);
+    for (size_t i = processed; i < count; i++)
+        bbox.Extend(positions[i]);
+
+    return bbox;
+}
+
+/**
+ * Compute a bounding sphere of a set of positions using the Ritter's algorithm.
+ *
+ * The initial sphere is defined by the most distant pair among the extreme positions along the
+ * x, y and z axes (EPOS-6), which is then grown to contain the positions outside of it.
+ *
+ * @param positions The positions.
+ * @param count The number of positions.
+ *
+ * @return The bounding sphere, empty if there are no positions.
+ */
+BSphere ComputeBSphere(const glm::vec3* positions, const size_t count)
+{
+    if (count == 0)
+        return BSphere();
+
+    glm::vec3 min[3] = { positions[0], positions[0], positions[0] };
+    glm::vec3 max[3] = { positions[0], positions[0], positions[0] };
+    FindExtremes(positions, count, min, max);
+
+    BSphere sphere = InitialSphere(min, max);
+    GrowSphere(positions, count, sphere);
+    return sphere;
+}
+
+/**
+ * Compute the bounding volumes of the positions (`a_Position` attribute) of a vertex stream.
+ *
+ * The positions are decoded by chunks instead of copying the complete stream. The bounding box
+ * and the extreme positions of the sphere are found in a single pass over the positions, and a
+ * second pass grows the sphere (the positions are decoded again only if there are several chunks).
+ *
+ * @param vertices The vertex data.
+ * @param count The number of vertices.
+ * @param layout The layout of the vertex data.
+ * @param decode The transformation used to decode the stored positions.
+ * @param bbox The bounding box of the positions.
+ * @param sphere The bounding sphere of the positions.
+ */
+void ComputeBounds(const void* vertices, const unsigned int count, const BufferLayout& layout,
+                   const glm::mat4& decode, BBox& bbox, BSphere& sphere)
+{
+    bbox = BBox();
+    sphere = BSphere();
+    if (count == 0)
+        return;
+
+    const char* data = static_cast<const char*>(vertices);
+    const size_t stride = layout.GetStride();
+    std::vector<glm::vec3> chunk(std::min(count, g_BoundsChunkSize));
+
+    // Bounding box and extreme positions
+    glm::vec3 min[3], max[3];
+    for (unsigned int first = 0; first < count; first += g_BoundsChunkSize)
+    {
+        unsigned int size = std::min(count - first, g_BoundsChunkSize);
+        if (!utils::Encoding::ReadPositions(data + first * stride, size, layout, decode, chunk.data()))
+            return;
+
+        if (first == 0)
+        {
+            std::fill(std::begin(min), std::end(min), chunk[0]);
+            std::fill(std::begin(max), std::end(max), chunk[0]);
+        }
+        size_t processed = ComputeBBoxVectorized(chunk.data(), size, bbox);
+        for (size_t i = processed; i < size; i++)
+            bbox.Extend(chunk[i]);
+        FindExtremes(chunk.data(), size, min, max);
+    }
+
+    // Bounding sphere
+    sphere = InitialSphere(min, max);
+    for (unsigned int first = 0; first < count; first += g_BoundsChunkSize)
+    {
+        unsigned int size = std::min(count - first, g_BoundsChunkSize);
+        if (count > g_BoundsChunkSize)
+            utils::Encoding::ReadPositions(data + first * stride, size, layout, decode, chunk.data());
+        GrowSphere(chunk.data(), size, sphere);
+    }
+}
+
+} // namespace Geometry
+} // namespace utils
@@ -0,0 +1,339 @@
+#include "enginepch.h"
+#include "Common/Renderer/Mesh/MeshSimplification.h"
+
+/**
+ * Represents the quadric error metric (sum of squared distances to a set of planes) of a vertex.
+ *
+ * The symmetric 4x4 matrix is stored with its 10 unique coefficients, together with the
+ * accumulated weight (area) of the planes.
+ */
+struct Quadric
+{
+    float a2 = 0.0f, b2 = 0.0f, c2 = 0.0f, d2 = 0.0f;
+    float ab = 0.0f, ac = 0.0f, ad = 0.0f;
+    float bc = 0.0f, bd = 0.0f, cd = 0.0f;
+    float w = 0.0f;
+
+    /// @brief Accumulate the planes of another quadric.
+    /// @param other The other quadric.
+    /// @return The accumulated quadric.
+    Quadric& operator+=(const Quadric& other)
+    {
+        a2 += other.a2; b2 += other.b2; c2 += other.c2; d2 += other.d2;
+        ab += other.ab; ac += other.ac; ad += other.ad;
+        bc += other.bc; bd += other.bd; cd += other.cd;
+        w += other.w;
+        return *this;
+    }
+};
+
+/**
+ * Represents a candidate half-edge collapse (a vertex merged into one of its neighbours).
+ */
+struct Collapse
+{
+    unsigned int source;    ///< Vertex removed by the collapse.
+    unsigned int target;    ///< Vertex kept by the collapse.
+    float error;            ///< Error introduced by the collapse.
+};
+
+/**
+ * Define the quadric of the plane containing a triangle, weighted by its area.
+ *
+ * @param p0 The first corner of the triangle.
+ * @param p1 The second corner of the triangle.
+ * @param p2 The third corner of the triangle.
+ *
+ * @return The quadric of the triangle plane.
+ */
+static Quadric TriangleQuadric(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2)
+{
+    Quadric q;
+
+    glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+    float length = glm::length(normal);
+    if (length <= 0.0f)
+        return q;
+
+    normal /= length;
+    float d = -glm::dot(normal, p0);
+    float weight = length * 0.5f;
+
+    q.a2 = normal.x * normal.x * weight; q.b2 = normal.y * normal.y * weight;
+    q.c2 = normal.z * normal.z * weight; q.d2 = d * d * weight;
+    q.ab = normal.x * normal.y * weight; q.ac = normal.x * normal.z * weight;
+    q.ad = normal.x * d * weight;
+    q.bc = normal.y * normal.z * weight; q.bd = normal.y * d * weight;
+    q.cd = normal.z * d * weight;
+    q.w = weight;
+
+    return q;
+}
+
+/**
+ * Evaluate the (area averaged) squared distance of a point to the planes of two quadrics.
+ *
+ * @param q0 The first quadric.
+ * @param q1 The second quadric.
+ * @param p The point to be evaluated.
+ *
+ * @return The error of the point.
+ */
+static float QuadricError(const Quadric& q0, const Quadric& q1, const glm::vec3& p)
+{
+    Quadric q = q0;
+    q += q1;
+
+    float error = q.a2 * p.x * p.x + q.b2 * p.y * p.y + q.c2 * p.z * p.z
+        + 2.0f * (q.ab * p.x * p.y + q.ac * p.x * p.z + q.bc * p.y * p.z)
+        + 2.0f * (q.ad * p.x + q.bd * p.y + q.cd * p.z) + q.d2;
+
+    return glm::abs(error) / glm::max(q.w, std::numeric_limits<float>::epsilon());
+}
+
+/**
+ * Find the vertices lying on open edges: the borders of the mesh, and the seams where
+ * vertices share the same position with different attributes (e.g. texture coordinates or
+ * normals), as the triangles on each side reference different vertices.
+ *
+ * @param indices The triangle indices.
+ * @param vertexCount The number of vertices.
+ *
+ * @return The flags marking the vertices on open edges.
+ */
+static std::vector<bool> FindOpenEdgeVertices(const std::vector<unsigned int>& indices,
+                                              const size_t vertexCount)
+{
+    auto key = [](uint64_t a, uint64_t b) { return (a << 32) | b; };
+
+    // Sorted set of the (directed) edges
+    std::vector<uint64_t> edges;
+    edges.reserve(indices.size());
+    for (size_t i = 0; i < indices.size(); i += 3)
+        for (unsigned int e = 0; e < 3; e++)
+            edges.push_back(key(indices[i + e], indices[i + (e + 1) % 3]));
+    std::sort(edges.begin(), edges.end());
+
+    // An edge is open if it has no opposite (twin) edge
+    std::vector<bool> open(vertexCount, false);
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        for (unsigned int e = 0; e < 3; e++)
+        {
+            unsigned int a = indices[i + e];
+            unsigned int b = indices[i + (e + 1) % 3];
+            if (!std::binary_search(edges.begin(), edges.end(), key(b, a)))
+                open[a] = open[b] = true;
+        }
+    }
+
+    return open;
+}
+
+/**
+ * Check if moving a vertex to the position of another one flips any of its triangles.
+ *
+ * @param collapse The collapse to be checked.
+ * @param points The vertex positions.
+ * @param indices The triangle indices.
+ * @param offsets The offsets of the triangles adjacent to each vertex.
+ * @param adjacency The triangles adjacent to each vertex.
+ *
+ * @return `true` if a triangle is flipped by the collapse.
+ */
+static bool IsFlipped(const Collapse& collapse, const std::vector<glm::vec3>& points,
+                      const std::vector<unsigned int>& indices,
+                      const std::vector<unsigned int>& offsets,
+                      const std::vector<unsigned int>& adjacency)
+{
+    for (unsigned int k = offsets[collapse.source]; k < offsets[collapse.source + 1]; k++)
+    {
+        const unsigned int* triangle = &indices[adjacency[k] * 3];
+        // Triangles containing the edge are removed by the collapse
+        if (triangle[0] == collapse.target || triangle[1] == collapse.target ||
+            triangle[2] == collapse.target)
+            continue;
+
+        glm::vec3 p[3], q[3];
+        for (unsigned int j = 0; j < 3; j++)
+        {
+            p[j] = points[triangle[j]];
+            q[j] = triangle[j] == collapse.source ? points[collapse.target] : p[j];
+        }
+
+        glm::vec3 n0 = glm::cross(p[1] - p[0], p[2] - p[0]);
+        glm::vec3 n1 = glm::cross(q[1] - q[0], q[2] - q[0]);
+        if (glm::dot(n0, n1) <= 0.0f)
+            return true;
+    }
+
+    return false;
+}
+
+namespace utils { namespace Geometry
+{
+
+/**
+ * Simplify a triangle mesh using quadric error metric edge collapses.
+ *
+ * The collapses are half-edge collapses (a vertex is merged into one of its neighbours), so the
+ * simplified mesh references the same vertices and can be rendered with the original vertex
+ * buffer. Vertices on open edges are never removed, which preserves the borders of the mesh
+ * and its attribute seams (UV and normal discontinuities).
+ *
+ * @param positions The vertex positions.
+ * @param indices The triangle indices.
+ * @param targetIndexCount The number of indices to be reached.
+ * @param maxError The maximum error allowed, relative to the mesh extent.
+ * @param resultError The error reached by the simplification, relative to the mesh extent
+ * (if defined).
+ *
+ * @return The indices of the simplified mesh. The target may not be reached if the remaining
+ * collapses exceed the error allowed.
+ */
+std::vector<unsigned int> SimplifyMesh(const std::vector<glm::vec3>& positions,
+                                       const std::vector<unsigned int>& indices,
+                                       const size_t targetIndexCount,
+                                       const float maxError,
+                                       float* resultError)
+{
+    CORE_ASSERT(indices.size() % 3 == 0, "The mesh indices do not define a list of triangles!");
+
+    std::vector<unsigned int> result = indices;
+    const size_t vertexCount = positions.size();
+    if (resultError)
+        *resultError = 0.0f;
+    if (result.size() <= targetIndexCount || vertexCount == 0)
+        return result;
+
+    // Normalize the positions, so the error is relative to the mesh extent
+    glm::vec3 min(std::numeric_limits<float>::max());
+    glm::vec3 max(std::numeric_limits<float>::lowest());
+    for (const auto& p : positions)
+    {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+    glm::vec3 extent = max - min;
+    float size = glm::max(glm::max(extent.x, extent.y), extent.z);
+    float scale = size > 0.0f ? 1.0f / size : 1.0f;
+
+    std::vector<glm::vec3> points(vertexCount);
+    for (size_t i = 0; i < vertexCount; i++)
+        points[i] = (positions[i] - min) * scale;
+
+    // Lock the borders and seams of the mesh
+    std::vector<bool> locked = FindOpenEdgeVertices(result, vertexCount);
+
+    // Define the quadric of each vertex from its triangles
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t i = 0; i < result.size(); i += 3)
+    {
+        Quadric q = TriangleQuadric(points[result[i]], points[result[i + 1]], points[result[i + 2]]);
+        for (unsigned int j = 0; j < 3; j++)
+            quadrics[result[i + j]] += q;
+    }
+
+    std::vector<unsigned int> remap(vertexCount);
+    std::vector<bool> collapsed(vertexCount);
+    std::vector<unsigned int> offsets, adjacency;
+    std::vector<Collapse> collapses;
+
+    const float maxCost = maxError * maxError;
+    float error = 0.0f;
+
+    // Each pass applies the cheapest collapses that do not share any vertex
+    while (result.size() > targetIndexCount)
+    {
+        // Define the triangles adjacent to each vertex
+        offsets.assign(vertexCount + 1, 0);
+        for (unsigned int index : result)
+            offsets[index + 1]++;
+        for (size_t i = 0; i < vertexCount; i++)
+            offsets[i + 1] += offsets[i];
+
+        adjacency.resize(result.size());
+        std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < result.size(); i++)
+            adjacency[fill[result[i]]++] = (unsigned int)(i / 3);
+
+        // Find the collapse candidates (each interior edge is visited twice, once per triangle)
+        collapses.clear();
+        for (size_t i = 0; i < result.size(); i += 3)
+        {
+            for (unsigned int e = 0; e < 3; e++)
+            {
+                unsigned int a = result[i + e];
+                unsigned int b = result[i + (e + 1) % 3];
+                if (a > b || (locked[a] && locked[b]))
+                    continue;
+
+                float costA = locked[a] ? std::numeric_limits<float>::max()
+                    : QuadricError(quadrics[a], quadrics[b], points[b]);
+                float costB = locked[b] ? std::numeric_limits<float>::max()
+                    : QuadricError(quadrics[a], quadrics[b], points[a]);
+
+                Collapse collapse = costA <= costB ? Collapse{ a, b, costA } : Collapse{ b, a, costB };
+                if (collapse.error <= maxCost)
+                    collapses.push_back(collapse);
+            }
+        }
+        if (collapses.empty())
+            break;
+
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& c0, const Collapse& c1) {
+            return c0.error < c1.error;
+        });
+
+        // Apply the collapses (each one removes two triangles on a manifold mesh)
+        for (size_t i = 0; i < vertexCount; i++)
+            remap[i] = (unsigned int)i;
+        std::fill(collapsed.begin(), collapsed.end(), false);
+
+        size_t triangles = result.size() / 3;
+        size_t applied = 0;
+        for (const auto& collapse : collapses)
+        {
+            if (triangles <= targetIndexCount / 3)
+                break;
+            if (collapsed[collapse.source] || collapsed[collapse.target])
+                continue;
+            if (IsFlipped(collapse, points, result, offsets, adjacency))
+                continue;
+
+            remap[collapse.source] = collapse.target;
+            collapsed[collapse.source] = collapsed[collapse.target] = true;
+            quadrics[collapse.target] += quadrics[collapse.source];
+
+            error = glm::max(error, collapse.error);
+            triangles = triangles > 2 ? triangles - 2 : 0;
+            applied++;
+        }
+        if (applied == 0)
+            break;
+
+        // Update the indices and remove the degenerated triangles
+        size_t count = 0;
+        for (size_t i = 0; i < result.size(); i += 3)
+        {
+            unsigned int a = remap[result[i]];
+            unsigned int b = remap[result[i + 1]];
+            unsigned int c = remap[result[i + 2]];
+            if (a == b || b == c || a == c)
+                continue;
+
+            result[count++] = a;
+            result[count++] = b;
+            result[count++] = c;
+        }
+        result.resize(count);
+    }
+
+    if (resultError)
+        *resultError = glm::sqrt(error);
+
+    return result;
+}
+
+} // namespace Geometry
+} // namespace utils
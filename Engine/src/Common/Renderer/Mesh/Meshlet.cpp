@@ -0,0 +1,180 @@
+#include "enginepch.h"
+#include "Common/Renderer/Mesh/Meshlet.h"
+
+/**
+ * Compute the bounding sphere and the normal cone of a meshlet.
+ *
+ * @param meshlet The meshlet to be updated.
+ * @param positions The vertex positions.
+ * @param indices The triangle indices of the meshlet.
+ */
+static void ComputeMeshletBounds(Meshlet& meshlet, const std::vector<glm::vec3>& positions,
+                                 const unsigned int* indices)
+{
+    const unsigned int count = meshlet.range.count;
+
+    // Bounding sphere (centered in the bounding box)
+    glm::vec3 min(std::numeric_limits<float>::max());
+    glm::vec3 max(std::numeric_limits<float>::lowest());
+    for (unsigned int i = 0; i < count; i++)
+    {
+        min = glm::min(min, positions[indices[i]]);
+        max = glm::max(max, positions[indices[i]]);
+    }
+    meshlet.center = (min + max) * 0.5f;
+
+    float radius = 0.0f;
+    for (unsigned int i = 0; i < count; i++)
+        radius = glm::max(radius, glm::length(positions[indices[i]] - meshlet.center));
+    meshlet.radius = radius;
+
+    // Normal cone (average normal, and the largest deviation of the triangle normals from it)
+    std::vector<glm::vec3> normals;
+    normals.reserve(count / 3);
+    glm::vec3 axis(0.0f);
+    for (unsigned int i = 0; i < count; i += 3)
+    {
+        const glm::vec3& p0 = positions[indices[i]];
+        glm::vec3 normal = glm::cross(positions[indices[i + 1]] - p0, positions[indices[i + 2]] - p0);
+        float length = glm::length(normal);
+        if (length <= 0.0f)
+            continue;
+
+        normals.push_back(normal / length);
+        axis += normals.back();
+    }
+
+    meshlet.coneCutoff = 1.0f;
+    if (normals.empty() || glm::length(axis) <= 0.0f)
+        return;
+
+    meshlet.coneAxis = glm::normalize(axis);
+    float minDot = 1.0f;
+    for (const auto& normal : normals)
+        minDot = glm::min(minDot, glm::dot(normal, meshlet.coneAxis));
+
+    // Wide cones (spread close to, or beyond, 90 degrees) are never culled
+    if (minDot > 0.1f)
+        meshlet.coneCutoff = glm::sqrt(1.0f - minDot * minDot);
+}
+
+namespace utils { namespace Geometry
+{
+
+/**
+ * Partition a triangle mesh into meshlets of connected triangles.
+ *
+ * The meshlets are grown greedily from a seed triangle, adding at each step the adjacent
+ * triangle that introduces the fewest new vertices, until the vertex or triangle limits are
+ * reached. The indices are reordered so the triangles of each meshlet are contiguous.
+ *
+ * @param positions The vertex positions.
+ * @param indices The triangle indices, reordered by meshlet on output.
+ * @param maxVertices The maximum number of unique vertices in a meshlet.
+ * @param maxTriangles The maximum number of triangles in a meshlet.
+ *
+ * @return The meshlets defining the mesh.
+ */
+std::vector<Meshlet> BuildMeshlets(const std::vector<glm::vec3>& positions,
+                                   std::vector<unsigned int>& indices,
+                                   const unsigned int maxVertices,
+                                   const unsigned int maxTriangles)
+{
+    CORE_ASSERT(indices.size() % 3 == 0, "The mesh indices do not define a list of triangles!");
+    CORE_ASSERT(maxVertices >= 3 && maxTriangles > 0, "Invalid meshlet limits!");
+
+    const size_t triangleCount = indices.size() / 3;
+    const size_t vertexCount = positions.size();
+    const unsigned int invalid = std::numeric_limits<unsigned int>::max();
+
+    // Define the triangles adjacent to each vertex
+    std::vector<unsigned int> offsets(vertexCount + 1, 0);
+    for (unsigned int index : indices)
+        offsets[index + 1]++;
+    for (size_t i = 0; i < vertexCount; i++)
+        offsets[i + 1] += offsets[i];
+
+    std::vector<unsigned int> adjacency(indices.size());
+    std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); i++)
+        adjacency[fill[indices[i]]++] = (unsigned int)(i / 3);
+
+    std::vector<bool> emitted(triangleCount, false);
+    // Meshlet currently containing each vertex
+    std::vector<unsigned int> owner(vertexCount, invalid);
+
+    std::vector<unsigned int> result;
+    result.reserve(indices.size());
+    std::vector<Meshlet> meshlets;
+    std::vector<unsigned int> vertices;
+
+    size_t seed = 0;
+    while (true)
+    {
+        // Start a new meshlet from the first triangle not yet emitted
+        while (seed < triangleCount && emitted[seed])
+            seed++;
+        if (seed == triangleCount)
+            break;
+
+        const unsigned int id = (unsigned int)meshlets.size();
+        Meshlet meshlet;
+        meshlet.range.offset = (unsigned int)result.size();
+        vertices.clear();
+
+        unsigned int triangle = (unsigned int)seed;
+        unsigned int triangles = 0;
+        while (triangle != invalid)
+        {
+            // Add the triangle to the meshlet
+            emitted[triangle] = true;
+            triangles++;
+            for (unsigned int j = 0; j < 3; j++)
+            {
+                unsigned int v = indices[triangle * 3 + j];
+                result.push_back(v);
+                if (owner[v] != id)
+                {
+                    owner[v] = id;
+                    vertices.push_back(v);
+                }
+            }
+            if (triangles == maxTriangles)
+                break;
+
+            // Select the adjacent triangle adding the fewest vertices
+            triangle = invalid;
+            unsigned int best = 3;
+            for (unsigned int i = 0; i < vertices.size() && best > 0; i++)
+            {
+                unsigned int v = vertices[i];
+                for (unsigned int k = offsets[v]; k < offsets[v + 1]; k++)
+                {
+                    unsigned int candidate = adjacency[k];
+                    if (emitted[candidate])
+                        continue;
+
+                    unsigned int added = 0;
+                    for (unsigned int j = 0; j < 3; j++)
+                        added += owner[indices[candidate * 3 + j]] != id ? 1 : 0;
+
+                    if (added < best && vertices.size() + added <= maxVertices)
+                    {
+                        best = added;
+                        triangle = candidate;
+                    }
+                }
+            }
+        }
+
+        meshlet.range.count = triangles * 3;
+        ComputeMeshletBounds(meshlet, positions, &result[meshlet.range.offset]);
+        meshlets.push_back(meshlet);
+    }
+
+    indices = std::move(result);
+    return meshlets;
+}
+
+} // namespace Geometry
+} // namespace utils
@@ -1,6 +1,9 @@
 #include "enginepch.h"
 #include "Common/Renderer/Model/AssimpModel.h"
 
+#include "Common/Renderer/Mesh/MeshUtils.h"
+#include "Common/Renderer/Mesh/MeshEncoding.h"
+
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
@@ -47,7 +50,8 @@ void AssimpModel::ProcessNode(aiNode *node, const aiScene *scene)
         // The node object only contains indices to index the actual
         // objects in the scene. The scene contains all the data
         aiMesh *mesh = scene->mMeshes[node->mMeshes[i]];
-        this->m_Meshes.push_back(ProcessMesh(mesh));
+        for (auto& chunk : ProcessMesh(mesh))
+            this->GetMeshAsset()->AddMesh(chunk);
     }
 
     // Then do the same for each child node
@@ -58,56 +62,62 @@ void AssimpModel::ProcessNode(aiNode *node, const aiScene *scene)
 }
 
 /**
- * Processes an ASSIMP mesh and creates a corresponding `Mesh` object.
+ * Processes an ASSIMP mesh and creates the corresponding `Mesh` objects.
+ *
+ * Large meshes are split into chunks that can be indexed using 16-bit values.
  *
  * @param mesh The ASSIMP mesh to be processed.
- * @return The processed `Mesh` object.
+ * @return The processed `Mesh` objects.
  */
-Mesh<AssimpVertexData> AssimpModel::ProcessMesh(aiMesh *mesh)
+std::vector<Mesh<AssimpVertexData>> AssimpModel::ProcessMesh(aiMesh *mesh)
 {
     // Mesh attributes
     // -----------------------
-    std::vector<AssimpVertexData> vertices;
+    std::vector<AssimpVertexData> vertices(mesh->mNumVertices);
     std::vector<unsigned int> indices;
     BufferLayout layout = {
-        { "a_Position", DataType::Vec4 },
-        { "a_TextureCoord", DataType::Vec2 },
-        { "a_Normal", DataType::Vec3 }
+        { "a_Position", DataType::Short4, true },
+        { "a_TextureCoord", DataType::Half2 },
+        { "a_Normal", DataType::Int2101010, true }
     };
     
+    // Define the quantization space
+    // -----------------------
+    static_assert(sizeof(aiVector3D) == sizeof(glm::vec3), "Unexpected ASSIMP vector type!");
+    BBox bounds = utils::Geometry::ComputeBBox(reinterpret_cast<const glm::vec3*>(mesh->mVertices),
+                                               mesh->mNumVertices);
+    glm::mat4 decode = mesh->mNumVertices ?
+        utils::Encoding::QuantizationTransform(bounds.min, bounds.max) : glm::mat4(1.0f);
+    
     // Process the vertex data
     // -----------------------
     // Check each mesh
     for (unsigned int i = 0; i < mesh->mNumVertices; i++)
     {
-        AssimpVertexData vertex;
+        AssimpVertexData& vertex = vertices[i];
 
         // Positions
-        vertex.position.x = mesh->mVertices[i].x;
-        vertex.position.y = mesh->mVertices[i].y;
-        vertex.position.z = mesh->mVertices[i].z;
-        vertex.position.w = 1.0f;
+        glm::vec3 position(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+        vertex.position = utils::Encoding::EncodePosition(position, decode);
 
         // Texture coordinates
+        glm::vec2 uv(0.0f, 0.0f);
         if (mesh->mTextureCoords[0])
         { // contains uv's?
-            vertex.uv.x = mesh->mTextureCoords[0][i].x;
-            vertex.uv.y = mesh->mTextureCoords[0][i].y;
+            uv.x = mesh->mTextureCoords[0][i].x;
+            uv.y = mesh->mTextureCoords[0][i].y;
         }
-        else
-            vertex.uv = glm::vec2(0.0f, 0.0f);
+        vertex.uv = utils::Encoding::EncodeTextureCoord(uv);
 
         // Normals
+        glm::vec3 normal(0.0f, 0.0f, 0.0f);
         if (mesh->HasNormals())
         {
-            vertex.normal.x = mesh->mNormals[i].x;
-            vertex.normal.y = mesh->mNormals[i].y;
-            vertex.normal.z = mesh->mNormals[i].z;
+            normal.x = mesh->mNormals[i].x;
+            normal.y = mesh->mNormals[i].y;
+            normal.z = mesh->mNormals[i].z;
         }
-        // Define the vertex of the model
-        vertices.push_back(vertex);
-        // Update its bounding box
-        this->UpdateBBoxWithVertex(vertex.position);
+        vertex.normal = utils::Encoding::EncodeNormal(normal);
     }
     
     // Process indices
@@ -121,5 +131,30 @@ Mesh<AssimpVertexData> AssimpModel::ProcessMesh(aiMesh *mesh)
             indices.push_back(face.mIndices[j]);
     }
     
-    return Mesh<AssimpVertexData>(vertices, indices, layout);
+    // Define the mesh(es)
+    // -----------------------
+    std::vector<Mesh<AssimpVertexData>> meshes;
+    for (auto& [chunkVertices, chunkIndices] : utils::Geometry::SplitMesh(vertices, indices))
+    {
+        Mesh<AssimpVertexData> chunk;
+        chunk.SetDecodeTransform(decode);
+        
+        // Keep (at least) the positions and indices until the levels of detail and meshlets are
+        // generated. The final residency policy is applied when the mesh is added to the asset
+        bool triangles = this->m_Asset->GetPrimitive() == PrimitiveType::Triangles;
+        bool lods = triangles && m_LODLevels > 1;
+        bool meshlets = triangles && m_Meshlets;
+        auto residency = this->m_Asset->GetResidency();
+        if ((lods || meshlets) && residency == MeshResidency::Discard)
+            residency = MeshResidency::Compact;
+        
+        chunk.SetResidency(residency);
+        chunk.DefineMesh(chunkVertices, chunkIndices, layout);
+        if (lods)
+            chunk.GenerateLODs(m_LODLevels);
+        if (meshlets)
+            chunk.GenerateMeshlets();
+        meshes.push_back(chunk);
+    }
+    return meshes;
 }
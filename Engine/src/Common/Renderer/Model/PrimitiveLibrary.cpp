@@ -0,0 +1,26 @@
+#include "enginepch.h"
+#include "Common/Renderer/Model/PrimitiveLibrary.h"
+
+/**
+ * Get the mesh of a primitive, generating it if it is not in the library yet.
+ *
+ * @param vertex The type of vertex data of the mesh.
+ * @param type The type of primitive.
+ * @param resolution The resolution of the primitive.
+ * @param generate The function generating the mesh (called while the library is locked).
+ *
+ * @return The (type-erased) mesh of the primitive.
+ */
+std::shared_ptr<void> PrimitiveLibrary::Get(const std::type_index& vertex, const PrimitiveGeometry type,
+                                            const int resolution,
+                                            const std::function<std::shared_ptr<void>()>& generate)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    
+    auto key = std::make_tuple(vertex, type, resolution);
+    auto it = m_Meshes.find(key);
+    if (it != m_Meshes.end())
+        return it->second;
+    
+    return m_Meshes.emplace(key, generate()).first->second;
+}
@@ -2,7 +2,6 @@
 #include "Common/Renderer/Renderer.h"
 
 #include "Common/Renderer/RendererCommand.h"
-#include "Common/Renderer/Material/LightedMaterial.h"
 
 #include <GL/glew.h>
 
@@ -11,6 +10,14 @@ std::unique_ptr<Renderer::SceneData> Renderer::s_SceneData = std::make_unique<Re
 
 static Renderer::RenderingStatistics g_Stats;
 
+// Size of the buffers allocated by the geometry pools (in bytes)
+static const unsigned int g_VertexPageSize = 32 * 1024 * 1024;
+static const unsigned int g_IndexPageSize = 16 * 1024 * 1024;
+// Size of the texture data uploaded each frame by the texture loader (in bytes)
+static const unsigned int g_TextureUploadBudget = 16 * 1024 * 1024;
+// Number of draws whose transformation matrices are streamed each frame without waiting for the GPU
+static const unsigned int g_TransformRingDraws = 16384;
+
 static const glm::mat4 g_TextureMatrix = glm::mat4(
     0.5f, 0.0f, 0.0f, 0.0f,
     0.0f, 0.5f, 0.0f, 0.0f,
@@ -24,6 +31,84 @@ static const glm::mat4 g_TextureMatrix = glm::mat4(
 void Renderer::Init()
 {
     RendererCommand::Init();
+    
+    // Query the optional features of the context
+    s_Capabilities.computeShaders = GLEW_VERSION_4_3 ||
+        (GLEW_ARB_compute_shader && GLEW_ARB_shader_storage_buffer_object);
+    s_Capabilities.indirectCount = GLEW_ARB_indirect_parameters;
+    s_Capabilities.drawParameters = GLEW_ARB_shader_draw_parameters;
+    s_Capabilities.bufferStorage = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+    s_Capabilities.directStateAccess = GLEW_VERSION_4_5 || GLEW_ARB_direct_state_access;
+    s_Capabilities.copyImage = GLEW_VERSION_4_3 || GLEW_ARB_copy_image;
+    s_Capabilities.textureCompressionS3TC = GLEW_EXT_texture_compression_s3tc;
+    s_Capabilities.textureCompressionBPTC = GLEW_VERSION_4_2 || GLEW_ARB_texture_compression_bptc;
+    
+    CORE_INFO("Renderer capabilities:");
+    CORE_INFO("  Compute shaders: {0}", s_Capabilities.computeShaders);
+    CORE_INFO("  Indirect draw count: {0}", s_Capabilities.indirectCount);
+    CORE_INFO("  Draw parameters: {0}", s_Capabilities.drawParameters);
+    CORE_INFO("  Persistent buffer mapping: {0}", s_Capabilities.bufferStorage);
+    CORE_INFO("  Direct state access: {0}", s_Capabilities.directStateAccess);
+    CORE_INFO("  Image copies: {0}", s_Capabilities.copyImage);
+    CORE_INFO("  S3TC texture compression: {0}", s_Capabilities.textureCompressionS3TC);
+    CORE_INFO("  BPTC texture compression: {0}", s_Capabilities.textureCompressionBPTC);
+    
+    // Define the memory pools of the geometry
+    s_VertexPool = std::make_shared<BufferPool>(g_VertexPageSize);
+    s_IndexPool = std::make_shared<BufferPool>(g_IndexPageSize);
+    s_PrimitiveLibrary = std::make_shared<PrimitiveLibrary>();
+    
+    // Define the ring streaming the transformation matrices of each draw (each one padded to the
+    // binding alignment)
+    unsigned int alignment = RingBuffer::QueryAlignment();
+    unsigned int stride = ((unsigned int)sizeof(TransformData) + alignment - 1) / alignment * alignment;
+    s_TransformRing = std::make_unique<RingBuffer>(g_TransformRingDraws * stride);
+    
+    // Define the workers of the CPU work split across threads (all the hardware threads except
+    // the calling one, which also takes a share of the work)
+    s_ThreadPool = std::make_shared<ThreadPool>();
+    
+    // Define the loader of the textures
+    s_TextureLoader = std::make_shared<TextureLoader>(g_TextureUploadBudget);
+    s_TextureLibrary = std::make_shared<TextureLibrary>(s_TextureLoader);
+}
+
+/**
+ * Release the resources of the renderer, while the context is still current (the objects still
+ * used elsewhere are released with their last reference).
+ */
+void Renderer::Shutdown()
+{
+    // Wait for the texture workers and release the staging buffers
+    s_TextureLibrary.reset();
+    s_TextureLoader.reset();
+    
+    // Release the materials, the primitives and the memory pools of the geometry
+    s_MaterialLibrary.Clear();
+    s_PrimitiveLibrary.reset();
+    s_VertexPool.reset();
+    s_IndexPool.reset();
+    s_TransformRing.reset();
+    
+    // Wait for the pending CPU work
+    s_ThreadPool.reset();
+}
+
+/**
+ * Start a new frame, waiting until the GPU has consumed the transformation matrices written into
+ * the same region of the ring buffer some frames earlier.
+ */
+void Renderer::BeginFrame()
+{
+    s_TransformRing->BeginFrame();
+}
+
+/**
+ * End the frame, once all its draw calls have been submitted.
+ */
+void Renderer::EndFrame()
+{
+    s_TransformRing->EndFrame();
 }
 
 /**
@@ -103,14 +188,37 @@ void Renderer::Clear(const glm::vec4& color, const BufferState& buffersActive)
  *
  * @param vao The VertexArray containing the vertex and index buffers for rendering.
  * @param primitive The type of primitive to be drawn (e.g., Points, Lines, Triangles).
- * @param useIndexBuffer Whether to use the index buffer for rendering or not.
+ * @param ranges The ranges of the index buffer to be drawn (the complete buffer if empty).
  */
-void Renderer::Draw(const std::shared_ptr<VertexArray>& vao, const PrimitiveType &primitive)
+void Renderer::Draw(const std::shared_ptr<VertexArray>& vao, const PrimitiveType &primitive,
+                    const std::vector<IndexRange> &ranges)
 {
     vao->Bind();
-    vao->GetIndexBuffer()->Bind();
-    glDrawElements(utils::OpenGL::PrimitiveTypeToOpenGLType(primitive),
-                   vao->GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr);
+    const auto& ibo = vao->GetIndexBuffer();
+    ibo->Bind();
+    
+    GLenum mode = utils::OpenGL::PrimitiveTypeToOpenGLType(primitive);
+    GLenum type = utils::OpenGL::IndexTypeToOpenGLType(ibo->GetType());
+    unsigned int size = utils::OpenGL::GetSizeOfIndexType(ibo->GetType());
+    size_t base = ibo->GetOffset();
+    
+    // Draw the complete buffer, a single range, or multiple ranges using a single call
+    if (ranges.empty())
+        glDrawElements(mode, ibo->GetCount(), type, reinterpret_cast<const void*>(base));
+    else if (ranges.size() == 1)
+        glDrawElements(mode, ranges[0].count, type,
+                       reinterpret_cast<const void*>(base + (size_t)ranges[0].offset * size));
+    else
+    {
+        std::vector<GLsizei> counts(ranges.size());
+        std::vector<const void*> offsets(ranges.size());
+        for (size_t i = 0; i < ranges.size(); i++)
+        {
+            counts[i] = ranges[i].count;
+            offsets[i] = reinterpret_cast<const void*>(base + (size_t)ranges[i].offset * size);
+        }
+        glMultiDrawElements(mode, counts.data(), type, offsets.data(), (GLsizei)ranges.size());
+    }
     
     g_Stats.drawCalls++;
 }
@@ -122,42 +230,149 @@ void Renderer::Draw(const std::shared_ptr<VertexArray>& vao, const PrimitiveType
  * @param shader The shader program.
  * @param transform The transformation matrix of the geometry (model matrix).
  * @param primitive The type of primitive to be drawn (e.g., Points, Lines, Triangles).
- * @param useIndexBuffer Whether to use the index buffer for rendering or not.
+ * @param ranges The ranges of the index buffer to be drawn (the complete buffer if empty).
  */
-
 void Renderer::Draw(const std::shared_ptr<VertexArray>& vao, const std::shared_ptr<Material>& material,
-                    const glm::mat4 &transform, const PrimitiveType &primitive)
+                    const glm::mat4 &transform, const PrimitiveType &primitive,
+                    const std::vector<IndexRange> &ranges)
 {
     // Bind the material and set the corresponding information into
     // it for the shading
+    PrepareMaterial(material, transform);
+    
+    // Render the geometry
+    Draw(vao, primitive, ranges);
+    
+    // Unbind the material
+    material->Unbind();
+}
+
+/**
+ * Render primitives using the draw commands stored in a buffer (one command per draw).
+ *
+ * If the number of commands is sourced from a buffer but the context cannot read it
+ * (`GL_ARB_indirect_parameters`), all the commands are executed, so the unused ones must
+ * have been reset to zero.
+ *
+ * @param vao The VertexArray containing the vertex and index buffers for rendering.
+ * @param commands The buffer with the draw commands (`DrawElementsIndirectCommand`).
+ * @param maxCount The maximum number of commands executed.
+ * @param drawCount The buffer with the number of commands to be executed (all if null).
+ * @param primitive The type of primitive to be drawn (e.g., Points, Lines, Triangles).
+ */
+void Renderer::DrawIndirect(const std::shared_ptr<VertexArray>& vao, const StorageBuffer& commands,
+                            const unsigned int maxCount, const StorageBuffer* drawCount,
+                            const PrimitiveType &primitive)
+{
+    vao->Bind();
+    const auto& ibo = vao->GetIndexBuffer();
+    ibo->Bind();
+    
+    GLenum mode = utils::OpenGL::PrimitiveTypeToOpenGLType(primitive);
+    GLenum type = utils::OpenGL::IndexTypeToOpenGLType(ibo->GetType());
+    
+    commands.Bind(StorageTarget::DrawIndirect);
+    if (drawCount && s_Capabilities.indirectCount)
+    {
+        drawCount->Bind(StorageTarget::Parameter);
+        glMultiDrawElementsIndirectCountARB(mode, type, nullptr, 0, (GLsizei)maxCount, 0);
+        drawCount->Unbind(StorageTarget::Parameter);
+    }
+    else
+        glMultiDrawElementsIndirect(mode, type, nullptr, (GLsizei)maxCount, 0);
+    commands.Unbind(StorageTarget::DrawIndirect);
+    
+    g_Stats.drawCalls++;
+}
+
+/**
+ * Render primitives using the draw commands stored in a buffer (one command per draw).
+ *
+ * @param vao The VertexArray containing the vertex and index buffers for rendering.
+ * @param material The material used for the shading.
+ * @param commands The buffer with the draw commands (`DrawElementsIndirectCommand`).
+ * @param maxCount The maximum number of commands executed.
+ * @param drawCount The buffer with the number of commands to be executed (all if null).
+ * @param transform The transformation matrix of the geometry (model matrix).
+ * @param primitive The type of primitive to be drawn (e.g., Points, Lines, Triangles).
+ */
+void Renderer::DrawIndirect(const std::shared_ptr<VertexArray>& vao,
+                            const std::shared_ptr<Material>& material,
+                            const StorageBuffer& commands, const unsigned int maxCount,
+                            const StorageBuffer* drawCount, const glm::mat4 &transform,
+                            const PrimitiveType &primitive)
+{
+    PrepareMaterial(material, transform);
+    DrawIndirect(vao, commands, maxCount, drawCount, primitive);
+    material->Unbind();
+}
+
+/**
+ * Execute a compute shader. Its uniforms must have been defined beforehand.
+ *
+ * @param shader The compute shader.
+ * @param groups The number of work groups in each dimension.
+ * @param barriers The accesses that must see the memory written by the shader afterwards.
+ */
+void Renderer::Dispatch(const std::shared_ptr<ComputeShader>& shader, const glm::uvec3& groups,
+                        const BarrierState& barriers)
+{
+    if (groups.x == 0 || groups.y == 0 || groups.z == 0)
+        return;
+    
+    shader->Bind();
+    glDispatchCompute(groups.x, groups.y, groups.z);
+    Barrier(barriers);
+    
+    g_Stats.dispatchCalls++;
+}
+
+/**
+ * Make the memory written by the shaders visible to the operations that follow.
+ *
+ * @param barriers The accesses to be synchronized.
+ */
+void Renderer::Barrier(const BarrierState& barriers)
+{
+    GLbitfield mask = utils::OpenGL::BarrierStateToOpenGLMask(barriers);
+    if (mask != 0)
+        glMemoryBarrier(mask);
+}
+
+/**
+ * Bind a material and set the scene information (transformations, view) into its shader.
+ *
+ * @param material The material used for the shading.
+ * @param transform The transformation matrix of the geometry (model matrix).
+ */
+void Renderer::PrepareMaterial(const std::shared_ptr<Material>& material, const glm::mat4 &transform)
+{
     material->Bind();
     
-    // Set the model, view, and projection matrices in the shader
-    material->GetShader()->SetMat4("u_Transform.Model", transform);
-    material->GetShader()->SetMat4("u_Transform.View", s_SceneData->ViewMatrix);
-    material->GetShader()->SetMat4("u_Transform.Projection", s_SceneData->ProjectionMatrix);
+    // Define the model, view, and projection matrices of the draw
+    TransformData data;
+    data.Model = transform;
+    data.View = s_SceneData->ViewMatrix;
+    data.Projection = s_SceneData->ProjectionMatrix;
+    data.Texture = g_TextureMatrix;
 
     // Check the flags for the material
     auto& flags = material->GetMaterialFlags();
     if (flags.ViewDirection)
         material->GetShader()->SetVec3("u_View.Position", s_SceneData->ViewPosition);
     if (flags.NormalMatrix)
-        material->GetShader()->SetMat3("u_Transform.Normal", glm::mat3(glm::transpose(glm::inverse(transform))));
+        data.Normal = glm::mat3x4(glm::mat3(glm::transpose(glm::inverse(transform))));
     
-    auto lightedMaterial = std::dynamic_pointer_cast<LightedMaterial>(material);
-    if (lightedMaterial)
-    {
-        // Check the flags for the lighted material
-        auto& lightFlags = lightedMaterial->GetLightFlags();
-        if (lightFlags.ShadowProperties)
-            material->GetShader()->SetMat4("u_Transform.Texture", g_TextureMatrix);
-    }
+    // Continue into the next region if the frame draws more than a region holds (e.g. while
+    // precomputing the environment maps), once the GPU has consumed it
+    if (s_TransformRing->GetFrameSize() - s_TransformRing->GetUsedSize() <
+        sizeof(TransformData) + s_TransformRing->GetAlignment())
+        s_TransformRing->NextRegion();
     
-    // Render the geometry
-    Draw(vao, primitive);
-    
-    // Unbind the material
-    material->Unbind();
+    // Stream the matrices and bind them to the transform block of the shader
+    RingAllocation allocation = s_TransformRing->Push(data);
+    s_TransformRing->BindRange(StorageTarget::Uniform, (unsigned int)UniformBinding::Transform,
+                               allocation);
 }
 
 /**
@@ -210,6 +425,21 @@ void Renderer::SetDepthFunction(const DepthFunction depth)
 void Renderer::SetFaceCulling(const FaceCulling culling)
 {
     glCullFace(utils::OpenGL::CullingToOpenGLType(culling));
+    s_FaceCulling = culling;
+}
+
+/**
+ * Enable or disable the face culling.
+ *
+ * @param enabled Set to `true` to discard the faces defined by `SetFaceCulling()`.
+ */
+void Renderer::SetFaceCullingEnabled(const bool enabled)
+{
+    if (enabled)
+        glEnable(GL_CULL_FACE);
+    else
+        glDisable(GL_CULL_FACE);
+    s_FaceCullingEnabled = enabled;
 }
 
 /**
@@ -251,3 +481,21 @@ Renderer::RenderingStatistics Renderer::GetStats()
     return g_Stats;
 }
 
+/**
+ * Defragment the memory pools of the geometry and release their unused buffers.
+ *
+ * The geometry is moved on the GPU, so this should be called at load boundaries (e.g. after
+ * unloading a scene) rather than every frame.
+ */
+void Renderer::CompactBuffers()
+{
+    for (auto& pool : { s_VertexPool, s_IndexPool })
+    {
+        if (!pool)
+            continue;
+        
+        pool->Defragment();
+        pool->Trim();
+    }
+}
+
@@ -0,0 +1,40 @@
+#include "enginepch.h"
+#include "Common/Renderer/Shader/ComputeShader.h"
+
+#include "Common/Renderer/Renderer.h"
+
+/**
+ * Generate a compute shader.
+ *
+ * @param name The name for the shader.
+ * @param filePath Path to the source file.
+ */
+ComputeShader::ComputeShader(const std::string& name, const std::filesystem::path& filePath)
+{
+    CORE_ASSERT(Renderer::GetCapabilities().computeShaders,
+                "Compute shaders are not supported by the current context!");
+
+    m_Shader = Shader::Create(name, filePath);
+    m_WorkGroupSize = m_Shader->GetWorkGroupSize();
+}
+
+/**
+ * Generate a compute shader.
+ *
+ * @param filePath Path to the source file.
+ */
+ComputeShader::ComputeShader(const std::filesystem::path& filePath)
+    : ComputeShader(filePath.stem().string(), filePath)
+{}
+
+/**
+ * Get the number of work groups required to cover a number of invocations.
+ *
+ * @param invocations The number of invocations in each dimension (e.g. the pixels of an image).
+ *
+ * @return The number of work groups in each dimension.
+ */
+glm::uvec3 ComputeShader::GetGroupCount(const glm::uvec3& invocations) const
+{
+    return (invocations + m_WorkGroupSize - glm::uvec3(1)) / m_WorkGroupSize;
+}
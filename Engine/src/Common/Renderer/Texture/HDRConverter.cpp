@@ -0,0 +1,290 @@
+#include "enginepch.h"
+#include "Common/Renderer/Texture/HDRConverter.h"
+
+#include "Common/Renderer/Renderer.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define CONVERTER_SIMD_SSE
+#endif
+
+// Minimum number of rows converted by each thread
+static const int g_RowsPerThread = 32;
+
+// Largest value of the shared exponent format (511/512 * 2^16)
+static const float g_MaxSharedExponent = 65408.0f;
+
+// Largest finite value of the half-float format
+static const float g_MaxHalf = 65504.0f;
+
+// --------------------------------------------
+// Packing
+// --------------------------------------------
+
+/**
+ * Clamp a value within the range of a packed format, converting the negative values (and NaN)
+ * to zero.
+ *
+ * @param value The value.
+ * @param maximum The largest value of the format.
+ *
+ * @return The clamped value.
+ */
+static float ClampValue(const float value, const float maximum)
+{
+    return value > 0.0f ? std::min(value, maximum) : 0.0f;
+}
+
+/**
+ * Pack a color into the shared exponent format, where the three mantissas are scaled by the
+ * exponent of the largest channel (see EXT_texture_shared_exponent).
+ *
+ * @param red The red channel (clamped).
+ * @param green The green channel (clamped).
+ * @param blue The blue channel (clamped).
+ *
+ * @return The packed color.
+ */
+static uint32_t PackSharedExponent(const float red, const float green, const float blue)
+{
+    // Exponent of the largest channel (its floor of log2, read from the float bits)
+    float maximum = std::max(std::max(red, green), blue);
+    uint32_t bits;
+    std::memcpy(&bits, &maximum, sizeof(float));
+    int exponent = std::max((int)(bits >> 23) - 127, -16) + 16;
+    
+    // Scale of the mantissas (the largest one rounding up to 512 requires the next exponent)
+    uint32_t scaleBits = (uint32_t)(151 - exponent) << 23;
+    float scale;
+    std::memcpy(&scale, &scaleBits, sizeof(float));
+    if ((uint32_t)(maximum * scale + 0.5f) == 512)
+    {
+        exponent++;
+        scale *= 0.5f;
+    }
+    
+    return (uint32_t)(red * scale + 0.5f) | ((uint32_t)(green * scale + 0.5f) << 9) |
+           ((uint32_t)(blue * scale + 0.5f) << 18) | ((uint32_t)exponent << 27);
+}
+
+#ifdef CONVERTER_SIMD_SSE
+/**
+ * Pack four colors into the shared exponent format.
+ *
+ * @param red The red channels (clamped).
+ * @param green The green channels (clamped).
+ * @param blue The blue channels (clamped).
+ *
+ * @return The packed colors.
+ */
+static __m128i PackSharedExponentSSE(const __m128 red, const __m128 green, const __m128 blue)
+{
+    const __m128 half = _mm_set1_ps(0.5f);
+    
+    // Exponent of the largest channels (SSE2 has no signed maximum)
+    __m128 maximum = _mm_max_ps(_mm_max_ps(red, green), blue);
+    __m128i exponent = _mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(maximum), 23), _mm_set1_epi32(127));
+    __m128i low = _mm_cmplt_epi32(exponent, _mm_set1_epi32(-16));
+    exponent = _mm_or_si128(_mm_andnot_si128(low, exponent), _mm_and_si128(low, _mm_set1_epi32(-16)));
+    exponent = _mm_add_epi32(exponent, _mm_set1_epi32(16));
+    
+    // Scale of the mantissas (the largest ones rounding up to 512 require the next exponent)
+    __m128i scale = _mm_slli_epi32(_mm_sub_epi32(_mm_set1_epi32(151), exponent), 23);
+    __m128i mantissa = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(maximum, _mm_castsi128_ps(scale)), half));
+    __m128i overflow = _mm_cmpeq_epi32(mantissa, _mm_set1_epi32(512));
+    exponent = _mm_sub_epi32(exponent, overflow);
+    scale = _mm_sub_epi32(scale, _mm_and_si128(overflow, _mm_set1_epi32(1 << 23)));
+    
+    __m128 factor = _mm_castsi128_ps(scale);
+    __m128i r = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(red, factor), half));
+    __m128i g = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(green, factor), half));
+    __m128i b = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(blue, factor), half));
+    return _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 9)),
+                        _mm_or_si128(_mm_slli_epi32(b, 18), _mm_slli_epi32(exponent, 27)));
+}
+#endif
+
+/**
+ * Pack a row of texels into the shared exponent format.
+ *
+ * @param input The texels of the row.
+ * @param width The number of texels.
+ * @param channels The number of channels of the texels (the alpha channel is ignored).
+ * @param output The packed row.
+ */
+static void PackSharedExponentRow(const float *input, const int width, const int channels,
+                                  uint32_t *output)
+{
+    int x = 0;
+#ifdef CONVERTER_SIMD_SSE
+    const __m128 zero = _mm_setzero_ps(), maximum = _mm_set1_ps(g_MaxSharedExponent);
+    for (; x + 4 <= width; x += 4)
+    {
+        const float* texel = input + (size_t)x * channels;
+        __m128 channel[3];
+        for (int c = 0; c < 3; c++)
+        {
+            __m128 value = _mm_setr_ps(texel[c], texel[channels + c], texel[2 * channels + c],
+                                       texel[3 * channels + c]);
+            channel[c] = _mm_min_ps(_mm_max_ps(value, zero), maximum);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + x),
+                         PackSharedExponentSSE(channel[0], channel[1], channel[2]));
+    }
+#endif
+    for (; x < width; x++)
+    {
+        const float* texel = input + (size_t)x * channels;
+        output[x] = PackSharedExponent(ClampValue(texel[0], g_MaxSharedExponent),
+                                       ClampValue(texel[1], g_MaxSharedExponent),
+                                       ClampValue(texel[2], g_MaxSharedExponent));
+    }
+}
+
+/**
+ * Pack a row of texels into half-floats.
+ *
+ * @param input The texels of the row.
+ * @param width The number of texels.
+ * @param channels The number of channels of the texels (the alpha channel is ignored).
+ * @param clamped The clamped color channels of the row (three floats per texel).
+ * @param output The packed row (three half-floats per texel).
+ */
+static void PackHalfRow(const float *input, const int width, const int channels, float *clamped,
+                        uint16_t *output)
+{
+    size_t count = (size_t)width * 3, i = 0;
+    if (channels == 3)
+    {
+#ifdef CONVERTER_SIMD_SSE
+        const __m128 zero = _mm_setzero_ps(), maximum = _mm_set1_ps(g_MaxHalf);
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_ps(clamped + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(input + i), zero), maximum));
+#endif
+        for (; i < count; i++)
+            clamped[i] = ClampValue(input[i], g_MaxHalf);
+    }
+    else
+    {
+        for (int x = 0; x < width; x++)
+        {
+            for (int c = 0; c < 3; c++)
+                clamped[x * 3 + c] = ClampValue(input[(size_t)x * channels + c], g_MaxHalf);
+        }
+    }
+    
+    // The conversion is selected for the instructions of the CPU (F16C if available)
+    utils::Pixels::FloatToHalf(clamped, output, count);
+}
+
+// --------------------------------------------
+// HDR converter
+// --------------------------------------------
+
+/**
+ * Define an HDR converter.
+ *
+ * @param format The format of the converted data (`RGB9E5` or `RGB16H`).
+ * @param threads The number of threads converting each level (the calling thread and the workers
+ * of the renderer thread pool if zero).
+ */
+HDRConverter::HDRConverter(const TextureFormat format, const unsigned int threads)
+    : m_Format(format), m_Threads(threads)
+{
+    const auto& pool = Renderer::GetThreadPool();
+    if (m_Threads == 0)
+        m_Threads = pool ? pool->GetThreadCount() + 1 : 1;
+}
+
+/**
+ * Convert a floating-point image into the packed format of the converter.
+ *
+ * @param data The image data (tightly packed rows of floats).
+ * @param width The width of the image.
+ * @param height The height of the image.
+ * @param channels The number of channels of the image (RGB or RGBA, the alpha is discarded).
+ * @param mipmaps Convert the complete mip chain after the base level.
+ *
+ * @return The data of each level, from the base level.
+ */
+std::vector<std::vector<uint8_t>> HDRConverter::Convert(const float *data, const int width,
+                                                        const int height, const int channels,
+                                                        const bool mipmaps) const
+{
+    CORE_ASSERT(IsSupported(m_Format), "The converter format must be a packed HDR format!");
+    CORE_ASSERT(data && width > 0 && height > 0 && (channels == 3 || channels == 4),
+                "Invalid image for the HDR converter!");
+    
+    std::vector<std::vector<uint8_t>> levels;
+    levels.emplace_back(utils::OpenGL::TextureFormatToImageSize(m_Format, width, height));
+    ConvertLevel(data, width, height, channels, levels.back().data());
+    if (!mipmaps || (width == 1 && height == 1))
+        return levels;
+    
+    // Filter the mipmaps in floating-point space, releasing each one once converted
+    MipmapSettings settings = m_Mipmaps;
+    settings.Threads = settings.Threads > 0 ? settings.Threads : m_Threads;
+    auto chain = MipmapGenerator(settings).Generate(data, width, height, channels == 4 ?
+                                                    TextureFormat::RGBA32F : TextureFormat::RGB32F);
+    for (unsigned int i = 0; i < chain.size(); i++)
+    {
+        int levelWidth = std::max(width >> (i + 1), 1), levelHeight = std::max(height >> (i + 1), 1);
+        levels.emplace_back(utils::OpenGL::TextureFormatToImageSize(m_Format, levelWidth, levelHeight));
+        ConvertLevel(reinterpret_cast<const float*>(chain[i].data()), levelWidth, levelHeight, channels,
+                     levels.back().data());
+        std::vector<uint8_t>().swap(chain[i]);
+    }
+    return levels;
+}
+
+/**
+ * Convert the rows of a level, splitting them among the threads.
+ *
+ * @param image The floating-point image of the level.
+ * @param width The width of the level.
+ * @param height The height of the level.
+ * @param channels The number of channels of the image.
+ * @param output The converted level.
+ */
+void HDRConverter::ConvertLevel(const float *image, const int width, const int height,
+                                const int channels, uint8_t *output) const
+{
+    size_t rowSize = utils::OpenGL::TextureFormatToImageSize(m_Format, width, 1);
+    bool shared = m_Format == TextureFormat::RGB9E5;
+    
+    auto convertRows = [=](const int begin, const int end)
+    {
+        std::vector<float> clamped(shared ? 0 : (size_t)width * 3);
+        for (int y = begin; y < end; y++)
+        {
+            const float* row = image + (size_t)y * width * channels;
+            if (shared)
+                PackSharedExponentRow(row, width, channels, reinterpret_cast<uint32_t*>(output + y * rowSize));
+            else
+                PackHalfRow(row, width, channels, clamped.data(), reinterpret_cast<uint16_t*>(output + y * rowSize));
+        }
+    };
+    
+    // Small levels are converted by the calling thread only, the others are split with the workers
+    // of the renderer thread pool
+    const auto& pool = Renderer::GetThreadPool();
+    int threads = pool ? std::clamp(height / g_RowsPerThread, 1, (int)m_Threads) : 1;
+    if (threads > 1)
+        pool->ParallelFor(height, threads, convertRows);
+    else
+        convertRows(0, height);
+}
+
+/**
+ * Check if a format can be produced by the converter.
+ *
+ * @param format The texture format.
+ *
+ * @return `true` if the format is a packed HDR format (both are core since OpenGL 3.0).
+ */
+bool HDRConverter::IsSupported(const TextureFormat format)
+{
+    return format == TextureFormat::RGB9E5 || format == TextureFormat::RGB16H;
+}
@@ -0,0 +1,804 @@
+#include "enginepch.h"
+#include "Common/Renderer/Texture/KTXTexture.h"
+
+#include "Common/Renderer/Texture/HDRConverter.h"
+
+#include <stb_image.h>
+
+#ifdef RENDERER_USE_ZSTD
+    #include <zstd.h>
+#endif
+
+#include <cstring>
+#include <numeric>
+
+// Identifier at the beginning of every KTX2 file
+static const uint8_t g_Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+// Supercompression schemes
+static const uint32_t g_SchemeNone = 0;
+static const uint32_t g_SchemeZstd = 2;
+
+// Compression level used when writing supercompressed files
+static const int g_ZstdLevel = 12;
+
+// Application stored in the written files
+static const char* g_Writer = "Pixel Core";
+
+/**
+ * Represents the header of a KTX2 file (including the index of its sections).
+ */
+struct KTXHeader
+{
+    uint8_t identifier[12];
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t layerCount;
+    uint32_t faceCount;
+    uint32_t levelCount;
+    uint32_t supercompressionScheme;
+    
+    uint32_t dfdByteOffset;
+    uint32_t dfdByteLength;
+    uint32_t kvdByteOffset;
+    uint32_t kvdByteLength;
+    uint64_t sgdByteOffset;
+    uint64_t sgdByteLength;
+};
+static_assert(sizeof(KTXHeader) == 80, "The KTX2 header must not be padded!");
+
+/**
+ * Represents the location of a level in a KTX2 file.
+ */
+struct KTXLevel
+{
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+
+/**
+ * Represents the correspondence between a texture format and its Vulkan format (used by KTX2).
+ */
+struct KTXFormat
+{
+    TextureFormat format;   ///< Texture format.
+    uint32_t vkFormat;      ///< Vulkan format.
+    uint32_t typeSize;      ///< Size of the data type of each channel (in bytes).
+};
+
+// Formats supported, the first entry of each texture format being the one written
+static const KTXFormat g_Formats[] = {
+    { TextureFormat::R8, 9, 1 },        { TextureFormat::RG8, 16, 1 },
+    { TextureFormat::RGB8, 23, 1 },     { TextureFormat::RGBA8, 37, 1 },
+    { TextureFormat::R8UI, 13, 1 },     { TextureFormat::RG8UI, 20, 1 },
+    { TextureFormat::RGB8UI, 27, 1 },   { TextureFormat::RGBA8UI, 41, 1 },
+    { TextureFormat::R16F, 76, 2 },     { TextureFormat::RG16F, 83, 2 },
+    { TextureFormat::RGB16F, 90, 2 },   { TextureFormat::RGBA16F, 97, 2 },
+    { TextureFormat::R32F, 100, 4 },    { TextureFormat::RG32F, 103, 4 },
+    { TextureFormat::RGB32F, 106, 4 },  { TextureFormat::RGBA32F, 109, 4 },
+    { TextureFormat::BC1, 131, 1 },     { TextureFormat::BC3, 137, 1 },
+    { TextureFormat::BC4, 139, 1 },     { TextureFormat::BC5, 141, 1 },
+    { TextureFormat::BC7, 145, 1 },     { TextureFormat::RGB9E5, 123, 4 },
+    // Half floats uploaded without conversion (only written, read back as RGB16F)
+    { TextureFormat::RGB16H, 90, 2 },
+    // sRGB and alpha variants (only read)
+    { TextureFormat::RGB8, 29, 1 },     { TextureFormat::RGBA8, 43, 1 },
+    { TextureFormat::BC1, 132, 1 },     { TextureFormat::BC1, 133, 1 },
+    { TextureFormat::BC1, 134, 1 },     { TextureFormat::BC3, 138, 1 },
+    { TextureFormat::BC7, 146, 1 },
+};
+
+// --------------------------------------------
+// Formats
+// --------------------------------------------
+
+/**
+ * Find the KTX2 description of a texture format.
+ *
+ * @param format The texture format.
+ *
+ * @return The format description, nullptr if the format cannot be stored.
+ */
+static const KTXFormat* FindFormat(const TextureFormat format)
+{
+    for (const auto& entry : g_Formats)
+    {
+        if (entry.format == format)
+            return &entry;
+    }
+    return nullptr;
+}
+
+/**
+ * Find the texture format corresponding to a Vulkan format.
+ *
+ * @param vkFormat The Vulkan format.
+ *
+ * @return The format description, nullptr if the format is not supported.
+ */
+static const KTXFormat* FindFormat(const uint32_t vkFormat)
+{
+    for (const auto& entry : g_Formats)
+    {
+        if (entry.vkFormat == vkFormat)
+            return &entry;
+    }
+    return nullptr;
+}
+
+/**
+ * Verify if the levels of a texture format are stored as 16-bit floats (but uploaded as 32-bit
+ * floats).
+ *
+ * @param format The texture format.
+ *
+ * @return `true` if the format is a 16-bit float format.
+ */
+static bool IsHalfFloatFormat(const TextureFormat format)
+{
+    return format == TextureFormat::R16F || format == TextureFormat::RG16F ||
+           format == TextureFormat::RGB16F || format == TextureFormat::RGBA16F;
+}
+
+/**
+ * Define the size of a level of a single face, as stored in the file.
+ *
+ * @param format The texture format.
+ * @param width The width of the level.
+ * @param height The height of the level.
+ *
+ * @return The size of the level (in bytes).
+ */
+static size_t ComputeFileLevelSize(const TextureFormat format, const int width, const int height)
+{
+    size_t size = utils::OpenGL::TextureFormatToImageSize(format, width, height);
+    return IsHalfFloatFormat(format) ? size / 2 : size;
+}
+
+/**
+ * Create the data format descriptor (DFD) of a texture format, describing how the texel blocks
+ * are laid out (required by the readers that do not know the Vulkan formats).
+ *
+ * @param format The texture format.
+ * @param typeSize The size of the data type of each channel (in bytes).
+ * @param supercompressed Whether the levels are supercompressed (their planes have no fixed size).
+ *
+ * @return The words of the descriptor (including its total size).
+ */
+static std::vector<uint32_t> CreateDescriptor(const TextureFormat format, const uint32_t typeSize,
+                                              const bool supercompressed)
+{
+    // Color models (Khronos data format specification)
+    uint32_t model = 1;     // RGBSDA
+    uint32_t dimensions = 0, bytes = 0;
+    
+    // Each sample: bit offset, bit length, channel (with its qualifiers), lower and upper values
+    std::vector<std::array<uint32_t, 5>> samples;
+    if (utils::OpenGL::IsCompressedFormat(format))
+    {
+        dimensions = 3 | (3 << 8);
+        bytes = utils::OpenGL::TextureFormatToBlockSize(format);
+        switch (format)
+        {
+            case TextureFormat::BC1:
+                model = 128;
+                samples.push_back({ 0, 64, 0, 0, 0xFFFFFFFF });
+                break;
+            case TextureFormat::BC3:
+                model = 130;
+                samples.push_back({ 0, 64, 15, 0, 0xFFFFFFFF });
+                samples.push_back({ 64, 64, 0, 0, 0xFFFFFFFF });
+                break;
+            case TextureFormat::BC4:
+                model = 131;
+                samples.push_back({ 0, 64, 0, 0, 0xFFFFFFFF });
+                break;
+            case TextureFormat::BC5:
+                model = 132;
+                samples.push_back({ 0, 64, 0, 0, 0xFFFFFFFF });
+                samples.push_back({ 64, 64, 1, 0, 0xFFFFFFFF });
+                break;
+            default:
+                model = 134;
+                samples.push_back({ 0, 128, 0, 0, 0xFFFFFFFF });
+                break;
+        }
+    }
+    else if (format == TextureFormat::RGB9E5)
+    {
+        // Mantissa and shared exponent of each channel
+        bytes = typeSize;
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            samples.push_back({ i * 9, 9, i, 0, 8448 });
+            samples.push_back({ 27, 5, i | 0x20, 15, 31 });
+        }
+    }
+    else
+    {
+        int channels = utils::OpenGL::TextureFormatToChannelNumber(format);
+        GLenum type = utils::OpenGL::TextureFormatToOpenGLDataType(format);
+        bool isFloat = type == GL_FLOAT || type == GL_HALF_FLOAT;
+        bool isInteger = format == TextureFormat::R8UI || format == TextureFormat::RG8UI ||
+                         format == TextureFormat::RGB8UI || format == TextureFormat::RGBA8UI;
+        bytes = typeSize * channels;
+        for (int i = 0; i < channels; i++)
+        {
+            uint32_t channel = (i == 3 ? 15 : i) | (isFloat ? 0xC0 : 0);
+            uint32_t lower = isFloat ? 0xBF800000 : 0;
+            uint32_t upper = isFloat ? 0x3F800000 : (isInteger ? 1 : 255);
+            samples.push_back({ i * typeSize * 8, typeSize * 8, channel, lower, upper });
+        }
+    }
+    
+    uint32_t blockSize = 24 + 16 * (uint32_t)samples.size();
+    std::vector<uint32_t> words = {
+        4 + blockSize,                      // Total size
+        0,                                  // Vendor (Khronos) and descriptor type (basic)
+        2 | (blockSize << 16),              // Version and size of the block
+        model | (1 << 8) | (1 << 16),       // Model, primaries (BT.709), transfer (linear), flags
+        dimensions,                         // Texel block dimensions (minus one)
+        supercompressed ? 0 : bytes,        // Bytes of the first plane
+        0
+    };
+    for (const auto& sample : samples)
+    {
+        words.push_back(sample[0] | ((sample[1] - 1) << 16) | (sample[2] << 24));
+        words.push_back(0);
+        words.push_back(sample[3]);
+        words.push_back(sample[4]);
+    }
+    return words;
+}
+
+/**
+ * Append a key/value pair to the key/value data of a file, padded to four bytes.
+ *
+ * @param data The key/value data.
+ * @param key The key.
+ * @param value The value (a string).
+ */
+static void AppendKeyValue(std::vector<uint8_t>& data, const std::string& key, const std::string& value)
+{
+    uint32_t length = (uint32_t)(key.size() + value.size() + 2);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&length);
+    data.insert(data.end(), bytes, bytes + sizeof(length));
+    data.insert(data.end(), key.begin(), key.end());
+    data.push_back(0);
+    data.insert(data.end(), value.begin(), value.end());
+    data.push_back(0);
+    data.resize((data.size() + 3) / 4 * 4, 0);
+}
+
+// --------------------------------------------
+// KTX texture
+// --------------------------------------------
+
+/**
+ * Define a texture to be written, allocating all its levels.
+ *
+ * @param spec The specifications of the texture (size and format).
+ * @param levels The number of levels stored.
+ * @param faces The number of faces (six for cube maps).
+ */
+KTXTexture::KTXTexture(const TextureSpecification& spec, const unsigned int levels,
+                       const unsigned int faces)
+    : m_Width(spec.Width), m_Height(spec.Height), m_Format(spec.Format), m_Faces(faces)
+{
+    CORE_ASSERT(m_Width > 0 && m_Height > 0 && FindFormat(m_Format), "Invalid KTX texture specification!");
+    CORE_ASSERT(faces == 1 || faces == 6, "KTX textures must have one or six faces!");
+    Allocate(std::max(levels, 1u));
+}
+
+/**
+ * Allocate the storage of the levels owned by the texture.
+ *
+ * @param levels The number of levels.
+ */
+void KTXTexture::Allocate(const unsigned int levels)
+{
+    m_Levels.assign(levels, nullptr);
+    m_Storage.assign(levels, {});
+    for (unsigned int i = 0; i < levels; i++)
+    {
+        m_Storage[i].resize(GetLevelSize(i) * m_Faces);
+        m_Levels[i] = m_Storage[i].data();
+    }
+}
+
+/**
+ * Read a texture from a KTX2 file.
+ *
+ * @param filePath The file path.
+ *
+ * @return `true` if the texture has been read.
+ */
+bool KTXTexture::Load(const std::filesystem::path& filePath)
+{
+    std::string name = filePath.filename().string();
+    m_Levels.clear();
+    m_Storage.clear();
+    
+    m_File = std::make_unique<MappedFile>(filePath);
+    if (!m_File->IsOpen() || m_File->GetSize() < sizeof(KTXHeader))
+    {
+        CORE_WARN("Failed to read: " + name);
+        return false;
+    }
+    const uint8_t* file = m_File->GetData();
+    size_t fileSize = m_File->GetSize();
+    
+    // Verify the header
+    KTXHeader header;
+    std::memcpy(&header, file, sizeof(header));
+    if (std::memcmp(header.identifier, g_Identifier, sizeof(g_Identifier)) != 0)
+    {
+        CORE_WARN(name + " is not a KTX2 file!");
+        return false;
+    }
+    
+    const KTXFormat* format = FindFormat(header.vkFormat);
+    if (!format)
+    {
+        CORE_WARN("Data format of " + name + " not supported!");
+        return false;
+    }
+    if (header.pixelWidth == 0 || header.pixelHeight == 0 || header.pixelDepth > 1 ||
+        header.layerCount > 1 || (header.faceCount != 1 && header.faceCount != 6))
+    {
+        CORE_WARN("Only 2D textures and cube maps can be read from " + name + "!");
+        return false;
+    }
+#ifdef RENDERER_USE_ZSTD
+    if (header.supercompressionScheme != g_SchemeNone && header.supercompressionScheme != g_SchemeZstd)
+#else
+    if (header.supercompressionScheme != g_SchemeNone)
+#endif
+    {
+        CORE_WARN("Supercompression of " + name + " not supported!");
+        return false;
+    }
+    
+    m_Width = (int)header.pixelWidth;
+    m_Height = (int)header.pixelHeight;
+    m_Format = format->format;
+    m_Faces = header.faceCount;
+    m_GenerateMipmaps = header.levelCount == 0;
+    
+    unsigned int levels = std::max(header.levelCount, 1u);
+    if (sizeof(KTXHeader) + levels * sizeof(KTXLevel) > fileSize)
+    {
+        CORE_WARN("Invalid level index in " + name + "!");
+        return false;
+    }
+    
+    // Read the orientation of the rows (top to bottom by default)
+    m_Flipped = false;
+    if (header.kvdByteLength > 0 && (uint64_t)header.kvdByteOffset + header.kvdByteLength <= fileSize)
+    {
+        const uint8_t* entry = file + header.kvdByteOffset;
+        const uint8_t* end = entry + header.kvdByteLength;
+        while (entry + sizeof(uint32_t) <= end)
+        {
+            uint32_t length = 0;
+            std::memcpy(&length, entry, sizeof(length));
+            const char* pair = reinterpret_cast<const char*>(entry + sizeof(length));
+            if (length == 0 || entry + sizeof(length) + length > end)
+                break;
+            
+            std::string key(pair, strnlen(pair, length));
+            if (key == "KTXorientation" && key.size() + 2 < length)
+                m_Flipped = pair[key.size() + 2] == 'u';
+            
+            entry += sizeof(length) + (length + 3) / 4 * 4;
+        }
+    }
+    
+    // Read the levels (directly from the mapping if possible)
+    m_Levels.assign(levels, nullptr);
+    m_Storage.assign(levels, {});
+    bool mapped = false;
+    for (unsigned int i = 0; i < levels; i++)
+    {
+        KTXLevel level;
+        std::memcpy(&level, file + sizeof(KTXHeader) + i * sizeof(KTXLevel), sizeof(level));
+        
+        size_t expected = ComputeFileLevelSize(m_Format, std::max(m_Width >> i, 1),
+                                               std::max(m_Height >> i, 1)) * m_Faces;
+        if (level.byteOffset > fileSize || level.byteLength > fileSize - level.byteOffset)
+        {
+            CORE_WARN("Invalid level index in " + name + "!");
+            return false;
+        }
+        
+        const uint8_t* data = file + level.byteOffset;
+#ifdef RENDERER_USE_ZSTD
+        if (header.supercompressionScheme == g_SchemeZstd)
+        {
+            m_Storage[i].resize(expected);
+            size_t size = ZSTD_decompress(m_Storage[i].data(), expected, data, (size_t)level.byteLength);
+            if (ZSTD_isError(size) || size != expected)
+            {
+                CORE_WARN("Failed to decompress the levels of " + name + "!");
+                return false;
+            }
+            data = m_Storage[i].data();
+        }
+        else
+#endif
+        if (level.byteLength != expected)
+        {
+            CORE_WARN("Invalid level size in " + name + "!");
+            return false;
+        }
+        
+        // Expand the 16-bit floats
+        if (IsHalfFloatFormat(m_Format))
+        {
+            std::vector<uint8_t> expanded(expected * 2);
+            utils::Pixels::HalfToFloat(reinterpret_cast<const uint16_t*>(data),
+                                       reinterpret_cast<float*>(expanded.data()), expected / sizeof(uint16_t));
+            m_Storage[i] = std::move(expanded);
+            data = m_Storage[i].data();
+        }
+        
+        m_Levels[i] = data;
+        mapped = mapped || data == file + level.byteOffset;
+    }
+    
+    // Release the mapping if all the levels have been copied
+    if (!mapped)
+        m_File.reset();
+    return true;
+}
+
+/**
+ * Write the texture into a KTX2 file. The levels are stored from the smallest to the largest,
+ * so the files can be streamed.
+ *
+ * @param filePath The file path.
+ * @param supercompress Supercompress the levels with zstd (if the engine is built with zstd).
+ *
+ * @return `true` if the file has been written.
+ */
+bool KTXTexture::Save(const std::filesystem::path& filePath, const bool supercompress) const
+{
+    const KTXFormat* format = FindFormat(m_Format);
+    if (!format || m_Levels.empty())
+    {
+        CORE_WARN("Invalid texture for " + filePath.filename().string() + "!");
+        return false;
+    }
+    
+    bool zstd = supercompress;
+#ifndef RENDERER_USE_ZSTD
+    if (zstd)
+        CORE_WARN("The engine is built without zstd, " + filePath.filename().string() + " is not supercompressed!");
+    zstd = false;
+#endif
+
+    // Prepare the data of the levels (with the 16-bit floats packed)
+    unsigned int levels = GetLevelCount();
+    std::vector<std::vector<uint8_t>> packed(levels);
+    std::vector<const uint8_t*> data(levels);
+    std::vector<KTXLevel> index(levels);
+    for (unsigned int i = 0; i < levels; i++)
+    {
+        size_t size = GetLevelSize(i) * m_Faces;
+        data[i] = m_Levels[i];
+        if (IsHalfFloatFormat(m_Format))
+        {
+            packed[i].resize(size / 2);
+            utils::Pixels::FloatToHalf(reinterpret_cast<const float*>(m_Levels[i]),
+                                       reinterpret_cast<uint16_t*>(packed[i].data()), size / sizeof(float));
+            data[i] = packed[i].data();
+            size /= 2;
+        }
+        index[i].byteLength = size;
+        index[i].uncompressedByteLength = size;
+
+#ifdef RENDERER_USE_ZSTD
+        if (zstd)
+        {
+            std::vector<uint8_t> compressed(ZSTD_compressBound(size));
+            size_t length = ZSTD_compress(compressed.data(), compressed.size(), data[i], size, g_ZstdLevel);
+            if (ZSTD_isError(length))
+            {
+                CORE_WARN("Failed to supercompress " + filePath.filename().string() + "!");
+                return false;
+            }
+            compressed.resize(length);
+            packed[i] = std::move(compressed);
+            data[i] = packed[i].data();
+            index[i].byteLength = length;
+        }
+#endif
+    }
+    
+    // Define the sections of the file
+    std::vector<uint32_t> descriptor = CreateDescriptor(m_Format, format->typeSize, zstd);
+    std::vector<uint8_t> keyValues;
+    AppendKeyValue(keyValues, "KTXorientation", m_Flipped ? "ru" : "rd");
+    AppendKeyValue(keyValues, "KTXwriter", g_Writer);
+    
+    KTXHeader header = {};
+    std::memcpy(header.identifier, g_Identifier, sizeof(g_Identifier));
+    header.vkFormat = format->vkFormat;
+    header.typeSize = format->typeSize;
+    header.pixelWidth = (uint32_t)m_Width;
+    header.pixelHeight = (uint32_t)m_Height;
+    header.faceCount = m_Faces;
+    header.levelCount = m_GenerateMipmaps ? 0 : levels;
+    header.supercompressionScheme = zstd ? g_SchemeZstd : g_SchemeNone;
+    header.dfdByteOffset = (uint32_t)(sizeof(KTXHeader) + levels * sizeof(KTXLevel));
+    header.dfdByteLength = (uint32_t)(descriptor.size() * sizeof(uint32_t));
+    header.kvdByteOffset = header.dfdByteOffset + header.dfdByteLength;
+    header.kvdByteLength = (uint32_t)keyValues.size();
+    
+    // The levels are aligned to their texel blocks (and four bytes) unless supercompressed
+    uint64_t alignment = 1;
+    if (!zstd)
+    {
+        uint64_t block = utils::OpenGL::IsCompressedFormat(m_Format) ?
+            utils::OpenGL::TextureFormatToBlockSize(m_Format) :
+            (uint64_t)ComputeFileLevelSize(m_Format, 1, 1);
+        alignment = std::lcm(block, (uint64_t)4);
+    }
+    uint64_t offset = header.kvdByteOffset + header.kvdByteLength;
+    for (int i = (int)levels - 1; i >= 0; i--)
+    {
+        offset = (offset + alignment - 1) / alignment * alignment;
+        index[i].byteOffset = offset;
+        offset += index[i].byteLength;
+    }
+    
+    // Write into a temporary file first, so the readers never see a partial file
+    std::filesystem::path temporary = utils::Files::TemporaryPath(filePath);
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            CORE_WARN("Failed to write: " + filePath.filename().string());
+            return false;
+        }
+        
+        auto write = [&file](const void *bytes, const size_t size)
+        {
+            file.write(static_cast<const char*>(bytes), (std::streamsize)size);
+        };
+        write(&header, sizeof(header));
+        write(index.data(), index.size() * sizeof(KTXLevel));
+        write(descriptor.data(), descriptor.size() * sizeof(uint32_t));
+        write(keyValues.data(), keyValues.size());
+        
+        uint64_t position = header.kvdByteOffset + header.kvdByteLength;
+        const char padding[16] = {};
+        for (int i = (int)levels - 1; i >= 0; i--)
+        {
+            write(padding, (size_t)(index[i].byteOffset - position));
+            write(data[i], (size_t)index[i].byteLength);
+            position = index[i].byteOffset + index[i].byteLength;
+        }
+        
+        if (!file)
+        {
+            CORE_WARN("Failed to write: " + filePath.filename().string());
+            return false;
+        }
+    }
+    
+    std::error_code error;
+    std::filesystem::rename(temporary, filePath, error);
+    if (error)
+    {
+        CORE_WARN("Failed to write: " + filePath.filename().string());
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Convert a source image (e.g. PNG, JPEG or HDR) into a KTX2 file, with all its mipmaps, so it
+ * is loaded without any decoding from then on.
+ *
+ * @param source The image file path.
+ * @param destination The KTX2 file path.
+ * @param options The options decoding the image (as done when loading the image directly).
+ * @param compress Compress the 8-bit images into the block-compressed format suited for their
+ * channels (if supported by the GPU), unless a format is requested by the options.
+ * @param quality The quality of the compression.
+ * @param supercompress Supercompress the levels with zstd.
+ * @param mipmaps The settings filtering the mipmaps (wrapping around the edges of repeated
+ * textures).
+ *
+ * @return `true` if the image has been converted.
+ */
+bool KTXTexture::Import(const std::filesystem::path& source, const std::filesystem::path& destination,
+                        const TextureLoadOptions& options, const bool compress,
+                        const EncoderQuality quality, const bool supercompress,
+                        const MipmapSettings& mipmaps)
+{
+    // Decode the image (flipped below with the pixel kernels)
+    stbi_set_flip_vertically_on_load_thread(false);
+    
+    std::string extension = source.extension().string();
+    bool hdr = extension == ".hdr";
+    
+    int width, height, channels;
+    void* data = hdr ? (void*)stbi_loadf(source.string().c_str(), &width, &height, &channels, 0) :
+                       (void*)stbi_load(source.string().c_str(), &width, &height, &channels, 0);
+    if (!data)
+    {
+        CORE_WARN("Failed to load: " + source.filename().string());
+        return false;
+    }
+    
+    // Define the format of the levels
+    TextureFormat compressed = TextureFormat::None;
+    if (!hdr && TextureEncoder::IsSupported(options.Format))
+        compressed = options.Format;
+    else if (!hdr && compress)
+        compressed = TextureEncoder::SelectFormat(channels, quality);
+    if (compress && !hdr && compressed == TextureFormat::None)
+        CORE_WARN("No compressed format supported for " + source.filename().string() + "!");
+    
+    bool packed = hdr && channels == 3 && HDRConverter::IsSupported(options.HDRFormat);
+    
+    // Expand the other 8-bit images into RGBA, uploaded without any conversion by the drivers
+    // (flipping them in the same pass), or flip the images in place
+    std::vector<uint8_t> expanded;
+    void* pixels = data;
+    int components = channels;
+    if (!hdr && compressed == TextureFormat::None && channels != 4)
+    {
+        expanded.resize((size_t)width * height * 4);
+        utils::Pixels::ExpandImageToRGBA(static_cast<const uint8_t*>(data), width, height, channels,
+                                         options.Flip, expanded.data());
+        pixels = expanded.data();
+        components = 4;
+    }
+    else if (options.Flip)
+    {
+        utils::Pixels::FlipVertically(data, (size_t)width * channels * (hdr ? sizeof(float) : 1),
+                                      height);
+    }
+    
+    // Premultiply the alpha before the colors are filtered (or compressed)
+    if (options.Premultiply && !hdr && components == 4)
+        utils::Pixels::PremultiplyAlpha(static_cast<uint8_t*>(pixels), (size_t)width * height);
+    
+    TextureSpecification spec;
+    utils::Texturing::UpdateSpecsTextureResource(spec, width, height, components, extension);
+    if (compressed != TextureFormat::None)
+        spec.Format = compressed;
+    else if (packed)
+        spec.Format = options.HDRFormat;
+    if (spec.Format == TextureFormat::None)
+    {
+        CORE_WARN("Data format of " + source.filename().string() + " not supported!");
+        stbi_image_free(data);
+        return false;
+    }
+    
+    unsigned int levels = 1;
+    for (int size = std::max(width, height); size > 1; size >>= 1)
+        levels++;
+    
+    KTXTexture texture(spec, levels);
+    texture.m_Flipped = options.Flip;
+    
+    // Build the mip chain
+    MipmapSettings settings = mipmaps;
+    settings.SRGB = settings.SRGB || options.SRGB;
+    settings.Wrap = settings.Wrap || spec.Wrap == TextureWrap::Repeat;
+    if (utils::OpenGL::IsCompressedFormat(spec.Format))
+    {
+        TextureEncoder encoder(quality);
+        encoder.SetMipmapSettings(settings);
+        std::vector<uint8_t> encoded = encoder.Encode(data, width, height, channels, spec.Format);
+        size_t offset = 0;
+        for (unsigned int i = 0; i < levels; i++)
+        {
+            texture.SetLevel(i, encoded.data() + offset);
+            offset += texture.GetLevelSize(i);
+        }
+    }
+    else if (packed)
+    {
+        HDRConverter converter(spec.Format);
+        converter.SetMipmapSettings(settings);
+        auto chain = converter.Convert(static_cast<const float*>(data), width, height, channels);
+        for (unsigned int i = 0; i < levels; i++)
+            texture.SetLevel(i, chain[i].data());
+    }
+    else
+    {
+        texture.SetLevel(0, pixels);
+        std::vector<std::vector<uint8_t>> chain = MipmapGenerator(settings).Generate(pixels, width, height,
+                                                                                     spec.Format);
+        for (unsigned int i = 1; i < levels; i++)
+            texture.SetLevel(i, chain[i - 1].data());
+    }
+    stbi_image_free(data);
+    
+    return texture.Save(destination, supercompress);
+}
+
+/**
+ * Copy the data of a level of the texture.
+ *
+ * @param level The level (zero for the base level).
+ * @param data The data of the level.
+ * @param face The face written.
+ */
+void KTXTexture::SetLevel(const unsigned int level, const void *data, const unsigned int face)
+{
+    CORE_ASSERT(level < m_Storage.size() && !m_Storage[level].empty() && face < m_Faces,
+                "The level is not owned by the KTX texture!");
+    std::memcpy(m_Storage[level].data() + face * GetLevelSize(level), data, GetLevelSize(level));
+}
+
+/**
+ * Get the data of a level of the texture.
+ *
+ * @param level The level (zero for the base level).
+ * @param face The face.
+ *
+ * @return The data of the level, as uploaded.
+ */
+const void* KTXTexture::GetLevel(const unsigned int level, const unsigned int face) const
+{
+    CORE_ASSERT(level < m_Levels.size() && face < m_Faces, "Invalid KTX texture level!");
+    return m_Levels[level] + face * GetLevelSize(level);
+}
+
+/**
+ * Get the size of a level of a single face, as uploaded.
+ *
+ * @param level The level (zero for the base level).
+ *
+ * @return The size of the level (in bytes).
+ */
+size_t KTXTexture::GetLevelSize(const unsigned int level) const
+{
+    return utils::OpenGL::TextureFormatToImageSize(m_Format, std::max(m_Width >> level, 1),
+                                                   std::max(m_Height >> level, 1));
+}
+
+/**
+ * Get the size of all the levels, as uploaded.
+ *
+ * @return The size of the data (in bytes).
+ */
+size_t KTXTexture::GetDataSize() const
+{
+    size_t size = 0;
+    for (unsigned int i = 0; i < GetLevelCount(); i++)
+        size += GetLevelSize(i) * m_Faces;
+    return size;
+}
+
+/**
+ * Update the specifications of a texture to receive the levels.
+ *
+ * @param spec The texture specifications.
+ */
+void KTXTexture::UpdateSpecification(TextureSpecification& spec) const
+{
+    spec.Width = m_Width;
+    spec.Height = m_Height;
+    spec.Format = m_Format;
+    spec.MipMaps = m_GenerateMipmaps || GetLevelCount() > 1;
+    
+    // Set default wrap and filter modes
+    if (spec.Wrap == TextureWrap::None)
+        spec.Wrap = IsHalfFloatFormat(m_Format) || HDRConverter::IsSupported(m_Format) ?
+            TextureWrap::ClampToEdge : TextureWrap::Repeat;
+    if (spec.Filter == TextureFilter::None)
+        spec.Filter = TextureFilter::Linear;
+}
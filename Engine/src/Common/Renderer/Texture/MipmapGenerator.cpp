@@ -0,0 +1,450 @@
+#include "enginepch.h"
+#include "Common/Renderer/Texture/MipmapGenerator.h"
+
+#include "Common/Renderer/Renderer.h"
+
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define MIPMAP_SIMD_SSE
+#endif
+
+// Minimum number of rows filtered by each thread
+static const int g_RowsPerThread = 32;
+
+// Half-width of the Kaiser filter (in texels of the source level) and its window shape
+static const int g_KaiserRadius = 3;
+static const float g_KaiserAlpha = 4.0f;
+
+// Number of texels converted at a time by the pixel kernels
+static const size_t g_ConversionChunk = 1024;
+
+// Number of iterations searching the alpha scale preserving the coverage
+static const int g_CoverageIterations = 12;
+
+// --------------------------------------------
+// Color spaces
+// --------------------------------------------
+
+/**
+ * Convert an image into linear RGBA floats (missing channels set to zero, alpha to one).
+ *
+ * @param data The image data.
+ * @param texels The number of texels.
+ * @param format The format of the image.
+ * @param srgb Whether the color channels of 8-bit images are sRGB encoded.
+ *
+ * @return The RGBA image.
+ */
+static std::vector<float> ConvertToLinear(const void *data, const size_t texels,
+                                          const TextureFormat format, const bool srgb)
+{
+    int channels = utils::OpenGL::TextureFormatToChannelNumber(format);
+    bool isFloat = utils::OpenGL::TextureFormatToOpenGLDataType(format) == GL_FLOAT;
+    
+    // Decode the 8-bit values in chunks with the pixel kernels (the alpha channel stays linear)
+    std::vector<float> values(isFloat ? 0 : g_ConversionChunk * channels);
+    
+    std::vector<float> image(texels * 4);
+    for (size_t first = 0; first < texels; first += g_ConversionChunk)
+    {
+        size_t count = std::min(texels - first, g_ConversionChunk);
+        const float* source = static_cast<const float*>(data) + first * channels;
+        if (!isFloat)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data) + first * channels;
+            if (srgb)
+                utils::Pixels::SRGBToLinear(bytes, values.data(), count * channels);
+            for (size_t i = 0; i < count * channels; i++)
+            {
+                if (!srgb || i % channels == 3)
+                    values[i] = (float)bytes[i] / 255.0f;
+            }
+            source = values.data();
+        }
+        
+        for (size_t i = 0; i < count; i++)
+        {
+            float* texel = image.data() + (first + i) * 4;
+            texel[0] = texel[1] = texel[2] = 0.0f;
+            texel[3] = 1.0f;
+            for (int c = 0; c < channels; c++)
+                texel[c] = source[i * channels + c];
+        }
+    }
+    return image;
+}
+
+/**
+ * Convert linear RGBA floats into the format of a level.
+ *
+ * @param image The RGBA image.
+ * @param texels The number of texels.
+ * @param format The format of the level.
+ * @param srgb Whether the color channels of 8-bit levels are sRGB encoded.
+ * @param alphaScale The scale applied to the alpha channel.
+ * @param output The data of the level.
+ */
+static void ConvertFromLinear(const float *image, const size_t texels, const TextureFormat format,
+                              const bool srgb, const float alphaScale, uint8_t *output)
+{
+    int channels = utils::OpenGL::TextureFormatToChannelNumber(format);
+    bool isFloat = utils::OpenGL::TextureFormatToOpenGLDataType(format) == GL_FLOAT;
+    
+    // Gather the channels of the level in chunks, encoded with the pixel kernels
+    std::vector<float> values(g_ConversionChunk * channels);
+    for (size_t first = 0; first < texels; first += g_ConversionChunk)
+    {
+        size_t count = std::min(texels - first, g_ConversionChunk);
+        float* destination = isFloat ? reinterpret_cast<float*>(output) + first * channels : values.data();
+        for (size_t i = 0; i < count; i++)
+        {
+            const float* texel = image + (first + i) * 4;
+            for (int c = 0; c < channels; c++)
+                destination[i * channels + c] = c == 3 ? texel[c] * alphaScale : texel[c];
+        }
+        if (isFloat)
+            continue;
+        
+        uint8_t* bytes = output + first * channels;
+        if (srgb)
+            utils::Pixels::LinearToSRGB(values.data(), bytes, count * channels);
+        for (size_t i = 0; i < count * channels; i++)
+        {
+            if (!srgb || i % channels == 3)
+                bytes[i] = (uint8_t)(std::clamp(values[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+    }
+}
+
+// --------------------------------------------
+// Alpha coverage
+// --------------------------------------------
+
+/**
+ * Compute the fraction of texels passing the alpha test.
+ *
+ * @param image The RGBA image.
+ * @param texels The number of texels.
+ * @param cutoff The alpha test threshold.
+ * @param scale The scale applied to the alpha channel.
+ *
+ * @return The coverage (between 0 and 1).
+ */
+static float ComputeCoverage(const float *image, const size_t texels, const float cutoff,
+                             const float scale)
+{
+    size_t covered = 0;
+    for (size_t i = 0; i < texels; i++)
+        covered += image[i * 4 + 3] * scale > cutoff ? 1 : 0;
+    return (float)covered / (float)texels;
+}
+
+/**
+ * Find the scale of the alpha channel of a level preserving the coverage of the base level.
+ *
+ * @param image The RGBA image of the level.
+ * @param texels The number of texels.
+ * @param cutoff The alpha test threshold.
+ * @param coverage The coverage of the base level.
+ *
+ * @return The alpha scale.
+ */
+static float FindAlphaScale(const float *image, const size_t texels, const float cutoff,
+                            const float coverage)
+{
+    float low = 0.0f, high = 4.0f, scale = 1.0f;
+    for (int i = 0; i < g_CoverageIterations; i++)
+    {
+        float current = ComputeCoverage(image, texels, cutoff, scale);
+        if (current < coverage)
+            low = scale;
+        else if (current > coverage)
+            high = scale;
+        else
+            break;
+        scale = 0.5f * (low + high);
+    }
+    return scale;
+}
+
+// --------------------------------------------
+// Filtering
+// --------------------------------------------
+
+/**
+ * Represents the taps of a filter downsampling by two.
+ */
+struct MipmapKernel
+{
+    std::vector<int> offsets;       ///< Offset of each tap from the first texel of the pair.
+    std::vector<float> weights;     ///< Normalized weight of each tap.
+};
+
+/**
+ * Compute the zeroth-order modified Bessel function of the first kind (Kaiser window).
+ *
+ * @param x The input value.
+ *
+ * @return The function value.
+ */
+static float Bessel(const float x)
+{
+    float sum = 1.0f, term = 1.0f;
+    for (int k = 1; k < 16; k++)
+    {
+        term *= (x / (2.0f * k)) * (x / (2.0f * k));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * Define the taps of a filter downsampling by two.
+ *
+ * @param filter The filter.
+ *
+ * @return The filter kernel.
+ */
+static MipmapKernel CreateKernel(const MipmapFilter filter)
+{
+    MipmapKernel kernel;
+    if (filter == MipmapFilter::Box)
+    {
+        kernel.offsets = { 0, 1 };
+        kernel.weights = { 0.5f, 0.5f };
+        return kernel;
+    }
+    
+    // Windowed sinc centered between the two texels, with the cutoff of the next level
+    float total = 0.0f;
+    for (int offset = 1 - g_KaiserRadius; offset <= g_KaiserRadius; offset++)
+    {
+        float d = (float)offset - 0.5f;
+        float x = std::numbers::pi_v<float> * d * 0.5f;
+        float sinc = std::abs(x) < 1e-6f ? 1.0f : std::sin(x) / x;
+        float t = d / (float)g_KaiserRadius;
+        float window = Bessel(g_KaiserAlpha * std::sqrt(std::max(1.0f - t * t, 0.0f))) / Bessel(g_KaiserAlpha);
+        
+        kernel.offsets.push_back(offset);
+        kernel.weights.push_back(sinc * window);
+        total += sinc * window;
+    }
+    for (auto& weight : kernel.weights)
+        weight /= total;
+    return kernel;
+}
+
+/**
+ * Get the texel read at a coordinate outside of the level.
+ *
+ * @param x The coordinate.
+ * @param size The size of the level.
+ * @param wrap Whether the texels wrap around the edges.
+ *
+ * @return The coordinate inside the level.
+ */
+static int Address(const int x, const int size, const bool wrap)
+{
+    if (wrap)
+        return ((x % size) + size) % size;
+    return std::clamp(x, 0, size - 1);
+}
+
+/**
+ * Run a function over ranges of rows, split between the calling thread and the thread pool of
+ * the renderer.
+ *
+ * @param rows The number of rows.
+ * @param threads The maximum number of threads.
+ * @param function The function filtering a range of rows (begin and end).
+ */
+static void ParallelRows(const int rows, const unsigned int threads,
+                         const std::function<void(int, int)>& function)
+{
+    const auto& pool = Renderer::GetThreadPool();
+    int count = pool ? std::clamp(rows / g_RowsPerThread, 1, (int)threads) : 1;
+    if (count > 1)
+        pool->ParallelFor(rows, count, function);
+    else
+        function(0, rows);
+}
+
+/**
+ * Accumulate a weighted row of RGBA texels.
+ *
+ * @param sum The accumulated row.
+ * @param row The row added.
+ * @param weight The weight of the row.
+ * @param count The number of floats of the rows.
+ */
+static void AccumulateRow(float *sum, const float *row, const float weight, const int count)
+{
+    int i = 0;
+#if defined(MIPMAP_SIMD_SSE)
+    const __m128 w = _mm_set1_ps(weight);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(sum + i, _mm_add_ps(_mm_loadu_ps(sum + i), _mm_mul_ps(w, _mm_loadu_ps(row + i))));
+#endif
+    for (; i < count; i++)
+        sum[i] += weight * row[i];
+}
+
+// --------------------------------------------
+// Mipmap generator
+// --------------------------------------------
+
+/**
+ * Define a mipmap generator.
+ *
+ * @param settings The settings of the generation.
+ */
+MipmapGenerator::MipmapGenerator(const MipmapSettings& settings)
+    : m_Settings(settings)
+{}
+
+/**
+ * Check if the mipmaps of a texture format can be generated.
+ *
+ * @param format The texture format.
+ *
+ * @return `true` if the format is a filterable 8-bit or float color format.
+ */
+bool MipmapGenerator::IsSupported(const TextureFormat format)
+{
+    switch (format)
+    {
+        case TextureFormat::R8:
+        case TextureFormat::RG8:
+        case TextureFormat::RGB8:
+        case TextureFormat::RGBA8:
+        case TextureFormat::R16F:
+        case TextureFormat::RG16F:
+        case TextureFormat::RGB16F:
+        case TextureFormat::RGBA16F:
+        case TextureFormat::R32F:
+        case TextureFormat::RG32F:
+        case TextureFormat::RGB32F:
+        case TextureFormat::RGBA32F:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Generate the mipmaps of an image, down to a single texel.
+ *
+ * @param data The image data (tightly packed rows, in the client format of the texture).
+ * @param width The width of the image.
+ * @param height The height of the image.
+ * @param format The format of the image.
+ *
+ * @return The data of each mipmap, from the first level below the base one.
+ */
+std::vector<std::vector<uint8_t>> MipmapGenerator::Generate(const void *data, const int width,
+                                                            const int height,
+                                                            const TextureFormat format) const
+{
+    CORE_ASSERT(IsSupported(format), "The mipmaps of the texture format cannot be generated!");
+    CORE_ASSERT(data && width > 0 && height > 0, "Invalid image for the mipmap generator!");
+    
+    bool srgb = m_Settings.SRGB && utils::OpenGL::TextureFormatToOpenGLDataType(format) != GL_FLOAT;
+    bool coverage = m_Settings.AlphaCutoff > 0.0f && utils::OpenGL::TextureFormatToChannelNumber(format) == 4;
+    
+    std::vector<float> image = ConvertToLinear(data, (size_t)width * height, format, srgb);
+    float baseCoverage = coverage ? ComputeCoverage(image.data(), (size_t)width * height,
+                                                    m_Settings.AlphaCutoff, 1.0f) : 0.0f;
+    
+    // Each level is downsampled from the previous one before being quantized
+    std::vector<std::vector<uint8_t>> levels;
+    int levelWidth = width, levelHeight = height;
+    while (levelWidth > 1 || levelHeight > 1)
+    {
+        image = Downsample(image, levelWidth, levelHeight);
+        levelWidth = std::max(levelWidth >> 1, 1);
+        levelHeight = std::max(levelHeight >> 1, 1);
+        
+        size_t texels = (size_t)levelWidth * levelHeight;
+        float alphaScale = coverage ? FindAlphaScale(image.data(), texels, m_Settings.AlphaCutoff,
+                                                     baseCoverage) : 1.0f;
+        
+        levels.emplace_back(utils::OpenGL::TextureFormatToImageSize(format, levelWidth, levelHeight));
+        ConvertFromLinear(image.data(), texels, format, srgb, alphaScale, levels.back().data());
+    }
+    return levels;
+}
+
+/**
+ * Downsample a level to the next one, filtering the rows and then the columns.
+ *
+ * @param image The RGBA image of the level.
+ * @param width The width of the level.
+ * @param height The height of the level.
+ *
+ * @return The RGBA image of the next level.
+ */
+std::vector<float> MipmapGenerator::Downsample(const std::vector<float>& image, const int width,
+                                               const int height) const
+{
+    static const MipmapKernel box = CreateKernel(MipmapFilter::Box);
+    static const MipmapKernel kaiser = CreateKernel(MipmapFilter::Kaiser);
+    const MipmapKernel& kernel = m_Settings.Filter == MipmapFilter::Box ? box : kaiser;
+    
+    int levelWidth = std::max(width >> 1, 1), levelHeight = std::max(height >> 1, 1);
+    const auto& pool = Renderer::GetThreadPool();
+    unsigned int threads = m_Settings.Threads > 0 ? m_Settings.Threads :
+        (pool ? pool->GetThreadCount() + 1 : 1);
+    bool wrap = m_Settings.Wrap;
+    
+    // Filter the rows (a dimension of one texel is kept as it is)
+    std::vector<float> rows((size_t)levelWidth * height * 4);
+    ParallelRows(height, threads, [&](const int begin, const int end)
+    {
+        for (int y = begin; y < end; y++)
+        {
+            const float* source = image.data() + (size_t)y * width * 4;
+            float* destination = rows.data() + (size_t)y * levelWidth * 4;
+            if (width == 1)
+            {
+                std::memcpy(destination, source, 4 * sizeof(float));
+                continue;
+            }
+            for (int x = 0; x < levelWidth; x++)
+            {
+                float* texel = destination + x * 4;
+                std::fill(texel, texel + 4, 0.0f);
+                for (size_t k = 0; k < kernel.offsets.size(); k++)
+                    AccumulateRow(texel, source + Address(2 * x + kernel.offsets[k], width, wrap) * 4,
+                                  kernel.weights[k], 4);
+            }
+        }
+    });
+    
+    // Filter the columns, a complete row at a time
+    std::vector<float> level((size_t)levelWidth * levelHeight * 4);
+    ParallelRows(levelHeight, threads, [&](const int begin, const int end)
+    {
+        int count = levelWidth * 4;
+        for (int y = begin; y < end; y++)
+        {
+            float* destination = level.data() + (size_t)y * count;
+            if (height == 1)
+            {
+                std::memcpy(destination, rows.data(), count * sizeof(float));
+                continue;
+            }
+            for (size_t k = 0; k < kernel.offsets.size(); k++)
+                AccumulateRow(destination, rows.data() + (size_t)Address(2 * y + kernel.offsets[k], height, wrap) * count,
+                              kernel.weights[k], count);
+            
+            // The negative lobes must not produce negative values
+            for (int i = 0; i < count; i++)
+                destination[i] = std::max(destination[i], 0.0f);
+        }
+    });
+    return level;
+}
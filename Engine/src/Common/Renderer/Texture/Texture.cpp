@@ -1,17 +1,23 @@
 #include "enginepch.h"
 #include "Common/Renderer/Texture/Texture.h"
 
+#include "Common/Renderer/Renderer.h"
+#include "Common/Renderer/Texture/TextureResidency.h"
+
 #include <GL/glew.h>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
 /**
- * Create a base texture.
+ * Create a base texture. With direct state access, the texture object is generated along with
+ * its storage (the target is required).
  */
 Texture::Texture()
 {
-    glGenTextures(1, &m_ID);
+    if (!UseDirectStateAccess())
+        glGenTextures(1, &m_ID);
+    TextureResidency::Register(this);
 }
 
 /**
@@ -22,7 +28,9 @@ Texture::Texture()
 Texture::Texture(const TextureSpecification& spec)
     : m_Spec(spec)
 {
-    glGenTextures(1, &m_ID);
+    if (!UseDirectStateAccess())
+        glGenTextures(1, &m_ID);
+    TextureResidency::Register(this);
 }
 
 /**
@@ -30,16 +38,52 @@ Texture::Texture(const TextureSpecification& spec)
  */
 Texture::~Texture()
 {
+    TextureResidency::Unregister(this);
     ReleaseTexture();
 }
 
+/**
+ * Estimate the video memory used by the texture, including all its levels, layers and faces.
+ *
+ * @return The size of the texture (in bytes), zero if it has no storage.
+ */
+size_t Texture::GetMemorySize() const
+{
+    if (m_ID == 0)
+        return 0;
+    
+    // The layers of an array are not part of its mip chain
+    TextureSpecification spec = m_Spec;
+    if (spec.Type == TextureType::TEXTURE2DARRAY)
+        spec.Depth = 0;
+    
+    size_t size = 0;
+    for (unsigned int i = 0; i < GetMipLevels(spec); i++)
+    {
+        size_t layers = 1;
+        if (m_Spec.Type == TextureType::TEXTURE3D)
+            layers = std::max(m_Spec.Depth >> i, 1);
+        else if (m_Spec.Type == TextureType::TEXTURE2DARRAY)
+            layers = std::max(m_Spec.Depth, 1);
+        else if (m_Spec.Type == TextureType::TEXTURECUBE)
+            layers = 6;
+        
+        size += layers * utils::OpenGL::TextureFormatToMemorySize(m_Spec.Format, std::max(m_Spec.Width >> i, 1),
+                                                                  std::max(m_Spec.Height >> i, 1));
+    }
+    return size;
+}
+
 /**
  * Release the resources of the texture.
  */
 void Texture::ReleaseTexture()
 {
     if (this)
+    {
         glDeleteTextures(1, &m_ID);
+        m_ID = 0;
+    }
 }
 
 /**
@@ -57,6 +101,9 @@ void Texture::Bind() const
  */
 void Texture::BindToTextureUnit(const unsigned int slot) const
 {
+    // Keep track of the textures in use (restored or kept by the residency manager)
+    m_LastBound = TextureResidency::GetFrame();
+    
     glActiveTexture(GL_TEXTURE0 + slot);
     Bind();
 }
@@ -68,3 +115,177 @@ void Texture::Unbind() const
 {
     glBindTexture(TextureTarget(), 0);
 }
+
+/**
+ * Prepare the texture to be (re)defined. With direct state access, a new texture object is
+ * generated, since the storage of the previous one cannot be redefined. Otherwise, the texture
+ * is bound to be edited.
+ */
+void Texture::BeginCreation()
+{
+    if (UseDirectStateAccess())
+    {
+        if (m_ID)
+            glDeleteTextures(1, &m_ID);
+        glCreateTextures(TextureTarget(), 1, &m_ID);
+    }
+    else
+        Bind();
+}
+
+/**
+ * Finish the definition of the texture, unbinding it if it was bound to be edited.
+ */
+void Texture::EndCreation() const
+{
+    if (!UseDirectStateAccess())
+        Unbind();
+}
+
+/**
+ * Set an integer parameter of the texture (bound if direct state access is not supported).
+ *
+ * @param name The parameter name.
+ * @param value The parameter value.
+ */
+void Texture::SetParameter(const GLenum name, const GLint value) const
+{
+    if (UseDirectStateAccess())
+        glTextureParameteri(m_ID, name, value);
+    else
+        glTexParameteri(TextureTarget(), name, value);
+}
+
+/**
+ * Set a vector parameter of the texture (bound if direct state access is not supported).
+ *
+ * @param name The parameter name.
+ * @param value The parameter values.
+ */
+void Texture::SetParameter(const GLenum name, const float *value) const
+{
+    if (UseDirectStateAccess())
+        glTextureParameterfv(m_ID, name, value);
+    else
+        glTexParameterfv(TextureTarget(), name, value);
+}
+
+/**
+ * Generate the mipmaps of the texture from its base level. The formats that cannot be rendered
+ * (see `utils::OpenGL::CanGenerateMipmaps()`) keep the levels uploaded instead.
+ */
+void Texture::GenerateMipmaps() const
+{
+    if (!utils::OpenGL::CanGenerateMipmaps(m_Spec.Format))
+        return;
+    
+    if (UseDirectStateAccess())
+        glGenerateTextureMipmap(m_ID);
+    else
+    {
+        Bind();
+        glGenerateMipmap(TextureTarget());
+    }
+}
+
+/**
+ * Upload the levels of a block-compressed texture. The mipmaps of compressed textures cannot be
+ * generated at runtime, so the data contains the complete chain (one level after the other) if
+ * they are specified.
+ *
+ * @param spec The specifications of the texture (or cube face).
+ * @param data The data of all the levels. If a pixel unpack buffer is bound, this is the offset
+ * of the data in the buffer.
+ * @param face The face of a cube map (-1 for 2D textures).
+ */
+void Texture::SetCompressedData(const TextureSpecification& spec, const void *data, const int face) const
+{
+    unsigned int levels = GetMipLevels(spec);
+    
+    // The bound texture only samples the levels defined
+    if (!UseDirectStateAccess())
+        SetParameter(GL_TEXTURE_MAX_LEVEL, (GLint)levels - 1);
+    
+    const uint8_t* level = static_cast<const uint8_t*>(data);
+    for (unsigned int i = 0; i < levels; i++)
+    {
+        SetLevelData(spec, i, level, face);
+        
+        // Keep the offset (instead of a null pointer) when the data is not provided
+        level += utils::OpenGL::TextureFormatToImageSize(spec.Format, std::max(spec.Width >> i, 1),
+                                                         std::max(spec.Height >> i, 1));
+    }
+}
+
+/**
+ * Upload the data of a single level of a texture (e.g. a pre-built mipmap), without
+ * regenerating the other levels.
+ *
+ * @param spec The specifications of the texture (or cube face).
+ * @param level The level (zero for the base level).
+ * @param data The data of the level. If a pixel unpack buffer is bound, this is the offset of the
+ * data in the buffer.
+ * @param face The face of a cube map (-1 for 2D textures).
+ */
+void Texture::SetLevelData(const TextureSpecification& spec, const unsigned int level,
+                           const void *data, const int face) const
+{
+    int width = std::max(spec.Width >> level, 1);
+    int height = std::max(spec.Height >> level, 1);
+    GLenum target = face >= 0 ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + face : GL_TEXTURE_2D;
+    
+    if (utils::OpenGL::IsCompressedFormat(spec.Format))
+    {
+        GLenum format = utils::OpenGL::TextureFormatToOpenGLStorageType(spec.Format);
+        GLsizei size = (GLsizei)utils::OpenGL::TextureFormatToImageSize(spec.Format, width, height);
+        if (UseDirectStateAccess() && face >= 0)
+            glCompressedTextureSubImage3D(m_ID, level, 0, 0, face, width, height, 1, format, size, data);
+        else if (UseDirectStateAccess())
+            glCompressedTextureSubImage2D(m_ID, level, 0, 0, width, height, format, size, data);
+        else
+            glCompressedTexImage2D(target, level, format, width, height, 0, size, data);
+        return;
+    }
+    
+    GLenum base = utils::OpenGL::TextureFormatToOpenGLBaseType(spec.Format);
+    GLenum type = utils::OpenGL::TextureFormatToOpenGLDataType(spec.Format);
+    if (UseDirectStateAccess() && face >= 0)
+        glTextureSubImage3D(m_ID, level, 0, 0, face, width, height, 1, base, type, data);
+    else if (UseDirectStateAccess())
+        glTextureSubImage2D(m_ID, level, 0, 0, width, height, base, type, data);
+    else
+        glTexImage2D(target, level, utils::OpenGL::TextureFormatToOpenGLInternalType(spec.Format),
+                     width, height, 0, base, type, data);
+}
+
+/**
+ * Get the number of levels allocated for a texture, including all the mipmaps if required.
+ *
+ * @param spec The texture specifications.
+ *
+ * @return The number of levels.
+ */
+unsigned int Texture::GetMipLevels(const TextureSpecification& spec)
+{
+    if (!spec.MipMaps || utils::OpenGL::IsDepthFormat(spec.Format))
+        return 1;
+    
+    int size = std::max(spec.Width, std::max(spec.Height, spec.Depth));
+    unsigned int levels = 1;
+    while (size > 1)
+    {
+        size >>= 1;
+        levels++;
+    }
+    return levels;
+}
+
+/**
+ * Check if the textures are created with direct state access and immutable storage.
+ *
+ * @return `true` if supported by the current context.
+ */
+bool Texture::UseDirectStateAccess()
+{
+    return Renderer::GetCapabilities().directStateAccess;
+}
@@ -71,26 +71,31 @@ void Texture1D::CreateTexture(const void *data)
     // Verify size of the 1D texture
     CORE_ASSERT(m_Spec.Width > 0, "1D texture size not properly defined!");
     
-    // Bind the texture
-    Bind();
+    // Generate (or bind) the texture
+    BeginCreation();
     
     // Set texture wrapping and filtering parameters
-    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S,
-                    utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
+    SetParameter(GL_TEXTURE_WRAP_S, utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
     
-    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER,
-                    utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, m_Spec.MipMaps));
-    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER,
-                    utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, false));
+    SetParameter(GL_TEXTURE_MIN_FILTER,
+                 utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, m_Spec.MipMaps));
+    SetParameter(GL_TEXTURE_MAG_FILTER,
+                 utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, false));
     
     // Create the texture based on the format and data type
-    if (utils::OpenGL::IsDepthFormat(m_Spec.Format))
+    bool depth = utils::OpenGL::IsDepthFormat(m_Spec.Format);
+    if (UseDirectStateAccess())
+    {
+        glTextureStorage1D(m_ID, GetMipLevels(m_Spec),
+                           utils::OpenGL::TextureFormatToOpenGLStorageType(m_Spec.Format), m_Spec.Width);
+        if (data && !depth)
+            glTextureSubImage1D(m_ID, 0, 0, m_Spec.Width, utils::OpenGL::TextureFormatToOpenGLBaseType(m_Spec.Format),
+                                utils::OpenGL::TextureFormatToOpenGLDataType(m_Spec.Format), data);
+    }
+    else if (depth)
     {
         glTexStorage1D(GL_TEXTURE_1D, 1, utils::OpenGL::TextureFormatToOpenGLBaseType(m_Spec.Format),
                        m_Spec.Width);
-        
-        float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
-        glTexParameterfv(GL_TEXTURE_1D, GL_TEXTURE_BORDER_COLOR, borderColor);
     }
     else
     {
@@ -99,10 +104,16 @@ void Texture1D::CreateTexture(const void *data)
                      utils::OpenGL::TextureFormatToOpenGLDataType(m_Spec.Format), data);
     }
     
+    if (depth)
+    {
+        float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        SetParameter(GL_TEXTURE_BORDER_COLOR, borderColor);
+    }
+    
     // Generate mipmaps if specified
     if (m_Spec.MipMaps)
-        glGenerateMipmap(GL_TEXTURE_1D);
+        GenerateMipmaps();
     
     // Unbind the texture
-    Unbind();
+    EndCreation();
 }
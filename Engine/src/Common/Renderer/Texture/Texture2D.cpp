@@ -1,9 +1,18 @@
 #include "enginepch.h"
 #include "Common/Renderer/Texture/Texture2D.h"
 
+#include "Common/Renderer/Renderer.h"
+#include "Common/Renderer/Texture/HDRConverter.h"
+#include "Common/Renderer/Texture/KTXTexture.h"
+#include "Common/Renderer/Texture/MipmapGenerator.h"
+#include "Common/Renderer/Texture/TextureEncoder.h"
+
 #include <GL/glew.h>
 #include <stb_image.h>
 
+// Minimum size of the base level kept by the textures whose top levels are dropped
+static const int g_MinimumResidentSize = 64;
+
 // --------------------------------------------
 // Texture (2D)
 // --------------------------------------------
@@ -51,6 +60,16 @@ Texture2D::Texture2D(const void *data, const TextureSpecification& spec, const i
     CreateTexture(data);
 }
 
+/**
+ * Estimate the video memory used by the texture (each sample of multisampled textures is stored).
+ *
+ * @return The size of the texture (in bytes).
+ */
+size_t Texture2D::GetMemorySize() const
+{
+    return Texture::GetMemorySize() * std::max(m_Samples, 1);
+}
+
 /**
  * Get the texture target based on the texture specification.
  *
@@ -72,51 +91,256 @@ void Texture2D::CreateTexture(const void *data)
     CORE_ASSERT(m_Spec.Width > 0 && m_Spec.Height > 0,
                 "2D texture size not properly defined!");
     
-    // Bind the texture
-    Bind();
+    // The levels dropped do not belong to the new storage
+    m_DroppedLevels = 0;
     
-    // For multisample textures, use glTexImage2DMultisample to create the texture
+    // Generate (or bind) the texture
+    BeginCreation();
+    
+    // For multisample textures, only the storage is defined
     if (m_Samples > 1)
     {
-        glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, m_Samples,
-                                utils::OpenGL::TextureFormatToOpenGLInternalType(m_Spec.Format),
-                                m_Spec.Width, m_Spec.Height, GL_FALSE);
+        if (UseDirectStateAccess())
+            glTextureStorage2DMultisample(m_ID, m_Samples,
+                                          utils::OpenGL::TextureFormatToOpenGLStorageType(m_Spec.Format),
+                                          m_Spec.Width, m_Spec.Height, GL_FALSE);
+        else
+            glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, m_Samples,
+                                    utils::OpenGL::TextureFormatToOpenGLInternalType(m_Spec.Format),
+                                    m_Spec.Width, m_Spec.Height, GL_FALSE);
+        EndCreation();
         return;
     }
     
     // Set texture wrapping and filtering parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,
-                    utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,
-                    utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
+    SetParameter(GL_TEXTURE_WRAP_S, utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
+    SetParameter(GL_TEXTURE_WRAP_T, utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
     
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-                    utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, m_Spec.MipMaps));
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
-                    utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, false));
+    SetParameter(GL_TEXTURE_MIN_FILTER,
+                 utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, m_Spec.MipMaps));
+    SetParameter(GL_TEXTURE_MAG_FILTER,
+                 utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, false));
     
     // Create the texture based on the format and data type
-    if (utils::OpenGL::IsDepthFormat(m_Spec.Format))
+    bool depth = utils::OpenGL::IsDepthFormat(m_Spec.Format);
+    bool compressed = utils::OpenGL::IsCompressedFormat(m_Spec.Format);
+    if (UseDirectStateAccess())
+    {
+        glTextureStorage2D(m_ID, GetMipLevels(m_Spec),
+                           utils::OpenGL::TextureFormatToOpenGLStorageType(m_Spec.Format),
+                           m_Spec.Width, m_Spec.Height);
+        if (data && compressed)
+            SetCompressedData(m_Spec, data);
+        else if (data && !depth)
+            glTextureSubImage2D(m_ID, 0, 0, 0, m_Spec.Width, m_Spec.Height,
+                                utils::OpenGL::TextureFormatToOpenGLBaseType(m_Spec.Format),
+                                utils::OpenGL::TextureFormatToOpenGLDataType(m_Spec.Format), data);
+    }
+    else if (depth)
     {
         glTexStorage2D(GL_TEXTURE_2D, 1, utils::OpenGL::TextureFormatToOpenGLBaseType(m_Spec.Format),
                        m_Spec.Width, m_Spec.Height);
-        
+    }
+    else if (compressed)
+    {
+        SetCompressedData(m_Spec, data);
+    }
+    else
+    {
+        // Without data, the levels are only allocated (they are written afterwards)
+        unsigned int levels = data || !m_Spec.MipMaps ? 1 : GetMipLevels(m_Spec);
+        for (unsigned int i = 0; i < levels; i++)
+        {
+            glTexImage2D(GL_TEXTURE_2D, i, utils::OpenGL::TextureFormatToOpenGLInternalType(m_Spec.Format),
+                         std::max(m_Spec.Width >> i, 1), std::max(m_Spec.Height >> i, 1), 0,
+                         utils::OpenGL::TextureFormatToOpenGLBaseType(m_Spec.Format),
+                         utils::OpenGL::TextureFormatToOpenGLDataType(m_Spec.Format), data);
+        }
+    }
+    
+    if (depth)
+    {
         float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
-        glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
+        SetParameter(GL_TEXTURE_BORDER_COLOR, borderColor);
+    }
+    
+    // Generate mipmaps if specified (compressed data already contains them, and the levels of an
+    // undefined storage are written afterwards)
+    if (m_Spec.MipMaps && !compressed && data)
+        GenerateMipmaps();
+    
+    // Unbind the texture
+    EndCreation();
+}
+
+/**
+ * Update the data of the base level of the texture, regenerating the mipmaps if specified. For
+ * compressed textures, the data contains all the levels instead.
+ *
+ * @param data The texture data. If a pixel unpack buffer is bound, this is the offset of the
+ * data in the buffer.
+ */
+void Texture2D::SetData(const void *data)
+{
+    CORE_ASSERT(m_Samples == 1 && !utils::OpenGL::IsDepthFormat(m_Spec.Format),
+                "Only single sample color textures can be updated!");
+    
+    if (utils::OpenGL::IsCompressedFormat(m_Spec.Format))
+    {
+        if (!UseDirectStateAccess())
+            Bind();
+        SetCompressedData(m_Spec, data);
+        EndCreation();
+        return;
+    }
+    
+    if (UseDirectStateAccess())
+    {
+        glTextureSubImage2D(m_ID, 0, 0, 0, m_Spec.Width, m_Spec.Height,
+                            utils::OpenGL::TextureFormatToOpenGLBaseType(m_Spec.Format),
+                            utils::OpenGL::TextureFormatToOpenGLDataType(m_Spec.Format), data);
     }
     else
     {
-        glTexImage2D(GL_TEXTURE_2D, 0, utils::OpenGL::TextureFormatToOpenGLInternalType(m_Spec.Format),
-                     m_Spec.Width, m_Spec.Height, 0, utils::OpenGL::TextureFormatToOpenGLBaseType(m_Spec.Format),
-                     utils::OpenGL::TextureFormatToOpenGLDataType(m_Spec.Format), data);
+        Bind();
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_Spec.Width, m_Spec.Height,
+                        utils::OpenGL::TextureFormatToOpenGLBaseType(m_Spec.Format),
+                        utils::OpenGL::TextureFormatToOpenGLDataType(m_Spec.Format), data);
     }
     
     // Generate mipmaps if specified
     if (m_Spec.MipMaps)
-        glGenerateMipmap(GL_TEXTURE_2D);
+        GenerateMipmaps();
+    
+    // Unbind the texture
+    EndCreation();
+}
+
+/**
+ * Update the levels of the texture with pre-built mipmaps (e.g. read from a texture container).
+ * If fewer levels than allocated are provided, only those are sampled.
+ *
+ * @param levels The data of each level, from the base level. If a pixel unpack buffer is bound,
+ * these are the offsets of the data in the buffer.
+ */
+void Texture2D::SetLevels(const std::vector<const void *>& levels)
+{
+    CORE_ASSERT(m_Samples == 1 && !utils::OpenGL::IsDepthFormat(m_Spec.Format),
+                "Only single sample color textures can be updated!");
+    CORE_ASSERT(!levels.empty() && levels.size() <= GetMipLevels(m_Spec),
+                "Invalid number of levels for the 2D texture!");
+    
+    if (!UseDirectStateAccess())
+        Bind();
+    
+    // Rows of three component formats are not always aligned to four bytes
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (unsigned int i = 0; i < levels.size(); i++)
+        SetLevelData(m_Spec, i, levels[i]);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    
+    SetParameter(GL_TEXTURE_MAX_LEVEL, (int)levels.size() - 1);
     
     // Unbind the texture
-    Unbind();
+    EndCreation();
+}
+
+/**
+ * Update a region of a level of the texture (without regenerating the mipmaps), e.g. the tiles
+ * streamed into a cache texture.
+ *
+ * @param x The position of the region (in texels).
+ * @param y The position of the region (in texels).
+ * @param width The size of the region (in texels).
+ * @param height The size of the region (in texels).
+ * @param data The data of the region (tightly packed rows). If a pixel unpack buffer is bound,
+ * this is the offset of the data in the buffer.
+ * @param level The level updated.
+ */
+void Texture2D::SetSubData(const int x, const int y, const int width, const int height,
+                           const void *data, const unsigned int level)
+{
+    CORE_ASSERT(m_Samples == 1 && !utils::OpenGL::IsDepthFormat(m_Spec.Format) &&
+                !utils::OpenGL::IsCompressedFormat(m_Spec.Format),
+                "Only single sample uncompressed color textures can be updated by region!");
+    CORE_ASSERT(x >= 0 && y >= 0 && x + width <= std::max(m_Spec.Width >> level, 1) &&
+                y + height <= std::max(m_Spec.Height >> level, 1),
+                "Region out of the bounds of the 2D texture!");
+    
+    GLenum format = utils::OpenGL::TextureFormatToOpenGLBaseType(m_Spec.Format);
+    GLenum type = utils::OpenGL::TextureFormatToOpenGLDataType(m_Spec.Format);
+    
+    // Rows of three component formats are not always aligned to four bytes
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (UseDirectStateAccess())
+    {
+        glTextureSubImage2D(m_ID, level, x, y, width, height, format, type, data);
+    }
+    else
+    {
+        Bind();
+        glTexSubImage2D(GL_TEXTURE_2D, level, x, y, width, height, format, type, data);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    
+    // Unbind the texture
+    EndCreation();
+}
+
+/**
+ * Check if the levels of the texture can be copied into a smaller storage on the GPU.
+ *
+ * @return `true` for single sample color textures with mipmaps (not attached to a framebuffer
+ * nor used by a virtual texture), larger than the minimum resident size.
+ */
+bool Texture2D::CanCopyLevels() const
+{
+    return m_ID && m_Samples == 1 && m_Spec.MipMaps && m_Category != TextureCategory::Attachment &&
+        m_Category != TextureCategory::Virtual &&
+        m_Spec.Format != TextureFormat::None && !utils::OpenGL::IsDepthFormat(m_Spec.Format) &&
+        std::min(m_Spec.Width, m_Spec.Height) >= 2 * g_MinimumResidentSize &&
+        UseDirectStateAccess() && Renderer::GetCapabilities().copyImage;
+}
+
+/**
+ * Drop the top levels of the texture. The texture is redefined with the remaining levels, copied
+ * from the previous storage on the GPU (the data of the levels dropped is not kept).
+ *
+ * @param count The number of levels dropped.
+ *
+ * @return `true` if the levels have been dropped.
+ */
+bool Texture2D::DropLevels(const unsigned int count)
+{
+    if (!CanDropLevels() || count == 0)
+        return false;
+    
+    GLint maxLevel = 0;
+    glGetTextureParameteriv(m_ID, GL_TEXTURE_MAX_LEVEL, &maxLevel);
+    unsigned int levels = std::min(GetMipLevels(m_Spec), (unsigned int)maxLevel + 1);
+    if (count >= levels)
+        return false;
+    
+    // The new storage drops these levels after the ones dropped before
+    unsigned int dropped = m_DroppedLevels;
+    
+    // Redefine the texture with the remaining levels (into a new texture, the previous one being
+    // the source of the copies)
+    GLuint source = m_ID;
+    int width = m_Spec.Width, height = m_Spec.Height;
+    m_ID = 0;
+    m_Spec.Width = std::max(width >> count, 1);
+    m_Spec.Height = std::max(height >> count, 1);
+    CreateTexture(nullptr);
+    
+    for (unsigned int i = count; i < levels; i++)
+        glCopyImageSubData(source, GL_TEXTURE_2D, i, 0, 0, 0, m_ID, GL_TEXTURE_2D, i - count, 0, 0, 0,
+                           std::max(width >> i, 1), std::max(height >> i, 1), 1);
+    glDeleteTextures(1, &source);
+    SetParameter(GL_TEXTURE_MAX_LEVEL, (int)(levels - count) - 1);
+    
+    m_DroppedLevels = dropped + count;
+    return true;
 }
 
 // --------------------------------------------
@@ -130,11 +354,76 @@ void Texture2D::CreateTexture(const void *data)
  * @param flip Fip the texture vertically.
  */
 Texture2DResource::Texture2DResource(const std::filesystem::path& filePath, bool flip)
-    : Texture2D(), m_FilePath(filePath), m_Flip(flip)
+    : Texture2D(), m_FilePath(filePath)
+{
+    m_Category = TextureCategory::Material;
+    m_Options.Flip = flip;
+    m_Options.HDRFormat = s_HDRFormat;
+    LoadFromFile(filePath);
+}
+
+/**
+ * Generate a texture from the input source file with specific options.
+ *
+ * @param filePath Texture file path.
+ * @param options The options decoding the file.
+ */
+Texture2DResource::Texture2DResource(const std::filesystem::path& filePath,
+                                     const TextureLoadOptions& options)
+    : Texture2D(), m_FilePath(filePath), m_Options(options)
 {
+    m_Category = TextureCategory::Material;
     LoadFromFile(filePath);
 }
 
+/**
+ * Generate a texture whose data is loaded later from the input source file (see
+ * `TextureLoader`), showing a fallback texture until then.
+ *
+ * @param filePath Texture file path.
+ * @param options The options decoding the file.
+ * @param fallback The data of the fallback texture.
+ * @param spec The specifications of the fallback texture.
+ */
+Texture2DResource::Texture2DResource(const std::filesystem::path& filePath,
+                                     const TextureLoadOptions& options, const void *fallback,
+                                     const TextureSpecification& spec)
+    : Texture2D(spec), m_FilePath(filePath), m_Options(options)
+{
+    m_Category = TextureCategory::Material;
+    CreateTexture(fallback);
+}
+
+/**
+ * Check if the top levels of the texture can be dropped to release memory.
+ *
+ * @return `true` if the levels can be copied on the GPU and restored from the file (through the
+ * texture loader, the texture being owned by a shared pointer).
+ */
+bool Texture2DResource::CanDropLevels() const
+{
+    return m_Loaded && !m_Restoring && !weak_from_this().expired() && Renderer::GetTextureLoader() &&
+        CanCopyLevels();
+}
+
+/**
+ * Restore the levels dropped from the texture, decoding its file again through the texture
+ * loader. The texture keeps its reduced levels until the file is uploaded.
+ *
+ * @return `true` if the file is being decoded.
+ */
+bool Texture2DResource::RestoreLevels()
+{
+    auto texture = weak_from_this().lock();
+    const auto& loader = Renderer::GetTextureLoader();
+    if (m_DroppedLevels == 0 || m_Restoring || !texture || !loader)
+        return false;
+    
+    m_Restoring = true;
+    loader->Reload(texture);
+    return true;
+}
+
 /**
  * Load the texture from an input (image) source file.
  *
@@ -142,11 +431,16 @@ Texture2DResource::Texture2DResource(const std::filesystem::path& filePath, bool
  */
 void Texture2DResource::LoadFromFile(const std::filesystem::path& filePath)
 {
-    // Determine whether to flip the image vertically
-    stbi_set_flip_vertically_on_load(m_Flip);
+    // The rows are flipped by the conversion kernels instead of the decoder (only for the calling thread)
+    stbi_set_flip_vertically_on_load_thread(false);
     
     // Extract the file extension
     std::string extension = filePath.extension().string();
+    if (extension == ".ktx2")
+    {
+        LoadFromContainer(filePath);
+        return;
+    }
     
     // Load the image into the local buffer
     int width, height, channels;
@@ -162,13 +456,136 @@ void Texture2DResource::LoadFromFile(const std::filesystem::path& filePath)
         return;
     }
     
+    // Expand the 8-bit images into RGBA (flipping them in the same pass), so the upload is never
+    // converted by the driver, or flip the other images in place
+    std::vector<uint8_t> expanded;
+    void* pixels = data;
+    bool isHDR = extension == ".hdr";
+    if (!isHDR && channels != 4)
+    {
+        expanded.resize((size_t)width * height * 4);
+        utils::Pixels::ExpandImageToRGBA(static_cast<const uint8_t*>(data), width, height, channels,
+                                         m_Options.Flip, expanded.data());
+        stbi_image_free(data);
+        data = nullptr;
+        pixels = expanded.data();
+        channels = 4;
+    }
+    else if (m_Options.Flip)
+    {
+        utils::Pixels::FlipVertically(data, (size_t)width * channels * (isHDR ? sizeof(float) : 1),
+                                      height);
+    }
+    
+    // Premultiply the alpha before the colors are filtered (or compressed)
+    if (m_Options.Premultiply && !isHDR && channels == 4)
+        utils::Pixels::PremultiplyAlpha(static_cast<uint8_t*>(pixels), (size_t)width * height);
+    
     // Save the corresponding image information
     utils::Texturing::UpdateSpecsTextureResource(m_Spec, width, height, channels, extension);
     CORE_ASSERT((unsigned int)m_Spec.Format, "Data format of " + m_FilePath.filename().string() + " not supported!");
     
+    MipmapSettings settings;
+    settings.SRGB = m_Options.SRGB;
+    settings.Wrap = m_Spec.Wrap == TextureWrap::Repeat;
+    
+    // Convert the HDR images into a packed format, releasing the floats before the upload
+    if (m_Spec.Format == TextureFormat::RGB16F && HDRConverter::IsSupported(m_Options.HDRFormat))
+    {
+        HDRConverter converter(m_Options.HDRFormat);
+        converter.SetMipmapSettings(settings);
+        auto levels = converter.Convert(static_cast<const float*>(data), width, height, channels,
+                                        m_Spec.MipMaps);
+        stbi_image_free(data);
+        
+        m_Spec.Format = m_Options.HDRFormat;
+        CreateTexture(nullptr);
+        
+        std::vector<const void *> pointers;
+        for (const auto& level : levels)
+            pointers.push_back(level.data());
+        SetLevels(pointers);
+        m_Loaded = true;
+        return;
+    }
+    
+    // Compress the 8-bit images into the format requested, with all their mipmaps
+    if (!isHDR && TextureEncoder::IsSupported(m_Options.Format))
+    {
+        TextureEncoder encoder;
+        encoder.SetMipmapSettings(settings);
+        std::vector<uint8_t> compressed = encoder.Encode(pixels, width, height, channels,
+                                                         m_Options.Format, m_Spec.MipMaps);
+        if (data)
+            stbi_image_free(data);
+        
+        m_Spec.Format = m_Options.Format;
+        CreateTexture(compressed.data());
+        m_Loaded = true;
+        return;
+    }
+    
+    // Filter the mipmaps of the sRGB images in linear space (the driver filters the encoded values)
+    if (m_Options.SRGB && m_Spec.MipMaps && MipmapGenerator::IsSupported(m_Spec.Format))
+    {
+        auto mipmaps = MipmapGenerator(settings).Generate(pixels, width, height, m_Spec.Format);
+        CreateTexture(nullptr);
+        
+        std::vector<const void *> pointers = { pixels };
+        for (const auto& level : mipmaps)
+            pointers.push_back(level.data());
+        SetLevels(pointers);
+        m_Loaded = true;
+        
+        if (data)
+            stbi_image_free(data);
+        return;
+    }
+    
     // Generate the 2D texture
-    CreateTexture(data);
+    CreateTexture(pixels);
+    m_Loaded = true;
     
     // Free memory
-    stbi_image_free(data);
+    if (data)
+        stbi_image_free(data);
+}
+
+/**
+ * Load the texture from a KTX2 file, uploading its levels (or generating the mipmaps if they
+ * are not stored).
+ *
+ * @param filePath Texture file path.
+ */
+void Texture2DResource::LoadFromContainer(const std::filesystem::path& filePath)
+{
+    KTXTexture container;
+    if (!container.Load(filePath))
+        return;
+    
+    if (container.GetFaceCount() != 1)
+    {
+        CORE_WARN(m_FilePath.filename().string() + " is a cube map!");
+        return;
+    }
+    if (container.IsFlipped() != m_Options.Flip)
+        CORE_WARN("The orientation of " + m_FilePath.filename().string() + " is not the one requested!");
+    
+    // Generate the 2D texture
+    container.UpdateSpecification(m_Spec);
+    CreateTexture(nullptr);
+    
+    std::vector<const void *> levels;
+    for (unsigned int i = 0; i < container.GetLevelCount(); i++)
+        levels.push_back(container.GetLevel(i));
+    
+    if (container.RequiresMipmaps())
+    {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        SetData(levels[0]);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+    else
+        SetLevels(levels);
+    m_Loaded = true;
 }
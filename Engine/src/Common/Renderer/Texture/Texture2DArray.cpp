@@ -0,0 +1,156 @@
+#include "enginepch.h"
+#include "Common/Renderer/Texture/Texture2DArray.h"
+
+#include <GL/glew.h>
+
+/**
+ * Create a 2D texture array with specific properties.
+ *
+ * @param spec The texture specifications (the depth defines the number of layers).
+ */
+Texture2DArray::Texture2DArray(const TextureSpecification& spec)
+    : Texture(spec)
+{
+    m_Spec.Type = TextureType::TEXTURE2DARRAY;
+    CreateTexture(nullptr);
+}
+
+/**
+ * Create a 2D texture array from input data and with specific properties.
+ *
+ * @param data The data of all the layers (one after the other).
+ * @param spec The texture specifications (the depth defines the number of layers).
+ */
+Texture2DArray::Texture2DArray(const void *data, const TextureSpecification& spec)
+    : Texture(spec)
+{
+    m_Spec.Type = TextureType::TEXTURE2DARRAY;
+    CreateTexture(data);
+}
+
+/**
+ * Get the texture target based on the texture specification.
+ *
+ * @return The OpenGL texture target.
+ */
+GLenum Texture2DArray::TextureTarget() const
+{
+    return (GLenum)GL_TEXTURE_2D_ARRAY;
+}
+
+/**
+ * Create and configure the texture based on the texture specification and provided data.
+ *
+ * @param data The data of all the layers. This can be nullptr if the layers are written later.
+ */
+void Texture2DArray::CreateTexture(const void *data)
+{
+    // Verify size of the texture array
+    CORE_ASSERT(m_Spec.Width > 0 && m_Spec.Height > 0 && m_Spec.Depth > 0,
+                "2D texture array size not properly defined!");
+    CORE_ASSERT(!utils::OpenGL::IsDepthFormat(m_Spec.Format),
+                "Depth formats are not supported in 2D texture arrays!");
+    
+    // Generate (or bind) the texture
+    BeginCreation();
+    
+    // Set texture wrapping and filtering parameters
+    SetParameter(GL_TEXTURE_WRAP_S, utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
+    SetParameter(GL_TEXTURE_WRAP_T, utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
+    
+    SetParameter(GL_TEXTURE_MIN_FILTER,
+                 utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, m_Spec.MipMaps));
+    SetParameter(GL_TEXTURE_MAG_FILTER,
+                 utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, false));
+    
+    // Define the mipmap levels from the size of a layer (not the number of layers)
+    TextureSpecification layer = m_Spec;
+    layer.Depth = 0;
+    unsigned int levels = GetMipLevels(layer);
+    
+    // Create the texture based on the format and data type
+    if (UseDirectStateAccess())
+    {
+        glTextureStorage3D(m_ID, levels, utils::OpenGL::TextureFormatToOpenGLStorageType(m_Spec.Format),
+                           m_Spec.Width, m_Spec.Height, m_Spec.Depth);
+        if (data)
+            glTextureSubImage3D(m_ID, 0, 0, 0, 0, m_Spec.Width, m_Spec.Height, m_Spec.Depth,
+                                utils::OpenGL::TextureFormatToOpenGLBaseType(m_Spec.Format),
+                                utils::OpenGL::TextureFormatToOpenGLDataType(m_Spec.Format), data);
+    }
+    else
+    {
+        SetParameter(GL_TEXTURE_MAX_LEVEL, (GLint)levels - 1);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, utils::OpenGL::TextureFormatToOpenGLInternalType(m_Spec.Format),
+                     m_Spec.Width, m_Spec.Height, m_Spec.Depth, 0,
+                     utils::OpenGL::TextureFormatToOpenGLBaseType(m_Spec.Format),
+                     utils::OpenGL::TextureFormatToOpenGLDataType(m_Spec.Format), data);
+    }
+    
+    // Generate mipmaps if specified
+    if (m_Spec.MipMaps && data)
+        GenerateMipmaps();
+    
+    // Unbind the texture
+    EndCreation();
+}
+
+/**
+ * Update the data of a complete layer. The mipmaps are not updated (see `UpdateMipmaps()`), so
+ * several layers can be written before generating them once.
+ *
+ * @param layer The index of the layer.
+ * @param data The data of the layer.
+ */
+void Texture2DArray::SetLayer(const unsigned int layer, const void *data)
+{
+    SetRegion(layer, 0, 0, m_Spec.Width, m_Spec.Height, data);
+}
+
+/**
+ * Update the data of a region of a layer. The mipmaps are not updated (see `UpdateMipmaps()`).
+ *
+ * @param layer The index of the layer.
+ * @param x The horizontal offset of the region (in pixels).
+ * @param y The vertical offset of the region (in pixels).
+ * @param width The width of the region (in pixels).
+ * @param height The height of the region (in pixels).
+ * @param data The data of the region (tightly packed rows).
+ */
+void Texture2DArray::SetRegion(const unsigned int layer, const int x, const int y,
+                               const int width, const int height, const void *data)
+{
+    CORE_ASSERT(layer < GetLayers(), "Layer out of the range of the texture array!");
+    CORE_ASSERT(x >= 0 && y >= 0 && x + width <= m_Spec.Width && y + height <= m_Spec.Height,
+                "Region out of the bounds of the texture array!");
+    
+    // Rows of three component formats are not always aligned to four bytes
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (UseDirectStateAccess())
+    {
+        glTextureSubImage3D(m_ID, 0, x, y, (GLint)layer, width, height, 1,
+                            utils::OpenGL::TextureFormatToOpenGLBaseType(m_Spec.Format),
+                            utils::OpenGL::TextureFormatToOpenGLDataType(m_Spec.Format), data);
+    }
+    else
+    {
+        Bind();
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, x, y, (GLint)layer, width, height, 1,
+                        utils::OpenGL::TextureFormatToOpenGLBaseType(m_Spec.Format),
+                        utils::OpenGL::TextureFormatToOpenGLDataType(m_Spec.Format), data);
+        Unbind();
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+/**
+ * Generate the mipmaps of all the layers (if specified), once their data has been updated.
+ */
+void Texture2DArray::UpdateMipmaps() const
+{
+    if (!m_Spec.MipMaps)
+        return;
+    
+    GenerateMipmaps();
+    EndCreation();
+}
@@ -72,27 +72,35 @@ void Texture3D::CreateTexture(const void *data)
     CORE_ASSERT(m_Spec.Width > 0 && m_Spec.Height > 0 && m_Spec.Depth > 0,
                 "3D texture size not properly defined!");
     
+    // Generate (or bind) the texture
+    BeginCreation();
+    
     // Set texture wrapping and filtering parameters
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S,
-                    utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T,
-                    utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R,
-                    utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
+    SetParameter(GL_TEXTURE_WRAP_S, utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
+    SetParameter(GL_TEXTURE_WRAP_T, utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
+    SetParameter(GL_TEXTURE_WRAP_R, utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
     
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER,
-                    utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, m_Spec.MipMaps));
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER,
-                    utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, false));
+    SetParameter(GL_TEXTURE_MIN_FILTER,
+                 utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, m_Spec.MipMaps));
+    SetParameter(GL_TEXTURE_MAG_FILTER,
+                 utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, false));
     
     // Create the texture based on the format and data type
-    if (utils::OpenGL::IsDepthFormat(m_Spec.Format))
+    bool depth = utils::OpenGL::IsDepthFormat(m_Spec.Format);
+    if (UseDirectStateAccess())
+    {
+        glTextureStorage3D(m_ID, GetMipLevels(m_Spec),
+                           utils::OpenGL::TextureFormatToOpenGLStorageType(m_Spec.Format),
+                           m_Spec.Width, m_Spec.Height, m_Spec.Depth);
+        if (data && !depth)
+            glTextureSubImage3D(m_ID, 0, 0, 0, 0, m_Spec.Width, m_Spec.Height, m_Spec.Depth,
+                                utils::OpenGL::TextureFormatToOpenGLBaseType(m_Spec.Format),
+                                utils::OpenGL::TextureFormatToOpenGLDataType(m_Spec.Format), data);
+    }
+    else if (depth)
     {
         glTexStorage3D(GL_TEXTURE_3D, 1, utils::OpenGL::TextureFormatToOpenGLBaseType(m_Spec.Format),
                        m_Spec.Width, m_Spec.Height, m_Spec.Depth);
-        
-        float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
-        glTexParameterfv(GL_TEXTURE_3D, GL_TEXTURE_BORDER_COLOR, borderColor);
     }
     else
     {
@@ -102,10 +110,16 @@ void Texture3D::CreateTexture(const void *data)
                      utils::OpenGL::TextureFormatToOpenGLDataType(m_Spec.Format), data);
     }
     
+    if (depth)
+    {
+        float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        SetParameter(GL_TEXTURE_BORDER_COLOR, borderColor);
+    }
+    
     // Generate mipmaps if specified
     if (m_Spec.MipMaps)
-        glGenerateMipmap(GL_TEXTURE_3D);
+        GenerateMipmaps();
     
     // Unbind the texture
-    Unbind();
+    EndCreation();
 }
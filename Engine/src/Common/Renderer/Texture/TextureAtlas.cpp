@@ -0,0 +1,384 @@
+#include "enginepch.h"
+#include "Common/Renderer/Texture/TextureAtlas.h"
+
+#include <stb_image.h>
+
+#include <cstring>
+
+// --------------------------------------------
+// Skyline packer
+// --------------------------------------------
+
+/**
+ * Define an empty packing area.
+ *
+ * @param width The width of the area.
+ * @param height The height of the area.
+ */
+SkylinePacker::SkylinePacker(const int width, const int height)
+    : m_Width(width), m_Height(height)
+{
+    Reset();
+}
+
+/**
+ * Find the position of a rectangle in the packing area, at the lowest skyline position where
+ * it fits (the narrowest segment in case of tie).
+ *
+ * @param width The width of the rectangle.
+ * @param height The height of the rectangle.
+ * @param position The position (bottom-left corner) of the packed rectangle.
+ *
+ * @return `true` if the rectangle has been packed, `false` if it does not fit.
+ */
+bool SkylinePacker::Pack(const int width, const int height, glm::ivec2& position)
+{
+    if (width <= 0 || height <= 0 || width > m_Width || height > m_Height)
+        return false;
+    
+    // Find the segment where the top edge of the rectangle is the lowest
+    size_t best = m_Skyline.size();
+    int bestTop = std::numeric_limits<int>::max();
+    int bestWidth = std::numeric_limits<int>::max();
+    int bestY = 0;
+    for (size_t i = 0; i < m_Skyline.size(); i++)
+    {
+        int y = Fit(i, width, height);
+        if (y < 0)
+            continue;
+        
+        int top = y + height;
+        if (top < bestTop || (top == bestTop && m_Skyline[i].width < bestWidth))
+        {
+            best = i;
+            bestTop = top;
+            bestWidth = m_Skyline[i].width;
+            bestY = y;
+        }
+    }
+    if (best == m_Skyline.size())
+        return false;
+    
+    // Raise the skyline over the rectangle
+    Segment segment = { m_Skyline[best].x, bestY + height, width };
+    m_Skyline.insert(m_Skyline.begin() + best, segment);
+    
+    // Shrink (or remove) the segments covered by the rectangle
+    int end = segment.x + segment.width;
+    for (size_t i = best + 1; i < m_Skyline.size(); )
+    {
+        if (m_Skyline[i].x >= end)
+            break;
+        
+        int shrink = end - m_Skyline[i].x;
+        m_Skyline[i].x += shrink;
+        m_Skyline[i].width -= shrink;
+        if (m_Skyline[i].width > 0)
+            break;
+        
+        m_Skyline.erase(m_Skyline.begin() + i);
+    }
+    
+    // Merge the neighbour segments at the same height
+    for (size_t i = 0; i + 1 < m_Skyline.size(); )
+    {
+        if (m_Skyline[i].y == m_Skyline[i + 1].y)
+        {
+            m_Skyline[i].width += m_Skyline[i + 1].width;
+            m_Skyline.erase(m_Skyline.begin() + i + 1);
+        }
+        else
+            i++;
+    }
+    
+    position = glm::ivec2(segment.x, bestY);
+    m_Area += (size_t)width * (size_t)height;
+    return true;
+}
+
+/**
+ * Remove all the packed rectangles.
+ */
+void SkylinePacker::Reset()
+{
+    m_Skyline.clear();
+    m_Skyline.push_back({ 0, 0, m_Width });
+    m_Area = 0;
+}
+
+/**
+ * Check if a rectangle fits with its left edge at the beginning of a skyline segment.
+ *
+ * @param index The index of the segment.
+ * @param width The width of the rectangle.
+ * @param height The height of the rectangle.
+ *
+ * @return The height where the rectangle would be placed, or -1 if it does not fit.
+ */
+int SkylinePacker::Fit(const size_t index, const int width, const int height) const
+{
+    int x = m_Skyline[index].x;
+    if (x + width > m_Width)
+        return -1;
+    
+    // The rectangle rests on the highest segment below it
+    int y = m_Skyline[index].y;
+    int remaining = width;
+    for (size_t i = index; remaining > 0; i++)
+    {
+        y = std::max(y, m_Skyline[i].y);
+        if (y + height > m_Height)
+            return -1;
+        remaining -= m_Skyline[i].width;
+    }
+    return y;
+}
+
+// --------------------------------------------
+// Texture atlas
+// --------------------------------------------
+
+/**
+ * Define an empty texture atlas.
+ *
+ * @param atlasSize The size of the atlas layers (in pixels).
+ * @param threshold The largest size of the textures packed into atlas layers (in pixels).
+ * @param layers The number of layers of each texture array.
+ */
+TextureAtlas::TextureAtlas(const unsigned int atlasSize, const unsigned int threshold,
+                           const unsigned int layers)
+    : m_AtlasSize(atlasSize), m_Threshold(std::min(threshold, atlasSize / 2)),
+      m_Layers(std::max(layers, 1u))
+{}
+
+/**
+ * Add a texture into a layer of a texture array, or into an atlas layer if it is small. The
+ * mipmaps of the arrays are generated on the next `Update()`.
+ *
+ * @param data The texture data.
+ * @param spec The texture specifications.
+ *
+ * @return The location of the texture.
+ */
+TextureRegion TextureAtlas::Add(const void *data, const TextureSpecification& spec)
+{
+    CORE_ASSERT(data && spec.Width > 0 && spec.Height > 0, "Texture data not properly defined!");
+    CORE_ASSERT(utils::OpenGL::TextureFormatToPixelSize(spec.Format) > 0,
+                "Only color formats can be packed into texture arrays!");
+    
+    // Pack the small textures together
+    if ((unsigned int)spec.Width <= m_Threshold && (unsigned int)spec.Height <= m_Threshold)
+        return AddToAtlas(data, spec);
+    
+    // Copy the texture into its own layer
+    TextureRegion region = AllocateLayer(spec, false);
+    region.array->SetLayer(region.layer, data);
+    if (std::find(m_Modified.begin(), m_Modified.end(), region.array) == m_Modified.end())
+        m_Modified.push_back(region.array);
+    
+    m_LayerTextures++;
+    return region;
+}
+
+/**
+ * Load a texture from an input (image) source file and add it into a texture array.
+ *
+ * @param filePath Texture file path.
+ * @param flip Fip the texture vertically.
+ *
+ * @return The location of the texture, invalid if it could not be loaded.
+ */
+TextureRegion TextureAtlas::Load(const std::filesystem::path& filePath, bool flip)
+{
+    // Decode the image (flipped below with the pixel kernels)
+    stbi_set_flip_vertically_on_load_thread(false);
+    
+    // Load the image into the local buffer
+    std::string extension = filePath.extension().string();
+    int width, height, channels;
+    void* data = (extension != ".hdr") ? stbi_load(filePath.string().c_str(), &width, &height, &channels, 0) :
+                                  (void*)stbi_loadf(filePath.string().c_str(), &width, &height, &channels, 0);
+    if (!data)
+    {
+        CORE_WARN("Failed to load: " + filePath.filename().string());
+        return {};
+    }
+    
+    // Expand the 8-bit images into RGBA (flipping them in the same pass), or flip the other
+    // images in place
+    std::vector<uint8_t> expanded;
+    const void* pixels = data;
+    bool isHDR = extension == ".hdr";
+    if (!isHDR && channels != 4)
+    {
+        expanded.resize((size_t)width * height * 4);
+        utils::Pixels::ExpandImageToRGBA(static_cast<const uint8_t*>(data), width, height, channels,
+                                         flip, expanded.data());
+        stbi_image_free(data);
+        data = nullptr;
+        pixels = expanded.data();
+        channels = 4;
+    }
+    else if (flip)
+    {
+        utils::Pixels::FlipVertically(data, (size_t)width * channels * (isHDR ? sizeof(float) : 1),
+                                      height);
+    }
+    
+    TextureSpecification spec;
+    utils::Texturing::UpdateSpecsTextureResource(spec, width, height, channels, extension);
+    
+    TextureRegion region;
+    if (spec.Format != TextureFormat::None)
+        region = Add(pixels, spec);
+    else
+        CORE_WARN("Data format of " + filePath.filename().string() + " not supported!");
+    
+    if (data)
+        stbi_image_free(data);
+    return region;
+}
+
+/**
+ * Generate the mipmaps of the texture arrays updated since the last call (e.g. once all the
+ * textures of a scene have been added).
+ */
+void TextureAtlas::Update()
+{
+    for (auto& array : m_Modified)
+        array->UpdateMipmaps();
+    m_Modified.clear();
+}
+
+/**
+ * Get the statistics of the texture arrays.
+ *
+ * @return The texture atlas statistics.
+ */
+TextureAtlas::AtlasStatistics TextureAtlas::GetStats() const
+{
+    AtlasStatistics stats;
+    for (const auto& [key, group] : m_Groups)
+    {
+        if (group.arrays.empty())
+            continue;
+        stats.arrays += (unsigned int)group.arrays.size();
+        stats.layers += (unsigned int)(group.arrays.size() - 1) * m_Layers + group.used;
+    }
+    
+    unsigned int pages = 0;
+    for (const auto& [format, formatPages] : m_Pages)
+    {
+        for (const auto& page : formatPages)
+            stats.occupancy += page.packer.GetOccupancy();
+        pages += (unsigned int)formatPages.size();
+    }
+    if (pages > 0)
+        stats.occupancy /= (float)pages;
+    
+    stats.atlasTextures = m_AtlasTextures;
+    stats.layerTextures = m_LayerTextures;
+    return stats;
+}
+
+/**
+ * Reserve a layer in a texture array with the size and format of a texture, creating a new
+ * array if all the existing ones are full.
+ *
+ * @param spec The texture specifications.
+ * @param atlas Whether the layer is shared by several textures.
+ *
+ * @return The reserved layer.
+ */
+TextureRegion TextureAtlas::AllocateLayer(const TextureSpecification& spec, const bool atlas)
+{
+    ArrayGroup& group = m_Groups[{ spec.Width, spec.Height, spec.Format, atlas }];
+    if (group.arrays.empty() || group.used == m_Layers)
+    {
+        // The atlas textures are wrapped in the shader, so their layers are clamped
+        TextureSpecification arraySpec(spec.Format);
+        arraySpec.SetTextureSize(spec.Width, spec.Height, m_Layers);
+        arraySpec.Wrap = atlas ? TextureWrap::ClampToEdge :
+            (spec.Wrap != TextureWrap::None ? spec.Wrap : TextureWrap::Repeat);
+        arraySpec.Filter = spec.Filter != TextureFilter::None ? spec.Filter : TextureFilter::Linear;
+        arraySpec.MipMaps = true;
+        
+        group.arrays.push_back(std::make_shared<Texture2DArray>(arraySpec));
+        group.used = 0;
+    }
+    
+    TextureRegion region;
+    region.array = group.arrays.back();
+    region.layer = (int)group.used++;
+    return region;
+}
+
+/**
+ * Pack a small texture into an atlas layer, surrounded by a copy of its edges.
+ *
+ * @param data The texture data.
+ * @param spec The texture specifications.
+ *
+ * @return The location of the texture.
+ */
+TextureRegion TextureAtlas::AddToAtlas(const void *data, const TextureSpecification& spec)
+{
+    int padding = (int)m_Padding;
+    int width = spec.Width + 2 * padding;
+    int height = spec.Height + 2 * padding;
+    
+    // Find an atlas layer with enough space, or reserve a new one
+    auto& pages = m_Pages[spec.Format];
+    glm::ivec2 position(0);
+    AtlasPage* target = nullptr;
+    for (auto& page : pages)
+    {
+        if (page.packer.Pack(width, height, position))
+        {
+            target = &page;
+            break;
+        }
+    }
+    if (!target)
+    {
+        TextureSpecification pageSpec(spec.Format);
+        pageSpec.SetTextureSize(m_AtlasSize, m_AtlasSize);
+        
+        AtlasPage page;
+        page.region = AllocateLayer(pageSpec, true);
+        page.packer = SkylinePacker((int)m_AtlasSize, (int)m_AtlasSize);
+        page.packer.Pack(width, height, position);
+        
+        pages.push_back(std::move(page));
+        target = &pages.back();
+    }
+    
+    // Replicate the edges of the texture into its padding
+    unsigned int pixel = utils::OpenGL::TextureFormatToPixelSize(spec.Format);
+    const uint8_t* source = static_cast<const uint8_t*>(data);
+    std::vector<uint8_t> padded((size_t)width * height * pixel);
+    for (int y = 0; y < height; y++)
+    {
+        int sy = std::clamp(y - padding, 0, spec.Height - 1);
+        for (int x = 0; x < width; x++)
+        {
+            int sx = std::clamp(x - padding, 0, spec.Width - 1);
+            std::memcpy(&padded[((size_t)y * width + x) * pixel],
+                        &source[((size_t)sy * spec.Width + sx) * pixel], pixel);
+        }
+    }
+    
+    const TextureRegion& page = target->region;
+    page.array->SetRegion(page.layer, position.x, position.y, width, height, padded.data());
+    if (std::find(m_Modified.begin(), m_Modified.end(), page.array) == m_Modified.end())
+        m_Modified.push_back(page.array);
+    
+    // Remap the texture coordinates into the region (inside the padding)
+    float size = (float)m_AtlasSize;
+    TextureRegion region = page;
+    region.transform = glm::vec4((float)spec.Width / size, (float)spec.Height / size,
+                                 (float)(position.x + padding) / size, (float)(position.y + padding) / size);
+    
+    m_AtlasTextures++;
+    return region;
+}
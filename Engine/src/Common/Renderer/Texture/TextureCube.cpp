@@ -1,6 +1,9 @@
 #include "enginepch.h"
 #include "Common/Renderer/Texture/TextureCube.h"
 
+#include "Common/Core/Timer.h"
+#include "Common/Renderer/Renderer.h"
+
 #include <GL/glew.h>
 #include <stb_image.h>
 
@@ -15,6 +18,7 @@ TextureCube::TextureCube()
     : Texture()
 {
     m_Spec.Type = TextureType::TEXTURECUBE;
+    m_Category = TextureCategory::Environment;
 }
 
 /**
@@ -48,6 +52,7 @@ TextureCube::TextureCube(const TextureSpecification& spec)
     : Texture(spec), m_CubeSpecs(std::vector<TextureSpecification>(6, spec))
 {
     m_Spec.Type = TextureType::TEXTURECUBE;
+    m_Category = TextureCategory::Environment;
 }
 
 /**
@@ -74,6 +79,27 @@ TextureCube::TextureCube(const std::vector<const void *>& data, const TextureSpe
     CreateTexture(data);
 }
 
+/**
+ * Estimate the video memory used by the texture, including the levels of all its faces.
+ *
+ * @return The size of the texture (in bytes).
+ */
+size_t TextureCube::GetMemorySize() const
+{
+    if (m_ID == 0 || m_CubeSpecs.empty())
+        return Texture::GetMemorySize();
+    
+    // The faces share the size and format
+    TextureSpecification spec = m_CubeSpecs[0];
+    spec.MipMaps = m_Spec.MipMaps;
+    
+    size_t size = 0;
+    for (unsigned int i = 0; i < GetMipLevels(spec); i++)
+        size += utils::OpenGL::TextureFormatToMemorySize(spec.Format, std::max(spec.Width >> i, 1),
+                                                         std::max(spec.Height >> i, 1));
+    return 6 * size;
+}
+
 /**
  * Get the texture target based on the texture specification.
  *
@@ -106,39 +132,62 @@ void TextureCube::CreateTexture(const std::vector<const void *>& data)
     // Check that the data contains exactly 6 faces
     CORE_ASSERT(data.size() == 6, "Invalid data for the texture cube map!");
     
-    // Bind the texture
-    Bind();
+    // Generate (or bind) the texture
+    BeginCreation();
     
     // Set texture wrapping and filtering parameters
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S,
-                    utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T,
-                    utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R,
-                    utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
-    
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER,
-                    utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, m_Spec.MipMaps));
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER,
-                    utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, false));
+    SetParameter(GL_TEXTURE_WRAP_S, utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
+    SetParameter(GL_TEXTURE_WRAP_T, utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
+    SetParameter(GL_TEXTURE_WRAP_R, utils::OpenGL::TextureWrapToOpenGLType(m_Spec.Wrap));
+    
+    SetParameter(GL_TEXTURE_MIN_FILTER,
+                 utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, m_Spec.MipMaps));
+    SetParameter(GL_TEXTURE_MAG_FILTER,
+                 utils::OpenGL::TextureFilterToOpenGLType(m_Spec.Filter, false));
+    
+    // The storage of all the faces is defined at once (they share the size and format)
+    bool compressed = utils::OpenGL::IsCompressedFormat(m_CubeSpecs[0].Format);
+    if (UseDirectStateAccess())
+    {
+        TextureSpecification spec = m_CubeSpecs[0];
+        spec.MipMaps = m_Spec.MipMaps;
+        glTextureStorage2D(m_ID, GetMipLevels(spec),
+                           utils::OpenGL::TextureFormatToOpenGLStorageType(spec.Format),
+                           spec.Width, spec.Height);
+    }
     
     for (unsigned int i = 0; i < data.size(); ++i)
     {
         // Verify size of the 2D texture
         CORE_ASSERT(m_CubeSpecs[i].Width > 0 && m_CubeSpecs[i].Height > 0,
                     "2D texture size not properly defined!");
-        // Create the texture with the data
-        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, utils::OpenGL::TextureFormatToOpenGLInternalType(m_CubeSpecs[i].Format),
-                     m_CubeSpecs[i].Width, m_CubeSpecs[i].Height, 0, utils::OpenGL::TextureFormatToOpenGLBaseType(m_CubeSpecs[i].Format),
-                     utils::OpenGL::TextureFormatToOpenGLDataType(m_CubeSpecs[i].Format), data[i]);
+        // Create the texture with the data (including its mipmaps if compressed)
+        if (compressed)
+        {
+            TextureSpecification spec = m_CubeSpecs[i];
+            spec.MipMaps = m_Spec.MipMaps;
+            if (data[i] || !UseDirectStateAccess())
+                SetCompressedData(spec, data[i], i);
+        }
+        else if (UseDirectStateAccess())
+        {
+            if (data[i])
+                glTextureSubImage3D(m_ID, 0, 0, 0, i, m_CubeSpecs[i].Width, m_CubeSpecs[i].Height, 1,
+                                    utils::OpenGL::TextureFormatToOpenGLBaseType(m_CubeSpecs[i].Format),
+                                    utils::OpenGL::TextureFormatToOpenGLDataType(m_CubeSpecs[i].Format), data[i]);
+        }
+        else
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, utils::OpenGL::TextureFormatToOpenGLInternalType(m_CubeSpecs[i].Format),
+                         m_CubeSpecs[i].Width, m_CubeSpecs[i].Height, 0, utils::OpenGL::TextureFormatToOpenGLBaseType(m_CubeSpecs[i].Format),
+                         utils::OpenGL::TextureFormatToOpenGLDataType(m_CubeSpecs[i].Format), data[i]);
     }
     
-    // Generate mipmaps if specified
-    if (m_Spec.MipMaps)
-        glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+    // Generate mipmaps if specified (compressed data already contains them)
+    if (m_Spec.MipMaps && !compressed)
+        GenerateMipmaps();
     
     // Unbind the texture
-    Unbind();
+    EndCreation();
 }
 
 // --------------------------------------------
@@ -159,7 +208,11 @@ TextureCubeResource::TextureCubeResource(const std::filesystem::path& directory,
 }
 
 /**
- * Load the texture from an input (image) source file.
+ * Load the texture from the input (image) source files, one for each face.
+ *
+ * The faces are validated from the headers of the files (all of them must share a square size
+ * and format) before being decoded concurrently by the thread pool of the renderer, and the
+ * texture is only created once all of them have been decoded.
  *
  * @param directory Textures file path.
  * @param files List of texture files.
@@ -170,44 +223,122 @@ void TextureCubeResource::LoadFromFile(const std::filesystem::path& directory,
     // Check that the data contains exactly 6 faces
     CORE_ASSERT(files.size() == 6, "Invalid data for the texture cube map!");
     
-    // Load the image into our local buffer
-    int width, height, channels;
-    std::vector<const void*> data(files.size(), nullptr);
-    m_CubeSpecs = std::vector<TextureSpecification>(files.size(), TextureSpecification());
+    Timer timer;
     
-    for(unsigned int i = 0; i < data.size(); i++)
+    // Validate the size and format of the faces before decoding them
+    m_CubeSpecs = std::vector<TextureSpecification>(files.size(), TextureSpecification());
+    for (unsigned int i = 0; i < files.size(); i++)
     {
-        // Determine whether to flip the image vertically
-        stbi_set_flip_vertically_on_load(m_Flip);
-        
-        // Define the file path
         std::filesystem::path filePath = directory / files[i];
+        int width, height, channels;
+        if (!stbi_info(filePath.string().c_str(), &width, &height, &channels))
+        {
+            CORE_WARN("Failed to load: " + filePath.filename().string());
+            return;
+        }
         
-        // Extract the file extension
+        // Save the corresponding image information (the 8-bit faces are expanded into RGBA)
         std::string extension = filePath.extension().string();
-        
-        data[i] = (extension != ".hdr") ? stbi_load(filePath.string().c_str(), &width, &height, &channels, 0) :
-                                   (void*)stbi_loadf(filePath.string().c_str(), &width, &height, &channels, 0);
-        
-        // Verify that the image has been loaded correctly
-        if (!data[i])
+        utils::Texturing::UpdateSpecsTextureResource(m_CubeSpecs[i], width, height,
+                                                     extension != ".hdr" ? 4 : channels, extension);
+        if (m_CubeSpecs[i].Format == TextureFormat::None)
         {
-            CORE_WARN("Failed to load: " + filePath.filename().string());
+            CORE_WARN("Data format of " + filePath.filename().string() + " not supported!");
+            return;
+        }
+        if (m_CubeSpecs[i].Width != m_CubeSpecs[0].Width || m_CubeSpecs[i].Height != m_CubeSpecs[0].Height ||
+            m_CubeSpecs[i].Format != m_CubeSpecs[0].Format)
+        {
+            CORE_WARN("The size or format of " + filePath.filename().string() +
+                      " does not match the other faces of the cube map!");
             return;
         }
+    }
+    if (m_CubeSpecs[0].Width != m_CubeSpecs[0].Height)
+    {
+        CORE_WARN("The faces of the cube map " + directory.string() + " are not square!");
+        return;
+    }
+    
+    // Decode the faces concurrently, expanding the 8-bit faces into RGBA (flipping them in the
+    // same pass) or flipping the other faces in place
+    std::vector<void*> decoded(files.size(), nullptr);
+    std::vector<std::vector<uint8_t>> expanded(files.size());
+    std::vector<const void*> data(files.size(), nullptr);
+    std::vector<float> decodeTimes(files.size(), 0.0f);
+    auto decodeFaces = [&](const int begin, const int end)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            Timer faceTimer;
+            stbi_set_flip_vertically_on_load_thread(false);
+            
+            std::filesystem::path filePath = directory / files[i];
+            bool isHDR = filePath.extension().string() == ".hdr";
+            int width, height, channels;
+            decoded[i] = !isHDR ? (void*)stbi_load(filePath.string().c_str(), &width, &height, &channels, 0) :
+                                  (void*)stbi_loadf(filePath.string().c_str(), &width, &height, &channels, 0);
+            data[i] = decoded[i];
+            if (decoded[i] && !isHDR && channels != 4)
+            {
+                expanded[i].resize((size_t)width * height * 4);
+                utils::Pixels::ExpandImageToRGBA(static_cast<const uint8_t*>(decoded[i]), width, height,
+                                                 channels, m_Flip, expanded[i].data());
+                stbi_image_free(decoded[i]);
+                decoded[i] = nullptr;
+                data[i] = expanded[i].data();
+            }
+            else if (decoded[i] && m_Flip)
+            {
+                utils::Pixels::FlipVertically(decoded[i], (size_t)width * channels *
+                                              (isHDR ? sizeof(float) : 1), height);
+            }
+            decodeTimes[i] = faceTimer.ElapsedMilliseconds();
+        }
+    };
+    
+    const auto& pool = Renderer::GetThreadPool();
+    int faces = (int)files.size();
+    int threads = pool ? std::min(faces, (int)pool->GetThreadCount() + 1) : 1;
+    if (threads > 1)
+        pool->ParallelFor(faces, threads, decodeFaces);
+    else
+        decodeFaces(0, faces);
+    float decodeTime = timer.ElapsedMilliseconds();
+    
+    // Verify that the images have been loaded correctly
+    bool loaded = true;
+    for (unsigned int i = 0; i < data.size(); i++)
+    {
+        if (data[i])
+            continue;
         
-        // Save the corresponding image information
-        utils::Texturing::UpdateSpecsTextureResource(m_CubeSpecs[i], width, height, channels);
-        CORE_ASSERT((unsigned int)m_CubeSpecs[i].Format,
-                    "Data format of " + filePath.filename().string() + " not supported!");
+        CORE_WARN("Failed to load: " + files[i]);
+        loaded = false;
     }
-    // Get the general image information
-    utils::Texturing::UpdateSpecsTextureResource(m_Spec, 0, 0, 0);
     
-    // Generate the cube texture
-    CreateTexture(data);
+    if (loaded)
+    {
+        // Get the general image information
+        utils::Texturing::UpdateSpecsTextureResource(m_Spec, 0, 0, 0);
+        
+        // Generate the cube texture
+        Timer uploadTimer;
+        CreateTexture(data);
+        float uploadTime = uploadTimer.ElapsedMilliseconds();
+        
+        // Report the timing of each face
+        CORE_DEBUG("Cube map {0} loaded in {1} ms (decoding: {2} ms, upload: {3} ms)",
+                   directory.string(), timer.ElapsedMilliseconds(), decodeTime, uploadTime);
+        for (unsigned int i = 0; i < files.size(); i++)
+            CORE_TRACE("  Face {0} ({1}): {2}x{3} decoded in {4} ms", i, files[i],
+                       m_CubeSpecs[i].Width, m_CubeSpecs[i].Height, decodeTimes[i]);
+    }
     
     // Free memory
-    for(unsigned int i = 0; i < data.size(); i++)
-        stbi_image_free(const_cast<void*>(data[i]));
+    for (unsigned int i = 0; i < decoded.size(); i++)
+    {
+        if (decoded[i])
+            stbi_image_free(decoded[i]);
+    }
 }
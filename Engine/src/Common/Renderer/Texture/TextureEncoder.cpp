@@ -0,0 +1,893 @@
+#include "enginepch.h"
+#include "Common/Renderer/Texture/TextureEncoder.h"
+
+#include "Common/Renderer/Renderer.h"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define ENCODER_SIMD_SSE
+#endif
+
+// Minimum number of block rows encoded by each thread
+static const int g_RowsPerThread = 8;
+
+// Weights of the endpoints interpolated by the BC7 4-bit indices (out of 64)
+static const int g_BC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+// Weights of the second endpoint for each index of the BC1 color blocks
+static const float g_BC1Weights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+// Number of least squares iterations refining the endpoints (high quality)
+static const int g_RefineIterations = 2;
+
+// --------------------------------------------
+// Blocks
+// --------------------------------------------
+
+/**
+ * Read a block of 4x4 texels, replicating the edge texels if the block exceeds the image.
+ *
+ * @param image The RGBA image.
+ * @param width The width of the image.
+ * @param height The height of the image.
+ * @param x The column of the block.
+ * @param y The row of the block.
+ * @param block The texels of the block (RGBA, row by row).
+ */
+static void FetchBlock(const uint8_t *image, const int width, const int height,
+                       const int x, const int y, uint8_t block[64])
+{
+    for (int j = 0; j < 4; j++)
+    {
+        int row = std::min(y * 4 + j, height - 1);
+        for (int i = 0; i < 4; i++)
+        {
+            int column = std::min(x * 4 + i, width - 1);
+            std::memcpy(block + (j * 4 + i) * 4, image + ((size_t)row * width + column) * 4, 4);
+        }
+    }
+}
+
+/**
+ * Write bits into a block, starting from the least significant bit of its first byte.
+ *
+ * @param output The block (zero initialized).
+ * @param position The bit to be written next (advanced by the number of bits).
+ * @param value The value to be written.
+ * @param bits The number of bits of the value.
+ */
+static void WriteBits(uint8_t *output, unsigned int& position, const unsigned int value,
+                      const unsigned int bits)
+{
+    for (unsigned int i = 0; i < bits; i++, position++)
+    {
+        if ((value >> i) & 1)
+            output[position >> 3] |= (uint8_t)(1 << (position & 7));
+    }
+}
+
+// --------------------------------------------
+// Endpoints
+// --------------------------------------------
+
+/**
+ * Find the endpoints of the line segment approximating the colors of a block.
+ *
+ * The fast estimation uses the diagonal of the bounding box of the colors (slightly inset),
+ * flipping the channels whose correlation with the largest one is negative. Otherwise, the
+ * colors are projected onto their principal axis, found with a power iteration.
+ *
+ * @param block The texels of the block.
+ * @param channels The number of channels used (3 for RGB, 4 for RGBA).
+ * @param principal Use the principal axis of the colors.
+ * @param e0 The first endpoint.
+ * @param e1 The second endpoint.
+ */
+static void FindEndpoints(const uint8_t block[64], const int channels, const bool principal,
+                          float e0[4], float e1[4])
+{
+    // Compute the mean and the covariance of the colors
+    float mean[4] = { 0.0f }, low[4], high[4];
+    for (int c = 0; c < 4; c++)
+    {
+        low[c] = 255.0f;
+        high[c] = 0.0f;
+    }
+    for (int i = 0; i < 16; i++)
+    {
+        for (int c = 0; c < channels; c++)
+        {
+            float value = (float)block[i * 4 + c];
+            mean[c] += value;
+            low[c] = std::min(low[c], value);
+            high[c] = std::max(high[c], value);
+        }
+    }
+    for (int c = 0; c < channels; c++)
+        mean[c] /= 16.0f;
+    
+    float covariance[4][4] = {};
+    for (int i = 0; i < 16; i++)
+    {
+        float d[4] = { 0.0f };
+        for (int c = 0; c < channels; c++)
+            d[c] = (float)block[i * 4 + c] - mean[c];
+        for (int a = 0; a < channels; a++)
+            for (int b = 0; b < channels; b++)
+                covariance[a][b] += d[a] * d[b];
+    }
+    
+    int major = 0;
+    for (int c = 1; c < channels; c++)
+        major = covariance[c][c] > covariance[major][major] ? c : major;
+    
+    if (!principal)
+    {
+        // Inset the bounding box to reduce the error of the interpolated colors
+        for (int c = 0; c < 4; c++)
+        {
+            float inset = (high[c] - low[c]) / 16.0f;
+            bool flip = c < channels && covariance[major][c] < 0.0f;
+            e0[c] = flip ? low[c] + inset : high[c] - inset;
+            e1[c] = flip ? high[c] - inset : low[c] + inset;
+        }
+        return;
+    }
+    
+    // Find the principal axis, starting from the channel with the largest variance
+    float axis[4] = { 0.0f };
+    for (int c = 0; c < channels; c++)
+        axis[c] = covariance[major][c];
+    for (int iteration = 0; iteration < 8; iteration++)
+    {
+        float next[4] = { 0.0f }, norm = 0.0f;
+        for (int a = 0; a < channels; a++)
+        {
+            for (int b = 0; b < channels; b++)
+                next[a] += covariance[a][b] * axis[b];
+            norm = std::max(norm, std::abs(next[a]));
+        }
+        if (norm < 1e-6f)
+            break;
+        for (int c = 0; c < channels; c++)
+            axis[c] = next[c] / norm;
+    }
+    
+    // Project the colors onto the axis to find its extent
+    float length = 0.0f;
+    for (int c = 0; c < channels; c++)
+        length += axis[c] * axis[c];
+    
+    float minimum = 0.0f, maximum = 0.0f;
+    if (length > 1e-6f)
+    {
+        minimum = std::numeric_limits<float>::max();
+        maximum = std::numeric_limits<float>::lowest();
+        for (int i = 0; i < 16; i++)
+        {
+            float t = 0.0f;
+            for (int c = 0; c < channels; c++)
+                t += ((float)block[i * 4 + c] - mean[c]) * axis[c];
+            minimum = std::min(minimum, t / length);
+            maximum = std::max(maximum, t / length);
+        }
+    }
+    
+    for (int c = 0; c < 4; c++)
+    {
+        e0[c] = c < channels ? std::clamp(mean[c] + axis[c] * maximum, 0.0f, 255.0f) : 255.0f;
+        e1[c] = c < channels ? std::clamp(mean[c] + axis[c] * minimum, 0.0f, 255.0f) : 255.0f;
+    }
+}
+
+/**
+ * Refine the endpoints of a block with the least squares fit of its texels, given the index
+ * (interpolation weight) selected for each texel.
+ *
+ * @param block The texels of the block.
+ * @param channels The number of channels used.
+ * @param indices The indices of the texels.
+ * @param weights The weight of the second endpoint for each index.
+ * @param e0 The first endpoint.
+ * @param e1 The second endpoint.
+ *
+ * @return `true` if the endpoints have been updated.
+ */
+static bool RefineEndpoints(const uint8_t block[64], const int channels, const uint8_t indices[16],
+                            const float *weights, float e0[4], float e1[4])
+{
+    float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+    float ax[4] = { 0.0f }, bx[4] = { 0.0f };
+    for (int i = 0; i < 16; i++)
+    {
+        float b = weights[indices[i]];
+        float a = 1.0f - b;
+        aa += a * a;
+        bb += b * b;
+        ab += a * b;
+        for (int c = 0; c < channels; c++)
+        {
+            ax[c] += a * (float)block[i * 4 + c];
+            bx[c] += b * (float)block[i * 4 + c];
+        }
+    }
+    
+    // All the texels use the same weight
+    float determinant = aa * bb - ab * ab;
+    if (std::abs(determinant) < 1e-6f)
+        return false;
+    
+    for (int c = 0; c < channels; c++)
+    {
+        e0[c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+        e1[c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+// --------------------------------------------
+// Color blocks (BC1)
+// --------------------------------------------
+
+/**
+ * Quantize a color into the 5:6:5 format of the color block endpoints.
+ *
+ * @param color The color (RGB, between 0 and 255).
+ *
+ * @return The packed color.
+ */
+static uint16_t PackRGB565(const float color[4])
+{
+    int r = (int)std::lround(color[0] * 31.0f / 255.0f);
+    int g = (int)std::lround(color[1] * 63.0f / 255.0f);
+    int b = (int)std::lround(color[2] * 31.0f / 255.0f);
+    return (uint16_t)((std::clamp(r, 0, 31) << 11) | (std::clamp(g, 0, 63) << 5) | std::clamp(b, 0, 31));
+}
+
+/**
+ * Expand a color of the 5:6:5 format, as done by the GPU.
+ *
+ * @param packed The packed color.
+ * @param color The color (RGB, alpha set to zero).
+ */
+static void UnpackRGB565(const uint16_t packed, int color[4])
+{
+    int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+    color[3] = 0;
+}
+
+/**
+ * Select the closest color of the palette for each texel of a block (alpha ignored).
+ *
+ * @param block The texels of the block.
+ * @param palette The four colors of the block.
+ * @param indices The index selected for each texel.
+ *
+ * @return The squared error of the block.
+ */
+static unsigned int FindColorIndices(const uint8_t block[64], const int palette[4][4],
+                                     uint8_t indices[16])
+{
+    unsigned int error = 0;
+#if defined(ENCODER_SIMD_SSE)
+    // Four texels are compared at a time, with their channels widened to 16 bits
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    __m128i colors[4];
+    for (int k = 0; k < 4; k++)
+        colors[k] = _mm_set_epi16(0, (short)palette[k][2], (short)palette[k][1], (short)palette[k][0],
+                                  0, (short)palette[k][2], (short)palette[k][1], (short)palette[k][0]);
+    
+    for (int group = 0; group < 4; group++)
+    {
+        __m128i texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + group * 16));
+        __m128i low = _mm_and_si128(_mm_unpacklo_epi8(texels, zero), mask);
+        __m128i high = _mm_and_si128(_mm_unpackhi_epi8(texels, zero), mask);
+        
+        __m128i best = _mm_setzero_si128(), selected = _mm_setzero_si128();
+        for (int k = 0; k < 4; k++)
+        {
+            // Squared distances (r² + g² and b² of each texel, then summed per texel)
+            __m128i dl = _mm_sub_epi16(low, colors[k]);
+            __m128i dh = _mm_sub_epi16(high, colors[k]);
+            __m128i sl = _mm_shuffle_epi32(_mm_madd_epi16(dl, dl), _MM_SHUFFLE(3, 1, 2, 0));
+            __m128i sh = _mm_shuffle_epi32(_mm_madd_epi16(dh, dh), _MM_SHUFFLE(3, 1, 2, 0));
+            __m128i distance = _mm_add_epi32(_mm_unpacklo_epi64(sl, sh), _mm_unpackhi_epi64(sl, sh));
+            
+            if (k == 0)
+            {
+                best = distance;
+                continue;
+            }
+            __m128i closer = _mm_cmplt_epi32(distance, best);
+            best = _mm_or_si128(_mm_and_si128(closer, distance), _mm_andnot_si128(closer, best));
+            selected = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(k)),
+                                    _mm_andnot_si128(closer, selected));
+        }
+        
+        alignas(16) int distances[4], choices[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(distances), best);
+        _mm_store_si128(reinterpret_cast<__m128i*>(choices), selected);
+        for (int i = 0; i < 4; i++)
+        {
+            indices[group * 4 + i] = (uint8_t)choices[i];
+            error += (unsigned int)distances[i];
+        }
+    }
+#else
+    for (int i = 0; i < 16; i++)
+    {
+        int best = std::numeric_limits<int>::max();
+        for (int k = 0; k < 4; k++)
+        {
+            int distance = 0;
+            for (int c = 0; c < 3; c++)
+            {
+                int d = (int)block[i * 4 + c] - palette[k][c];
+                distance += d * d;
+            }
+            if (distance < best)
+            {
+                best = distance;
+                indices[i] = (uint8_t)k;
+            }
+        }
+        error += (unsigned int)best;
+    }
+#endif
+    return error;
+}
+
+/**
+ * Encode a color block from its endpoints, always using the four color mode.
+ *
+ * @param block The texels of the block.
+ * @param e0 The first endpoint.
+ * @param e1 The second endpoint.
+ * @param output The encoded block (8 bytes).
+ * @param indices The index selected for each texel.
+ *
+ * @return The squared error of the block.
+ */
+static unsigned int QuantizeColorBlock(const uint8_t block[64], const float e0[4], const float e1[4],
+                                       uint8_t *output, uint8_t indices[16])
+{
+    // The four color mode requires the first endpoint to be greater
+    uint16_t c0 = PackRGB565(e0), c1 = PackRGB565(e1);
+    if (c0 < c1)
+        std::swap(c0, c1);
+    
+    int palette[4][4];
+    UnpackRGB565(c0, palette[0]);
+    UnpackRGB565(c1, palette[1]);
+    for (int c = 0; c < 4; c++)
+    {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+    
+    // If both endpoints are equal, all the texels use the first one
+    unsigned int error = FindColorIndices(block, palette, indices);
+    
+    uint32_t bits = 0;
+    for (int i = 0; i < 16; i++)
+        bits |= (uint32_t)indices[i] << (2 * i);
+    
+    output[0] = (uint8_t)(c0 & 0xFF);
+    output[1] = (uint8_t)(c0 >> 8);
+    output[2] = (uint8_t)(c1 & 0xFF);
+    output[3] = (uint8_t)(c1 >> 8);
+    for (int i = 0; i < 4; i++)
+        output[4 + i] = (uint8_t)(bits >> (8 * i));
+    return error;
+}
+
+/**
+ * Encode the color (RGB) of a block (BC1, and the color part of BC3).
+ *
+ * @param block The texels of the block.
+ * @param high Use the high quality encoding.
+ * @param output The encoded block (8 bytes).
+ */
+static void EncodeColorBlock(const uint8_t block[64], const bool high, uint8_t *output)
+{
+    float e0[4], e1[4];
+    uint8_t indices[16];
+    FindEndpoints(block, 3, high, e0, e1);
+    unsigned int error = QuantizeColorBlock(block, e0, e1, output, indices);
+    if (!high)
+        return;
+    
+    // Keep the refined endpoints only if they reduce the error
+    uint8_t candidate[8], refined[16];
+    for (int iteration = 0; iteration < g_RefineIterations && error > 0; iteration++)
+    {
+        // The indices refer to the endpoints in their encoded order
+        uint16_t c0 = (uint16_t)(output[0] | (output[1] << 8));
+        uint16_t c1 = (uint16_t)(output[2] | (output[3] << 8));
+        if (c0 == c1 || !RefineEndpoints(block, 3, indices, g_BC1Weights, e0, e1))
+            break;
+        
+        unsigned int candidateError = QuantizeColorBlock(block, e0, e1, candidate, refined);
+        if (candidateError >= error)
+            break;
+        
+        error = candidateError;
+        std::memcpy(output, candidate, 8);
+        std::memcpy(indices, refined, 16);
+    }
+}
+
+// --------------------------------------------
+// Channel blocks (BC4)
+// --------------------------------------------
+
+/**
+ * Encode a single channel block from its endpoints.
+ *
+ * @param values The values of the texels.
+ * @param r0 The first endpoint.
+ * @param r1 The second endpoint (greater than the first for the six value mode).
+ * @param output The encoded block (8 bytes).
+ *
+ * @return The squared error of the block.
+ */
+static unsigned int QuantizeChannelBlock(const int values[16], const int r0, const int r1,
+                                         uint8_t *output)
+{
+    // Build the palette: eight interpolated values, or six with the extremes (0 and 255)
+    int palette[8] = { r0, r1 };
+    if (r0 > r1)
+    {
+        for (int k = 2; k < 8; k++)
+            palette[k] = ((8 - k) * r0 + (k - 1) * r1 + 3) / 7;
+    }
+    else
+    {
+        for (int k = 2; k < 6; k++)
+            palette[k] = ((6 - k) * r0 + (k - 1) * r1 + 2) / 5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    
+    unsigned int error = 0;
+    uint64_t bits = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        int best = std::numeric_limits<int>::max(), index = 0;
+        for (int k = 0; k < 8; k++)
+        {
+            int d = values[i] - palette[k];
+            if (d * d < best)
+            {
+                best = d * d;
+                index = k;
+            }
+        }
+        error += (unsigned int)best;
+        bits |= (uint64_t)index << (3 * i);
+    }
+    
+    output[0] = (uint8_t)r0;
+    output[1] = (uint8_t)r1;
+    for (int i = 0; i < 6; i++)
+        output[2 + i] = (uint8_t)(bits >> (8 * i));
+    return error;
+}
+
+/**
+ * Encode a channel of a block (BC4, the red and green channels of BC5, and the alpha of BC3).
+ *
+ * @param block The texels of the block.
+ * @param channel The channel encoded.
+ * @param high Use the high quality encoding.
+ * @param output The encoded block (8 bytes).
+ */
+static void EncodeChannelBlock(const uint8_t block[64], const int channel, const bool high,
+                               uint8_t *output)
+{
+    int values[16], low = 255, peak = 0, innerLow = 255, innerPeak = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        values[i] = block[i * 4 + channel];
+        low = std::min(low, values[i]);
+        peak = std::max(peak, values[i]);
+        if (values[i] > 0 && values[i] < 255)
+        {
+            innerLow = std::min(innerLow, values[i]);
+            innerPeak = std::max(innerPeak, values[i]);
+        }
+    }
+    
+    // Constant blocks only use the first endpoint
+    if (low == peak)
+    {
+        QuantizeChannelBlock(values, low, low, output);
+        return;
+    }
+    
+    unsigned int error = QuantizeChannelBlock(values, peak, low, output);
+    if (!high || error == 0)
+        return;
+    
+    // Blocks containing the extremes may be better encoded with the six value mode, and the
+    // interpolated values may be closer with the endpoints slightly inset
+    uint8_t candidate[8];
+    auto tryEndpoints = [&](const int r0, const int r1)
+    {
+        unsigned int candidateError = QuantizeChannelBlock(values, r0, r1, candidate);
+        if (candidateError < error)
+        {
+            error = candidateError;
+            std::memcpy(output, candidate, 8);
+        }
+    };
+    if (innerLow <= innerPeak && (low == 0 || peak == 255))
+        tryEndpoints(innerLow, innerPeak);
+    
+    int inset = (peak - low) / 28;
+    for (int i = 1; i <= inset && error > 0; i++)
+    {
+        tryEndpoints(peak - i, low);
+        tryEndpoints(peak, low + i);
+        tryEndpoints(peak - i, low + i);
+    }
+}
+
+// --------------------------------------------
+// BPTC blocks (BC7)
+// --------------------------------------------
+
+/**
+ * Encode a BC7 block (mode 6) from its endpoints.
+ *
+ * Each endpoint is quantized to 7 bits per channel plus a shared low bit (p-bit), chosen to
+ * minimize its error. The indices are then selected among the 16 interpolated colors.
+ *
+ * @param block The texels of the block.
+ * @param e0 The first endpoint.
+ * @param e1 The second endpoint.
+ * @param output The encoded block (16 bytes).
+ * @param indices The index selected for each texel.
+ *
+ * @return The squared error of the block.
+ */
+static unsigned int QuantizeBPTCBlock(const uint8_t block[64], const float e0[4], const float e1[4],
+                                      uint8_t *output, uint8_t indices[16])
+{
+    // Quantize the endpoints with the p-bit of lowest error
+    int quantized[2][4], pbits[2], endpoints[2][4];
+    const float* source[2] = { e0, e1 };
+    for (int e = 0; e < 2; e++)
+    {
+        float bestError = std::numeric_limits<float>::max();
+        for (int p = 0; p < 2; p++)
+        {
+            int q[4];
+            float pError = 0.0f;
+            for (int c = 0; c < 4; c++)
+            {
+                q[c] = std::clamp((int)std::lround((source[e][c] - (float)p) / 2.0f), 0, 127);
+                float d = (float)((q[c] << 1) | p) - source[e][c];
+                pError += d * d;
+            }
+            if (pError < bestError)
+            {
+                bestError = pError;
+                pbits[e] = p;
+                std::memcpy(quantized[e], q, sizeof(q));
+            }
+        }
+        for (int c = 0; c < 4; c++)
+            endpoints[e][c] = (quantized[e][c] << 1) | pbits[e];
+    }
+    
+    int palette[16][4];
+    for (int k = 0; k < 16; k++)
+        for (int c = 0; c < 4; c++)
+            palette[k][c] = ((64 - g_BC7Weights[k]) * endpoints[0][c] + g_BC7Weights[k] * endpoints[1][c] + 32) >> 6;
+    
+    unsigned int error = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        int best = std::numeric_limits<int>::max();
+        for (int k = 0; k < 16; k++)
+        {
+            int distance = 0;
+            for (int c = 0; c < 4; c++)
+            {
+                int d = (int)block[i * 4 + c] - palette[k][c];
+                distance += d * d;
+            }
+            if (distance < best)
+            {
+                best = distance;
+                indices[i] = (uint8_t)k;
+            }
+        }
+        error += (unsigned int)best;
+    }
+    
+    // The most significant bit of the first index is implicit (zero), so the endpoints are
+    // swapped if required
+    if (indices[0] >= 8)
+    {
+        std::swap(quantized[0], quantized[1]);
+        std::swap(pbits[0], pbits[1]);
+        for (int i = 0; i < 16; i++)
+            indices[i] = (uint8_t)(15 - indices[i]);
+    }
+    
+    std::memset(output, 0, 16);
+    unsigned int position = 0;
+    WriteBits(output, position, 1 << 6, 7);
+    for (int c = 0; c < 4; c++)
+    {
+        WriteBits(output, position, (unsigned int)quantized[0][c], 7);
+        WriteBits(output, position, (unsigned int)quantized[1][c], 7);
+    }
+    WriteBits(output, position, (unsigned int)pbits[0], 1);
+    WriteBits(output, position, (unsigned int)pbits[1], 1);
+    WriteBits(output, position, indices[0], 3);
+    for (int i = 1; i < 16; i++)
+        WriteBits(output, position, indices[i], 4);
+    return error;
+}
+
+/**
+ * Encode a block (RGBA) with the BC7 format.
+ *
+ * @param block The texels of the block.
+ * @param high Use the high quality encoding.
+ * @param output The encoded block (16 bytes).
+ */
+static void EncodeBPTCBlock(const uint8_t block[64], const bool high, uint8_t *output)
+{
+    float e0[4], e1[4];
+    uint8_t indices[16];
+    FindEndpoints(block, 4, high, e0, e1);
+    unsigned int error = QuantizeBPTCBlock(block, e0, e1, output, indices);
+    if (!high)
+        return;
+    
+    // Weight of the second endpoint for each index
+    float weights[16];
+    for (int k = 0; k < 16; k++)
+        weights[k] = (float)g_BC7Weights[k] / 64.0f;
+    
+    uint8_t candidate[16], refined[16];
+    for (int iteration = 0; iteration < g_RefineIterations && error > 0; iteration++)
+    {
+        if (!RefineEndpoints(block, 4, indices, weights, e0, e1))
+            break;
+        
+        unsigned int candidateError = QuantizeBPTCBlock(block, e0, e1, candidate, refined);
+        if (candidateError >= error)
+            break;
+        
+        error = candidateError;
+        std::memcpy(output, candidate, 16);
+        std::memcpy(indices, refined, 16);
+    }
+}
+
+// --------------------------------------------
+// Images
+// --------------------------------------------
+
+/**
+ * Expand an 8-bit image into RGBA texels, so all the blocks are read the same way.
+ *
+ * The two-channel images are expanded as luminance and alpha, like the images uploaded directly,
+ * except for BC5, which encodes the red and green channels: their second channel is moved from
+ * the alpha back into the green channel.
+ *
+ * @param data The image data.
+ * @param width The width of the image.
+ * @param height The height of the image.
+ * @param channels The number of channels of the image.
+ * @param format The compressed format.
+ *
+ * @return The RGBA image.
+ */
+static std::vector<uint8_t> ExpandImage(const uint8_t *data, const int width, const int height,
+                                        const int channels, const TextureFormat format)
+{
+    size_t texels = (size_t)width * height;
+    std::vector<uint8_t> image(texels * 4);
+    utils::Pixels::ExpandImageToRGBA(data, width, height, channels, false, image.data());
+    if (channels == 2 && format == TextureFormat::BC5)
+        utils::Pixels::Swizzle(image.data(), texels, { 0, 3, 2, 1 });
+    return image;
+}
+
+// --------------------------------------------
+// Texture encoder
+// --------------------------------------------
+
+/**
+ * Define a texture encoder.
+ *
+ * @param quality The quality of the encoding.
+ * @param threads The number of threads encoding each level (the calling thread and the workers of
+ * the renderer thread pool if zero).
+ */
+TextureEncoder::TextureEncoder(const EncoderQuality quality, const unsigned int threads)
+    : m_Quality(quality), m_Threads(threads)
+{
+    const auto& pool = Renderer::GetThreadPool();
+    if (m_Threads == 0)
+        m_Threads = pool ? pool->GetThreadCount() + 1 : 1;
+}
+
+/**
+ * Encode an 8-bit image into a block-compressed format.
+ *
+ * @param data The image data (tightly packed rows).
+ * @param width The width of the image.
+ * @param height The height of the image.
+ * @param channels The number of channels of the image.
+ * @param format The compressed format.
+ * @param mipmaps Encode the complete mip chain after the base level.
+ *
+ * @return The encoded levels, one after the other.
+ */
+std::vector<uint8_t> TextureEncoder::Encode(const void *data, const int width, const int height,
+                                            const int channels, const TextureFormat format,
+                                            const bool mipmaps) const
+{
+    CORE_ASSERT(utils::OpenGL::IsCompressedFormat(format), "The encoder format must be compressed!");
+    CORE_ASSERT(data && width > 0 && height > 0 && channels >= 1 && channels <= 4,
+                "Invalid image for the texture encoder!");
+    
+    // Compute the size of all the levels (as allocated by the texture)
+    int levels = 1;
+    for (int size = std::max(width, height); mipmaps && size > 1; size >>= 1)
+        levels++;
+    
+    size_t total = 0;
+    for (int i = 0; i < levels; i++)
+        total += utils::OpenGL::TextureFormatToImageSize(format, std::max(width >> i, 1),
+                                                         std::max(height >> i, 1));
+    std::vector<uint8_t> output(total);
+    
+    // Generate the mipmaps from the expanded image
+    std::vector<uint8_t> image = ExpandImage(static_cast<const uint8_t*>(data), width, height, channels,
+                                             format);
+    std::vector<std::vector<uint8_t>> chain;
+    if (levels > 1)
+    {
+        MipmapSettings settings = m_Mipmaps;
+        settings.Threads = settings.Threads > 0 ? settings.Threads : m_Threads;
+        chain = MipmapGenerator(settings).Generate(image.data(), width, height, TextureFormat::RGBA8);
+    }
+    
+    // Encode the levels
+    size_t offset = 0;
+    for (int i = 0; i < levels; i++)
+    {
+        int levelWidth = std::max(width >> i, 1), levelHeight = std::max(height >> i, 1);
+        EncodeLevel(i == 0 ? image.data() : chain[i - 1].data(), levelWidth, levelHeight, format,
+                    output.data() + offset);
+        offset += utils::OpenGL::TextureFormatToImageSize(format, levelWidth, levelHeight);
+    }
+    return output;
+}
+
+/**
+ * Encode the blocks of a level, splitting the rows of blocks among the threads.
+ *
+ * @param image The RGBA image of the level.
+ * @param width The width of the level.
+ * @param height The height of the level.
+ * @param format The compressed format.
+ * @param output The encoded level.
+ */
+void TextureEncoder::EncodeLevel(const uint8_t *image, const int width, const int height,
+                                 const TextureFormat format, uint8_t *output) const
+{
+    int columns = (width + 3) / 4, rows = (height + 3) / 4;
+    unsigned int blockSize = utils::OpenGL::TextureFormatToBlockSize(format);
+    bool high = m_Quality == EncoderQuality::High;
+    
+    auto encodeRows = [=](const int begin, const int end)
+    {
+        uint8_t block[64];
+        for (int y = begin; y < end; y++)
+        {
+            for (int x = 0; x < columns; x++)
+            {
+                FetchBlock(image, width, height, x, y, block);
+                uint8_t* encoded = output + ((size_t)y * columns + x) * blockSize;
+                switch (format)
+                {
+                    case TextureFormat::BC1:
+                        EncodeColorBlock(block, high, encoded);
+                        break;
+                    case TextureFormat::BC3:
+                        EncodeChannelBlock(block, 3, high, encoded);
+                        EncodeColorBlock(block, high, encoded + 8);
+                        break;
+                    case TextureFormat::BC4:
+                        EncodeChannelBlock(block, 0, high, encoded);
+                        break;
+                    case TextureFormat::BC5:
+                        EncodeChannelBlock(block, 0, high, encoded);
+                        EncodeChannelBlock(block, 1, high, encoded + 8);
+                        break;
+                    case TextureFormat::BC7:
+                        EncodeBPTCBlock(block, high, encoded);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+    };
+    
+    // Small levels are encoded by the calling thread only, the others are split with the workers
+    // of the renderer thread pool
+    const auto& pool = Renderer::GetThreadPool();
+    int threads = pool ? std::clamp(rows / g_RowsPerThread, 1, (int)m_Threads) : 1;
+    if (threads > 1)
+        pool->ParallelFor(rows, threads, encodeRows);
+    else
+        encodeRows(0, rows);
+}
+
+/**
+ * Select the compressed format suited for the number of channels of an image.
+ *
+ * @param channels The number of channels of the image.
+ * @param quality The quality of the encoding.
+ *
+ * @return The compressed format, or `TextureFormat::None` if the GPU supports none.
+ */
+TextureFormat TextureEncoder::SelectFormat(const int channels, const EncoderQuality quality)
+{
+    TextureFormat format = TextureFormat::None;
+    switch (channels)
+    {
+        case 1: format = TextureFormat::BC4; break;
+        case 2: format = TextureFormat::BC5; break;
+        case 3: format = TextureFormat::BC1; break;
+        case 4: format = TextureFormat::BC3; break;
+        default: return TextureFormat::None;
+    }
+    
+    // BC7 preserves the color (and alpha) gradients better than BC1/BC3
+    if (channels >= 3 && quality == EncoderQuality::High && IsSupported(TextureFormat::BC7))
+        return TextureFormat::BC7;
+    return IsSupported(format) ? format : TextureFormat::None;
+}
+
+/**
+ * Check if a compressed format can be sampled by the current graphics context.
+ *
+ * @param format The compressed format.
+ *
+ * @return `true` if the format is supported.
+ */
+bool TextureEncoder::IsSupported(const TextureFormat format)
+{
+    switch (format)
+    {
+        case TextureFormat::BC1:
+        case TextureFormat::BC3:
+            return Renderer::GetCapabilities().textureCompressionS3TC;
+        // RGTC is core since OpenGL 3.0
+        case TextureFormat::BC4:
+        case TextureFormat::BC5:
+            return true;
+        case TextureFormat::BC7:
+            return Renderer::GetCapabilities().textureCompressionBPTC;
+        default:
+            return false;
+    }
+}
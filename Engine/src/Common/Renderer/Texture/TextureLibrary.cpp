@@ -0,0 +1,99 @@
+#include "enginepch.h"
+#include "Common/Renderer/Texture/TextureLibrary.h"
+
+/**
+ * Define a library of textures.
+ *
+ * @param loader The loader decoding the image files (the textures are loaded directly if null).
+ */
+TextureLibrary::TextureLibrary(const std::shared_ptr<TextureLoader>& loader)
+    : Library("Texture"), m_Loader(loader)
+{}
+
+/**
+ * Get the texture loaded from a file with specific options, loading it if it is not in the
+ * library yet.
+ *
+ * @param filePath Texture file path.
+ * @param options The options decoding the image.
+ *
+ * @return The (shared) texture.
+ */
+std::shared_ptr<Texture2DResource> TextureLibrary::Load(const std::filesystem::path& filePath,
+                                                        const TextureLoadOptions& options)
+{
+    std::string key = GetKey(filePath, options);
+    if (Exists(key))
+    {
+        m_Stats.hits++;
+        return Get(key);
+    }
+    
+    auto texture = m_Loader ? m_Loader->Load(filePath, options) :
+                              std::make_shared<Texture2DResource>(filePath, options);
+    Add(key, texture);
+    m_Stats.loads++;
+    return texture;
+}
+
+/**
+ * Evict the textures that are only referenced by the library.
+ *
+ * @return The video memory released (in bytes).
+ */
+size_t TextureLibrary::Collect()
+{
+    std::vector<std::string> unused;
+    size_t released = 0;
+    for (const auto& [key, texture] : *this)
+    {
+        if (texture.use_count() > 1)
+            continue;
+        
+        unused.push_back(key);
+        released += texture->GetMemorySize();
+    }
+    
+    for (const auto& key : unused)
+        Remove(key);
+    m_Stats.evictions += (unsigned int)unused.size();
+    return released;
+}
+
+/**
+ * Get the statistics of the textures in the library.
+ *
+ * @return The texture library statistics.
+ */
+TextureLibrary::LibraryStatistics TextureLibrary::GetStats() const
+{
+    LibraryStatistics stats = m_Stats;
+    for (const auto& [key, texture] : *this)
+    {
+        stats.textures++;
+        stats.references += (unsigned int)texture.use_count() - 1;
+        stats.memory += texture->GetMemorySize();
+    }
+    return stats;
+}
+
+/**
+ * Define the key identifying a texture in the library.
+ *
+ * @param filePath Texture file path.
+ * @param options The options decoding the image.
+ *
+ * @return The canonical path of the file followed by the options.
+ */
+std::string TextureLibrary::GetKey(const std::filesystem::path& filePath, const TextureLoadOptions& options)
+{
+    // Different relative paths to the same file must be identified by the same key
+    std::error_code error;
+    std::filesystem::path path = std::filesystem::weakly_canonical(filePath, error);
+    if (error)
+        path = filePath.lexically_normal();
+    
+    return path.generic_string() + "|" + (options.Flip ? "F" : "-") + (options.SRGB ? "S" : "-") +
+        (options.Premultiply ? "P" : "-") +
+        std::to_string((int)options.Format) + "|" + std::to_string((int)options.HDRFormat);
+}
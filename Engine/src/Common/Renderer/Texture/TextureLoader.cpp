@@ -0,0 +1,443 @@
+#include "enginepch.h"
+#include "Common/Renderer/Texture/TextureLoader.h"
+
+#include "Common/Core/Timer.h"
+
+#include <stb_image.h>
+
+// Data of the fallback texture (a single white pixel)
+static const unsigned char g_FallbackPixel[] = { 255, 255, 255, 255 };
+
+// Alignment of the uploads in the pixel unpack buffers (in bytes)
+static const unsigned int g_UploadAlignment = 16;
+
+/**
+ * Define the path of the KTX2 file imported from a source image. The file is named after the
+ * options changing its content, so loads of the same image with different options never share
+ * the same file.
+ *
+ * @param filePath The source image file path.
+ * @param options The options decoding the image.
+ * @param compress Whether the 8-bit images are compressed.
+ * @param quality The quality of the compression.
+ * @param mipmaps The settings filtering the mipmaps.
+ *
+ * @return The KTX2 file path.
+ */
+static std::filesystem::path GetImportPath(const std::filesystem::path& filePath,
+                                           const TextureLoadOptions& options, const bool compress,
+                                           const EncoderQuality quality, const MipmapSettings& mipmaps)
+{
+    uint64_t key = (uint64_t)options.Flip | ((uint64_t)(options.SRGB || mipmaps.SRGB) << 1) |
+                   ((uint64_t)options.Premultiply << 2) | ((uint64_t)compress << 3) |
+                   ((uint64_t)quality << 4) | ((uint64_t)mipmaps.Filter << 8) |
+                   ((uint64_t)options.Format << 16) | ((uint64_t)options.HDRFormat << 24) |
+                   ((uint64_t)(std::clamp(mipmaps.AlphaCutoff, 0.0f, 1.0f) * 255.0f + 0.5f) << 32);
+    
+    std::stringstream name;
+    name << filePath.stem().string() << "." << std::hex << key << ".ktx2";
+    return filePath.parent_path() / name.str();
+}
+
+/**
+ * Start the worker threads and allocate the pixel unpack buffers.
+ *
+ * The loader has its own workers because the converters it runs (e.g. `HDRConverter` and
+ * `MipmapGenerator`) split their work on the renderer thread pool, which must not be waited for
+ * from its own tasks. A few workers are enough to keep the uploads busy, and they share the CPU
+ * with the renderer pool while many textures load at startup.
+ *
+ * @param budget The maximum number of bytes uploaded each frame.
+ * @param threads The number of worker threads (all the hardware threads except the calling one
+ * if zero).
+ */
+TextureLoader::TextureLoader(const unsigned int budget, const unsigned int threads)
+    : m_Budget(budget)
+{
+    m_Workers = std::make_unique<ThreadPool>(threads);
+    m_Staging = std::make_unique<RingBuffer>(budget);
+}
+
+/**
+ * Wait for the workers and release the images not uploaded.
+ */
+TextureLoader::~TextureLoader()
+{
+    m_Workers.reset();
+    
+    for (auto& image : m_Decoded)
+    {
+        if (image.data)
+            stbi_image_free(image.data);
+    }
+}
+
+/**
+ * Generate a texture showing a fallback until the data of the image file is loaded.
+ *
+ * @param filePath Texture file path.
+ * @param flip Fip the texture vertically.
+ *
+ * @return The texture.
+ */
+std::shared_ptr<Texture2DResource> TextureLoader::Load(const std::filesystem::path& filePath, bool flip)
+{
+    TextureLoadOptions options;
+    options.Flip = flip;
+    return Load(filePath, options);
+}
+
+/**
+ * Generate a texture showing a fallback until the data of the image file is loaded.
+ *
+ * @param filePath Texture file path.
+ * @param options The options decoding the image.
+ *
+ * @return The texture.
+ */
+std::shared_ptr<Texture2DResource> TextureLoader::Load(const std::filesystem::path& filePath,
+                                                       const TextureLoadOptions& options)
+{
+    // Define the fallback texture
+    TextureSpecification spec(TextureFormat::RGBA8);
+    spec.SetTextureSize(1, 1);
+    spec.Wrap = TextureWrap::Repeat;
+    spec.Filter = TextureFilter::Linear;
+    
+    std::shared_ptr<Texture2DResource> texture(new Texture2DResource(filePath, options, g_FallbackPixel, spec));
+    Decode(texture, filePath, options);
+    return texture;
+}
+
+/**
+ * Decode again the image file of a texture, with its load options. The texture keeps its current
+ * data until the image is uploaded.
+ *
+ * @param texture The texture reloaded.
+ */
+void TextureLoader::Reload(const std::shared_ptr<Texture2DResource>& texture)
+{
+    Decode(texture, texture->m_FilePath, texture->m_Options);
+}
+
+/**
+ * Decode an image file on a worker thread, queuing it to be uploaded into a texture.
+ *
+ * @param target The texture waiting for the image.
+ * @param filePath Texture file path.
+ * @param options The options decoding the image.
+ */
+void TextureLoader::Decode(const std::weak_ptr<Texture2DResource>& target,
+                           const std::filesystem::path& filePath, const TextureLoadOptions& options)
+{
+    m_Decoding++;
+    MipmapSettings mipmaps = m_Mipmaps;
+    mipmaps.SRGB = mipmaps.SRGB || options.SRGB;
+    m_Workers->Submit([this, target, filePath, options, compress = m_Compression, quality = m_Quality,
+                       import = m_Import, generate = m_MipmapGeneration, mipmaps]()
+    {
+        DecodedImage image;
+        image.texture = target;
+        image.extension = filePath.extension().string();
+        
+        // Read the KTX2 files directly, or the one imported from the source image with the same options
+        bool imported = image.extension == ".ktx2";
+        std::filesystem::path container = imported ? filePath :
+            GetImportPath(filePath, options, compress, quality, mipmaps);
+        if (!imported && import)
+        {
+            std::error_code error;
+            auto source = std::filesystem::last_write_time(filePath, error);
+            auto converted = error ? source : std::filesystem::last_write_time(container, error);
+            imported = !error && converted >= source;
+            if (!imported)
+                imported = KTXTexture::Import(filePath, container, options, compress, quality, false, mipmaps);
+        }
+        if (imported)
+        {
+            auto levels = std::make_shared<KTXTexture>();
+            if (levels->Load(container))
+                image.container = levels;
+            
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Decoded.push_back(std::move(image));
+            m_Decoding--;
+            return;
+        }
+        
+        // The rows are flipped by the conversion kernels instead of the decoder (only for this thread)
+        stbi_set_flip_vertically_on_load_thread(false);
+        
+        bool isHDR = image.extension == ".hdr";
+        image.data = !isHDR ?
+            (void*)stbi_load(filePath.string().c_str(), &image.width, &image.height, &image.channels, 0) :
+            (void*)stbi_loadf(filePath.string().c_str(), &image.width, &image.height, &image.channels, 0);
+        
+        // Compress the 8-bit color images (or into the format requested), with all their mipmaps
+        if (image.data && !isHDR)
+        {
+            if (TextureEncoder::IsSupported(options.Format))
+                image.format = options.Format;
+            else if (compress && image.channels >= 3)
+                image.format = TextureEncoder::SelectFormat(image.channels, quality);
+        }
+        
+        // Expand the other 8-bit images into RGBA (flipping them in the same pass), so the upload is
+        // never converted by the driver, or flip the images in place
+        size_t texels = (size_t)image.width * image.height;
+        if (image.data && !isHDR && image.format == TextureFormat::None && image.channels != 4)
+        {
+            image.converted.resize(texels * 4);
+            utils::Pixels::ExpandImageToRGBA(static_cast<const uint8_t*>(image.data), image.width,
+                                             image.height, image.channels, options.Flip,
+                                             image.converted.data());
+            stbi_image_free(image.data);
+            image.data = nullptr;
+            image.format = TextureFormat::RGBA8;
+            image.channels = 4;
+        }
+        else if (image.data && options.Flip)
+        {
+            utils::Pixels::FlipVertically(image.data, (size_t)image.width * image.channels *
+                                          (isHDR ? sizeof(float) : 1), image.height);
+        }
+        
+        // Premultiply the alpha before the colors are filtered (or compressed)
+        uint8_t* pixels = image.converted.empty() ? static_cast<uint8_t*>(image.data) : image.converted.data();
+        if (pixels && options.Premultiply && !isHDR && image.channels == 4)
+            utils::Pixels::PremultiplyAlpha(pixels, texels);
+        
+        if (image.data && image.format != TextureFormat::None)
+        {
+            // The workers already run concurrently, so each image is encoded by a single thread
+            TextureEncoder encoder(quality, 1);
+            encoder.SetMipmapSettings(mipmaps);
+            image.compressed = encoder.Encode(image.data, image.width, image.height, image.channels,
+                                              image.format);
+            stbi_image_free(image.data);
+            image.data = nullptr;
+        }
+        
+        // Convert the HDR images into a packed format, with all their mipmaps, releasing the floats
+        if (image.data && isHDR && image.channels == 3 && HDRConverter::IsSupported(options.HDRFormat))
+        {
+            HDRConverter converter(options.HDRFormat, 1);
+            converter.SetMipmapSettings(mipmaps);
+            auto levels = converter.Convert(static_cast<const float*>(image.data), image.width,
+                                            image.height, image.channels);
+            stbi_image_free(image.data);
+            image.data = nullptr;
+            
+            image.format = options.HDRFormat;
+            image.converted = std::move(levels[0]);
+            for (size_t i = 1; i < levels.size(); i++)
+                image.mipmaps.push_back(std::move(levels[i]));
+        }
+        
+        // Generate the mipmaps of the uncompressed images (the packed HDR images already contain them)
+        const void* levelData = image.converted.empty() ? image.data : image.converted.data();
+        TextureSpecification spec;
+        if (levelData && generate && !HDRConverter::IsSupported(image.format))
+            utils::Texturing::UpdateSpecsTextureResource(spec, image.width, image.height, image.channels,
+                                                         image.extension);
+        if (MipmapGenerator::IsSupported(spec.Format))
+        {
+            MipmapSettings settings = mipmaps;
+            settings.Threads = settings.Threads > 0 ? settings.Threads : 1;
+            settings.Wrap = settings.Wrap || spec.Wrap == TextureWrap::Repeat;
+            image.mipmaps = MipmapGenerator(settings).Generate(levelData, image.width, image.height,
+                                                               spec.Format);
+        }
+        
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Decoded.push_back(std::move(image));
+        m_Decoding--;
+    });
+}
+
+/**
+ * Upload the decoded images into their textures, within the budget of the frame. This must be
+ * called once per frame from the rendering thread.
+ */
+void TextureLoader::Update()
+{
+    m_Stats.uploads = 0;
+    m_Stats.bytes = 0;
+    m_Stats.uploadTime = 0.0f;
+    
+    Timer timer;
+    m_Staging->BeginFrame();
+    while (true)
+    {
+        // Take the next decoded image, if it fits into the budget of the frame
+        DecodedImage image;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_Decoded.empty())
+                break;
+            
+            size_t size = m_Decoded.front().GetSize();
+            if (m_Stats.uploads > 0 && m_Stats.bytes + size > m_Budget)
+                break;
+            
+            image = std::move(m_Decoded.front());
+            m_Decoded.pop_front();
+        }
+        
+        // Skip the textures released while being decoded
+        auto texture = image.texture.lock();
+        if (texture && image.IsValid())
+        {
+            bool uploaded = image.container ? UploadContainer(*texture, *image.container) :
+                                              Upload(*texture, image);
+            if (!uploaded)
+                m_Stats.failed++;
+        }
+        else if (texture)
+        {
+            CORE_WARN("Failed to load: " + texture->GetName());
+            m_Stats.failed++;
+        }
+        if (texture)
+            texture->m_Restoring = false;
+        
+        if (image.data)
+            stbi_image_free(image.data);
+    }
+    m_Staging->EndFrame();
+    
+    if (m_Stats.uploads > 0)
+        m_Stats.uploadTime = timer.ElapsedMilliseconds();
+    m_Stats.pending = GetPendingCount();
+}
+
+/**
+ * Get the number of textures still loading.
+ *
+ * @return The number of textures decoding or waiting to be uploaded.
+ */
+unsigned int TextureLoader::GetPendingCount()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Decoding + (unsigned int)m_Decoded.size();
+}
+
+/**
+ * Redefine a texture with the size and format of a decoded image, and upload its data through
+ * the pixel unpack buffers.
+ *
+ * @param texture The texture waiting for the image.
+ * @param image The decoded image.
+ *
+ * @return `true` if the texture has been updated.
+ */
+bool TextureLoader::Upload(Texture2DResource& texture, const DecodedImage& image)
+{
+    // Define the specifications of the image
+    utils::Texturing::UpdateSpecsTextureResource(texture.m_Spec, image.width, image.height,
+                                                 image.channels, image.extension);
+    if (texture.m_Spec.Format == TextureFormat::None)
+    {
+        CORE_WARN("Data format of " + texture.GetName() + " not supported!");
+        return false;
+    }
+    if (!image.compressed.empty() || !image.converted.empty())
+        texture.m_Spec.Format = image.format;
+    
+    // Allocate the storage of the texture (before binding the unpack buffer)
+    texture.CreateTexture(nullptr);
+    
+    // Copy the data into the region of the frame, or upload it directly if it does not fit
+    const void* data = !image.converted.empty() ? image.converted.data() :
+                       !image.compressed.empty() ? image.compressed.data() : image.data;
+    unsigned int size = (unsigned int)image.GetSize();
+    std::vector<const void *> levels = { data };
+    std::vector<unsigned int> sizes = { size };
+    for (const auto& level : image.mipmaps)
+    {
+        levels.push_back(level.data());
+        sizes.push_back((unsigned int)level.size());
+        sizes[0] -= (unsigned int)level.size();
+    }
+    
+    bool staged = size + levels.size() * g_UploadAlignment <= m_Staging->GetFrameSize() - m_Staging->GetUsedSize();
+    for (unsigned int i = 0; staged && i < levels.size(); i++)
+    {
+        RingAllocation allocation = m_Staging->Push(levels[i], sizes[i], g_UploadAlignment);
+        levels[i] = reinterpret_cast<const void*>((uintptr_t)allocation.offset);
+    }
+    
+    if (staged)
+        m_Staging->Bind(StorageTarget::PixelUnpack);
+    if (levels.size() > 1)
+        texture.SetLevels(levels);
+    else
+    {
+        // Rows of three component formats are not always aligned to four bytes
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        texture.SetData(levels[0]);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+    if (staged)
+        m_Staging->Unbind(StorageTarget::PixelUnpack);
+    
+    texture.m_Loaded = true;
+    m_Stats.uploads++;
+    m_Stats.bytes += size;
+    return true;
+}
+
+/**
+ * Redefine a texture with the levels read from a KTX2 file, and upload them through the pixel
+ * unpack buffers.
+ *
+ * @param texture The texture waiting for the levels.
+ * @param container The levels read.
+ *
+ * @return `true` if the texture has been updated.
+ */
+bool TextureLoader::UploadContainer(Texture2DResource& texture, const KTXTexture& container)
+{
+    if (container.GetFaceCount() != 1)
+    {
+        CORE_WARN(texture.GetName() + " is a cube map!");
+        return false;
+    }
+    
+    // Allocate the storage of the texture (before binding the unpack buffer)
+    container.UpdateSpecification(texture.m_Spec);
+    texture.CreateTexture(nullptr);
+    
+    // Copy all the levels into the region of the frame, or upload them directly if they do not fit
+    std::vector<const void *> levels(container.GetLevelCount());
+    size_t size = container.GetDataSize();
+    bool staged = size + levels.size() * g_UploadAlignment <= m_Staging->GetFrameSize() - m_Staging->GetUsedSize();
+    for (unsigned int i = 0; i < levels.size(); i++)
+    {
+        levels[i] = container.GetLevel(i);
+        if (!staged)
+            continue;
+        
+        RingAllocation allocation = m_Staging->Push(levels[i], (unsigned int)container.GetLevelSize(i),
+                                                    g_UploadAlignment);
+        levels[i] = reinterpret_cast<const void*>((uintptr_t)allocation.offset);
+    }
+    
+    if (staged)
+        m_Staging->Bind(StorageTarget::PixelUnpack);
+    if (container.RequiresMipmaps())
+    {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        texture.SetData(levels[0]);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+    else
+        texture.SetLevels(levels);
+    if (staged)
+        m_Staging->Unbind(StorageTarget::PixelUnpack);
+    
+    texture.m_Loaded = true;
+    m_Stats.uploads++;
+    m_Stats.bytes += size;
+    return true;
+}
@@ -0,0 +1,122 @@
+#include "enginepch.h"
+#include "Common/Renderer/Texture/TextureResidency.h"
+
+#include <unordered_set>
+
+// Number of frames since their last binding during which the textures are considered in use
+static const uint64_t g_RecentFrames = 2;
+
+// Maximum number of textures reduced or restored each frame (each one redefines its storage)
+static const unsigned int g_MaxOperations = 4;
+
+// Statistics of the texture residency
+TextureResidency::ResidencyStatistics TextureResidency::s_Stats;
+
+/**
+ * Get the textures accounted by the residency manager.
+ *
+ * @return The registered textures.
+ */
+static std::unordered_set<Texture*>& GetTextures()
+{
+    // Never destroyed, since static textures may be released after the other static variables
+    static auto* textures = new std::unordered_set<Texture*>();
+    return *textures;
+}
+
+/**
+ * Account the memory of the textures, restore the levels of the textures bound again and drop
+ * the top levels of the textures bound least recently while the memory exceeds the budget. This
+ * must be called once per frame from the rendering thread.
+ *
+ * The levels are restored asynchronously (the files are decoded again by the texture loader), so
+ * their memory is accounted once uploaded.
+ */
+void TextureResidency::Update()
+{
+    s_Frame++;
+    
+    // Account the memory of each texture
+    auto& textures = GetTextures();
+    ResidencyStatistics stats;
+    std::vector<Texture*> candidates;
+    for (Texture* texture : textures)
+    {
+        size_t size = texture->GetMemorySize();
+        stats.used += size;
+        stats.categories[(size_t)texture->m_Category] += size;
+        stats.textures++;
+        
+        if (texture->CanDropLevels())
+            candidates.push_back(texture);
+    }
+    
+    // Restore the textures bound recently, as long as their levels fit in the budget
+    unsigned int operations = 0;
+    for (Texture* texture : textures)
+    {
+        unsigned int dropped = texture->GetDroppedLevels();
+        if (dropped == 0 || s_Frame - texture->m_LastBound > g_RecentFrames || operations >= g_MaxOperations)
+            continue;
+        
+        // Each level dropped is a quarter of the size of the previous one
+        size_t size = texture->GetMemorySize();
+        size_t restored = size << (2 * std::min(dropped, 16u));
+        if (s_Budget > 0 && stats.used - size + restored > s_Budget)
+            continue;
+        
+        if (texture->RestoreLevels())
+        {
+            stats.used += texture->GetMemorySize() - size;
+            stats.categories[(size_t)texture->m_Category] += texture->GetMemorySize() - size;
+            stats.restored++;
+            operations++;
+        }
+    }
+    
+    // Drop a level of the textures bound least recently (the largest first) until within budget
+    std::sort(candidates.begin(), candidates.end(), [](const Texture *a, const Texture *b)
+    {
+        if (a->m_LastBound != b->m_LastBound)
+            return a->m_LastBound < b->m_LastBound;
+        return a->GetMemorySize() > b->GetMemorySize();
+    });
+    for (Texture* texture : candidates)
+    {
+        if (s_Budget == 0 || stats.used <= s_Budget || operations >= g_MaxOperations)
+            break;
+        
+        size_t size = texture->GetMemorySize();
+        if (texture->DropLevels(1))
+        {
+            stats.used -= size - texture->GetMemorySize();
+            stats.categories[(size_t)texture->m_Category] -= size - texture->GetMemorySize();
+            stats.dropped++;
+            operations++;
+        }
+    }
+    
+    for (Texture* texture : textures)
+        stats.reduced += texture->GetDroppedLevels() > 0 ? 1 : 0;
+    s_Stats = stats;
+}
+
+/**
+ * Start accounting the memory of a texture.
+ *
+ * @param texture The texture created.
+ */
+void TextureResidency::Register(Texture *texture)
+{
+    GetTextures().insert(texture);
+}
+
+/**
+ * Stop accounting the memory of a texture.
+ *
+ * @param texture The texture deleted.
+ */
+void TextureResidency::Unregister(Texture *texture)
+{
+    GetTextures().erase(texture);
+}
@@ -0,0 +1,810 @@
+#include "enginepch.h"
+#include "Common/Renderer/Texture/TextureUtils.h"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+    #define PIXELS_X86
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define PIXELS_SIMD_SSE
+#endif
+
+// Enable an instruction set for a single kernel (selected at runtime if the CPU supports it)
+#if defined(PIXELS_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define PIXELS_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define PIXELS_TARGET(isa)
+#endif
+
+// Number of entries of the table converting linear values into sRGB
+static const int g_SRGBTableSize = 4096;
+
+// --------------------------------------------
+// Tables
+// --------------------------------------------
+
+/**
+ * Get the table converting 8-bit sRGB values into linear values.
+ *
+ * @return The table (256 entries).
+ */
+static const std::array<float, 256>& GetLinearTable()
+{
+    static const std::array<float, 256> table = []()
+    {
+        std::array<float, 256> values;
+        for (int i = 0; i < 256; i++)
+        {
+            float c = (float)i / 255.0f;
+            values[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        return values;
+    }();
+    return table;
+}
+
+/**
+ * Get the table converting linear values into 8-bit sRGB values.
+ *
+ * @return The table (indexed by the linear value scaled to the table size).
+ */
+static const std::vector<uint8_t>& GetSRGBTable()
+{
+    static const std::vector<uint8_t> table = []()
+    {
+        std::vector<uint8_t> values(g_SRGBTableSize + 1);
+        for (int i = 0; i <= g_SRGBTableSize; i++)
+        {
+            float c = (float)i / (float)g_SRGBTableSize;
+            float s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+            values[i] = (uint8_t)std::lround(std::clamp(s, 0.0f, 1.0f) * 255.0f);
+        }
+        return values;
+    }();
+    return table;
+}
+
+// --------------------------------------------
+// Scalar kernels
+// --------------------------------------------
+
+/**
+ * Expand texels into RGBA (gray levels are replicated into the color channels).
+ *
+ * @param source The texels.
+ * @param channels The number of channels of the texels.
+ * @param destination The RGBA texels.
+ * @param texels The number of texels.
+ */
+static void ExpandToRGBAScalar(const uint8_t *source, const int channels, uint8_t *destination,
+                               const size_t texels)
+{
+    for (size_t i = 0; i < texels; i++)
+    {
+        const uint8_t* texel = source + i * channels;
+        uint8_t* output = destination + i * 4;
+        switch (channels)
+        {
+            case 1:
+                output[0] = output[1] = output[2] = texel[0];
+                output[3] = 255;
+                break;
+            case 2:
+                output[0] = output[1] = output[2] = texel[0];
+                output[3] = texel[1];
+                break;
+            case 3:
+                output[0] = texel[0];
+                output[1] = texel[1];
+                output[2] = texel[2];
+                output[3] = 255;
+                break;
+            default:
+                std::memcpy(output, texel, 4);
+                break;
+        }
+    }
+}
+
+/**
+ * Reorder the channels of RGBA texels.
+ *
+ * @param data The RGBA texels.
+ * @param texels The number of texels.
+ * @param order The source channel of each channel.
+ */
+static void SwizzleScalar(uint8_t *data, const size_t texels, const uint8_t *order)
+{
+    for (size_t i = 0; i < texels; i++)
+    {
+        uint8_t* texel = data + i * 4;
+        uint8_t copy[4] = { texel[0], texel[1], texel[2], texel[3] };
+        for (int c = 0; c < 4; c++)
+            texel[c] = copy[order[c]];
+    }
+}
+
+/**
+ * Convert 8-bit sRGB values into linear values.
+ *
+ * @param source The sRGB values.
+ * @param destination The linear values.
+ * @param count The number of values.
+ */
+static void SRGBToLinearScalar(const uint8_t *source, float *destination, const size_t count)
+{
+    const auto& table = GetLinearTable();
+    for (size_t i = 0; i < count; i++)
+        destination[i] = table[source[i]];
+}
+
+/**
+ * Convert linear values into 8-bit sRGB values (clamped to [0, 1]).
+ *
+ * @param source The linear values.
+ * @param destination The sRGB values.
+ * @param count The number of values.
+ */
+static void LinearToSRGBScalar(const float *source, uint8_t *destination, const size_t count)
+{
+    const auto& table = GetSRGBTable();
+    for (size_t i = 0; i < count; i++)
+    {
+        float value = source[i] > 0.0f ? std::min(source[i], 1.0f) : 0.0f;
+        destination[i] = table[(int)(value * g_SRGBTableSize + 0.5f)];
+    }
+}
+
+/**
+ * Multiply the color channels of RGBA texels by their alpha.
+ *
+ * @param data The RGBA texels.
+ * @param texels The number of texels.
+ */
+static void PremultiplyAlphaScalar(uint8_t *data, const size_t texels)
+{
+    for (size_t i = 0; i < texels; i++)
+    {
+        uint8_t* texel = data + i * 4;
+        for (int c = 0; c < 3; c++)
+        {
+            // Exact rounding of the division by 255
+            unsigned int value = texel[c] * texel[3] + 128;
+            texel[c] = (uint8_t)((value + (value >> 8)) >> 8);
+        }
+    }
+}
+
+/**
+ * Convert floats into half-floats, rounding to the nearest even value (values beyond the range
+ * of the half-floats become infinite).
+ *
+ * @param source The floats.
+ * @param destination The half-floats.
+ * @param count The number of values.
+ */
+static void FloatToHalfScalar(const float *source, uint16_t *destination, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, source + i, sizeof(float));
+        uint32_t sign = bits & 0x80000000u;
+        bits ^= sign;
+        
+        uint32_t half = 0;
+        if (bits >= (143u << 23))
+        {
+            // Infinite (or overflowing) and NaN values
+            half = bits > (255u << 23) ? 0x7E00 : 0x7C00;
+        }
+        else if (bits < (113u << 23))
+        {
+            // Values below the smallest normal half-float are rounded by the addition
+            float value, rounded;
+            std::memcpy(&value, &bits, sizeof(float));
+            rounded = value + 0.5f;
+            std::memcpy(&bits, &rounded, sizeof(float));
+            half = bits - (126u << 23);
+        }
+        else
+        {
+            // Rebias the exponent and round the mantissa
+            half = (bits - (112u << 23) + 0xFFF + ((bits >> 13) & 1)) >> 13;
+        }
+        destination[i] = (uint16_t)(half | (sign >> 16));
+    }
+}
+
+/**
+ * Convert half-floats into floats.
+ *
+ * @param source The half-floats.
+ * @param destination The floats.
+ * @param count The number of values.
+ */
+static void HalfToFloatScalar(const uint16_t *source, float *destination, const size_t count)
+{
+    // Scale moving the exponent bias of the half-floats to the one of the floats (2^112)
+    const uint32_t magicBits = (254u - 15u) << 23;
+    float magic;
+    std::memcpy(&magic, &magicBits, sizeof(float));
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t bits = (uint32_t)(source[i] & 0x7FFF) << 13;
+        float value;
+        std::memcpy(&value, &bits, sizeof(float));
+        value *= magic;
+        
+        std::memcpy(&bits, &value, sizeof(float));
+        if ((source[i] & 0x7FFF) > 0x7BFF)
+            bits |= 255u << 23;
+        bits |= (uint32_t)(source[i] & 0x8000) << 16;
+        std::memcpy(destination + i, &bits, sizeof(float));
+    }
+}
+
+// --------------------------------------------
+// SSE2 kernels
+// --------------------------------------------
+
+#ifdef PIXELS_SIMD_SSE
+/**
+ * Convert linear values into 8-bit sRGB values (clamped to [0, 1]).
+ *
+ * @param source The linear values.
+ * @param destination The sRGB values.
+ * @param count The number of values.
+ */
+static void LinearToSRGBSSE2(const float *source, uint8_t *destination, const size_t count)
+{
+    const auto& table = GetSRGBTable();
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps((float)g_SRGBTableSize), half = _mm_set1_ps(0.5f);
+    
+    size_t i = 0;
+    alignas(16) int32_t indices[4];
+    for (; i + 4 <= count; i += 4)
+    {
+        // The maximum converts NaN values to zero
+        __m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i), zero), one);
+        _mm_store_si128(reinterpret_cast<__m128i*>(indices),
+                        _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, scale), half)));
+        for (int j = 0; j < 4; j++)
+            destination[i + j] = table[indices[j]];
+    }
+    LinearToSRGBScalar(source + i, destination + i, count - i);
+}
+
+/**
+ * Multiply the color channels of RGBA texels by their alpha.
+ *
+ * @param data The RGBA texels.
+ * @param texels The number of texels.
+ */
+static void PremultiplyAlphaSSE2(uint8_t *data, const size_t texels)
+{
+    const __m128i zero = _mm_setzero_si128(), round = _mm_set1_epi16(128);
+    
+    // The alpha channel is multiplied by 255 (unchanged)
+    const __m128i colorMask = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+    const __m128i alphaScale = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+    
+    auto premultiply = [&](const __m128i texels16)
+    {
+        __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(texels16, 0xFF), 0xFF);
+        __m128i factor = _mm_or_si128(_mm_and_si128(alpha, colorMask), alphaScale);
+        __m128i value = _mm_add_epi16(_mm_mullo_epi16(texels16, factor), round);
+        return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+    };
+    
+    size_t i = 0;
+    for (; i + 4 <= texels; i += 4)
+    {
+        __m128i* pointer = reinterpret_cast<__m128i*>(data + i * 4);
+        __m128i value = _mm_loadu_si128(pointer);
+        __m128i low = premultiply(_mm_unpacklo_epi8(value, zero));
+        __m128i high = premultiply(_mm_unpackhi_epi8(value, zero));
+        _mm_storeu_si128(pointer, _mm_packus_epi16(low, high));
+    }
+    PremultiplyAlphaScalar(data + i * 4, texels - i);
+}
+
+/**
+ * Convert floats into half-floats, rounding to the nearest even value.
+ *
+ * @param source The floats.
+ * @param destination The half-floats.
+ * @param count The number of values.
+ */
+static void FloatToHalfSSE2(const float *source, uint16_t *destination, const size_t count)
+{
+    const __m128i infinity = _mm_set1_epi32(255 << 23), overflow = _mm_set1_epi32(143 << 23);
+    const __m128i normal = _mm_set1_epi32(113 << 23), magic = _mm_set1_epi32(126 << 23);
+    const __m128i bias = _mm_set1_epi32(0xFFF - (112 << 23));
+    
+    auto convert = [&](const __m128 value)
+    {
+        __m128i bits = _mm_castps_si128(value);
+        __m128i sign = _mm_and_si128(bits, _mm_set1_epi32((int)0x80000000));
+        bits = _mm_xor_si128(bits, sign);
+        
+        // Infinite (or overflowing) and NaN values
+        __m128i special = _mm_or_si128(_mm_set1_epi32(0x7C00),
+                                       _mm_and_si128(_mm_cmpgt_epi32(bits, infinity), _mm_set1_epi32(0x200)));
+        // Values below the smallest normal half-float are rounded by the addition
+        __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(bits),
+                                                                      _mm_castsi128_ps(magic))), magic);
+        // Rebias the exponent and round the mantissa
+        __m128i odd = _mm_and_si128(_mm_srli_epi32(bits, 13), _mm_set1_epi32(1));
+        __m128i regular = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(bits, bias), odd), 13);
+        
+        __m128i isSubnormal = _mm_cmplt_epi32(bits, normal);
+        __m128i isFinite = _mm_cmplt_epi32(bits, overflow);
+        __m128i half = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, regular));
+        half = _mm_or_si128(_mm_and_si128(isFinite, half), _mm_andnot_si128(isFinite, special));
+        half = _mm_or_si128(half, _mm_srli_epi32(sign, 16));
+        
+        // Sign extend the half-floats so the saturating pack keeps their bits
+        return _mm_srai_epi32(_mm_slli_epi32(half, 16), 16);
+    };
+    
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i low = convert(_mm_loadu_ps(source + i));
+        __m128i high = convert(_mm_loadu_ps(source + i + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packs_epi32(low, high));
+    }
+    FloatToHalfScalar(source + i, destination + i, count - i);
+}
+
+/**
+ * Convert half-floats into floats.
+ *
+ * @param source The half-floats.
+ * @param destination The floats.
+ * @param count The number of values.
+ */
+static void HalfToFloatSSE2(const uint16_t *source, float *destination, const size_t count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+    const __m128 infinity = _mm_castsi128_ps(_mm_set1_epi32(255 << 23));
+    
+    auto convert = [&](const __m128i half)
+    {
+        __m128i magnitude = _mm_and_si128(half, _mm_set1_epi32(0x7FFF));
+        __m128i sign = _mm_slli_epi32(_mm_xor_si128(half, magnitude), 16);
+        __m128 value = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(magnitude, 13)), magic);
+        
+        // Infinite and NaN values keep the largest exponent
+        __m128 special = _mm_and_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7BFF))),
+                                    infinity);
+        return _mm_or_ps(value, _mm_or_ps(_mm_castsi128_ps(sign), special));
+    };
+    
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        _mm_storeu_ps(destination + i, convert(_mm_unpacklo_epi16(halves, zero)));
+        _mm_storeu_ps(destination + i + 4, convert(_mm_unpackhi_epi16(halves, zero)));
+    }
+    HalfToFloatScalar(source + i, destination + i, count - i);
+}
+#endif
+
+// --------------------------------------------
+// SSSE3, AVX2 and F16C kernels
+// --------------------------------------------
+
+#ifdef PIXELS_X86
+/**
+ * Expand texels into RGBA, shuffling four texels at a time.
+ *
+ * @param source The texels.
+ * @param channels The number of channels of the texels.
+ * @param destination The RGBA texels.
+ * @param texels The number of texels.
+ */
+PIXELS_TARGET("ssse3")
+static void ExpandToRGBASSSE3(const uint8_t *source, const int channels, uint8_t *destination,
+                              const size_t texels)
+{
+    if (channels == 4)
+    {
+        std::memcpy(destination, source, texels * 4);
+        return;
+    }
+    
+    // Source byte of each destination byte (negative indices clear the byte, set by the alpha)
+    static const int8_t g_Shuffles[3][16] = {
+        { 0, 0, 0, -1, 1, 1, 1, -1, 2, 2, 2, -1, 3, 3, 3, -1 },
+        { 0, 0, 0, 1, 2, 2, 2, 3, 4, 4, 4, 5, 6, 6, 6, 7 },
+        { 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1 }
+    };
+    __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g_Shuffles[channels - 1]));
+    __m128i alpha = channels == 2 ? _mm_setzero_si128() : _mm_set1_epi32((int)0xFF000000);
+    
+    // Each iteration reads 16 bytes, so the last texels are expanded by the scalar kernel
+    size_t i = 0;
+    for (; i * channels + 16 <= texels * channels; i += 4)
+    {
+        __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * channels));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4),
+                         _mm_or_si128(_mm_shuffle_epi8(value, shuffle), alpha));
+    }
+    ExpandToRGBAScalar(source + i * channels, channels, destination + i * 4, texels - i);
+}
+
+/**
+ * Reorder the channels of RGBA texels, shuffling four texels at a time.
+ *
+ * @param data The RGBA texels.
+ * @param texels The number of texels.
+ * @param order The source channel of each channel.
+ */
+PIXELS_TARGET("ssse3")
+static void SwizzleSSSE3(uint8_t *data, const size_t texels, const uint8_t *order)
+{
+    alignas(16) int8_t bytes[16];
+    for (int t = 0; t < 4; t++)
+    {
+        for (int c = 0; c < 4; c++)
+            bytes[t * 4 + c] = (int8_t)(t * 4 + order[c]);
+    }
+    __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i*>(bytes));
+    
+    size_t i = 0;
+    for (; i + 4 <= texels; i += 4)
+    {
+        __m128i* pointer = reinterpret_cast<__m128i*>(data + i * 4);
+        _mm_storeu_si128(pointer, _mm_shuffle_epi8(_mm_loadu_si128(pointer), shuffle));
+    }
+    SwizzleScalar(data + i * 4, texels - i, order);
+}
+
+/**
+ * Convert 8-bit sRGB values into linear values, gathering eight values at a time from the table.
+ *
+ * @param source The sRGB values.
+ * @param destination The linear values.
+ * @param count The number of values.
+ */
+PIXELS_TARGET("avx2")
+static void SRGBToLinearAVX2(const uint8_t *source, float *destination, const size_t count)
+{
+    const float* table = GetLinearTable().data();
+    
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + i)));
+        _mm256_storeu_ps(destination + i, _mm256_i32gather_ps(table, indices, sizeof(float)));
+    }
+    SRGBToLinearScalar(source + i, destination + i, count - i);
+}
+
+/**
+ * Convert floats into half-floats with the F16C instructions, rounding to the nearest even value.
+ *
+ * @param source The floats.
+ * @param destination The half-floats.
+ * @param count The number of values.
+ */
+PIXELS_TARGET("avx,f16c")
+static void FloatToHalfF16C(const float *source, uint16_t *destination, const size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i halves = _mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), halves);
+    }
+    FloatToHalfScalar(source + i, destination + i, count - i);
+}
+
+/**
+ * Convert half-floats into floats with the F16C instructions.
+ *
+ * @param source The half-floats.
+ * @param destination The floats.
+ * @param count The number of values.
+ */
+PIXELS_TARGET("avx,f16c")
+static void HalfToFloatF16C(const uint16_t *source, float *destination, const size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        _mm256_storeu_ps(destination + i, _mm256_cvtph_ps(halves));
+    }
+    HalfToFloatScalar(source + i, destination + i, count - i);
+}
+
+/**
+ * Read the information of the CPU.
+ *
+ * @param leaf The information requested.
+ * @param registers The values of the EAX, EBX, ECX and EDX registers.
+ */
+static void ReadCPUID(const unsigned int leaf, unsigned int registers[4])
+{
+#if defined(_MSC_VER)
+    int values[4];
+    __cpuidex(values, (int)leaf, 0);
+    for (int i = 0; i < 4; i++)
+        registers[i] = (unsigned int)values[i];
+#else
+    __cpuid_count(leaf, 0, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+/**
+ * Read the register enabled by the operating system (XCR0), telling which registers it saves.
+ *
+ * @return The value of the register.
+ */
+static uint64_t ReadXCR0()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int low, high;
+    __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return ((uint64_t)high << 32) | low;
+#endif
+}
+#endif
+
+// --------------------------------------------
+// Dispatch
+// --------------------------------------------
+
+/**
+ * Represents the kernels selected for the CPU.
+ */
+struct PixelKernels
+{
+    void (*expand)(const uint8_t*, const int, uint8_t*, const size_t) = ExpandToRGBAScalar;
+    void (*swizzle)(uint8_t*, const size_t, const uint8_t*) = SwizzleScalar;
+    void (*srgbToLinear)(const uint8_t*, float*, const size_t) = SRGBToLinearScalar;
+    void (*linearToSRGB)(const float*, uint8_t*, const size_t) = LinearToSRGBScalar;
+    void (*premultiply)(uint8_t*, const size_t) = PremultiplyAlphaScalar;
+    void (*floatToHalf)(const float*, uint16_t*, const size_t) = FloatToHalfScalar;
+    void (*halfToFloat)(const uint16_t*, float*, const size_t) = HalfToFloatScalar;
+};
+
+/**
+ * Select the fastest kernels supported by the CPU (once).
+ *
+ * @return The kernels.
+ */
+static const PixelKernels& GetKernels()
+{
+    static const PixelKernels kernels = []()
+    {
+        PixelKernels selected;
+        const auto& features = utils::Pixels::GetCPUFeatures();
+#ifdef PIXELS_SIMD_SSE
+        if (features.sse2)
+        {
+            selected.linearToSRGB = LinearToSRGBSSE2;
+            selected.premultiply = PremultiplyAlphaSSE2;
+            selected.floatToHalf = FloatToHalfSSE2;
+            selected.halfToFloat = HalfToFloatSSE2;
+        }
+#endif
+#ifdef PIXELS_X86
+        if (features.ssse3)
+        {
+            selected.expand = ExpandToRGBASSSE3;
+            selected.swizzle = SwizzleSSSE3;
+        }
+        if (features.avx2)
+            selected.srgbToLinear = SRGBToLinearAVX2;
+        if (features.f16c)
+        {
+            selected.floatToHalf = FloatToHalfF16C;
+            selected.halfToFloat = HalfToFloatF16C;
+        }
+#endif
+        (void)features;
+        return selected;
+    }();
+    return kernels;
+}
+
+namespace utils { namespace Pixels
+{
+
+/**
+ * Get the instruction sets supported by the CPU, detected on the first call.
+ *
+ * @return The CPU features (none on other architectures than x86).
+ */
+const CPUFeatures& GetCPUFeatures()
+{
+    static const CPUFeatures features = []()
+    {
+        CPUFeatures detected;
+#ifdef PIXELS_X86
+        unsigned int registers[4] = {};
+        ReadCPUID(0, registers);
+        unsigned int leaves = registers[0];
+        
+        ReadCPUID(1, registers);
+        detected.sse2 = (registers[3] >> 26) & 1;
+        detected.ssse3 = (registers[2] >> 9) & 1;
+        
+        // The 256-bit registers must also be saved by the operating system
+        bool avx = ((registers[2] >> 27) & 1) && ((registers[2] >> 28) & 1) && (ReadXCR0() & 0x6) == 0x6;
+        detected.f16c = avx && ((registers[2] >> 29) & 1);
+        if (leaves >= 7)
+        {
+            ReadCPUID(7, registers);
+            detected.avx2 = avx && ((registers[1] >> 5) & 1);
+        }
+#endif
+        return detected;
+    }();
+    return features;
+}
+
+/**
+ * Expand 8-bit texels into RGBA, the layout uploaded without conversion by the drivers. Gray
+ * levels are replicated into the color channels, and the alpha is opaque if missing.
+ *
+ * @param source The texels.
+ * @param channels The number of channels of the texels (1 to 4).
+ * @param destination The RGBA texels (must not overlap the source).
+ * @param texels The number of texels.
+ */
+void ExpandToRGBA(const uint8_t *source, const int channels, uint8_t *destination, const size_t texels)
+{
+    CORE_ASSERT(channels >= 1 && channels <= 4, "Invalid number of channels!");
+    GetKernels().expand(source, channels, destination, texels);
+}
+
+/**
+ * Expand an 8-bit image into RGBA, flipping it vertically in the same pass if specified.
+ *
+ * @param source The image (tightly packed rows).
+ * @param width The width of the image.
+ * @param height The height of the image.
+ * @param channels The number of channels of the image (1 to 4).
+ * @param flip Flip the rows of the image.
+ * @param destination The RGBA image (must not overlap the source).
+ */
+void ExpandImageToRGBA(const uint8_t *source, const int width, const int height, const int channels,
+                       const bool flip, uint8_t *destination)
+{
+    CORE_ASSERT(channels >= 1 && channels <= 4, "Invalid number of channels!");
+    const auto& kernels = GetKernels();
+    for (int y = 0; y < height; y++)
+    {
+        int row = flip ? height - 1 - y : y;
+        kernels.expand(source + (size_t)y * width * channels, channels,
+                       destination + (size_t)row * width * 4, (size_t)width);
+    }
+}
+
+/**
+ * Flip an image vertically in place, swapping its rows.
+ *
+ * @param data The image.
+ * @param rowSize The size of a row (in bytes).
+ * @param rows The number of rows.
+ */
+void FlipVertically(void *data, const size_t rowSize, const unsigned int rows)
+{
+    uint8_t* pixels = static_cast<uint8_t*>(data);
+    for (unsigned int y = 0; y < rows / 2; y++)
+    {
+        uint8_t* top = pixels + y * rowSize;
+        uint8_t* bottom = pixels + (rows - 1 - y) * rowSize;
+        
+        size_t x = 0;
+#ifdef PIXELS_SIMD_SSE
+        for (; x + 16 <= rowSize; x += 16)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top + x));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + x));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(top + x), b);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(bottom + x), a);
+        }
+#endif
+        for (; x < rowSize; x++)
+            std::swap(top[x], bottom[x]);
+    }
+}
+
+/**
+ * Reorder the channels of RGBA texels in place (e.g. { 2, 1, 0, 3 } converts BGRA into RGBA).
+ *
+ * @param data The RGBA texels.
+ * @param texels The number of texels.
+ * @param order The source channel (0 to 3) of each channel.
+ */
+void Swizzle(uint8_t *data, const size_t texels, const std::array<uint8_t, 4>& order)
+{
+    CORE_ASSERT(order[0] < 4 && order[1] < 4 && order[2] < 4 && order[3] < 4, "Invalid channel order!");
+    GetKernels().swizzle(data, texels, order.data());
+}
+
+/**
+ * Convert 8-bit sRGB values into linear values (the alpha channels must be converted linearly).
+ *
+ * @param source The sRGB values.
+ * @param destination The linear values.
+ * @param count The number of values.
+ */
+void SRGBToLinear(const uint8_t *source, float *destination, const size_t count)
+{
+    GetKernels().srgbToLinear(source, destination, count);
+}
+
+/**
+ * Convert linear values into 8-bit sRGB values, clamping them to [0, 1].
+ *
+ * @param source The linear values.
+ * @param destination The sRGB values.
+ * @param count The number of values.
+ */
+void LinearToSRGB(const float *source, uint8_t *destination, const size_t count)
+{
+    GetKernels().linearToSRGB(source, destination, count);
+}
+
+/**
+ * Multiply the color channels of RGBA texels by their alpha in place, so they are blended and
+ * filtered without dark fringes around the transparent texels.
+ *
+ * @param data The RGBA texels.
+ * @param texels The number of texels.
+ */
+void PremultiplyAlpha(uint8_t *data, const size_t texels)
+{
+    GetKernels().premultiply(data, texels);
+}
+
+/**
+ * Convert floats into half-floats, rounding to the nearest even value (values beyond the range
+ * of the half-floats become infinite).
+ *
+ * @param source The floats.
+ * @param destination The half-floats.
+ * @param count The number of values.
+ */
+void FloatToHalf(const float *source, uint16_t *destination, const size_t count)
+{
+    GetKernels().floatToHalf(source, destination, count);
+}
+
+/**
+ * Convert half-floats into floats.
+ *
+ * @param source The half-floats.
+ * @param destination The floats.
+ * @param count The number of values.
+ */
+void HalfToFloat(const uint16_t *source, float *destination, const size_t count)
+{
+    GetKernels().halfToFloat(source, destination, count);
+}
+
+} // namespace Pixels
+} // namespace utils
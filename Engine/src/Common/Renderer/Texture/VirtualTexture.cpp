@@ -0,0 +1,685 @@
+#include "enginepch.h"
+#include "Common/Renderer/Texture/VirtualTexture.h"
+
+#include "Common/Renderer/Renderer.h"
+#include "Common/Renderer/Material/Material.h"
+
+#include <stb_image.h>
+
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+// Identifier at the beginning of every tiled file
+static const uint8_t g_Identifier[8] = { 'P', 'X', 'V', 'T', 'E', 'X', '0', '1' };
+
+// Channels of the texels stored (RGBA8)
+static const unsigned int g_Channels = 4;
+
+// Maximum number of tiles on each side of the base level (limited by the keys of the tiles)
+static const unsigned int g_MaxTiles = 4096;
+
+// Maximum number of tiles uploaded into the cache each frame
+static const unsigned int g_MaxUploads = 8;
+
+// Maximum number of tiles requested to the workers at the same time
+static const unsigned int g_MaxRequests = 32;
+
+// Number of frames since their last use during which the tiles are never evicted
+static const uint64_t g_RecentFrames = 4;
+
+// Last use of the tiles never evicted (the coarsest level)
+static const uint64_t g_Pinned = UINT64_MAX;
+
+/**
+ * Represents the header of a tiled file.
+ */
+struct TiledHeader
+{
+    uint8_t identifier[8];
+    uint32_t width;
+    uint32_t height;
+    uint32_t tileSize;
+    uint32_t border;
+    uint32_t tilesX;
+    uint32_t tilesY;
+    uint32_t levels;
+    uint32_t flipped;
+};
+static_assert(sizeof(TiledHeader) == 40, "The tiled header must not be padded!");
+
+/**
+ * Get the smallest power of two greater or equal to a value.
+ *
+ * @param value The value.
+ *
+ * @return The power of two.
+ */
+static unsigned int NextPowerOfTwo(const unsigned int value)
+{
+    unsigned int power = 1;
+    while (power < value)
+        power <<= 1;
+    return power;
+}
+
+/**
+ * Get the size of a tile stored, including its border.
+ *
+ * @param tileSize The size of the tile (in texels, without the border).
+ * @param border The size of the border (in texels).
+ *
+ * @return The size of the tile (in bytes).
+ */
+static size_t GetTileBytes(const unsigned int tileSize, const unsigned int border)
+{
+    size_t padded = tileSize + 2 * border;
+    return padded * padded * g_Channels;
+}
+
+/**
+ * Pack the location of a tile in the cache into an entry of the page table (RGBA8 texel).
+ *
+ * @param slot The position of the slot in the cache (in slots).
+ * @param level The level of the tile.
+ *
+ * @return The entry, with the slot in red and green, the level in blue and a valid alpha.
+ */
+static uint32_t PackEntry(const glm::uvec2& slot, const unsigned int level)
+{
+    return slot.x | (slot.y << 8) | (level << 16) | (255u << 24);
+}
+
+// --------------------------------------------
+// Virtual texture
+// --------------------------------------------
+
+/**
+ * Read a tiled file and allocate the cache of its tiles, keeping the tile of the coarsest level
+ * resident.
+ *
+ * @param filePath The tiled file path (see `Import()`).
+ * @param budget The video memory used by the cache (in bytes).
+ * @param feedbackWidth The size of the feedback framebuffer (in pixels).
+ * @param feedbackHeight The size of the feedback framebuffer (in pixels).
+ * @param threads The number of worker threads reading the tiles.
+ */
+VirtualTexture::VirtualTexture(const std::filesystem::path& filePath, const size_t budget,
+                               const unsigned int feedbackWidth, const unsigned int feedbackHeight,
+                               const unsigned int threads)
+{
+    std::string name = filePath.filename().string();
+    
+    // Verify the header
+    TiledHeader header;
+    m_File = std::make_unique<MappedFile>(filePath);
+    if (!m_File->IsOpen() || m_File->GetSize() < sizeof(header))
+    {
+        CORE_WARN("Failed to read: " + name);
+        return;
+    }
+    std::memcpy(&header, m_File->GetData(), sizeof(header));
+    if (std::memcmp(header.identifier, g_Identifier, sizeof(g_Identifier)) != 0 ||
+        header.tileSize == 0 || header.levels == 0 || header.tilesX > g_MaxTiles ||
+        header.tilesY > g_MaxTiles)
+    {
+        CORE_WARN(name + " is not a tiled texture file!");
+        return;
+    }
+    
+    m_Width = header.width;
+    m_Height = header.height;
+    m_TileSize = header.tileSize;
+    m_Border = header.border;
+    m_TilesX = header.tilesX;
+    m_TilesY = header.tilesY;
+    m_Levels = header.levels;
+    
+    // Verify that every tile is stored
+    size_t tiles = GetTileIndex(GetTileKey(m_Levels, 0, 0));
+    size_t tileBytes = GetTileBytes(m_TileSize, m_Border);
+    if (m_File->GetSize() < sizeof(header) + tiles * tileBytes)
+    {
+        CORE_WARN(name + " is truncated!");
+        return;
+    }
+    
+    // Define the cache within the budget (never larger than the whole texture)
+    unsigned int padded = m_TileSize + 2 * m_Border;
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    
+    m_CacheSlots = (unsigned int)std::sqrt((double)budget / (double)tileBytes);
+    m_CacheSlots = std::min(m_CacheSlots, (unsigned int)std::ceil(std::sqrt((double)tiles)));
+    m_CacheSlots = std::min(m_CacheSlots, std::min((unsigned int)maxSize / padded, 256u));
+    m_CacheSlots = std::max(m_CacheSlots, 1u);
+    m_Slots.resize(m_CacheSlots * m_CacheSlots);
+    
+    TextureSpecification cache(TextureFormat::RGBA8);
+    cache.SetTextureSize(m_CacheSlots * padded, m_CacheSlots * padded);
+    cache.Wrap = TextureWrap::ClampToEdge;
+    cache.Filter = TextureFilter::Linear;
+    m_Cache = std::make_shared<Texture2D>(nullptr, cache);
+    m_Cache->SetCategory(TextureCategory::Virtual);
+    
+    // Define the page table, with one texel for each tile
+    TextureSpecification table(TextureFormat::RGBA8);
+    table.SetTextureSize(m_TilesX, m_TilesY);
+    table.Wrap = TextureWrap::ClampToEdge;
+    table.Filter = TextureFilter::Nearest;
+    table.MipMaps = true;
+    m_PageTable = std::make_shared<Texture2D>(nullptr, table);
+    m_PageTable->SetCategory(TextureCategory::Virtual);
+    
+    m_Entries.resize(m_Levels);
+    m_DirtyRows.resize(m_Levels, { UINT_MAX, 0 });
+    for (unsigned int level = 0; level < m_Levels; level++)
+        m_Entries[level].resize((size_t)std::max(m_TilesX >> level, 1u) * std::max(m_TilesY >> level, 1u), 0);
+    
+    // Define the feedback, read back into a ring of pixel pack buffers
+    FrameBufferSpecification feedback;
+    feedback.SetFrameBufferSize(feedbackWidth, feedbackHeight);
+    feedback.AttachmentsSpec = {
+        TextureSpecification(TextureFormat::RGBA8),
+        TextureSpecification(TextureFormat::DEPTH24)
+    };
+    m_Feedback = std::make_shared<FrameBuffer>(feedback);
+    for (auto& readback : m_Readbacks)
+        readback.buffer = std::make_unique<StorageBuffer>(feedbackWidth * feedbackHeight * g_Channels);
+    
+    // Keep the tile of the coarsest level resident, so the texture can always be sampled
+    LoadedTile root;
+    root.tile = GetTileKey(m_Levels - 1, 0, 0);
+    root.data = ReadTile(root.tile);
+    Upload(root);
+    m_Slots[m_Resident[root.tile]].lastUsed = g_Pinned;
+    UploadPageTable();
+    
+    m_Workers = std::make_unique<ThreadPool>(threads);
+    m_Stats.capacity = (unsigned int)m_Slots.size();
+}
+
+/**
+ * Wait for the workers and release the pending read backs.
+ */
+VirtualTexture::~VirtualTexture()
+{
+    m_Workers.reset();
+    
+    for (auto& readback : m_Readbacks)
+    {
+        if (readback.fence)
+            glDeleteSync(readback.fence);
+    }
+}
+
+/**
+ * Convert a source image (e.g. PNG or JPEG) into a tiled file, with all its levels. The image is
+ * placed into a power of two number of tiles on each side (the texels outside of the image repeat
+ * its edges), and the levels are stored until a single tile covers the whole image.
+ *
+ * The whole image is decoded, so the conversion must be done offline (or once) on a machine with
+ * enough memory, while the tiled file is then streamed within a fixed budget.
+ *
+ * @param source The image file path.
+ * @param destination The tiled file path.
+ * @param tileSize The size of the tiles (in texels, without their border).
+ * @param border The size of the border around the tiles (in texels).
+ * @param flip Flip the image vertically (as done when loading the image directly).
+ * @param mipmaps The settings filtering the levels.
+ *
+ * @return `true` if the image has been converted.
+ */
+bool VirtualTexture::Import(const std::filesystem::path& source, const std::filesystem::path& destination,
+                            const unsigned int tileSize, const unsigned int border, const bool flip,
+                            const MipmapSettings& mipmaps)
+{
+    CORE_ASSERT(tileSize > 0, "Invalid size of the tiles!");
+    
+    // Decode the image into RGBA (flipped in place with the pixel kernels)
+    stbi_set_flip_vertically_on_load_thread(false);
+    
+    int width, height, channels;
+    uint8_t* data = stbi_load(source.string().c_str(), &width, &height, &channels, g_Channels);
+    if (!data)
+    {
+        CORE_WARN("Failed to load: " + source.filename().string());
+        return false;
+    }
+    if (flip)
+        utils::Pixels::FlipVertically(data, (size_t)width * g_Channels, height);
+    
+    // Define the tiles covering the image
+    TiledHeader header;
+    std::memcpy(header.identifier, g_Identifier, sizeof(g_Identifier));
+    header.width = (uint32_t)width;
+    header.height = (uint32_t)height;
+    header.tileSize = tileSize;
+    header.border = border;
+    header.tilesX = NextPowerOfTwo((width + tileSize - 1) / tileSize);
+    header.tilesY = NextPowerOfTwo((height + tileSize - 1) / tileSize);
+    header.flipped = flip ? 1 : 0;
+    
+    header.levels = 1;
+    for (unsigned int tiles = std::max(header.tilesX, header.tilesY); tiles > 1; tiles >>= 1)
+        header.levels++;
+    
+    if (header.tilesX > g_MaxTiles || header.tilesY > g_MaxTiles)
+    {
+        CORE_WARN(source.filename().string() + " is too large for tiles of " +
+                  std::to_string(tileSize) + " texels!");
+        stbi_image_free(data);
+        return false;
+    }
+    
+    // Build the mip chain (the levels smaller than a tile are not stored)
+    std::vector<std::vector<uint8_t>> chain = MipmapGenerator(mipmaps).Generate(data, width, height,
+                                                                                TextureFormat::RGBA8);
+    
+    // Write into a temporary file first, so the readers never see a partial file
+    std::filesystem::path temporary = utils::Files::TemporaryPath(destination);
+    bool written = false;
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (file)
+        {
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            
+            unsigned int padded = tileSize + 2 * border;
+            std::vector<uint8_t> tile(GetTileBytes(tileSize, border));
+            for (unsigned int level = 0; level < header.levels; level++)
+            {
+                const uint8_t* image = level == 0 ? data : chain[level - 1].data();
+                int levelWidth = std::max(width >> level, 1);
+                int levelHeight = std::max(height >> level, 1);
+                
+                // Copy the texels of each tile with its border (clamped to the edges of the level)
+                unsigned int tilesX = std::max(header.tilesX >> level, 1u);
+                unsigned int tilesY = std::max(header.tilesY >> level, 1u);
+                for (unsigned int ty = 0; ty < tilesY; ty++)
+                {
+                    for (unsigned int tx = 0; tx < tilesX; tx++)
+                    {
+                        for (unsigned int y = 0; y < padded; y++)
+                        {
+                            int sy = std::clamp((int)(ty * tileSize + y) - (int)border, 0, levelHeight - 1);
+                            for (unsigned int x = 0; x < padded; x++)
+                            {
+                                int sx = std::clamp((int)(tx * tileSize + x) - (int)border, 0, levelWidth - 1);
+                                std::memcpy(&tile[((size_t)y * padded + x) * g_Channels],
+                                            &image[((size_t)sy * levelWidth + sx) * g_Channels], g_Channels);
+                            }
+                        }
+                        file.write(reinterpret_cast<const char*>(tile.data()), (std::streamsize)tile.size());
+                    }
+                }
+            }
+            written = (bool)file;
+        }
+    }
+    stbi_image_free(data);
+    
+    std::error_code error;
+    if (written)
+        std::filesystem::rename(temporary, destination, error);
+    if (!written || error)
+    {
+        CORE_WARN("Failed to write: " + destination.filename().string());
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Start rendering the tiles required into the feedback framebuffer (with the feedback shader).
+ *
+ * @param width The size of the framebuffer where the texture is sampled (in pixels).
+ * @param height The size of the framebuffer where the texture is sampled (in pixels).
+ */
+void VirtualTexture::BeginFeedback(const unsigned int width, const unsigned int height)
+{
+    if (!IsLoaded())
+        return;
+    
+    // The derivatives of the texture coordinates are larger in the low resolution feedback
+    const auto& spec = m_Feedback->GetSpec();
+    float scale = std::max((float)width / (float)spec.Width, (float)height / (float)spec.Height);
+    m_FeedbackBias = -std::log2(std::max(scale, 1.0f));
+    
+    // Pixels not covered by the geometry do not require any tile
+    m_Feedback->Bind();
+    Renderer::Clear(glm::vec4(0.0f), { true, true, false });
+}
+
+/**
+ * Finish rendering the feedback, and read it back asynchronously (unless every read back is
+ * still pending).
+ */
+void VirtualTexture::EndFeedback()
+{
+    if (!IsLoaded())
+        return;
+    
+    FeedbackReadback& readback = m_Readbacks[m_Readback];
+    if (!readback.fence)
+    {
+        const auto& spec = m_Feedback->GetSpec();
+        m_Feedback->BindForReadAttachment(0);
+        readback.buffer->Bind(StorageTarget::PixelPack);
+        glReadPixels(0, 0, spec.Width, spec.Height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        readback.buffer->Unbind(StorageTarget::PixelPack);
+        
+        readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        m_Readback = (m_Readback + 1) % (unsigned int)m_Readbacks.size();
+    }
+    m_Feedback->Unbind(false);
+}
+
+/**
+ * Read the feedback copied since the last update, request the tiles missing, and upload the
+ * tiles read by the workers into the cache. This must be called once per frame from the
+ * rendering thread.
+ */
+void VirtualTexture::Update()
+{
+    if (!IsLoaded())
+        return;
+    
+    m_Frame++;
+    m_Stats.uploads = 0;
+    
+    // Read the feedback copied (from the oldest), without waiting for the GPU
+    for (unsigned int i = 0; i < m_Readbacks.size(); i++)
+    {
+        FeedbackReadback& readback = m_Readbacks[(m_Readback + i) % m_Readbacks.size()];
+        if (!readback.fence)
+            continue;
+        
+        GLenum status = glClientWaitSync(readback.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            break;
+        glDeleteSync(readback.fence);
+        readback.fence = nullptr;
+        
+        const auto& spec = m_Feedback->GetSpec();
+        if (const uint8_t* pixels = readback.buffer->Map<uint8_t>(StorageAccess::Read))
+            ReadFeedback(pixels, (size_t)spec.Width * spec.Height);
+        readback.buffer->Unmap();
+    }
+    
+    // Upload the tiles read, within the limit of the frame
+    while (m_Stats.uploads < g_MaxUploads)
+    {
+        LoadedTile tile;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_Loaded.empty())
+                break;
+            
+            tile = std::move(m_Loaded.front());
+            m_Loaded.pop_front();
+        }
+        
+        m_Requested.erase(tile.tile);
+        if (!tile.data.empty() && Upload(tile))
+            m_Stats.uploads++;
+    }
+    UploadPageTable();
+    
+    m_Stats.resident = (unsigned int)m_Resident.size();
+    m_Stats.pending = (unsigned int)m_Requested.size();
+    m_Stats.memory = m_Cache->GetMemorySize() + m_PageTable->GetMemorySize();
+}
+
+/**
+ * Set the properties of the texture into the uniforms of a shader program (see the
+ * `VirtualTexture` structure of the shaders).
+ *
+ * @param shader The shader program to set the properties for.
+ * @param name The uniform name.
+ * @param slot The first texture slot (incremented for each texture bound).
+ * @param feedback Whether the shader renders the feedback (at a lower resolution).
+ */
+void VirtualTexture::SetProperties(const std::shared_ptr<Shader>& shader, const std::string& name,
+                                   unsigned int& slot, const bool feedback) const
+{
+    if (!IsLoaded())
+        return;
+    
+    utils::Texturing::SetTextureMap(shader, name + ".PageTable", m_PageTable, slot++);
+    utils::Texturing::SetTextureMap(shader, name + ".Cache", m_Cache, slot++);
+    
+    shader->SetVec2(name + ".Scale", glm::vec2((float)m_Width / (float)(m_TilesX * m_TileSize),
+                                               (float)m_Height / (float)(m_TilesY * m_TileSize)));
+    shader->SetVec2(name + ".Tiles", glm::vec2((float)m_TilesX, (float)m_TilesY));
+    shader->SetFloat(name + ".TileSize", (float)m_TileSize);
+    shader->SetFloat(name + ".Border", (float)m_Border);
+    shader->SetFloat(name + ".CacheSize", (float)(m_CacheSlots * (m_TileSize + 2 * m_Border)));
+    shader->SetFloat(name + ".Levels", (float)m_Levels);
+    shader->SetFloat(name + ".Bias", feedback ? m_FeedbackBias : 0.0f);
+}
+
+/**
+ * Get the index of a tile in the tiled file (the tiles of each level are stored one after the
+ * other, row by row, from the base level).
+ *
+ * @param tile The tile key.
+ *
+ * @return The index of the tile.
+ */
+size_t VirtualTexture::GetTileIndex(const uint32_t tile) const
+{
+    unsigned int level = tile >> 24;
+    size_t index = 0;
+    for (unsigned int i = 0; i < level; i++)
+        index += (size_t)std::max(m_TilesX >> i, 1u) * std::max(m_TilesY >> i, 1u);
+    
+    return index + (size_t)((tile >> 12) & 0xFFF) * std::max(m_TilesX >> level, 1u) + (tile & 0xFFF);
+}
+
+/**
+ * Read the texels of a tile from the tiled file (paging them in from the disk if needed).
+ *
+ * @param tile The tile key.
+ *
+ * @return The texels of the tile, with its border.
+ */
+std::vector<uint8_t> VirtualTexture::ReadTile(const uint32_t tile) const
+{
+    size_t size = GetTileBytes(m_TileSize, m_Border);
+    const uint8_t* data = m_File->GetData() + sizeof(TiledHeader) + GetTileIndex(tile) * size;
+    return std::vector<uint8_t>(data, data + size);
+}
+
+/**
+ * Mark the tiles required by the feedback as used, and request the ones missing (with the
+ * coarser tiles missing between them and the tiles resident replacing them).
+ *
+ * @param pixels The pixels of the feedback (RGBA8).
+ * @param count The number of pixels.
+ */
+void VirtualTexture::ReadFeedback(const uint8_t *pixels, const size_t count)
+{
+    // Decode the tiles required (the level is stored in the alpha, zero if none is required)
+    std::unordered_set<uint32_t> visible;
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint8_t* pixel = pixels + i * g_Channels;
+        if (pixel[3] == 0)
+            continue;
+        
+        unsigned int level = std::min((unsigned int)pixel[3] - 1, m_Levels - 1);
+        unsigned int x = pixel[0] | ((pixel[2] & 0x0F) << 8);
+        unsigned int y = pixel[1] | ((pixel[2] >> 4) << 8);
+        x = std::min(x, std::max(m_TilesX >> level, 1u) - 1);
+        y = std::min(y, std::max(m_TilesY >> level, 1u) - 1);
+        visible.insert(GetTileKey(level, x, y));
+    }
+    m_Stats.visible = (unsigned int)visible.size();
+    
+    // Mark the tiles sampled, collecting the tiles missing until a resident one
+    std::vector<uint32_t> missing;
+    for (uint32_t tile : visible)
+    {
+        for (uint32_t key = tile; (key >> 24) < m_Levels; key = GetParentTile(key))
+        {
+            auto it = m_Resident.find(key);
+            if (it != m_Resident.end())
+            {
+                CacheSlot& slot = m_Slots[it->second];
+                if (slot.lastUsed != g_Pinned)
+                    slot.lastUsed = m_Frame;
+                break;
+            }
+            missing.push_back(key);
+        }
+    }
+    
+    // Request the coarser tiles first (the level is in the highest bits of the keys)
+    std::sort(missing.begin(), missing.end(), std::greater<uint32_t>());
+    missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+    for (uint32_t tile : missing)
+    {
+        if (m_Requested.size() >= g_MaxRequests)
+            break;
+        Request(tile);
+    }
+}
+
+/**
+ * Request a tile to the workers (unless it has already been requested).
+ *
+ * @param tile The tile key.
+ */
+void VirtualTexture::Request(const uint32_t tile)
+{
+    if (!m_Requested.insert(tile).second)
+        return;
+    
+    m_Workers->Submit([this, tile]()
+    {
+        LoadedTile loaded;
+        loaded.tile = tile;
+        loaded.data = ReadTile(tile);
+        
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Loaded.push_back(std::move(loaded));
+    });
+}
+
+/**
+ * Upload a tile into a free slot of the cache, or into the slot of the tile used least recently.
+ *
+ * @param tile The tile read.
+ *
+ * @return `true` if the tile has been uploaded, `false` if every slot holds a tile still in use.
+ */
+bool VirtualTexture::Upload(const LoadedTile& tile)
+{
+    if (m_Resident.count(tile.tile))
+        return false;
+    
+    // Find a free slot, or the slot used least recently
+    unsigned int index = UINT_MAX;
+    uint64_t oldest = g_Pinned;
+    for (unsigned int i = 0; i < m_Slots.size(); i++)
+    {
+        if (m_Slots[i].tile == UINT32_MAX)
+        {
+            index = i;
+            break;
+        }
+        if (m_Slots[i].lastUsed < oldest)
+        {
+            oldest = m_Slots[i].lastUsed;
+            index = i;
+        }
+    }
+    if (index == UINT_MAX)
+        return false;
+    
+    // Evict the tile of the slot, unless it has been used in the last frames
+    CacheSlot& slot = m_Slots[index];
+    if (slot.tile != UINT32_MAX)
+    {
+        if (slot.lastUsed + g_RecentFrames >= m_Frame)
+            return false;
+        
+        uint32_t evicted = slot.tile;
+        m_Resident.erase(evicted);
+        slot.tile = UINT32_MAX;
+        UpdatePageTable(evicted);
+        m_Stats.evictions++;
+    }
+    
+    unsigned int padded = m_TileSize + 2 * m_Border;
+    m_Cache->SetSubData((index % m_CacheSlots) * padded, (index / m_CacheSlots) * padded, padded, padded,
+                        tile.data.data());
+    
+    slot.tile = tile.tile;
+    slot.lastUsed = m_Frame;
+    m_Resident[tile.tile] = index;
+    UpdatePageTable(tile.tile);
+    return true;
+}
+
+/**
+ * Update the entries of the page table covered by a tile (after it has been uploaded or
+ * evicted): each entry locates its own tile if resident, or the entry of its parent otherwise.
+ *
+ * @param tile The tile key.
+ */
+void VirtualTexture::UpdatePageTable(const uint32_t tile)
+{
+    unsigned int level = tile >> 24;
+    unsigned int x = tile & 0xFFF;
+    unsigned int y = (tile >> 12) & 0xFFF;
+    
+    // The entries are updated from the coarser level, so the entries of the parents are up to date
+    for (int l = (int)level; l >= 0; l--)
+    {
+        unsigned int shift = level - l;
+        unsigned int width = std::max(m_TilesX >> l, 1u);
+        unsigned int height = std::max(m_TilesY >> l, 1u);
+        unsigned int parentWidth = std::max(m_TilesX >> (l + 1), 1u);
+        
+        unsigned int x0 = x << shift, x1 = std::min((x + 1) << shift, width);
+        unsigned int y0 = y << shift, y1 = std::min((y + 1) << shift, height);
+        for (unsigned int ty = y0; ty < y1; ty++)
+        {
+            for (unsigned int tx = x0; tx < x1; tx++)
+            {
+                uint32_t entry = 0;
+                auto it = m_Resident.find(GetTileKey(l, tx, ty));
+                if (it != m_Resident.end())
+                    entry = PackEntry(glm::uvec2(it->second % m_CacheSlots, it->second / m_CacheSlots), l);
+                else if (l + 1 < (int)m_Levels)
+                    entry = m_Entries[l + 1][(ty >> 1) * parentWidth + (tx >> 1)];
+                m_Entries[l][(size_t)ty * width + tx] = entry;
+            }
+        }
+        
+        m_DirtyRows[l].first = std::min(m_DirtyRows[l].first, y0);
+        m_DirtyRows[l].second = std::max(m_DirtyRows[l].second, y1 - 1);
+    }
+}
+
+/**
+ * Upload the rows of the page table modified since the last upload.
+ */
+void VirtualTexture::UploadPageTable()
+{
+    for (unsigned int level = 0; level < m_Levels; level++)
+    {
+        auto& [first, last] = m_DirtyRows[level];
+        if (first > last)
+            continue;
+        
+        unsigned int width = std::max(m_TilesX >> level, 1u);
+        m_PageTable->SetSubData(0, first, width, last - first + 1, &m_Entries[level][(size_t)first * width],
+                                level);
+        first = UINT_MAX;
+        last = 0;
+    }
+}
@@ -67,6 +67,11 @@ void Scene::Draw(const RenderPassSpecification &pass)
             Renderer::Clear();
     }
     
+    // Rasterize the occluders from the scene camera, hiding the models behind them
+    bool occlusion = m_Occlusion && pass.Camera == m_Camera;
+    if (occlusion)
+        m_Occlusion->Render(m_Camera->GetViewMatrix(), m_Camera->GetProjectionMatrix());
+    
     // Render each model with its associated material
     for (auto& pair : pass.Models)
     {
@@ -83,6 +88,10 @@ void Scene::Draw(const RenderPassSpecification &pass)
         // Check if the model is valid
         if (model)
         {
+            // Skip the model if it is hidden behind the occluders
+            if (occlusion && !m_Occlusion->IsVisible(*model))
+                continue;
+            
             // If a material is specified for the model, set it
             if (!pair.second.empty())
             {
@@ -90,7 +99,12 @@ void Scene::Draw(const RenderPassSpecification &pass)
                 DefineShadowProperties(material);
                 model->SetMaterial(material);
             }
-            
+
+            // Select the level of detail from the scene camera, so all the passes (e.g. shadows)
+            // render the same geometry
+            if (pass.Camera == m_Camera)
+                model->UpdateLOD(m_Camera->GetViewMatrix(), m_Camera->GetProjectionMatrix());
+
             // Draw the model
             model->DrawModel();
         }
@@ -4,6 +4,14 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
+// Context versions requested, from the most recent one (compute shaders, indirect draw counts,
+// direct state access) to the minimum version required
+#ifdef __APPLE__
+static const int g_Versions[][2] = { { 4, 1 }, { 3, 3 } };
+#else
+static const int g_Versions[][2] = { { 4, 6 }, { 4, 5 }, { 4, 3 }, { 3, 3 } };
+#endif
+
 /**
  *  Constructs an OpenGL context for rendering.
  *
@@ -47,8 +55,8 @@ void OpenGLContext::Init()
  */
 void OpenGLContext::SetWindowHints()
 {
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, g_Versions[s_VersionIndex][0]);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, g_Versions[s_VersionIndex][1]);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     
 #ifdef __APPLE__
@@ -56,6 +64,23 @@ void OpenGLContext::SetWindowHints()
 #endif
 }
 
+/**
+ *  Sets the window hints for the next (older) OpenGL version, used when the context could not
+ *  be created with the current one.
+ *
+ *  @return `true` if an older version can be requested.
+ */
+bool OpenGLContext::SetFallbackWindowHints()
+{
+    if (s_VersionIndex + 1 >= sizeof(g_Versions) / sizeof(g_Versions[0]))
+        return false;
+    
+    s_VersionIndex++;
+    CORE_WARN("Falling back to OpenGL {0}.{1}", g_Versions[s_VersionIndex][0], g_Versions[s_VersionIndex][1]);
+    SetWindowHints();
+    return true;
+}
+
 /**
  * Define if the window's buffer swap will be synchronized with the vertical
  * refresh rate of the monitor.
@@ -14,8 +14,18 @@ OpenGLShader::OpenGLShader(const std::string& name, const std::filesystem::path&
     : Shader(name, filePath)
 {
     OpenGLShaderSource source = ParseShader(filePath);
-    m_ID = CreateShader(source.VertexSource, source.FragmentSource,
-                        source.GeometrySource);
+    // A compute shader defines a program on its own
+    if (!source.ComputeSource.empty())
+    {
+        m_ID = CreateComputeShader(source.ComputeSource);
+        
+        GLint size[3];
+        glGetProgramiv(m_ID, GL_COMPUTE_WORK_GROUP_SIZE, size);
+        m_WorkGroupSize = glm::uvec3(size[0], size[1], size[2]);
+    }
+    else
+        m_ID = CreateShader(source.VertexSource, source.FragmentSource,
+                            source.GeometrySource);
 }
 
 /**
@@ -73,6 +83,17 @@ int OpenGLShader::GetUniformLocation(const std::string& name)
     return location;
 }
 
+/**
+ * Get the size of the work groups declared by the compute shader (`local_size`).
+ *
+ * @return The number of invocations in each dimension of a work group (one for
+ * non-compute programs).
+ */
+glm::uvec3 OpenGLShader::GetWorkGroupSize() const
+{
+    return m_WorkGroupSize;
+}
+
 /**
  * Set the uniform with a bool value.
  *
@@ -207,6 +228,9 @@ unsigned int OpenGLShader::CompileShader(unsigned int type, const std::string& s
         case GL_GEOMETRY_SHADER:
             shaderType = "geometry";
             break;
+        case GL_COMPUTE_SHADER:
+            shaderType = "compute";
+            break;
         default:
             shaderType = "unknown";
             break;
@@ -252,6 +276,12 @@ unsigned int OpenGLShader::CreateShader(const std::string& vertexShader,
     
     // Link shaders
     glLinkProgram(program);
+    
+    // Assign the shared uniform blocks to their binding points (no `binding` layout in GLSL 3.30)
+    unsigned int transform = glGetUniformBlockIndex(program, "Transform");
+    if (transform != GL_INVALID_INDEX)
+        glUniformBlockBinding(program, transform, (GLuint)UniformBinding::Transform);
+    
     glValidateProgram(program);
     
     // De-allocate the shader resources
@@ -264,6 +294,36 @@ unsigned int OpenGLShader::CreateShader(const std::string& vertexShader,
     return program;
 }
 
+/**
+ * Generate a shader program from a compute input.
+ *
+ * @param computeShader Source of compute shader.
+ *
+ * @return ID of the shader program.
+ */
+unsigned int OpenGLShader::CreateComputeShader(const std::string& computeShader)
+{
+    CORE_ASSERT(GLEW_VERSION_4_3 || GLEW_ARB_compute_shader,
+                "Compute shaders are not supported by the current context!");
+    
+    // Define a shader program
+    unsigned int program = glCreateProgram();
+    
+    // Compute shader
+    unsigned int cs = CompileShader(GL_COMPUTE_SHADER, computeShader);
+    glAttachShader(program, cs);
+    
+    // Link shader
+    glLinkProgram(program);
+    glValidateProgram(program);
+    
+    // De-allocate the shader resources
+    glDeleteShader(cs);
+    
+    // Return the shader program
+    return program;
+}
+
 /**
  * Parse shader input file.
  *
@@ -279,12 +339,12 @@ OpenGLShader::OpenGLShaderSource OpenGLShader::ParseShader(const std::filesystem
     // Define the different shader classes available
     enum class ShaderType
     {
-        NONE = -1, VERTEX = 0, FRAGMENT = 1, GEOMETRY = 2
+        NONE = -1, VERTEX = 0, FRAGMENT = 1, GEOMETRY = 2, COMPUTE = 3
     };
     
     // Parse the file
     std::string line;
-    std::stringstream ss[3];
+    std::stringstream ss[4];
     ShaderType type = ShaderType::NONE;
     while (getline(stream, line))
     {
@@ -296,9 +356,12 @@ OpenGLShader::OpenGLShaderSource OpenGLShader::ParseShader(const std::filesystem
             // Set mode to fragment
             else if (line.find("fragment") != std::string::npos)
                 type = ShaderType::FRAGMENT;
-            // Set mode to fragment
+            // Set mode to geometry
             else if (line.find("geometry") != std::string::npos)
                 type = ShaderType::GEOMETRY;
+            // Set mode to compute
+            else if (line.find("compute") != std::string::npos)
+                type = ShaderType::COMPUTE;
         }
         else
         {
@@ -316,5 +379,5 @@ OpenGLShader::OpenGLShaderSource OpenGLShader::ParseShader(const std::filesystem
     }
     
     // Return the shader sources
-    return OpenGLShaderSource(ss[0].str(), ss[1].str(), ss[2].str());
+    return OpenGLShaderSource(ss[0].str(), ss[1].str(), ss[2].str(), ss[3].str());
 }
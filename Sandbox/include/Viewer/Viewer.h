@@ -27,6 +27,12 @@ public:
     void OnUpdate(Timestep ts) override;
     void OnEvent(Event& e) override;
     
+    // Getter(s)
+    // ----------------------------------------
+    /// @brief Get the scene rendered in the viewer.
+    /// @return The scene.
+    Scene& GetScene() { return *m_Scene; }
+    
     // Setters(s)
     // ----------------------------------------
     /// @brief Set the interaction state inside this layer.
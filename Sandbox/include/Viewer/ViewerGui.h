@@ -30,6 +30,7 @@ private:
     // GUI
     // ----------------------------------------
     void GUIMenu();
+    void GUIModels();
     
     // Getter(s)
     // ----------------------------------------
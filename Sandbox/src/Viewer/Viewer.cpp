@@ -97,8 +97,11 @@ void Viewer::DefineMaterials()
     
     auto cubeMaterial = library.Create<PhongTextureMaterial>("PhongTexture",
         "Resources/shaders/phong/PhongTextureShadow.glsl");
-    cubeMaterial->SetDiffuseMap(std::make_shared<Texture2DResource>("Resources/textures/diffuse.jpeg"));
-    cubeMaterial->SetSpecularMap(std::make_shared<Texture2DResource>("Resources/textures/specular.jpeg"));
+    auto& textures = Renderer::GetTextureLibrary();
+    TextureLoadOptions colorOptions;
+    colorOptions.SRGB = true;
+    cubeMaterial->SetDiffuseMap(textures->Load("Resources/textures/diffuse.jpeg", colorOptions));
+    cubeMaterial->SetSpecularMap(textures->Load("Resources/textures/specular.jpeg"));
     cubeMaterial->SetShininess(32.0f);
     
     auto planeMaterial = library.Create<PhongColorMaterial>("PhongColor",
@@ -166,6 +169,9 @@ void Viewer::DefineRenderPasses()
         { "Light", "" }
     };
     scenePassSpec.Color = glm::vec4(0.93f, 0.93f, 0.93f, 1.0f);
+    // Discard the back faces (also skipping the meshlets facing away from the camera)
+    scenePassSpec.PreRenderCode = []() { Renderer::SetFaceCullingEnabled(true); };
+    scenePassSpec.PostRenderCode = []() { Renderer::SetFaceCullingEnabled(false); };
     library.Add("Scene", scenePassSpec);
     
     RenderPassSpecification screenPassSpec;
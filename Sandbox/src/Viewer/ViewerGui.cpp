@@ -20,6 +20,7 @@ void ViewerGui::OnUpdate(Timestep ts)
     Begin();
     GUIStats(ts);
     GUIMenu();
+    GUIModels();
     End();
     
     // If GUI is active, disable the interaction in the rendering layer
@@ -72,6 +73,28 @@ void ViewerGui::GUIMenu()
      */
 }
 
+/**
+ * Render the memory used by each model of the scene.
+ */
+void ViewerGui::GUIModels()
+{
+    ImGui::Begin("Models");
+    
+    MemoryUsage total;
+    for (const auto& [name, model] : m_Viewer->GetScene().GetModels())
+    {
+        MemoryUsage usage = model->GetMemoryUsage();
+        unsigned int levels = model->GetAsset() ? model->GetAsset()->GetLODNumber() : 1;
+        ImGui::Text("%s: CPU %.1f KB / GPU %.1f KB (LOD %u/%u)", name.c_str(),
+                    usage.cpu / 1024.0f, usage.gpu / 1024.0f, model->GetLOD(), levels);
+        total += usage;
+    }
+    ImGui::Separator();
+    ImGui::Text("Total: CPU %.1f KB / GPU %.1f KB", total.cpu / 1024.0f, total.gpu / 1024.0f);
+    
+    ImGui::End();
+}
+
 /**
  * Define the style of the GUI.
  */
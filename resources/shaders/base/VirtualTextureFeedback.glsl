@@ -0,0 +1,24 @@
+#shader vertex
+#version 330 core
+
+// Include transformation matrices
+#include "Resources/shaders/common/matrix/SimpleMatrix.glsl"
+
+// Include vertex shader
+#include "Resources/shaders/common/vertex/PT.vs.glsl"
+
+#shader fragment
+#version 330 core
+
+// Include material properties
+#include "Resources/shaders/common/material/VirtualTextureMaterial.glsl"
+
+// Include fragment inputs
+#include "Resources/shaders/common/fragment/T.fs.glsl"
+
+// Entry point of the fragment shader
+void main()
+{
+    // Write the tile required at the provided texture coordinates
+    color = virtualFeedback(u_Material.TextureMap, v_TextureCoord);
+}
@@ -0,0 +1,35 @@
+/**
+ * Represents the material properties of an object.
+ */
+struct Material {
+    sampler2DArray DiffuseMap;  ///< Texture array containing the diffuse map.
+    sampler2DArray SpecularMap; ///< Texture array containing the specular map.
+    
+    float DiffuseLayer;         ///< Layer of the diffuse map.
+    vec4 DiffuseTransform;      ///< Scale (xy) and offset (zw) of the diffuse map coordinates.
+    float SpecularLayer;        ///< Layer of the specular map.
+    vec4 SpecularTransform;     ///< Scale (xy) and offset (zw) of the specular map coordinates.
+    
+    float Shininess;            ///< Shininess factor for specular highlights.
+    float Alpha;                ///< Alpha transparency value of the material.
+};
+
+/**
+ * Sample a texture packed into a layer of a texture array.
+ *
+ * The texture coordinates are wrapped (repeated) before being remapped into the region of the
+ * layer, and the gradients of the original coordinates are used to select the mipmap level, so
+ * the wrapping does not cause seams.
+ *
+ * @param map The texture array.
+ * @param uv The texture coordinates.
+ * @param layer The layer of the texture.
+ * @param transform The scale (xy) and offset (zw) of the region in the layer.
+ *
+ * @return The sampled color.
+ */
+vec4 sampleLayer(sampler2DArray map, vec2 uv, float layer, vec4 transform)
+{
+    vec2 coords = fract(uv) * transform.xy + transform.zw;
+    return textureGrad(map, vec3(coords, layer), dFdx(uv) * transform.xy, dFdy(uv) * transform.xy);
+}
@@ -0,0 +1,95 @@
+/**
+ * Represents a texture streamed by tiles into a cache (see `VirtualTexture`).
+ */
+struct VirtualTexture {
+    sampler2D PageTable;    ///< Location of each tile in the cache (one level per level of the texture).
+    sampler2D Cache;        ///< Tiles resident, with their border.
+    
+    vec2 Scale;             ///< Size of the image relative to the tiles covering it.
+    vec2 Tiles;             ///< Number of tiles of the base level.
+    float TileSize;         ///< Size of the tiles (in texels, without their border).
+    float Border;           ///< Size of the border of the tiles (in texels).
+    float CacheSize;        ///< Size of the cache (in texels).
+    float Levels;           ///< Number of levels of the texture.
+    float Bias;             ///< Bias of the level selected (negative for the low resolution feedback).
+};
+
+/**
+ * Represents the material properties of an object.
+ */
+struct Material {
+    VirtualTexture TextureMap;  ///< Virtual texture applied to the material.
+};
+
+/**
+ * Select the level of a virtual texture sampled, from the gradients of the texture coordinates.
+ *
+ * @param map The virtual texture.
+ * @param uv The texture coordinates (not wrapped, so the wrapping does not affect the gradients).
+ *
+ * @return The level (the finest one of the footprint).
+ */
+float virtualLevel(VirtualTexture map, vec2 uv)
+{
+    vec2 texel = uv * map.Scale * map.Tiles * map.TileSize;
+    vec2 dx = dFdx(texel);
+    vec2 dy = dFdy(texel);
+    float level = 0.5f * log2(max(max(dot(dx, dx), dot(dy, dy)), 1e-8f)) + map.Bias;
+    return clamp(floor(level), 0.0f, map.Levels - 1.0f);
+}
+
+/**
+ * Get the tile of a virtual texture covering the texture coordinates at a level.
+ *
+ * @param map The virtual texture.
+ * @param uv The texture coordinates.
+ * @param level The level of the tile.
+ *
+ * @return The position of the tile (in tiles).
+ */
+ivec2 virtualTile(VirtualTexture map, vec2 uv, float level)
+{
+    ivec2 size = textureSize(map.PageTable, int(level));
+    return min(ivec2(fract(uv) * map.Scale * vec2(size)), size - 1);
+}
+
+/**
+ * Sample a virtual texture, using the closest coarser tile resident if the tile required is not
+ * resident yet.
+ *
+ * @param map The virtual texture.
+ * @param uv The texture coordinates (wrapped).
+ *
+ * @return The sampled color.
+ */
+vec4 sampleVirtual(VirtualTexture map, vec2 uv)
+{
+    float level = virtualLevel(map, uv);
+    
+    // Locate the tile resident in the cache (red and green) and its level (blue)
+    vec4 entry = texelFetch(map.PageTable, virtualTile(map, uv, level), int(level)) * 255.0f;
+    
+    // Position inside the tile resident (the coarsest tiles cover more than the image)
+    vec2 position = fract(uv) * map.Scale * map.Tiles / exp2(entry.b);
+    vec2 offset = position - floor(position);
+    
+    vec2 coords = entry.rg * (map.TileSize + 2.0f * map.Border) + map.Border + offset * map.TileSize;
+    return texture(map.Cache, coords / map.CacheSize);
+}
+
+/**
+ * Encode the tile of a virtual texture required at the texture coordinates into the feedback.
+ *
+ * @param map The virtual texture.
+ * @param uv The texture coordinates (wrapped).
+ *
+ * @return The low bits of the position of the tile (red and green), its high bits (blue) and its
+ * level plus one (alpha, zero where no tile is required).
+ */
+vec4 virtualFeedback(VirtualTexture map, vec2 uv)
+{
+    float level = virtualLevel(map, uv);
+    ivec2 tile = virtualTile(map, uv, level);
+    
+    return vec4(tile.x & 255, tile.y & 255, (tile.x >> 8) | ((tile.y >> 8) << 4), level + 1.0f) / 255.0f;
+}
@@ -0,0 +1,19 @@
+/**
+ * Represents the transformation matrices of the instances drawn indirectly (one instance per
+ * draw command, identified by the base instance of the command).
+ *
+ * Requires the `GL_ARB_shader_draw_parameters` extension.
+ */
+layout (std430, binding = 0) readonly buffer Instances {
+    mat4 Transforms[];  ///< Model matrix of each instance.
+} u_Instances;
+
+/**
+ * Get the model matrix of the instance being drawn.
+ *
+ * @return The model matrix of the instance.
+ */
+mat4 InstanceModel()
+{
+    return u_Instances.Transforms[gl_BaseInstanceARB];
+}
@@ -1,10 +1,12 @@
 /**
- * Represents transformation matrices for rendering.
+ * Represents transformation matrices for rendering, written for each draw into a uniform block
+ * (shared by all the matrix variants, so the members keep the same order and offsets).
  */
-struct Transform {
+layout (std140) uniform Transform {
     mat4 Model;         ///< Model matrix for transforming object vertices to world space.
     mat4 View;          ///< View matrix for transforming world space to camera space.
     mat4 Projection;    ///< Projection matrix for transforming camera space to clip space.
 
+    mat3 Normal;        ///< Normal matrix for transforming normals to world space.
     mat4 Texture;       ///< Texture matrix for transforming position to [0, 1] range for texture sampling.
-};
+} u_Transform;
@@ -0,0 +1,15 @@
+/**
+ * Decode a normal vector encoded using the octahedral mapping.
+ *
+ * @param e Encoded normal in the range [-1, 1] (e.g. a normalized `Short2` attribute).
+ *
+ * @return Decoded (normalized) normal vector.
+ */
+vec3 octahedralDecode(vec2 e) {
+    // Recover the position on the octahedron
+    vec3 n = vec3(e.xy, 1.0f - abs(e.x) - abs(e.y));
+    // Unfold the lower hemisphere
+    float t = max(-n.z, 0.0f);
+    n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0f)));
+    return normalize(n);
+}
@@ -0,0 +1,11 @@
+// Input vertex attribute: Position of the vertex in object space
+layout (location = 0) in vec4 a_Position;
+
+// Entry point of the vertex shader
+void main()
+{
+    // Calculate the final position of the vertex in clip space, applying the
+    // transformation of the instance on top of the model matrix
+    gl_Position = u_Transform.Projection * u_Transform.View * InstanceModel()
+        * u_Transform.Model * a_Position;
+}
@@ -1,9 +1,6 @@
 // Input vertex attribute: Position of the vertex in object space
 layout (location = 0) in vec4 a_Position;
 
-// Uniform buffer block containing transformation matrices
-uniform Transform u_Transform;
-
 // Entry point of the vertex shader
 void main()
 {
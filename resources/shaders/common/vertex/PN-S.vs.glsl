@@ -2,9 +2,6 @@
 layout (location = 0) in vec4 a_Position;           // Vertex position in object space
 layout (location = 1) in vec3 a_Normal;             // Vertex normal in object space
 
-// Uniform buffer block containing transformation matrices
-uniform Transform u_Transform;
-
 uniform Environment u_Environment;
 #define MAX_NUMBER_LIGHTS 4
 uniform Light u_Light[MAX_NUMBER_LIGHTS];
@@ -2,9 +2,6 @@
 layout (location = 0) in vec4 a_Position;       // Vertex position in object space
 layout (location = 1) in vec2 a_TextureCoord;  // Texture coordinates
 
-// Uniform buffer block containing transformation matrices
-uniform Transform u_Transform;
-
 // Output to fragment shader
 out vec2 v_TextureCoord;  // Pass texture coordinates to the fragment shader
 
@@ -3,9 +3,6 @@ layout (location = 0) in vec4 a_Position;       // Vertex position in object spa
 layout (location = 1) in vec2 a_TextureCoord;  // Texture coordinates
 layout (location = 2) in vec3 a_Normal;        // Vertex normal in object space
 
-// Uniform buffer block containing transformation matrices
-uniform Transform u_Transform;
-
 // Output to fragment shader
 out vec3 v_Position;           // Vertex position in world space
 out vec2 v_TextureCoord;       // Texture coordinates
@@ -0,0 +1,26 @@
+#shader vertex
+#version 430 core
+#extension GL_ARB_shader_draw_parameters : require
+
+// Include transformation matrices
+#include "Resources/shaders/common/matrix/SimpleMatrix.glsl"
+#include "Resources/shaders/common/matrix/InstanceMatrix.glsl"
+
+// Include vertex shader
+#include "Resources/shaders/common/vertex/P-I.vs.glsl"
+
+#shader fragment
+#version 430 core
+
+// Include material properties
+#include "Resources/shaders/common/material/ColorMaterial.glsl"
+
+// Include fragment inputs
+#include "Resources/shaders/common/fragment/P.fs.glsl"
+
+// Entry point of the fragment shader
+void main()
+{
+    // Set the output color of the fragment shader to the material color
+    color = u_Material.Color;
+}
@@ -0,0 +1,165 @@
+#shader compute
+#version 430 core
+
+// One instance processed per invocation
+layout (local_size_x = 64) in;
+
+/**
+ * Represents the arguments of an indexed indirect draw call (`DrawElementsIndirectCommand`).
+ */
+struct DrawCommand {
+    uint Count;             ///< Number of indices drawn.
+    uint InstanceCount;     ///< Number of instances drawn.
+    uint FirstIndex;        ///< First index drawn.
+    int BaseVertex;         ///< Value added to the indices.
+    uint BaseInstance;      ///< First instance drawn (identifies the instance transformation).
+};
+
+// Storage buffer blocks
+layout (std430, binding = 0) readonly buffer Instances {
+    mat4 Transforms[];                          ///< Model matrix of each instance.
+} u_Instances;
+layout (std430, binding = 1) writeonly buffer Commands {
+    DrawCommand Commands[];                     ///< Draw commands of the visible instances.
+} u_Commands;
+layout (std430, binding = 2) buffer DrawCount {
+    uint Count;                                 ///< Number of draw commands written.
+} u_DrawCount;
+
+// Geometry being culled
+uniform int u_InstanceCount;                    ///< Number of instances.
+uniform vec4 u_Sphere;                          ///< Bounding sphere (center, radius) in model space.
+uniform int u_LODNumber;                        ///< Number of levels of detail.
+uniform int u_LODOffsets[8];                    ///< First index of each level of detail.
+uniform int u_LODCounts[8];                     ///< Number of indices of each level of detail.
+
+// View
+uniform vec4 u_Planes[6];                       ///< Frustum planes (world space).
+uniform mat4 u_View;                            ///< View matrix.
+uniform mat4 u_Projection;                      ///< Projection matrix.
+
+// Occlusion
+uniform bool u_Occlusion;                       ///< Occlusion culling enabled.
+uniform sampler2D u_DepthPyramid;               ///< Farthest depth of each region (previous frame).
+uniform mat4 u_PyramidViewProjection;           ///< View-projection used to render the pyramid.
+
+// -----------------------------------------
+// Visibility
+// -----------------------------------------
+/**
+ * Checks if a sphere is (at least partially) inside the view frustum.
+ *
+ * @param center The center of the sphere (world space).
+ * @param radius The radius of the sphere.
+ *
+ * @return `true` if the sphere intersects the frustum.
+ */
+bool IsInsideFrustum(vec3 center, float radius)
+{
+    for (int i = 0; i < 6; i++)
+    {
+        if (dot(u_Planes[i].xyz, center) + u_Planes[i].w < -radius)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Checks if a sphere is hidden behind the depth of the previous frame.
+ *
+ * The box around the sphere is projected into the depth pyramid, and its nearest depth is
+ * compared against the farthest depth stored in the level where the box covers 2x2 texels.
+ *
+ * @param center The center of the sphere (world space).
+ * @param radius The radius of the sphere.
+ *
+ * @return `true` if the sphere is completely occluded.
+ */
+bool IsOccluded(vec3 center, float radius)
+{
+    vec2 minUV = vec2(1.0f);
+    vec2 maxUV = vec2(0.0f);
+    float minDepth = 1.0f;
+    for (int i = 0; i < 8; i++)
+    {
+        vec3 corner = center + radius * vec3((i & 1) == 0 ? -1.0f : 1.0f,
+                                             (i & 2) == 0 ? -1.0f : 1.0f,
+                                             (i & 4) == 0 ? -1.0f : 1.0f);
+        vec4 clip = u_PyramidViewProjection * vec4(corner, 1.0f);
+        // The box crosses the near plane
+        if (clip.w <= 0.0f)
+            return false;
+        
+        vec3 ndc = clip.xyz / clip.w;
+        minUV = min(minUV, ndc.xy * 0.5f + 0.5f);
+        maxUV = max(maxUV, ndc.xy * 0.5f + 0.5f);
+        minDepth = min(minDepth, ndc.z * 0.5f + 0.5f);
+    }
+    minUV = clamp(minUV, 0.0f, 1.0f);
+    maxUV = clamp(maxUV, 0.0f, 1.0f);
+    
+    // Select the level where the box covers (at most) 2x2 texels
+    vec2 size = (maxUV - minUV) * vec2(textureSize(u_DepthPyramid, 0));
+    float levels = float(textureQueryLevels(u_DepthPyramid));
+    float level = clamp(ceil(log2(max(max(size.x, size.y), 1.0f))), 0.0f, levels - 1.0f);
+    
+    float depth = max(max(textureLod(u_DepthPyramid, vec2(minUV.x, minUV.y), level).r,
+                          textureLod(u_DepthPyramid, vec2(maxUV.x, minUV.y), level).r),
+                      max(textureLod(u_DepthPyramid, vec2(minUV.x, maxUV.y), level).r,
+                          textureLod(u_DepthPyramid, vec2(maxUV.x, maxUV.y), level).r));
+    return minDepth > depth;
+}
+
+// -----------------------------------------
+// Level of detail
+// -----------------------------------------
+/**
+ * Selects the level of detail of a sphere from its size on the screen (each level is used
+ * below half the size of the previous one).
+ *
+ * @param center The center of the sphere (world space).
+ * @param radius The radius of the sphere.
+ *
+ * @return The level of detail.
+ */
+int SelectLOD(vec3 center, float radius)
+{
+    // Clip-space w of the center (the view depth for perspective projections)
+    vec4 p = u_View * vec4(center, 1.0f);
+    float w = u_Projection[2][3] * p.z + u_Projection[3][3];
+    if (w <= radius * abs(u_Projection[2][3]))
+        return 0;
+    
+    float size = radius * abs(u_Projection[1][1]) / w;
+    int lod = 0;
+    while (lod + 1 < u_LODNumber && size < exp2(-float(lod + 1)))
+        lod++;
+    return lod;
+}
+
+// Entry point of the compute shader
+void main()
+{
+    uint id = gl_GlobalInvocationID.x;
+    if (id >= uint(u_InstanceCount))
+        return;
+    
+    // Bounding sphere of the instance (world space)
+    mat4 transform = u_Instances.Transforms[id];
+    vec3 center = (transform * vec4(u_Sphere.xyz, 1.0f)).xyz;
+    float scale = sqrt(max(max(dot(transform[0].xyz, transform[0].xyz),
+                               dot(transform[1].xyz, transform[1].xyz)),
+                           dot(transform[2].xyz, transform[2].xyz)));
+    float radius = u_Sphere.w * scale;
+    
+    // Discard the instances outside the view or hidden by the previous frame
+    if (!IsInsideFrustum(center, radius))
+        return;
+    if (u_Occlusion && IsOccluded(center, radius))
+        return;
+    
+    // Append the draw command of the instance
+    int lod = SelectLOD(center, radius);
+    uint slot = atomicAdd(u_DrawCount.Count, 1u);
+    u_Commands.Commands[slot] = DrawCommand(uint(u_LODCounts[lod]), 1u, uint(u_LODOffsets[lod]), 0, id);
+}
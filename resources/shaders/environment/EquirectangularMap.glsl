@@ -7,9 +7,6 @@
 // Input vertex attributes
 layout (location = 0) in vec4 a_Position;   ///< Vertex position in object space
 
-// Uniform buffer block containing transformation matrices
-uniform Transform u_Transform;
-
 // Outputs to fragment shader
 out vec3 v_Position;                        ///< Vertex position in object space
 
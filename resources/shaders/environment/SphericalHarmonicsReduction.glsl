@@ -0,0 +1,72 @@
+#shader compute
+#version 430 core
+
+// Number of invocations sharing the samples (a single work group)
+#define GROUP_SIZE 128
+
+layout (local_size_x = GROUP_SIZE) in;
+
+/**
+ * Represents the material properties of an object.
+ */
+struct Material {
+    samplerCube TextureMap;                     ///< Texture map applied to the material.
+};
+
+// Uniform buffer blocks
+uniform Material u_Material;                    ///< Material properties.
+
+// Storage buffer blocks
+layout (std430, binding = 0) writeonly buffer Coefficients {
+    vec4 Llm[9];                                ///< Spherical harmonics coefficients (rgb).
+} u_Coefficients;
+
+// Include the sampling and spherical harmonics functions
+#include "Resources/shaders/environment/chunks/SHSampling.glsl"
+
+// Partial sums of each invocation
+shared vec3 s_Llm[GROUP_SIZE * 9];
+
+// Entry point of the compute shader
+void main()
+{
+    uint id = gl_LocalInvocationID.x;
+    
+    // Define the initial values
+    vec3 Llm[9];
+    for (int k = 0; k < 9; ++k)
+        Llm[k] = vec3(0.0f);
+    
+    // Integrate over the sphere, each invocation projecting a subset of the samples
+    // into all the coefficients
+    const uint SAMPLE_COUNT = 8192u;
+    float deltaW = 4.0f * PI / float(SAMPLE_COUNT);
+    
+    for (uint i = id; i < SAMPLE_COUNT; i += GROUP_SIZE)
+    {
+        vec2 Xi = Hammersley(i, SAMPLE_COUNT);
+        vec3 wi = SampleSphereUniform(Xi);
+        vec3 Li = texture(u_Material.TextureMap, wi).rgb;
+        
+        for (int k = 0; k < 9; ++k)
+            Llm[k] += SH(indices[k].x, indices[k].y, wi) * Li * deltaW;
+    }
+    
+    // Reduce the partial sums of the work group
+    for (int k = 0; k < 9; ++k)
+        s_Llm[id * 9u + uint(k)] = Llm[k];
+    barrier();
+    
+    for (uint stride = GROUP_SIZE / 2; stride > 0u; stride >>= 1u)
+    {
+        if (id < stride)
+        {
+            for (int k = 0; k < 9; ++k)
+                s_Llm[id * 9u + uint(k)] += s_Llm[(id + stride) * 9u + uint(k)];
+        }
+        barrier();
+    }
+    
+    if (id < 9u)
+        u_Coefficients.Llm[id] = vec4(s_Llm[id], 0.0f);
+}